@@ -0,0 +1,204 @@
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bench/engine_benchmarks.h"
+#include "bench/episode_benchmark.h"
+#include "bench/micro_benchmark.h"
+
+using dig_dug::BenchmarkCase;
+using dig_dug::BenchmarkOptions;
+using dig_dug::BenchmarkResult;
+using dig_dug::EpisodeBenchmarkConfig;
+using dig_dug::EpisodeBenchmarkResult;
+
+namespace {
+
+void PrintUsage(const char* program) {
+  std::fprintf(stderr,
+               "Usage: %s [--board-sizes N,N,...] [--enemy-scales N,N,...] [--seed N] [--filter NAME] [--min-time-ms N] "
+               "[--batches N] [--json FILE] [--label TEXT] [--compare FILE]\n"
+               "       %s --episodes N [--board-sizes N,N,...] [--seed N] [--policy idle|random|hunter] "
+               "[--max-ticks N] [--json FILE] [--label TEXT] [--compare FILE]\n",
+               program, program);
+}
+
+/**
+ * Parses a list of sizes like 15,64,256
+ */
+std::vector<size_t> ParseSizes(const std::string& text) {
+  std::vector<size_t> sizes;
+  size_t start = 0;
+
+  while (start <= text.size()) {
+    size_t comma = text.find(',', start);
+    if (comma == std::string::npos) {
+      comma = text.size();
+    }
+
+    sizes.push_back(std::stoul(text.substr(start, comma - start)));
+    start = comma + 1;
+  }
+
+  return sizes;
+}
+
+/**
+ * Plays whole games on each board size and prints their throughput, tick latency and peak memory
+ */
+void RunEpisodeBenchmarks(const std::vector<size_t>& board_sizes, EpisodeBenchmarkConfig config,
+                          const std::string& json_path, const std::string& label, const std::string& compare_path) {
+  // Reads the baseline first so a bad path fails before the games are played
+  std::map<std::string, EpisodeBenchmarkResult> baseline;
+  if (!compare_path.empty()) {
+    for (const EpisodeBenchmarkResult& result : dig_dug::ReadEpisodeBenchmarkJson(compare_path)) {
+      baseline[result.GetKey()] = result;
+    }
+  }
+
+  std::printf("%6s %-8s %9s %11s %7s %9s %12s %12s %12s %12s %9s%s\n", "board", "policy", "episodes", "ticks", "levels",
+              "seconds", "episodes/s", "ticks/s", "p50 tick ns", "p99 tick ns", "peak MB",
+              baseline.empty() ? "" : "   episodes/s vs baseline");
+
+  std::vector<EpisodeBenchmarkResult> results;
+  for (size_t board_size : board_sizes) {
+    config.board_dimension = board_size;
+    EpisodeBenchmarkResult result = dig_dug::RunEpisodeBenchmark(config);
+    results.push_back(result);
+
+    std::printf("%6zu %-8s %9zu %11zu %7zu %9.3f %12.2f %12.0f %12llu %12llu %9.1f", result.board_dimension,
+                result.policy.c_str(), result.num_episodes, result.num_ticks, result.num_levels_cleared,
+                result.seconds, result.GetEpisodesPerSecond(), result.GetTicksPerSecond(),
+                (unsigned long long) (result.p50_tick_ns), (unsigned long long) (result.p99_tick_ns),
+                result.peak_resident_bytes / (1024.0 * 1024.0));
+
+    auto base = baseline.find(result.GetKey());
+    if (base != baseline.end() && base->second.GetEpisodesPerSecond() > 0) {
+      std::printf("   %+7.1f%%", (result.GetEpisodesPerSecond() / base->second.GetEpisodesPerSecond() - 1) * 100);
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+  }
+
+  if (!json_path.empty()) {
+    dig_dug::WriteEpisodeBenchmarkJson(json_path, results, label);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::vector<size_t> board_sizes;
+  // 0 is the default number of enemies for the board size
+  std::vector<size_t> enemy_scales = {0};
+  uint64_t seed = 1;
+  std::string filter;
+  BenchmarkOptions options;
+  std::string json_path;
+  std::string label;
+  std::string compare_path;
+  EpisodeBenchmarkConfig episode_config;
+  bool has_episodes = false;
+
+  try {
+    for (int arg = 1; arg < argc; arg++) {
+      bool has_value = arg + 1 < argc;
+
+      if (std::strcmp(argv[arg], "--board-sizes") == 0 && has_value) {
+        board_sizes = ParseSizes(argv[++arg]);
+      } else if (std::strcmp(argv[arg], "--enemy-scales") == 0 && has_value) {
+        enemy_scales = ParseSizes(argv[++arg]);
+      } else if (std::strcmp(argv[arg], "--seed") == 0 && has_value) {
+        seed = std::stoull(argv[++arg]);
+      } else if (std::strcmp(argv[arg], "--filter") == 0 && has_value) {
+        filter = argv[++arg];
+      } else if (std::strcmp(argv[arg], "--min-time-ms") == 0 && has_value) {
+        options.min_batch_seconds = std::stod(argv[++arg]) / 1000;
+      } else if (std::strcmp(argv[arg], "--batches") == 0 && has_value) {
+        options.num_batches = std::stoul(argv[++arg]);
+      } else if (std::strcmp(argv[arg], "--json") == 0 && has_value) {
+        json_path = argv[++arg];
+      } else if (std::strcmp(argv[arg], "--label") == 0 && has_value) {
+        label = argv[++arg];
+      } else if (std::strcmp(argv[arg], "--compare") == 0 && has_value) {
+        compare_path = argv[++arg];
+      } else if (std::strcmp(argv[arg], "--episodes") == 0 && has_value) {
+        episode_config.num_episodes = std::stoul(argv[++arg]);
+        has_episodes = true;
+      } else if (std::strcmp(argv[arg], "--policy") == 0 && has_value) {
+        episode_config.policy = argv[++arg];
+      } else if (std::strcmp(argv[arg], "--max-ticks") == 0 && has_value) {
+        episode_config.max_ticks = std::stoul(argv[++arg]);
+      } else {
+        PrintUsage(argv[0]);
+        return 1;
+      }
+    }
+
+    // Whole games on large boards take minutes, so games are only played on the arcade board unless asked
+    if (has_episodes) {
+      episode_config.first_seed = seed;
+      RunEpisodeBenchmarks(board_sizes.empty() ? std::vector<size_t>{15} : board_sizes, episode_config, json_path,
+                           label, compare_path);
+      return 0;
+    }
+    if (board_sizes.empty()) {
+      board_sizes = {15, 64, 256};
+    }
+
+    if (options.num_batches == 0) {
+      throw std::invalid_argument("Benchmarks need at least one batch");
+    }
+
+    // Reads the baseline first so a bad path fails before the benchmarks run
+    std::map<std::string, BenchmarkResult> baseline;
+    if (!compare_path.empty()) {
+      for (const BenchmarkResult& result : dig_dug::ReadBenchmarkJson(compare_path)) {
+        baseline[result.GetKey()] = result;
+      }
+    }
+
+    std::printf("%-18s %6s %8s %10s %12s %10s %12s %14s%s\n", "benchmark", "board", "enemies", "map KB", "ns/op",
+                "allocs/op", "bytes/op", "ops/s", baseline.empty() ? "" : "   vs baseline");
+
+    std::vector<BenchmarkResult> results;
+    for (size_t board_size : board_sizes) {
+      for (size_t enemy_scale : enemy_scales) {
+        for (const BenchmarkCase& benchmark : dig_dug::MakeEngineBenchmarks(board_size, seed, enemy_scale)) {
+          if (benchmark.name.find(filter) == std::string::npos) {
+            continue;
+          }
+
+          BenchmarkResult result = dig_dug::RunBenchmark(benchmark, options);
+          results.push_back(result);
+
+          std::printf("%-18s %6zu %8zu %10.1f %12.1f %10.3f %12.1f %14.0f", result.name.c_str(),
+                      result.board_dimension, result.num_enemies, result.map_bytes / 1024.0, result.ns_per_op,
+                      result.allocs_per_op, result.bytes_per_op, result.GetOpsPerSecond());
+
+          // Negative changes are faster than the baseline
+          auto base = baseline.find(result.GetKey());
+          if (base != baseline.end() && base->second.ns_per_op > 0) {
+            std::printf("   %+7.1f%%", (result.ns_per_op / base->second.ns_per_op - 1) * 100);
+          }
+          std::printf("\n");
+          std::fflush(stdout);
+        }
+      }
+    }
+
+    if (!json_path.empty()) {
+      dig_dug::WriteBenchmarkJson(json_path, results, label);
+    }
+
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "%s\n", error.what());
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  return 0;
+}
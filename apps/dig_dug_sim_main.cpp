@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "sim/episode_runner.h"
+#include "sim/level_pack_builder.h"
+
+using dig_dug::EpisodeRunner;
+using dig_dug::EpisodeResult;
+using dig_dug::LevelPackConfig;
+using dig_dug::RunnerConfig;
+using dig_dug::RunSummary;
+
+namespace {
+
+void PrintUsage(const char* program) {
+  std::fprintf(stderr,
+               "Usage: %s [--seeds FIRST-LAST] [--policy idle|random|hunter] [--threads N] [--max-ticks N] "
+               "[--board-size N | --stress] [--level-pack FILE] [--quiet]\n"
+               "       %s --build-level-pack FILE [--seeds FIRST-LAST] [--levels N] [--boards-per-level N] "
+               "[--board-size N] [--threads N]\n",
+               program, program);
+}
+
+/**
+ * Parses a seed range like 1-1000, or a single seed
+ */
+void ParseSeeds(const std::string& text, RunnerConfig& config) {
+  size_t dash = text.find('-');
+  uint64_t first = std::stoull(text.substr(0, dash));
+  uint64_t last = dash == std::string::npos ? first : std::stoull(text.substr(dash + 1));
+
+  if (last < first) {
+    throw std::invalid_argument("Seed range ends before it starts");
+  }
+
+  config.first_seed = first;
+  config.num_episodes = (size_t) (last - first + 1);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  RunnerConfig config;
+  config.num_threads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+  bool is_quiet = false;
+  std::string build_pack_path;
+  LevelPackConfig pack_config;
+
+  try {
+    for (int arg = 1; arg < argc; arg++) {
+      bool has_value = arg + 1 < argc;
+
+      if (std::strcmp(argv[arg], "--seeds") == 0 && has_value) {
+        ParseSeeds(argv[++arg], config);
+      } else if (std::strcmp(argv[arg], "--policy") == 0 && has_value) {
+        config.policy = argv[++arg];
+      } else if (std::strcmp(argv[arg], "--threads") == 0 && has_value) {
+        config.num_threads = std::stoul(argv[++arg]);
+      } else if (std::strcmp(argv[arg], "--max-ticks") == 0 && has_value) {
+        config.max_ticks = std::stoul(argv[++arg]);
+      } else if (std::strcmp(argv[arg], "--board-size") == 0 && has_value) {
+        config.board_dimension = std::stoul(argv[++arg]);
+      } else if (std::strcmp(argv[arg], "--stress") == 0) {
+        config.board_dimension = RunnerConfig::kStressBoardDimension;
+        config.enemy_scale = RunnerConfig::kStressEnemyScale;
+      } else if (std::strcmp(argv[arg], "--level-pack") == 0 && has_value) {
+        config.level_pack_path = argv[++arg];
+      } else if (std::strcmp(argv[arg], "--build-level-pack") == 0 && has_value) {
+        build_pack_path = argv[++arg];
+      } else if (std::strcmp(argv[arg], "--levels") == 0 && has_value) {
+        pack_config.num_levels = std::stoul(argv[++arg]);
+      } else if (std::strcmp(argv[arg], "--boards-per-level") == 0 && has_value) {
+        pack_config.boards_per_level = std::stoul(argv[++arg]);
+      } else if (std::strcmp(argv[arg], "--quiet") == 0) {
+        is_quiet = true;
+      } else {
+        PrintUsage(argv[0]);
+        return 1;
+      }
+    }
+
+    if (!build_pack_path.empty()) {
+      pack_config.first_seed = config.first_seed;
+      pack_config.num_seeds = config.num_episodes;
+      pack_config.num_threads = config.num_threads;
+      pack_config.board_dimension = config.board_dimension;
+
+      auto start_time = std::chrono::steady_clock::now();
+      dig_dug::BuildLevelPack(build_pack_path, pack_config);
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+
+      size_t num_boards = pack_config.num_seeds * pack_config.num_levels * pack_config.boards_per_level;
+      std::printf("boards: %zu\n", num_boards);
+      std::printf("threads: %zu\n", pack_config.num_threads);
+      std::printf("seconds: %.3f\n", elapsed.count());
+      std::printf("boards_per_second: %.0f\n", elapsed.count() > 0 ? num_boards / elapsed.count() : 0);
+      return 0;
+    }
+
+    EpisodeRunner runner(config);
+    RunSummary summary = runner.Run();
+
+    if (!is_quiet) {
+      std::printf("seed,score,level,ticks\n");
+      for (const EpisodeResult& result : summary.episodes) {
+        std::printf("%llu,%zu,%zu,%zu\n", (unsigned long long) (result.seed), result.score, result.level,
+                    result.num_ticks);
+      }
+    }
+
+    std::printf("episodes: %zu\n", summary.episodes.size());
+    std::printf("threads: %zu\n", config.num_threads);
+    std::printf("ticks: %zu\n", summary.num_ticks);
+    std::printf("seconds: %.3f\n", summary.seconds);
+    std::printf("episodes_per_second: %.1f\n", summary.GetEpisodesPerSecond());
+    std::printf("ticks_per_second: %.0f\n", summary.GetTicksPerSecond());
+
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "%s\n", error.what());
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+
+namespace dig_dug {
+
+using std::size_t;
+
+/**
+ * Gets the number of times the program allocated from the heap so far. Any program that calls this links in
+ * replacements of the global operator new and delete, nothrow forms included, that count every allocation on every
+ * thread, so two reads around some code give the allocations it made
+ */
+size_t GetNumAllocations();
+
+/**
+ * Gets the number of bytes the program asked the heap for so far, counting memory that was freed again
+ */
+size_t GetNumAllocatedBytes();
+
+} // namespace dig_dug
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bench/micro_benchmark.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::vector;
+
+/**
+ * Makes the cases that time the hot paths of the generator and the engine on one size of board: generating a board,
+ * constructing an engine, each kind of move, the collision check and the getters that copy state out. A tick of many
+ * games is timed both by looping over engines and by stepping a BatchGameEngine. Every case starts from the same
+ * board, generated from a seed, so runs on different commits time the same work
+ *
+ * @param board_dimension number of tiles along each side of the board
+ * @param seed seed of the board
+ * @param enemy_scale number of times the arcade board's enemies and rocks the board gets, or 0 for the default for its
+ * size
+ * @throws std::invalid_argument if boards cannot have that size
+ */
+vector<BenchmarkCase> MakeEngineBenchmarks(size_t board_dimension, uint64_t seed, size_t enemy_scale = 0);
+
+} // namespace dig_dug
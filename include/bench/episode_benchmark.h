@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/game_state_generator.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+/**
+ * Which games to play
+ */
+struct EpisodeBenchmarkConfig {
+  // Episodes are played with seeds first_seed to first_seed + num_episodes - 1
+  uint64_t first_seed = 1;
+  size_t num_episodes = 100;
+  // Deterministic bot to play with, which is the hunter for the numbers that are tracked
+  string policy = "hunter";
+  // Episodes still running after this many frames are cut off
+  size_t max_ticks = 100000;
+  size_t board_dimension = GameStateGenerator::kDefaultBoardDimension;
+};
+
+/**
+ * Throughput and tick latency of complete games
+ */
+struct EpisodeBenchmarkResult {
+  size_t board_dimension = 0;
+  string policy;
+  size_t num_episodes = 0;
+  size_t num_ticks = 0;
+  // Levels cleared over every episode, which shows how much of the progression the run went through
+  size_t num_levels_cleared = 0;
+  double seconds = 0;
+  uint64_t p50_tick_ns = 0;
+  uint64_t p99_tick_ns = 0;
+  uint64_t max_tick_ns = 0;
+  // Highest resident memory of the whole process so far
+  size_t peak_resident_bytes = 0;
+
+  double GetEpisodesPerSecond() const;
+
+  double GetTicksPerSecond() const;
+
+  /**
+   * Gets the key that matches this result with the result of the same games from another run
+   */
+  string GetKey() const;
+};
+
+/**
+ * Plays complete games on one thread, from level 1 until the game is over, the way EpisodeRunner::PlayEpisode does,
+ * through every level change, lost life and new board of GameSession. Each tick is timed on its own, covering the
+ * bot's choice, the session update and one read of the clock
+ *
+ * @throws std::invalid_argument if the policy does not exist or boards cannot have the size
+ */
+EpisodeBenchmarkResult RunEpisodeBenchmark(const EpisodeBenchmarkConfig& config);
+
+/**
+ * Gets the highest resident memory of the process so far
+ *
+ * @return bytes, or 0 where the system does not say
+ */
+size_t GetPeakResidentBytes();
+
+/**
+ * Writes results as JSON, in the same layout as WriteBenchmarkJson with one result per line
+ *
+ * @throws std::runtime_error if the file cannot be written
+ */
+void WriteEpisodeBenchmarkJson(const string& path, const vector<EpisodeBenchmarkResult>& results,
+                               const string& label);
+
+/**
+ * Reads results written by WriteEpisodeBenchmarkJson
+ *
+ * @throws std::runtime_error if the file cannot be read or was not written by WriteEpisodeBenchmarkJson
+ */
+vector<EpisodeBenchmarkResult> ReadEpisodeBenchmarkJson(const string& path);
+
+} // namespace dig_dug
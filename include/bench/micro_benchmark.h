@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace dig_dug {
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+/**
+ * One operation to time, on one fixture
+ */
+struct BenchmarkCase {
+  // Name of the operation, shared by the cases that time it on different fixtures
+  string name;
+  size_t board_dimension = 0;
+  // Number of times the arcade board's enemies the board was generated with, or 0 for the default for its size
+  size_t enemy_scale = 0;
+  size_t num_enemies = 0;
+  // Memory taken by the fixture's map before the case runs
+  size_t map_bytes = 0;
+  // Puts the fixture back into its starting state before each batch, outside of the timing
+  std::function<void()> setup;
+  // Runs the operation a number of times
+  std::function<void(size_t num_ops)> run;
+};
+
+/**
+ * How long to time each case
+ */
+struct BenchmarkOptions {
+  // Batches grow until one takes at least this long
+  double min_batch_seconds = 0.05;
+  // Number of batches of that size to take the median of
+  size_t num_batches = 5;
+  // Stops batches from growing past this many operations, so fixtures that change as they run stay near their start
+  size_t max_batch_ops = 1 << 20;
+};
+
+/**
+ * Measurements of one case
+ */
+struct BenchmarkResult {
+  string name;
+  size_t board_dimension = 0;
+  size_t enemy_scale = 0;
+  size_t num_enemies = 0;
+  size_t map_bytes = 0;
+  // Operations in each timed batch
+  size_t batch_ops = 0;
+  // Median over the batches
+  double ns_per_op = 0;
+  double allocs_per_op = 0;
+  double bytes_per_op = 0;
+
+  double GetOpsPerSecond() const;
+
+  /**
+   * Gets the key that matches this result with the result of the same case from another run. Cases on boards with
+   * the default number of enemies keep the key they had before enemy counts could be set
+   */
+  string GetKey() const;
+};
+
+/**
+ * Times a case. The batch size doubles from one operation until a batch takes long enough to measure, then the same
+ * number of operations is timed several times and the median kept, which holds up better against other programs
+ * running at the same time than the mean. Allocations are counted across every timed batch
+ */
+BenchmarkResult RunBenchmark(const BenchmarkCase& benchmark, const BenchmarkOptions& options);
+
+/**
+ * Writes results as JSON, with one result per line so other runs can be read back without a JSON library
+ *
+ * @param path file to write
+ * @param results results to write
+ * @param label describes the run, like a commit
+ * @throws std::runtime_error if the file cannot be written
+ */
+void WriteBenchmarkJson(const string& path, const vector<BenchmarkResult>& results, const string& label);
+
+/**
+ * Escapes a string for a JSON file, dropping control characters
+ */
+string EscapeJson(const string& text);
+
+/**
+ * Reads results written by WriteBenchmarkJson
+ *
+ * @throws std::runtime_error if the file cannot be read or was not written by WriteBenchmarkJson
+ */
+vector<BenchmarkResult> ReadBenchmarkJson(const string& path);
+
+} // namespace dig_dug
@@ -0,0 +1,362 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/bit_board.h"
+#include "core/direction.h"
+#include "core/engine_snapshot.h"
+#include "core/fixed_point.h"
+#include "core/game_engine.h"
+#include "core/lane_vector.h"
+#include "core/player_action.h"
+#include "core/tile_grid.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::vector;
+
+/**
+ * Runs many games side by side in lockstep, such as the environments of a training run. Small games are kept as a
+ * structure of arrays with one lane per game, so every step moves the players, harpoons and enemies of kLaneWidth
+ * games at once with the kernels of lane_vector.h. Games whose board, enemies or tile size do not fit the lanes are
+ * stepped by a GameEngine instead.
+ *
+ * Either way, a game in the batch plays out exactly like a GameEngine with the same board and seed that gets the same
+ * calls, random numbers included. Every game also keeps its GameEngine for its whole life, which holds its map, so
+ * starting a game over reuses the memory instead of allocating
+ */
+class BatchGameEngine {
+ public:
+  /**
+   * Constructs an empty batch
+   */
+  BatchGameEngine() = default;
+
+  /**
+   * Creates a batch of games with no board. Every game must be reset with a board before it is stepped
+   *
+   * @param num_games number of games
+   * @param tile_size size of each tile in pixels, which is the same for every game
+   */
+  BatchGameEngine(size_t num_games, size_t tile_size);
+
+  /**
+   * Starts a game over on a new board, like constructing a GameEngine
+   *
+   * @param game index of the game
+   * @param board starting game map
+   * @param seed seed of the game's random numbers
+   * @throws std::out_of_range if there is no game at the index
+   */
+  void ResetGame(size_t game, const TileGrid& board, uint64_t seed);
+
+  /**
+   * Advances every game by one frame. Each game applies its action, then checks whether the player died, and then
+   * moves its enemies if the player is still alive
+   *
+   * @param actions action of each game
+   * @param is_player_dead set to 1 for games where the player died this frame and 0 for the others
+   */
+  void Step(const PlayerAction* actions, uint8_t* is_player_dead);
+
+  /**
+   * Moves the player of one game, like GameEngine::MovePlayer with a unit velocity
+   */
+  void MovePlayer(size_t game, Direction direction);
+
+  /**
+   * Player of one game shoots the harpoon, like GameEngine::AttackEnemy
+   */
+  void AttackEnemy(size_t game);
+
+  /**
+   * Checks whether an enemy killed the player of each game, like GameEngine::IsPlayerDead
+   *
+   * @param is_player_dead set to 1 for games where the player died and 0 for the others
+   */
+  void CheckPlayerDeaths(uint8_t* is_player_dead);
+
+  /**
+   * Moves the enemies of every game, like GameEngine::MoveEnemies
+   *
+   * @param is_game_moving nonzero for games whose enemies move, or null to move every game
+   */
+  void MoveEnemies(const uint8_t* is_game_moving = nullptr);
+
+  size_t GetNumGames() const;
+
+  /**
+   * Checks whether a game is stepped in the lanes, rather than by its GameEngine
+   *
+   * @throws std::out_of_range if there is no game at the index
+   */
+  bool IsGameInLanes(size_t game) const;
+
+  /**
+   * Gets the engine of one game, with the state of a game in the lanes copied into it first
+   *
+   * @return engine that stays up to date until the batch is next changed
+   * @throws std::out_of_range if there is no game at the index
+   */
+  const GameEngine& GetGame(size_t game) const;
+
+  const TileGrid& GetTileGrid(size_t game) const;
+
+  FixedVec2 GetPlayerPosition(size_t game) const;
+
+  FixedVec2 GetPlayerPrevVelocity(size_t game) const;
+
+  size_t GetNumEnemies(size_t game) const;
+
+  FixedVec2 GetEnemyPosition(size_t game, size_t enemy) const;
+
+  FixedVec2 GetEnemyVelocity(size_t game, size_t enemy) const;
+
+  bool IsEnemyGhost(size_t game, size_t enemy) const;
+
+  bool IsEnemyHurt(size_t game, size_t enemy) const;
+
+  bool IsPlayerAttacking(size_t game) const;
+
+  FixedVec2 GetHarpoonPosition(size_t game) const;
+
+  size_t GetScore(size_t game) const;
+
+  size_t GetNumLives(size_t game) const;
+
+  // Largest boards and numbers of enemies of games in the lanes. The tiles of each lane are laid out like a BitBoard,
+  // and the enemies fill the same slots as a snapshot
+  const static size_t kMaxLaneDimension = BitBoard::kMaxDimension;
+  const static size_t kMaxLaneEnemies = EngineSnapshot::kMaxEnemies;
+  // Tile sizes of games in the lanes, which must also be a whole number of enemy moves. Enemies must move less than a
+  // tile a tick, and the squared distance of anything closer than a tile must fit in 32 bits
+  const static size_t kMinLaneTileSize = 8;
+  const static size_t kMaxLaneTileSize = 181;
+
+ private:
+  size_t tile_size_ = 0;
+  size_t num_games_ = 0;
+  // Games rounded up to whole blocks of kLaneWidth lanes. The lanes past the last game are never in use
+  size_t num_lanes_ = 0;
+  int32_t max_harpoon_distance_ = 0;
+  // 2^32 over the tile size rounded up, which divides pixels on the board into tiles with one multiply
+  uint32_t tile_size_reciprocal_ = 0;
+
+  // Engine of every game. It holds the map of a game in the lanes, which digging keeps up to date, and the whole
+  // state of every other game. The rest of a game in the lanes is only copied into its engine when it is asked for
+  mutable vector<GameEngine> games_;
+  // -1 for each lane that is in use and 0 for games stepped by their engine
+  vector<int32_t> is_in_lanes_;
+
+  // State of the games in the lanes, one entry per lane. Masks are -1 for true and 0 for false
+  vector<int32_t> board_size_;
+  vector<int32_t> player_x_;
+  vector<int32_t> player_y_;
+  vector<int32_t> player_prev_x_;
+  vector<int32_t> player_prev_y_;
+  vector<int32_t> is_player_facing_left_;
+  vector<int32_t> delayed_turn_x_;
+  vector<int32_t> delayed_turn_y_;
+  vector<int32_t> is_attacking_;
+  vector<int32_t> attack_frames_;
+  vector<int32_t> arrow_x_;
+  vector<int32_t> arrow_y_;
+  vector<int32_t> harpoon_velocity_x_;
+  vector<int32_t> harpoon_velocity_y_;
+  vector<int32_t> harpoon_step_;
+  vector<int32_t> harpoon_distance_;
+  vector<int32_t> ghost_chance_;
+  vector<int32_t> num_lives_;
+  vector<size_t> score_;
+
+  // Enemies of the games in the lanes, with all the lanes of slot 0 first, then slot 1 and so on. The flags are in
+  // the layout of EnemyPool::GetFlags
+  vector<int32_t> num_enemies_;
+  // Largest number of enemies in each block of lanes, which is how many slots the kernels go through
+  vector<size_t> max_enemies_;
+  vector<int32_t> enemy_x_;
+  vector<int32_t> enemy_y_;
+  vector<int32_t> enemy_velocity_x_;
+  vector<int32_t> enemy_velocity_y_;
+  vector<int32_t> enemy_flags_;
+
+  // Random numbers of the games in the lanes, in the layout of Random: the key is the seed and the counter is the next
+  // block and the stream. Each lane keeps the outputs of the two blocks before its counter and uses them up to the
+  // output index, so lanes that drift apart can still make their blocks in the same run of Philox
+  vector<int32_t> random_key_0_;
+  vector<int32_t> random_key_1_;
+  vector<int32_t> random_block_0_;
+  vector<int32_t> random_block_1_;
+  vector<int32_t> random_stream_0_;
+  vector<int32_t> random_stream_1_;
+  vector<int32_t> random_outputs_[2 * Random::kBlockSize];
+  vector<int32_t> random_output_index_;
+
+  // TileType and TunnelExits mask of every tile of the games in the lanes, kMaxLaneDimension squared bytes per lane
+  // in the layout of a BitBoard, with room at the end for gathers that read whole words
+  vector<uint8_t> tiles_;
+  vector<uint8_t> exits_;
+
+  /**
+   * Checks that a game exists
+   */
+  void CheckGame(size_t game) const;
+
+  /**
+   * Checks that an enemy of a game exists
+   */
+  void CheckEnemy(size_t game, size_t enemy) const;
+
+  /**
+   * Checks whether the game an engine was just reset to can be stepped in the lanes. Walking enemies must start on a
+   * tile boundary moving at enemy speed along one axis, so with a tile size that is a whole number of their moves
+   * they only ever stop on tile boundaries of the tunnels, where the kernels turn them like the engine would
+   */
+  bool FitsInLanes(const GameEngine& engine) const;
+
+  /**
+   * Copies the whole state of a game's engine into its lane
+   */
+  void LoadLane(size_t game);
+
+  /**
+   * Copies the state of a game in the lanes into its engine, which then plays on exactly as the lane would have
+   */
+  void StoreLane(size_t game) const;
+
+  /**
+   * Counts the enemies of the largest game in a block of lanes again
+   */
+  void UpdateMaxEnemies(size_t first);
+
+  /**
+   * Draws the next random number of the masked lanes, like Random::Next
+   */
+  LaneVector DrawRandom(size_t first, const LaneVector& mask);
+
+  /**
+   * Gets the TileType or TunnelExits mask of a tile of each lane. Coordinates off the board wrap around within the
+   * lane, for lanes whose result is not used
+   */
+  LaneVector GatherTiles(const vector<uint8_t>& tiles, size_t first, const LaneVector& x, const LaneVector& y) const;
+
+  /**
+   * Divides whole pixels into tiles, rounding down, like GameEngine::GetTileIndex does for pixels on the board. Lanes
+   * with negative pixels get a meaningless tile, which callers mask out
+   *
+   * @param remainder set to the pixels past the start of the tile
+   */
+  LaneVector DivideIntoTiles(const LaneVector& pixels, LaneVector& remainder) const;
+
+  /**
+   * Checks whether fixed-point positions are on a tile boundary along both axes, like GameEngine::IsTileAligned for
+   * positions on the board
+   */
+  LaneVector IsTileAligned(const LaneVector& x, const LaneVector& y) const;
+
+  /**
+   * Checks each lane like GameEngine::IsNextTileOpen
+   */
+  LaneVector IsNextTileOpen(size_t first, const LaneVector& velocity_x, const LaneVector& velocity_y,
+                            const LaneVector& x, const LaneVector& y) const;
+
+  /**
+   * Finds the walking enemy with the lowest slot that is closer than one tile to a point, in each lane
+   *
+   * @return slot of the enemy, or kMaxLaneEnemies if there is none
+   */
+  LaneVector FindWalkingEnemiesNear(size_t first, const LaneVector& x, const LaneVector& y) const;
+
+  /**
+   * Sets a flag of the enemy at a slot of each masked lane
+   */
+  void SetEnemyFlag(size_t first, const LaneVector& mask, const LaneVector& slot, int32_t flag);
+
+  /**
+   * Moves the players of the masked lanes, like GameEngine::MovePlayer
+   *
+   * @param velocity_x fixed-point x velocity of each lane, already scaled by the player speed
+   * @param velocity_y fixed-point y velocity of each lane, already scaled by the player speed
+   */
+  void MovePlayers(size_t first, const LaneVector& mask, const LaneVector& velocity_x, const LaneVector& velocity_y);
+
+  /**
+   * Digs the tiles that the players of the masked lanes entered, like GameEngine::DigUpTiles
+   */
+  void DigUpTiles(size_t first, const LaneVector& mask, const LaneVector& x, const LaneVector& y,
+                  const LaneVector& velocity_x, const LaneVector& velocity_y);
+
+  /**
+   * Turns a tile of a game in the lanes into a tunnel, in its engine and in its lane
+   */
+  void DigTile(size_t game, size_t x, size_t y);
+
+  /**
+   * Players of the masked lanes shoot the harpoon, like GameEngine::AttackEnemy
+   */
+  void AttackEnemies(size_t first, const LaneVector& mask);
+
+  /**
+   * Checks each lane like GameEngine::CanHarpoonContinue
+   */
+  LaneVector CanHarpoonsContinue(size_t first) const;
+
+  /**
+   * Removes an enemy killed by the harpoon, moving the last enemy into its slot like EnemyPool::RemoveAt
+   */
+  void KillEnemy(size_t game, size_t slot);
+
+  /**
+   * Checks whether an enemy killed the player of each masked lane, like GameEngine::IsPlayerDead
+   *
+   * @return mask of the lanes whose player died
+   */
+  LaneVector FindPlayerDeaths(size_t first, const LaneVector& mask);
+
+  /**
+   * Moves the enemies of the masked lanes, like GameEngine::MoveEnemies
+   */
+  void MoveLaneEnemies(size_t first, const LaneVector& mask);
+
+  /**
+   * Moves the ghosts at a slot of the masked lanes, like GameEngine::MoveGhostedEnemy up to the point where a ghost
+   * that came out of the dirt starts walking
+   *
+   * @return mask of the lanes whose ghost is walking again
+   */
+  LaneVector MoveGhosts(size_t first, size_t slot, const LaneVector& mask);
+
+  /**
+   * Turns the walking enemies at a slot of the masked lanes, like GameEngine::MoveWalkingEnemy
+   */
+  void TurnWalkingEnemies(size_t first, size_t slot, const LaneVector& mask);
+
+  /**
+   * Applies the action of each masked lane of a block, like ApplyAction
+   */
+  void ApplyLaneActions(size_t first, const LaneVector& mask, const PlayerAction* actions);
+
+  /**
+   * Gets the mask of a single lane
+   */
+  static LaneVector GetLaneMask(size_t lane);
+
+  /**
+   * Gets the index of an enemy slot of a lane in the enemy arrays
+   */
+  size_t GetEnemyIndex(size_t game, size_t slot) const {
+    return slot * num_lanes_ + game;
+  }
+
+  /**
+   * Gets the largest number of enemies of the games in a block of lanes
+   */
+  size_t GetMaxEnemies(size_t first) const {
+    return max_enemies_[first / kLaneWidth];
+  }
+};
+
+} // namespace dig_dug
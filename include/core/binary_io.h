@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dig_dug {
+
+using std::size_t;
+using std::vector;
+
+/**
+ * Appends an unsigned integer in LEB128 form, 7 bits per byte with the high bit set on every byte but the last, so
+ * small values take one byte
+ */
+void PutVarint(vector<uint8_t>& out, uint64_t value);
+
+/**
+ * Appends a 32 bit integer as 4 little-endian bytes
+ */
+void PutFixed32(vector<uint8_t>& out, uint32_t value);
+
+/**
+ * Appends a 64 bit integer as 8 little-endian bytes
+ */
+void PutFixed64(vector<uint8_t>& out, uint64_t value);
+
+/**
+ * Reads the values written by the Put functions back out of a block of bytes it does not own
+ */
+class ByteReader {
+ public:
+  /**
+   * Constructs a reader at the start of a block of bytes
+   */
+  ByteReader(const uint8_t* data, size_t size);
+
+  /**
+   * @throws std::runtime_error if the data ends in the middle of the value or the value does not fit in 64 bits
+   */
+  uint64_t ReadVarint();
+
+  /**
+   * @throws std::runtime_error if fewer than 4 bytes are left
+   */
+  uint32_t ReadFixed32();
+
+  /**
+   * @throws std::runtime_error if fewer than 8 bytes are left
+   */
+  uint64_t ReadFixed64();
+
+  /**
+   * Copies bytes out of the data
+   *
+   * @throws std::runtime_error if fewer than size bytes are left
+   */
+  void ReadBytes(void* out, size_t size);
+
+  /**
+   * Moves to an offset from the start of the data
+   *
+   * @throws std::runtime_error if the offset is past the end
+   */
+  void Seek(size_t offset);
+
+  size_t GetOffset() const;
+
+  size_t GetNumLeft() const;
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t offset_ = 0;
+
+  /**
+   * Throws if fewer than size bytes are left
+   */
+  void Require(size_t size) const;
+};
+
+} // namespace dig_dug
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dig_dug {
+
+using std::size_t;
+
+/**
+ * Set of tiles on a board of up to 16x16 tiles, stored as four 64-bit words. Tile (x, y) is bit x * 16 + y, so
+ * moving one tile along y is a shift by 1 bit and moving one tile along x is a shift by 16 bits
+ */
+class BitBoard {
+ public:
+  const static size_t kMaxDimension = 16;
+  const static size_t kNumWords = 4;
+
+  /**
+   * Constructs an empty set
+   */
+  BitBoard() = default;
+
+  /**
+   * Creates a set containing every tile of a board
+   *
+   * @param dimension number of tiles along each side of the board, at most kMaxDimension
+   */
+  static BitBoard Full(size_t dimension);
+
+  bool Test(size_t x, size_t y) const {
+    size_t bit = x * kMaxDimension + y;
+    return ((words_[bit >> 6] >> (bit & 63)) & 1) != 0;
+  }
+
+  void Set(size_t x, size_t y) {
+    size_t bit = x * kMaxDimension + y;
+    words_[bit >> 6] |= uint64_t(1) << (bit & 63);
+  }
+
+  void Clear(size_t x, size_t y) {
+    size_t bit = x * kMaxDimension + y;
+    words_[bit >> 6] &= ~(uint64_t(1) << (bit & 63));
+  }
+
+  /**
+   * Counts the tiles in the set
+   */
+  size_t Count() const;
+
+  bool IsEmpty() const;
+
+  /**
+   * Moves every tile one step toward larger x. Tiles pushed past x = 15 are dropped
+   */
+  BitBoard ShiftedPlusX() const;
+
+  /**
+   * Moves every tile one step toward smaller x. Tiles pushed past x = 0 are dropped
+   */
+  BitBoard ShiftedMinusX() const;
+
+  /**
+   * Moves every tile one step toward larger y. Tiles pushed past y = 15 are dropped
+   */
+  BitBoard ShiftedPlusY() const;
+
+  /**
+   * Moves every tile one step toward smaller y. Tiles pushed past y = 0 are dropped
+   */
+  BitBoard ShiftedMinusY() const;
+
+  /**
+   * Gets the set of tiles next to at least one tile of this set, excluding the set itself
+   */
+  BitBoard Neighbors() const;
+
+  BitBoard operator&(const BitBoard& other) const;
+
+  BitBoard operator|(const BitBoard& other) const;
+
+  BitBoard operator^(const BitBoard& other) const;
+
+  BitBoard operator~() const;
+
+  BitBoard& operator&=(const BitBoard& other);
+
+  BitBoard& operator|=(const BitBoard& other);
+
+  bool operator==(const BitBoard& other) const;
+
+  bool operator!=(const BitBoard& other) const;
+
+ private:
+  uint64_t words_[kNumWords] = {0, 0, 0, 0};
+
+  /**
+   * Shifts the whole 256-bit set toward higher bits
+   */
+  BitBoard ShiftedLeft(size_t bits) const;
+
+  /**
+   * Shifts the whole 256-bit set toward lower bits
+   */
+  BitBoard ShiftedRight(size_t bits) const;
+};
+
+} // namespace dig_dug
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/game_state_generator.h"
+
+namespace dig_dug {
+
+using std::size_t;
+
+/**
+ * Supplies a GameSession with boards that were made ahead of time, so starting a level does not have to generate
+ * one. A source must hand out exactly the board GameStateGenerator makes for the same seed, level and board number,
+ * so a session plays the same way whether or not it has a source
+ */
+class BoardSource {
+ public:
+  virtual ~BoardSource() = default;
+
+  /**
+   * Hints that a board will probably be asked for soon
+   *
+   * @param seed seed of the game
+   * @param level level of the board
+   * @param num_boards number of boards made on the level once this one is, so 1 for the level's first board
+   */
+  virtual void Prepare(uint64_t seed, size_t level, size_t num_boards) = 0;
+
+  /**
+   * Gives a board to a generator, if the source has it ready
+   *
+   * @param seed seed of the game, which is the generator's seed
+   * @param level level of the board
+   * @param num_boards number of boards made on the level once this one is
+   * @param generator generator to set to the board
+   * @return true if the generator now holds the board, false if the caller has to generate it
+   */
+  virtual bool TakeBoard(uint64_t seed, size_t level, size_t num_boards, GameStateGenerator& generator) = 0;
+};
+
+} // namespace dig_dug
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "core/const_span.h"
+#include "core/game_session.h"
+#include "core/mapped_file.h"
+#include "core/session_snapshot.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::string;
+
+/**
+ * Start of a checkpoint file, followed straight away by num_snapshots SessionSnapshots laid out exactly as they are
+ * in memory. There is nothing to parse, so a file is loaded by mapping it and checking this header. Files only load
+ * in builds that lay snapshots out the same way, which the version, byte order and snapshot size check
+ */
+struct CheckpointHeader {
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  // kCheckpointByteOrder as written, which reads differently on a machine with the other byte order
+  uint32_t byte_order = 0;
+  uint32_t snapshot_size = 0;
+  uint64_t num_snapshots = 0;
+  uint64_t reserved = 0;
+};
+
+const uint32_t kCheckpointMagic = 0x43504444;  // "DDPC"
+// Goes up whenever SessionSnapshot or anything in it changes layout
+const uint32_t kCheckpointVersion = 2;
+const uint32_t kCheckpointByteOrder = 0x01020304;
+
+static_assert(sizeof(CheckpointHeader) % alignof(SessionSnapshot) == 0,
+              "Snapshots after the header must be aligned so they can be used in place");
+
+/**
+ * Writes snapshots to a checkpoint file in one write
+ *
+ * @throws std::runtime_error if the file cannot be written
+ */
+void SaveCheckpoints(const string& path, ConstSpan<SessionSnapshot> snapshots);
+
+/**
+ * Saves a session to a checkpoint file holding just its state
+ *
+ * @throws std::invalid_argument if the session is too large for a snapshot
+ * @throws std::runtime_error if the file cannot be written
+ */
+void SaveSession(const string& path, const GameSession& session);
+
+/**
+ * Loads the first snapshot of a checkpoint file into a session
+ *
+ * @throws std::runtime_error if the file cannot be read, is not a checkpoint file this build can load or is empty
+ */
+void LoadSession(const string& path, GameSession& session);
+
+/**
+ * Memory-mapped checkpoint file, whose snapshots are used where they are in the mapping. Opening a file of thousands
+ * of snapshots costs one map and one header check, and the pages of a snapshot are only read when it is used
+ */
+class CheckpointFile {
+ public:
+  /**
+   * Opens a checkpoint file
+   *
+   * @throws std::runtime_error if the file cannot be read or is not a checkpoint file this build can load
+   */
+  explicit CheckpointFile(const string& path);
+
+  /**
+   * Gets the snapshots in the file, which stay valid while the file is open
+   */
+  ConstSpan<SessionSnapshot> GetSnapshots() const;
+
+  size_t Size() const;
+
+ private:
+  MappedFile file_;
+  ConstSpan<SessionSnapshot> snapshots_;
+};
+
+} // namespace dig_dug
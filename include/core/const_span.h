@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+
+namespace dig_dug {
+
+using std::size_t;
+
+/**
+ * Read-only view over a contiguous array that does not own its elements, standing in for std::span
+ */
+template <typename T>
+class ConstSpan {
+ public:
+  ConstSpan() = default;
+
+  ConstSpan(const T* data, size_t size) : data_(data), size_(size) {}
+
+  const T* begin() const {
+    return data_;
+  }
+
+  const T* end() const {
+    return data_ + size_;
+  }
+
+  const T& operator[](size_t index) const {
+    return data_[index];
+  }
+
+  const T* data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+ private:
+  const T* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+} // namespace dig_dug
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dig_dug {
+
+/**
+ * The four directions something can move on the board, in clockwise order
+ */
+enum class Direction : uint8_t {
+  Right,
+  Down,
+  Left,
+  Up
+};
+
+const std::size_t kNumDirections = 4;
+
+// Tile offsets of each direction, indexed by the Direction value
+const int32_t kDirectionOffsetX[kNumDirections] = {1, 0, -1, 0};
+const int32_t kDirectionOffsetY[kNumDirections] = {0, 1, 0, -1};
+
+inline int32_t GetOffsetX(Direction direction) {
+  return kDirectionOffsetX[static_cast<std::size_t>(direction)];
+}
+
+inline int32_t GetOffsetY(Direction direction) {
+  return kDirectionOffsetY[static_cast<std::size_t>(direction)];
+}
+
+/**
+ * Finds the tile at an offset from a tile of a square board
+ *
+ * @param x x index of the tile
+ * @param y y index of the tile
+ * @param offset_x tiles to move along x
+ * @param offset_y tiles to move along y
+ * @param dimension number of tiles along each side of the board
+ * @param next_x set to the x index of the neighbor
+ * @param next_y set to the y index of the neighbor
+ * @return true if the neighbor is on the board
+ */
+inline bool GetNeighbor(std::size_t x, std::size_t y, int32_t offset_x, int32_t offset_y, std::size_t dimension,
+                        std::size_t& next_x, std::size_t& next_y) {
+  next_x = x + offset_x;
+  next_y = y + offset_y;
+
+  // Tiles off the board wrap around to huge indices, which fail the bounds check
+  return next_x < dimension && next_y < dimension;
+}
+
+/**
+ * Finds the tile next to a tile of a square board in a direction
+ *
+ * @return true if the neighbor is on the board
+ */
+inline bool GetNeighbor(std::size_t x, std::size_t y, Direction direction, std::size_t dimension, std::size_t& next_x,
+                        std::size_t& next_y) {
+  return GetNeighbor(x, y, GetOffsetX(direction), GetOffsetY(direction), dimension, next_x, next_y);
+}
+
+/**
+ * Gets the direction after a quarter turn counterclockwise
+ */
+inline Direction TurnLeft(Direction direction) {
+  return static_cast<Direction>((static_cast<std::size_t>(direction) + 3) % kNumDirections);
+}
+
+/**
+ * Gets the direction after a quarter turn clockwise
+ */
+inline Direction TurnRight(Direction direction) {
+  return static_cast<Direction>((static_cast<std::size_t>(direction) + 1) % kNumDirections);
+}
+
+inline Direction Reverse(Direction direction) {
+  return static_cast<Direction>((static_cast<std::size_t>(direction) + 2) % kNumDirections);
+}
+
+inline bool IsHorizontal(Direction direction) {
+  return direction == Direction::Right || direction == Direction::Left;
+}
+
+} // namespace dig_dug
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/direction.h"
+#include "core/tile_grid.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::vector;
+
+/**
+ * Number of steps through tunnels from every tile to a root tile, found with a breadth-first search. Walking enemies
+ * can only move through tunnels, so this is how far they are from the root. The field is kept up to date as tunnels
+ * are dug without searching the whole board again, and every query is a single lookup
+ */
+class DistanceField {
+ public:
+  // Distance of tiles that cannot reach the root through tunnels, or only through more steps than this
+  const static uint16_t kUnreachable = UINT16_MAX;
+
+  /**
+   * Constructs a field for an empty board
+   */
+  DistanceField() = default;
+
+  /**
+   * Searches the whole board from a root tile. The root counts as open even if it is not a tunnel
+   *
+   * @param map game map, whose tunnel tiles are the open ones
+   * @param root_x x index of the root tile
+   * @param root_y y index of the root tile
+   */
+  void Reset(const TileGrid& map, size_t root_x, size_t root_y);
+
+  /**
+   * Moves the root to another tile. Every distance can change, so this searches the board again, reusing the memory
+   * of the last search
+   */
+  void SetRoot(const TileGrid& map, size_t root_x, size_t root_y);
+
+  /**
+   * Updates the field after a tile of the map was dug into a tunnel. Opening a tile can only make paths shorter, so
+   * only the tiles whose distance drops are visited
+   *
+   * @param map game map, which already has the tile as a tunnel
+   * @param x x index of the opened tile
+   * @param y y index of the opened tile
+   */
+  void OpenTile(const TileGrid& map, size_t x, size_t y);
+
+  /**
+   * Empties the field as if it were new, keeping its memory for the next search
+   */
+  void Clear();
+
+  /**
+   * Replaces the field with saved distances, for restoring a snapshot
+   *
+   * @param dimension number of tiles along each side of the board
+   * @param distances distance of every tile, in the TileGrid [x][y] layout
+   */
+  void Assign(size_t dimension, size_t root_x, size_t root_y, const uint16_t* distances);
+
+  /**
+   * Gets the number of steps through tunnels from a tile on the board to the root
+   *
+   * @return distance, or kUnreachable if no tunnel path leads to the root
+   */
+  uint16_t GetDistance(size_t x, size_t y) const {
+    return distances_[x * dimension_ + y];
+  }
+
+  /**
+   * Finds the first step of a shortest tunnel path from a tile to the root, trying directions in Direction order
+   *
+   * @param x x index of a tile on the board
+   * @param y y index of a tile on the board
+   * @param direction set to the direction of the step
+   * @return true if there is a step, false if the tile is the root or cannot reach it
+   */
+  bool GetStepToRoot(size_t x, size_t y, Direction& direction) const;
+
+  size_t GetRootX() const;
+
+  size_t GetRootY() const;
+
+  size_t GetDimension() const;
+
+  const uint16_t* GetData() const;
+
+ private:
+  size_t dimension_ = 0;
+  size_t root_x_ = 0;
+  size_t root_y_ = 0;
+  vector<uint16_t> distances_;
+  // Tiles waiting to be visited, with x in the high bits and y in the low bits. Kept between searches so updates do
+  // not allocate
+  vector<uint32_t> queue_;
+  const static uint32_t kQueueShift = 16;
+  const static uint32_t kQueueMask = (1 << kQueueShift) - 1;
+  // Queue entries reserved up front, which covers every tile of small boards
+  const static size_t kMaxReservedTiles = 4096;
+
+  static uint32_t PackTile(size_t x, size_t y) {
+    return (uint32_t) (x << kQueueShift | y);
+  }
+
+  /**
+   * Reserves the queue for a search of the current board
+   */
+  void ReserveQueue();
+
+  /**
+   * Visits tiles from the queue, lowering the distances of their tunnel neighbors
+   */
+  void Propagate(const TileGrid& map);
+
+  /**
+   * Lowers the distance of a tile to a new distance if it is a tunnel and not already closer, and queues it
+   */
+  void Relax(const TileGrid& map, size_t x, size_t y, size_t tile, uint16_t distance) {
+    if (distance < distances_[tile] && map.GetUnchecked(x, y) == TileType::Tunnel) {
+      distances_[tile] = distance;
+      queue_.push_back(PackTile(x, y));
+    }
+  }
+};
+
+} // namespace dig_dug
@@ -1,8 +1,10 @@
 #pragma once
 
-#include <cinder/gl/gl.h>
+#include <glm/vec2.hpp>
+
 #include "game_state_generator.h"
 #include "player.h"
+#include "core/fixed_point.h"
 
 namespace dig_dug {
 
@@ -17,6 +19,11 @@ class Enemy {
    */
   Enemy(const vec2& position, const vec2& velocity, TileType enemy_type);
 
+  /**
+   * Initializes an enemy with a fixed-point position and velocity
+   */
+  static Enemy AtFixedPosition(const FixedVec2& position, const FixedVec2& velocity, TileType enemy_type);
+
   /**
    * Moves the enemy
    */
@@ -30,6 +37,14 @@ class Enemy {
 
   void SetVelocity(const vec2& velocity);
 
+  const FixedVec2& GetFixedPosition() const;
+
+  void SetFixedPosition(const FixedVec2& position);
+
+  const FixedVec2& GetFixedVelocity() const;
+
+  void SetFixedVelocity(const FixedVec2& velocity);
+
   bool IsGhost() const;
 
   void SetGhost();
@@ -42,13 +57,15 @@ class Enemy {
 
   CharacterOrientation GetOrientation() const;
 
+  void SetOrientation(CharacterOrientation orientation);
+
   bool IsInDirt() const;
 
   void SetInDirt(bool in_dirt);
 
  private:
-  vec2 position_;
-  vec2 velocity_;
+  FixedVec2 position_;
+  FixedVec2 velocity_;
   bool ghost_ = false;
   bool in_dirt_ = false;
   bool hurt_ = false;
@@ -56,4 +73,4 @@ class Enemy {
   CharacterOrientation orientation_ = CharacterOrientation::Right;
 };
 
-} // namespace dig_dug
\ No newline at end of file
+} // namespace dig_dug
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/enemy_pool.h"
+#include "core/fixed_point.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::vector;
+
+/**
+ * Spatial hash of the enemies of an EnemyPool, keyed by the tile each enemy's corner is in. Enemies closer than a tile
+ * to a point are always in the 3x3 tiles around it, so collision checks only look at those buckets instead of every
+ * enemy. Enemies are kept by pool index in intrusive lists, and only change buckets when they cross into another tile
+ */
+class EnemyGrid {
+ public:
+  /**
+   * Constructs an empty grid
+   */
+  EnemyGrid() = default;
+
+  /**
+   * Puts every enemy of a pool into the grid, replacing whatever it held. The grid keeps its buckets until the next
+   * reset, which is fine because enemies are only ever removed in between
+   *
+   * @param enemies pool to index
+   * @param tile_size fixed-point size of a tile
+   */
+  void Reset(const EnemyPool& enemies, int32_t tile_size);
+
+  /**
+   * Moves an enemy to the bucket of the tile it is in now, which leaves the buckets alone unless it crossed into
+   * another tile
+   *
+   * @param index index of the enemy in the pool
+   * @param position fixed-point position of the enemy
+   */
+  void Update(size_t index, const FixedVec2& position) {
+    int32_t tile_x = GetTile(position.x);
+    int32_t tile_y = GetTile(position.y);
+
+    if (tile_x != tile_x_[index] || tile_y != tile_y_[index]) {
+      Unlink(index);
+      tile_x_[index] = tile_x;
+      tile_y_[index] = tile_y;
+      Link(index);
+    }
+  }
+
+  /**
+   * Removes the enemy at an index the way EnemyPool::RemoveAt does, by moving the last enemy into its place
+   */
+  void RemoveAt(size_t index);
+
+  /**
+   * Finds the walking enemy with the lowest index that is closer than a tile to a point, which is the one a scan
+   * over the whole pool would find first
+   *
+   * @param enemies pool the grid indexes
+   * @param point fixed-point position to search around
+   * @return index of the enemy, or enemies.Size() if there is none
+   */
+  size_t FindWalkingEnemyNear(const EnemyPool& enemies, const FixedVec2& point) const;
+
+  size_t Size() const;
+
+ private:
+  // Ends a bucket's list
+  const static uint32_t kNone = UINT32_MAX;
+  const static size_t kMinBuckets = 16;
+
+  int32_t tile_size_ = 0;
+  uint32_t bucket_mask_ = 0;
+  // First enemy of each bucket
+  vector<uint32_t> heads_;
+  // Neighbors of each enemy in its bucket's list, and the tile it was last put in
+  vector<uint32_t> next_;
+  vector<uint32_t> prev_;
+  vector<int32_t> tile_x_;
+  vector<int32_t> tile_y_;
+
+  /**
+   * Gets the tile containing a fixed-point coordinate, rounding down for coordinates off the top or left of the board
+   */
+  int32_t GetTile(int32_t position) const {
+    return position >= 0 ? position / tile_size_ : -((-position + tile_size_ - 1) / tile_size_);
+  }
+
+  uint32_t GetBucket(int32_t tile_x, int32_t tile_y) const {
+    return ((uint32_t) (tile_x) * 0x9E3779B1u ^ (uint32_t) (tile_y) * 0x85EBCA77u) & bucket_mask_;
+  }
+
+  /**
+   * Adds an enemy to the front of the bucket of its tile
+   */
+  void Link(size_t index);
+
+  /**
+   * Takes an enemy out of its bucket
+   */
+  void Unlink(size_t index);
+};
+
+} // namespace dig_dug
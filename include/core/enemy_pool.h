@@ -0,0 +1,229 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/const_span.h"
+#include "core/enemy.h"
+#include "core/fixed_point.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::vector;
+
+/**
+ * Refers to one enemy in an EnemyPool. A handle stays valid while its enemy is alive, even as other enemies are
+ * removed and the pool reorders itself, and it can never refer to a different enemy that later reuses its slot
+ */
+struct EnemyHandle {
+  uint32_t slot = UINT32_MAX;
+  uint32_t generation = 0;
+
+  EnemyHandle() = default;
+
+  EnemyHandle(uint32_t slot_value, uint32_t generation_value) : slot(slot_value), generation(generation_value) {}
+
+  bool operator==(const EnemyHandle& other) const {
+    return slot == other.slot && generation == other.generation;
+  }
+
+  bool operator!=(const EnemyHandle& other) const {
+    return !(*this == other);
+  }
+};
+
+/**
+ * Stores the enemies on the board as a structure of arrays, so loops over one field read contiguous memory. Enemies
+ * are addressed by a dense index from 0 to Size() - 1 for iteration, or by an EnemyHandle that survives removals.
+ * Removing an enemy moves the last enemy into its place, so indices are only valid until the next removal
+ */
+class EnemyPool {
+ public:
+  /**
+   * Constructs an empty pool
+   */
+  EnemyPool() = default;
+
+  /**
+   * Adds an enemy to the end of the pool
+   *
+   * @return handle of the new enemy
+   */
+  EnemyHandle Add(const Enemy& enemy);
+
+  /**
+   * Adds an enemy to the end of the pool
+   *
+   * @param position fixed-point position
+   * @param velocity fixed-point velocity
+   * @param type type of enemy
+   * @return handle of the new enemy
+   */
+  EnemyHandle Add(const FixedVec2& position, const FixedVec2& velocity, TileType type);
+
+  /**
+   * Removes the enemy a handle refers to
+   *
+   * @return true if the enemy was removed, false if the handle was already stale
+   */
+  bool Remove(const EnemyHandle& handle);
+
+  /**
+   * Removes the enemy at an index by moving the last enemy into its place. Does not allocate
+   *
+   * @throws std::out_of_range if there is no enemy at the index
+   */
+  void RemoveAt(size_t index);
+
+  /**
+   * Removes every enemy and invalidates all of their handles
+   */
+  void Clear();
+
+  /**
+   * Replaces every enemy with the given ones, in order, and invalidates the handles of the old enemies. Does not
+   * allocate once the pool has held that many enemies
+   *
+   * @param count number of enemies
+   * @param x fixed-point x coordinate of each enemy
+   * @param y fixed-point y coordinate of each enemy
+   * @param velocity_x fixed-point x velocity of each enemy
+   * @param velocity_y fixed-point y velocity of each enemy
+   * @param flags flags byte of each enemy, in the layout returned by GetFlags
+   */
+  void Assign(size_t count, const int32_t* x, const int32_t* y, const int32_t* velocity_x, const int32_t* velocity_y,
+              const uint8_t* flags);
+
+  /**
+   * Checks whether a handle still refers to an enemy in the pool
+   */
+  bool IsValid(const EnemyHandle& handle) const;
+
+  /**
+   * Gets the current index of the enemy a handle refers to
+   *
+   * @throws std::out_of_range if the handle is stale
+   */
+  size_t GetIndex(const EnemyHandle& handle) const;
+
+  EnemyHandle GetHandle(size_t index) const;
+
+  size_t Size() const;
+
+  bool IsEmpty() const;
+
+  /**
+   * Copies the enemy at an index out of the pool
+   */
+  Enemy GetEnemy(size_t index) const;
+
+  /**
+   * Copies every enemy out of the pool, in index order
+   */
+  vector<Enemy> ToVector() const;
+
+  FixedVec2 GetPosition(size_t index) const {
+    return FixedVec2(x_[index], y_[index]);
+  }
+
+  void SetPosition(size_t index, const FixedVec2& position) {
+    x_[index] = position.x;
+    y_[index] = position.y;
+  }
+
+  FixedVec2 GetVelocity(size_t index) const {
+    return FixedVec2(velocity_x_[index], velocity_y_[index]);
+  }
+
+  /**
+   * Sets the velocity of an enemy and turns it to face the way it moves horizontally
+   */
+  void SetVelocity(size_t index, const FixedVec2& velocity);
+
+  /**
+   * Moves an enemy by its velocity
+   */
+  void Move(size_t index) {
+    x_[index] += velocity_x_[index];
+    y_[index] += velocity_y_[index];
+  }
+
+  TileType GetType(size_t index) const {
+    return static_cast<TileType>(flags_[index] >> kTypeShift);
+  }
+
+  bool IsGhost(size_t index) const {
+    return (flags_[index] & kGhostFlag) != 0;
+  }
+
+  /**
+   * Turns an enemy into a ghost or back into a walking enemy, which is no longer in dirt
+   */
+  void SetGhost(size_t index, bool is_ghost);
+
+  bool IsHurt(size_t index) const {
+    return (flags_[index] & kHurtFlag) != 0;
+  }
+
+  void SetHurt(size_t index, bool is_hurt) {
+    SetFlag(index, kHurtFlag, is_hurt);
+  }
+
+  /**
+   * Marks every enemy as not hurt
+   */
+  void ClearHurt();
+
+  bool IsInDirt(size_t index) const {
+    return (flags_[index] & kInDirtFlag) != 0;
+  }
+
+  void SetInDirt(size_t index, bool in_dirt) {
+    SetFlag(index, kInDirtFlag, in_dirt);
+  }
+
+  CharacterOrientation GetOrientation(size_t index) const {
+    return (flags_[index] & kFacingLeftFlag) != 0 ? CharacterOrientation::Left : CharacterOrientation::Right;
+  }
+
+  ConstSpan<int32_t> GetPositionsX() const;
+
+  ConstSpan<int32_t> GetPositionsY() const;
+
+  ConstSpan<uint8_t> GetFlags() const;
+
+  // The low bits of each flags byte are the flags below and the high bits are the TileType of the enemy
+  const static uint8_t kGhostFlag = 1 << 0;
+  const static uint8_t kHurtFlag = 1 << 1;
+  const static uint8_t kInDirtFlag = 1 << 2;
+  const static uint8_t kFacingLeftFlag = 1 << 3;
+  const static uint8_t kTypeShift = 4;
+
+ private:
+  struct Slot {
+    uint32_t index;
+    uint32_t generation;
+  };
+
+  vector<int32_t> x_;
+  vector<int32_t> y_;
+  vector<int32_t> velocity_x_;
+  vector<int32_t> velocity_y_;
+  vector<uint8_t> flags_;
+  // Slot of the enemy at each index
+  vector<uint32_t> slot_of_index_;
+  vector<Slot> slots_;
+  vector<uint32_t> free_slots_;
+
+  void SetFlag(size_t index, uint8_t flag, bool value) {
+    if (value) {
+      flags_[index] |= flag;
+    } else {
+      flags_[index] &= (uint8_t) (~flag);
+    }
+  }
+};
+
+} // namespace dig_dug
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "core/bit_board.h"
+#include "core/fixed_point.h"
+#include "core/harpoon.h"
+#include "core/player.h"
+#include "core/random.h"
+#include "core/tile_layers.h"
+
+namespace dig_dug {
+
+using std::size_t;
+
+/**
+ * Complete state of a GameEngine in one fixed-size block with no pointers, so it can be copied with memcpy, kept in
+ * arrays and restored without allocating. Fits boards of up to kMaxDimension tiles per side with up to kMaxEnemies
+ * enemies. Unused tiles and enemy entries are zero, so equal states have equal bytes
+ */
+struct EngineSnapshot {
+  const static size_t kMaxDimension = BitBoard::kMaxDimension;
+  // Most enemies the generator places on a board that fits a snapshot by default. Such boards are below the size where
+  // enemy counts start to grow with the side, so they get the same enemies as the arcade board
+  const static size_t kMaxEnemies = 8;
+
+  // Map in the TileGrid [x][y] layout, packed to board_size tiles per side
+  uint8_t tiles[kMaxDimension * kMaxDimension] = {};
+  TileLayers layers;
+  uint32_t board_size = 0;
+  uint32_t tile_size = 0;
+  bool has_layers = false;
+
+  Player player;
+  FixedVec2 delayed_turn_velocity {0, 0};
+  Harpoon harpoon;
+  bool is_player_attacking = false;
+  uint32_t cur_attack_frames = 0;
+  int32_t max_harpoon_distance = 0;
+
+  // Enemies in pool order, with the EnemyPool flags bytes
+  uint32_t num_enemies = 0;
+  int32_t enemy_x[kMaxEnemies] = {};
+  int32_t enemy_y[kMaxEnemies] = {};
+  int32_t enemy_velocity_x[kMaxEnemies] = {};
+  int32_t enemy_velocity_y[kMaxEnemies] = {};
+  uint8_t enemy_flags[kMaxEnemies] = {};
+
+  // Distance field rooted at the player's tile, in the same layout as the map
+  uint16_t distances[kMaxDimension * kMaxDimension] = {};
+  uint32_t distance_root_x = 0;
+  uint32_t distance_root_y = 0;
+
+  uint64_t ghost_chance = 0;
+  uint64_t num_lives = 0;
+  uint64_t score = 0;
+  Random random;
+};
+
+static_assert(std::is_trivially_copyable<EngineSnapshot>::value, "Snapshots must be copyable as plain bytes");
+
+} // namespace dig_dug
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+#include "core/direction.h"
+
+namespace dig_dug {
+
+using glm::vec2;
+
+// Fixed-point coordinates have 8 fractional bits, so one pixel is 256 units
+const int32_t kFixedShift = 8;
+const int32_t kFixedOne = 1 << kFixedShift;
+
+/**
+ * Position or velocity in fixed-point pixels. The simulation only uses integer math, so runs are bit-for-bit
+ * reproducible across compilers and platforms
+ */
+struct FixedVec2 {
+  int32_t x = 0;
+  int32_t y = 0;
+
+  FixedVec2() = default;
+
+  FixedVec2(int32_t x_value, int32_t y_value) : x(x_value), y(y_value) {}
+
+  FixedVec2& operator+=(const FixedVec2& other) {
+    x += other.x;
+    y += other.y;
+    return *this;
+  }
+
+  FixedVec2 operator+(const FixedVec2& other) const {
+    return FixedVec2(x + other.x, y + other.y);
+  }
+
+  FixedVec2 operator-(const FixedVec2& other) const {
+    return FixedVec2(x - other.x, y - other.y);
+  }
+
+  FixedVec2 operator-() const {
+    return FixedVec2(-x, -y);
+  }
+
+  bool operator==(const FixedVec2& other) const {
+    return x == other.x && y == other.y;
+  }
+
+  bool operator!=(const FixedVec2& other) const {
+    return !(*this == other);
+  }
+};
+
+/**
+ * Converts whole pixels to fixed point
+ */
+inline int32_t PixelsToFixed(int32_t pixels) {
+  return pixels * kFixedOne;
+}
+
+/**
+ * Converts fixed point to whole pixels, truncating toward zero like a float to integer cast
+ */
+inline int32_t FixedToPixels(int32_t fixed) {
+  return fixed / kFixedOne;
+}
+
+/**
+ * Converts a float vector in pixels to fixed point, rounding to the nearest unit
+ */
+FixedVec2 ToFixed(const vec2& value);
+
+/**
+ * Converts a fixed-point vector to float pixels
+ */
+vec2 ToFloat(const FixedVec2& value);
+
+/**
+ * Gets the squared length of a fixed-point vector, which cannot overflow
+ */
+int64_t LengthSquared(const FixedVec2& value);
+
+/**
+ * Gets the length of a fixed-point vector using an integer square root
+ */
+int32_t Length(const FixedVec2& value);
+
+/**
+ * Gets the largest integer whose square is at most the given value
+ */
+uint32_t IntegerSqrt(uint64_t value);
+
+/**
+ * Gets the velocity of something moving in the given direction
+ *
+ * @param direction direction of travel
+ * @param speed fixed-point distance moved each tick
+ */
+FixedVec2 DirectionVelocity(Direction direction, int32_t speed);
+
+/**
+ * Gets the direction of travel of a velocity along one axis. Any other velocity, including zero, counts as Up, which
+ * is how the board checks have always treated it
+ */
+Direction GetTravelDirection(const FixedVec2& velocity);
+
+} // namespace dig_dug
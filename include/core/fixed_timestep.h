@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+
+namespace dig_dug {
+
+using std::size_t;
+
+/**
+ * Turns the real time between rendered frames into a whole number of simulation ticks, so the game runs at the same
+ * speed whatever the frame rate is. Time left over after the last tick carries into the next frame, and the fraction
+ * of a tick it makes up is how far the renderer should blend between the last two states. Headless runs do not need
+ * this and just tick as fast as they can
+ */
+class FixedTimestep {
+ public:
+  // Tick rate the game was tuned at, which is one tick per frame at Cinder's default 60 frames per second
+  const static size_t kDefaultTickRate = 60;
+  // Most ticks run for one frame. After a long stall, like dragging the window, the rest of the time is dropped so
+  // the game does not fall further and further behind trying to catch up
+  const static size_t kDefaultMaxTicksPerFrame = 5;
+
+  /**
+   * Constructs a timestep with no time accumulated
+   *
+   * @param ticks_per_second number of simulation ticks in one second of real time
+   * @param max_ticks_per_frame most ticks Advance returns at once
+   * @throws std::invalid_argument if either value is zero
+   */
+  explicit FixedTimestep(size_t ticks_per_second = kDefaultTickRate,
+                         size_t max_ticks_per_frame = kDefaultMaxTicksPerFrame);
+
+  /**
+   * Adds the real time since the last frame and takes out the ticks that are due
+   *
+   * @param elapsed_seconds time since the last call, where negative times count as zero
+   * @return number of ticks to run this frame
+   */
+  size_t Advance(double elapsed_seconds);
+
+  /**
+   * Gets how far the time left over is into the next tick, from 0 up to but not including 1
+   */
+  double GetAlpha() const;
+
+  /**
+   * Changes the tick rate, keeping the fraction of a tick that has built up
+   *
+   * @throws std::invalid_argument if the rate is zero
+   */
+  void SetTickRate(size_t ticks_per_second);
+
+  size_t GetTickRate() const;
+
+  double GetTickSeconds() const;
+
+ private:
+  size_t ticks_per_second_ = 0;
+  size_t max_ticks_per_frame_;
+  double tick_seconds_ = 0;
+  double accumulated_seconds_ = 0;
+};
+
+} // namespace dig_dug
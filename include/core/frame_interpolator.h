@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/enemy_pool.h"
+#include "core/fixed_point.h"
+#include "core/game_engine.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::vector;
+
+/**
+ * Remembers where the characters were before the last simulation tick, so the renderer can draw them part of the way
+ * between that state and the current one. Enemies are matched by handle, so removals and reordering in the pool do
+ * not mix up their positions. Anything that moved more than a tile in one tick, like a new board or a restarted
+ * level, is drawn where it is instead of sliding across the screen
+ */
+class FrameInterpolator {
+ public:
+  /**
+   * Constructs an interpolator with nothing captured, which draws everything at its current position
+   */
+  FrameInterpolator() = default;
+
+  /**
+   * Records the positions of the characters. Call this right before every tick
+   *
+   * @param engine engine that is about to tick
+   */
+  void Capture(const GameEngine& engine);
+
+  /**
+   * Forgets the captured positions, so everything is drawn at its current position until the next capture
+   */
+  void Clear();
+
+  /**
+   * Gets where to draw the player
+   *
+   * @param engine engine after the last tick
+   * @param alpha fraction of a tick since the last tick, from FixedTimestep::GetAlpha
+   * @return position in pixels
+   */
+  vec2 GetPlayerPosition(const GameEngine& engine, double alpha) const;
+
+  /**
+   * Gets where to draw an enemy
+   *
+   * @param engine engine after the last tick
+   * @param index index of the enemy in the engine's pool
+   * @param alpha fraction of a tick since the last tick, from FixedTimestep::GetAlpha
+   * @return position in pixels
+   */
+  vec2 GetEnemyPosition(const GameEngine& engine, size_t index, double alpha) const;
+
+  /**
+   * Gets where to draw the tip of the harpoon. A harpoon shot on the last tick comes out of the player's captured
+   * position, so it stays attached to the player as drawn
+   *
+   * @param engine engine after the last tick, with the player attacking
+   * @param alpha fraction of a tick since the last tick, from FixedTimestep::GetAlpha
+   * @return position in pixels
+   */
+  vec2 GetArrowPosition(const GameEngine& engine, double alpha) const;
+
+ private:
+  bool has_player_ = false;
+  FixedVec2 player_position_;
+  bool has_arrow_ = false;
+  FixedVec2 arrow_position_;
+  // Positions and generations by enemy slot, so lookups by handle do not search. Slots of enemies that were not
+  // alive at the capture have a generation no handle can match
+  vector<FixedVec2> enemy_positions_;
+  vector<uint32_t> enemy_generations_;
+  int32_t max_step_ = 0;
+
+  /**
+   * Blends a captured position toward the current one, or takes the current one if it is too far away
+   */
+  vec2 Blend(const FixedVec2& previous, const FixedVec2& current, double alpha) const;
+};
+
+} // namespace dig_dug
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+#include "core/const_span.h"
+#include "core/tile_grid.h"
+#include "core/player.h"
+#include "core/enemy_pool.h"
+#include "core/harpoon.h"
+
+namespace dig_dug {
+
+using std::size_t;
+
+/**
+ * References to all of the engine state needed to draw or observe one frame. The engine refreshes a single FrameView
+ * in place, so taking one never copies or allocates, and it stays valid until the engine is next changed
+ */
+struct FrameView {
+  const TileGrid* tiles = nullptr;
+  const EnemyPool* enemies = nullptr;
+  const Player* player = nullptr;
+  const Harpoon* harpoon = nullptr;
+  bool is_player_attacking = false;
+  size_t score = 0;
+  size_t num_lives = 0;
+};
+
+} // namespace dig_dug
@@ -1,11 +1,25 @@
 #pragma once
 
-#include <cinder/gl/gl.h>
+#include <memory>
+
+#include <glm/vec2.hpp>
 
 #include "core/game_state_generator.h"
+#include "core/tile_grid.h"
+#include "core/tile_layers.h"
+#include "core/tunnel_exits.h"
 #include "core/player.h"
 #include "core/enemy.h"
+#include "core/enemy_pool.h"
+#include "core/enemy_grid.h"
 #include "core/harpoon.h"
+#include "core/frame_view.h"
+#include "core/const_span.h"
+#include "core/fixed_point.h"
+#include "core/random.h"
+#include "core/engine_snapshot.h"
+#include "core/distance_field.h"
+#include "core/state_hash.h"
 
 namespace dig_dug {
 
@@ -29,11 +43,32 @@ class GameEngine {
    * Creates the game map based on the generated starting state
    *
    * @param initial_game_state starting game map
+   * @param tile_size size of each tile in pixels
+   * @param seed seed of the engine's random numbers, so a run with the same seed and input plays out the same way
    */
-  GameEngine(const vector<vector<TileType>>& initial_game_state, size_t tile_size);
+  GameEngine(const TileGrid& initial_game_state, size_t tile_size, uint64_t seed = 0);
 
   /**
-   * Moves the enemies on the board
+   * Creates the game map based on a starting state in the nested [x][y] layout
+   *
+   * @param initial_game_state starting game map
+   */
+  GameEngine(const vector<vector<TileType>>& initial_game_state, size_t tile_size, uint64_t seed = 0);
+
+  /**
+   * Starts over on a new board, leaving the engine the same as one constructed with these arguments. The map, enemy
+   * and tile change buffers of the last board are kept and reused, so moving to a board no larger than the ones
+   * before does not allocate, unless the map is chunked or shared with a fork
+   *
+   * @param board starting game map of the level
+   * @param tile_size size of each tile in pixels
+   * @param seed seed of the engine's random numbers
+   */
+  void Reset(const TileGrid& board, size_t tile_size, uint64_t seed = 0);
+
+  /**
+   * Moves the enemies on the board. Like MovePlayer, AttackEnemy and IsPlayerDead, this never allocates on boards of
+   * up to 64 tiles per side, whose buffers are all reserved up front
    */
   void MoveEnemies();
 
@@ -56,10 +91,30 @@ class GameEngine {
    */
   void AttackEnemy();
 
+  /**
+   * Copies the map out in the nested [x][y] layout. Code that runs every tick reads GetTileGrid instead, which does not
+   * allocate
+   */
   vector<vector<TileType>> GetGameMap() const;
 
+  const TileGrid& GetTileGrid() const;
+
+  /**
+   * Lets the map of a large board keep only some of its chunks in memory, spilling the rest into a temporary file.
+   * Forks get their own copy of the map once they change it, and that copy does not spill
+   *
+   * @param directory folder for the file
+   * @param max_resident_chunks number of chunks of the map to keep in memory
+   * @throws std::invalid_argument if the map is not chunked
+   */
+  void SpillMapTo(const string& directory, size_t max_resident_chunks);
+
   Player GetPlayer() const;
 
+  /**
+   * Copies every enemy out of the engine. Code that runs every tick reads GetEnemyView instead, which does not
+   * allocate
+   */
   vector<Enemy> GetEnemies() const;
 
   size_t GetNumLives() const;
@@ -74,37 +129,73 @@ class GameEngine {
 
   void SetScore(size_t score);
 
- private:
-  vector<vector<TileType>> game_map_;
-  Player player_;
-  vector<Enemy> enemies_;
-  Harpoon harpoon_;
+  size_t GetTileSize() const;
 
-  bool player_attacking_ = false;
-  double enemy_ghost_percentage_;
-  size_t tile_size_;
-  size_t num_lives_ = 3;
-  size_t cur_attack_frames_ = 0;
-  size_t max_harpoon_traveling_frames_;
-  vec2 delayed_turn_velocity_ {0, 0};
-  size_t score_ = 0;
-  size_t board_size_;
+  /**
+   * Gets read-only views of the whole game state for drawing or observing the current frame, without copying it
+   *
+   * @return view that stays valid until the engine is next changed
+   */
+  const FrameView& GetFrameView() const;
 
-  constexpr static double kPlayerSpeed = 10;
-  constexpr static double kEnemySpeed = 4;
-  constexpr static double kEnemyDifficulty = 0.01;
-  constexpr static double kGhostDistanceBuffer = 500;
-  const static size_t kAttackFrames = 20;
-  const static size_t kHarpoonLength = 10;
-  const static size_t kHarpoonSpeed = 20;
-  const static size_t kEnemyKillScore = 100;
+  const EnemyPool& GetEnemyView() const;
+
+  const Player& GetPlayerView() const;
+
+  const Harpoon& GetHarpoonView() const;
 
   /**
-   * Moves a normal, walking enemy
+   * Gets the number of steps through tunnels from every tile to the tile the player is on. Digging updates the field
+   * as it happens, and the field moves to the player's tile when it is asked for
    *
-   * @param enemy
+   * @return field that stays valid until the engine is next changed
+   */
+  const DistanceField& GetDistanceField() const;
+
+  /**
+   * Gets the tiles of the map that changed since the last ClearTileChanges, in the order they changed. Applying them
+   * in order to a copy of the map taken at that point brings it up to date
    */
-  void MoveWalkingEnemy(Enemy& enemy) const;
+  ConstSpan<TileChange> GetTileChanges() const;
+
+  /**
+   * Checks whether the whole map was replaced since the last ClearTileChanges, in which case the changes do not cover
+   * it and consumers have to read the whole map again. True for a new engine and after Restore
+   */
+  bool IsMapReplaced() const;
+
+  /**
+   * Starts a new list of tile changes. Whoever consumes the changes calls this once they have been applied, usually
+   * once per tick
+   */
+  void ClearTileChanges();
+
+  /**
+   * Captures the whole state of the game, including the random number state, so Restore can return to it exactly
+   *
+   * @throws std::invalid_argument if the board or the number of enemies is too large for a snapshot
+   */
+  EngineSnapshot Snapshot() const;
+
+  /**
+   * Returns to a captured state. Does not allocate when the engine does not share its map with a fork, its map is
+   * the size of the snapshot's and it has held as many enemies before
+   */
+  void Restore(const EngineSnapshot& snapshot);
+
+  /**
+   * Hashes everything that decides how the game plays out from here, so two engines with the same hash play the same
+   * way given the same input. Derived data like the distance field and the tile change log is left out
+   *
+   * @param hash hash to add the state to
+   */
+  void AddToHash(StateHash& hash) const;
+
+  /**
+   * Copies the engine for searching ahead. The copy shares the map with this engine until either of them digs a
+   * tile, so forking does not copy the map
+   */
+  GameEngine Fork() const;
 
   /**
    * Checks whether the next tile along the object's path is dirt
@@ -124,12 +215,172 @@ class GameEngine {
    */
   bool IsNextTileOpen(const vec2& velocity, const vec2& position) const;
 
+  /**
+   * Checks whether the next tile along the object's path is dirt, using fixed-point coordinates
+   */
+  bool IsNextTileDirt(const FixedVec2& velocity, const FixedVec2& position) const;
+
+  /**
+   * Checks whether the next tile along the object's path is within the bounds of the board, using fixed-point
+   * coordinates
+   */
+  bool IsNextTileOpen(const FixedVec2& velocity, const FixedVec2& position) const;
+
+  const TileLayers& GetTileLayers() const;
+
+  /**
+   * Checks whether the board is small enough for the engine to keep bit board layers of the map
+   */
+  bool HasTileLayers() const;
+
+  /**
+   * Gets the tunnel neighbors of every tile, which walking enemies decide where to go by
+   */
+  const TunnelExits& GetTunnelExits() const;
+
+  /**
+   * Checks whether the board is small enough for the engine to keep the tunnel neighbors of every tile
+   */
+  bool HasTunnelExits() const;
+
+  // Rules of the game. Speeds and distances are in fixed-point pixels
+  const static int32_t kPlayerSpeed = 10 * kFixedOne;
+  const static int32_t kEnemySpeed = 4 * kFixedOne;
+  // Chance out of kGhostChanceScale, for each starting enemy, that an enemy turns into a ghost on a tick
+  const static size_t kGhostChancePerEnemy = 1;
+  const static size_t kGhostChanceScale = 10000;
+  const static int32_t kGhostDistanceBuffer = 500 * kFixedOne;
+  const static size_t kAttackFrames = 20;
+  const static size_t kHarpoonLength = 10;
+  const static int32_t kHarpoonSpeed = 20 * kFixedOne;
+  const static size_t kEnemyKillScore = 100;
+
+ private:
+  // Steps small games in lanes of its own, so it moves their state in and out of the engine and digs through it
+  friend class BatchGameEngine;
+
+  // Tile changes reserved up front, which covers every tile of small boards so digging on them never allocates
+  const static size_t kMaxReservedTileChanges = 4096;
+  // Boards with fewer enemies than this are cheaper to scan in full than to keep in the enemy grid
+  const static size_t kMinGridEnemies = 32;
+  const static size_t kNumStartingLives = 3;
+
+  // Shared with forks of this engine until one of them changes it
+  std::shared_ptr<TileGrid> game_map_ = std::make_shared<TileGrid>();
+  TileLayers layers_;
+  bool has_layers_ = false;
+  // Tunnel neighbors of every tile, which walking enemies turn by. Kept on every board that is not chunked
+  TunnelExits tunnel_exits_;
+  bool has_tunnel_exits_ = false;
+  Player player_;
+  EnemyPool enemies_;
+  // Index of enemies_ by tile for collision checks, kept only on boards with many enemies
+  EnemyGrid enemy_grid_;
+  bool has_enemy_grid_ = false;
+  Harpoon harpoon_;
+  Random random_;
+  // Tiles only ever change into tunnels, so the list holds at most one change per tile
+  vector<TileChange> tile_changes_;
+  bool is_map_replaced_ = true;
+  // Rooted at the player's tile as of the last time it was asked for, and empty until then
+  mutable DistanceField distance_field_;
+
+  bool player_attacking_ = false;
+  size_t ghost_chance_;
+  size_t tile_size_;
+  size_t num_lives_ = kNumStartingLives;
+  size_t cur_attack_frames_ = 0;
+  int32_t max_harpoon_distance_;
+  FixedVec2 delayed_turn_velocity_ {0, 0};
+  size_t score_ = 0;
+  size_t board_size_;
+  mutable FrameView frame_view_;
+
+  /**
+   * Moves a normal, walking enemy
+   *
+   * @param index index of the enemy in the pool
+   */
+  void MoveWalkingEnemy(size_t index);
+
+  /**
+   * Finds which neighbors of the tile a walking enemy is aligned with it can move into, as a TunnelExits mask. Only
+   * the bits of going forward, left and right are meaningful
+   *
+   * @param position fixed-point position of the enemy, on a tile boundary along both axes
+   * @param velocity fixed-point velocity of the enemy
+   */
+  uint8_t GetWalkingExits(const FixedVec2& position, const FixedVec2& velocity) const;
+
+  /**
+   * Finds the tile an object moves into next, the same way for every direction
+   *
+   * @param velocity velocity of object
+   * @param position position of object
+   * @param next_x set to the x index of the next tile
+   * @param next_y set to the y index of the next tile
+   * @return true if the next tile is on the board, false otherwise
+   */
+  bool GetNextTile(const FixedVec2& velocity, const FixedVec2& position, size_t& next_x, size_t& next_y) const;
+
+  /**
+   * Checks whether a position is on a tile boundary along both axes
+   */
+  bool IsTileAligned(const FixedVec2& position) const;
+
+  /**
+   * Finds the walking enemy with the lowest index that is closer than one tile to a point
+   *
+   * @return index of the enemy, or the number of enemies if there is none
+   */
+  size_t FindWalkingEnemyNear(const FixedVec2& point) const;
+
+  /**
+   * Rebuilds the enemy grid after the enemies were replaced, or drops it if there are few enough to scan
+   */
+  void ResetEnemyGrid();
+
+  /**
+   * Checks whether two objects with the given offset between them are closer than one tile
+   */
+  bool IsWithinTile(const FixedVec2& offset) const;
+
+  /**
+   * Gets the index of the tile containing a fixed-point coordinate
+   */
+  size_t GetTileIndex(int32_t position) const;
+
+  bool IsTunnelTile(size_t x, size_t y) const;
+
+  bool IsRockTile(size_t x, size_t y) const;
+
+  /**
+   * Changes a tile of the map and keeps the bit board layers in sync
+   */
+  void SetTile(size_t x, size_t y, TileType type);
+
+  /**
+   * Gets the map for changing it, first making a copy of it if a fork shares it
+   */
+  TileGrid& GetMutableMap();
+
+  /**
+   * Checks whether the distance field was searched for this engine's board, after which digging keeps it up to date
+   */
+  bool HasDistanceField() const;
+
+  /**
+   * Gets the tile that the center of the player is on
+   */
+  void GetPlayerTile(size_t& x, size_t& y) const;
+
+
   /**
    * Moves a ghosted enemy that can go through dirt
    *
-   * @param enemy
+   * @param index index of the enemy in the pool
    */
-  void MoveGhostedEnemy(Enemy& enemy) const;
+  void MoveGhostedEnemy(size_t index);
 
   /**
    * Turns the dirt tiles that the player enters into tunnels
@@ -137,7 +388,7 @@ class GameEngine {
    * @param player_pos player position
    * @param velocity player velocity
    */
-  void DigUpTiles(const vec2& player_pos, const vec2& velocity);
+  void DigUpTiles(const FixedVec2& player_pos, const FixedVec2& velocity);
 
   /**
    * Creates a harpoon
@@ -145,11 +396,11 @@ class GameEngine {
   void CreateHarpoon();
 
   /**
-   * Gets the index of the enemy which the harpoon is hurting
+   * Gets the enemy which the harpoon is hurting
    *
-   * @return index of enemy, or -1 if harpoon not hurting anything
+   * @return handle of enemy, or an invalid handle if harpoon not hurting anything
    */
-  int GetHurtEnemy() const;
+  EnemyHandle GetHurtEnemy() const;
 
   /**
    * Gets the index on the game board of a player's position in pixels
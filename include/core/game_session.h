@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/board_source.h"
+#include "core/game_state_generator.h"
+#include "core/game_engine.h"
+#include "core/player_action.h"
+#include "core/session_snapshot.h"
+#include "core/state_hash.h"
+
+namespace dig_dug {
+
+/**
+ * A whole game from the first level until the player runs out of lives. The session moves the enemies every frame,
+ * goes to the next level once every enemy is killed, and restarts the level after a pause when the player dies
+ */
+class GameSession {
+ public:
+  /**
+   * Constructs a session with no game
+   */
+  GameSession() = default;
+
+  /**
+   * Starts a new game
+   *
+   * @param seed seed of every board and engine in the game
+   * @param tile_size size of each tile in pixels
+   * @param level level to start on
+   * @param board_source boards made ahead of time, or nullptr to always generate them; see SetBoardSource
+   * @param board_dimension number of tiles along each side of every board in the game
+   * @param enemy_scale number of times the arcade board's enemies and rocks that every board gets, or 0 for the
+   * generator's default for the board size
+   * @throws std::invalid_argument if the generator cannot make boards of that size
+   */
+  GameSession(uint64_t seed, size_t tile_size, size_t level = 1, BoardSource* board_source = nullptr,
+              size_t board_dimension = GameStateGenerator::kDefaultBoardDimension, size_t enemy_scale = 0);
+
+  /**
+   * Advances the game by one frame, first applying the player's input for the frame. Input is ignored while the game
+   * is paused after the player died
+   *
+   * @param input input for this frame
+   */
+  void Update(const InputFrame& input = InputFrame());
+
+  /**
+   * Starts over with a new seed, on boards of the same size and with as many enemies
+   *
+   * @param seed seed of every board and engine in the game
+   * @param level level to start on
+   */
+  void NewGame(uint64_t seed, size_t level = 1);
+
+  /**
+   * Takes boards from a source made ahead of time when levels start, generating them only when the source does not
+   * have them. The session does not own the source, which has to outlive it or be unset
+   *
+   * @param source source of boards, or nullptr to always generate them
+   */
+  void SetBoardSource(BoardSource* source);
+
+  /**
+   * Captures the whole state of the game so Restore can return to it exactly
+   *
+   * @throws std::invalid_argument if the engine is too large for a snapshot
+   */
+  SessionSnapshot Snapshot() const;
+
+  /**
+   * Returns to a captured state, which can come from any session
+   */
+  void Restore(const SessionSnapshot& snapshot);
+
+  /**
+   * Hashes the whole state of the game, for checking that a replay plays out the way it was recorded
+   */
+  uint64_t GetStateHash() const;
+
+  bool IsGameOver() const;
+
+  /**
+   * Checks whether the game is paused after the player died, before the level restarts
+   */
+  bool IsLosingLife() const;
+
+  size_t GetLevel() const;
+
+  size_t GetScore() const;
+
+  /**
+   * Gets the number of frames played since the game started
+   */
+  size_t GetNumTicks() const;
+
+  GameEngine& GetEngine();
+
+  const GameEngine& GetEngine() const;
+
+  const GameStateGenerator& GetGenerator() const;
+
+  const static size_t kLevelUpScore = 200;
+  // Number of frames the game pauses for after the player dies
+  const static size_t kMaxLiveLostFrames = 100;
+
+ private:
+  GameStateGenerator generator_;
+  GameEngine engine_;
+  size_t tile_size_ = 0;
+  size_t live_lost_num_frames_ = 0;
+  size_t num_ticks_ = 0;
+  bool game_over_ = false;
+  BoardSource* board_source_ = nullptr;
+
+  /**
+   * Generates the next board of the current level and starts a new engine on it, keeping the lives and score
+   *
+   * @param num_lives lives the player has left
+   * @param score score to carry over
+   */
+  void StartLevel(size_t num_lives, size_t score);
+
+  /**
+   * Moves the generator to the next board of its level, taking it from the board source if it has it
+   */
+  void NextBoard();
+
+  /**
+   * Tells the board source which boards may come after the current one
+   */
+  void PrepareNextBoards();
+};
+
+} // namespace dig_dug
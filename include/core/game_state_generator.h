@@ -1,93 +1,195 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 #include <random>
 
+#include "core/tile_grid.h"
+#include "core/random.h"
+
 namespace dig_dug {
 
 using std::vector;
 
-enum class TileType {
-  Dirt,
-  Tunnel,
-  Player,
-  Fygar,
-  Pooka,
-  Ghost,
-  Rock,
-};
-
 class GameStateGenerator {
  public:
+  // Size of the arcade board
+  const static size_t kDefaultBoardDimension = 15;
+  // Smallest board with room for enemies around the player's starting tunnel
+  const static size_t kMinBoardDimension = 8;
+  const static size_t kMaxBoardDimension = 4096;
+  // Most times the arcade board's enemies and rocks that a board gets unless asked for more, so even the largest
+  // boards get a few hundred enemies and stay mostly untouched dirt
+  const static size_t kMaxDefaultEnemyScale = 64;
+
   /**
    * Fills in the field values when a GameStateGenerator is created
+   *
+   * @param seed seed of every board this generator makes
+   * @param board_dimension number of tiles along each side of the boards
+   * @param enemy_scale number of times the arcade board's enemies and rocks that each board gets, or 0 for
+   * GetDefaultEnemyScale(board_dimension)
+   * @throws std::invalid_argument if the dimension is below kMinBoardDimension or above kMaxBoardDimension
    */
-  GameStateGenerator() = default;
+  explicit GameStateGenerator(uint64_t seed = 0, size_t board_dimension = kDefaultBoardDimension,
+                              size_t enemy_scale = 0);
 
   /**
-   * Returns the starting game state for the current level
+   * Checks whether boards can have the given number of tiles per side, from kMinBoardDimension to kMaxBoardDimension
    */
-  vector<vector<TileType>> Generate();
+  static bool IsValidDimension(size_t board_dimension);
+
+  /**
+   * Gets how many times the arcade board's enemies and rocks a board gets by default. This grows with the side of the
+   * board rather than its area, up to kMaxDefaultEnemyScale, so large boards have room to move around in
+   */
+  static size_t GetDefaultEnemyScale(size_t board_dimension);
+
+  /**
+   * Returns the starting game state for the current level. Each call on the same level makes a new board, and the n-th
+   * board of a level depends only on the seed, the level and n
+   */
+  const TileGrid& Generate();
 
   /**
    * Increases the level by 1
    */
   void IncreaseLevel();
 
+  /**
+   * Jumps straight to a level, so the next board generated is that level's first board
+   */
+  void SetLevel(size_t level);
+
   size_t GetLevel() const;
 
+  /**
+   * Gets the number of boards generated on the current level
+   */
+  size_t GetNumBoards() const;
+
+  /**
+   * Returns to a point where some boards of a level were already generated, making the last of them again so
+   * GetTileGrid and GetEngineSeed match
+   *
+   * @param level level to go to
+   * @param num_boards number of boards generated on the level
+   */
+  void Resume(size_t level, size_t num_boards);
+
+  /**
+   * Sets the generator to a board made ahead of time, as if it had just generated it
+   *
+   * @param level level of the board
+   * @param num_boards number of boards generated on the level, counting this one
+   * @param tiles tiles of the board in the TileGrid layout, GetBoardDimension() tiles per side
+   * @param engine_seed seed for the engine that plays the board
+   */
+  void SetBoard(size_t level, size_t num_boards, const uint8_t* tiles, uint64_t engine_seed);
+
+  /**
+   * Sets the generator to a board made ahead of time, taking over its map so chunked boards are not copied tile by tile
+   *
+   * @param level level of the board
+   * @param num_boards number of boards generated on the level, counting this one
+   * @param map board with GetBoardDimension() tiles per side
+   * @param engine_seed seed for the engine that plays the board
+   */
+  void SetBoard(size_t level, size_t num_boards, TileGrid map, uint64_t engine_seed);
+
+  uint64_t GetSeed() const;
+
+  /**
+   * Gets the number of tiles along each side of the boards this generator makes
+   */
+  size_t GetBoardDimension() const;
+
+  /**
+   * Gets the number of times the arcade board's enemies and rocks that each board gets
+   */
+  size_t GetEnemyScale() const;
+
+  /**
+   * Gets the seed for the engine that plays the last generated board, so a whole level is reproducible from the
+   * generator seed
+   */
+  uint64_t GetEngineSeed() const;
+
   vector<vector<TileType>> GetGameMap() const;
 
+  const TileGrid& GetTileGrid() const;
+
  private:
   size_t level_ = 1;
+  // Number of boards generated for the current level
+  size_t attempt_ = 0;
+  uint64_t seed_;
+  uint64_t engine_seed_ = 0;
+  Random random_;
   TileType cur_enemy = TileType::Pooka;
-  const static size_t kBoardDimension_ = 15;
+  size_t board_dimension_ = kDefaultBoardDimension;
+  size_t enemy_scale_ = 1;
   const static size_t kTunnelSize_ = 3;
-  // minimum distance between enemies
-  const static size_t kEnemyBuffer = 1;
-  vector<vector<TileType>> game_map_;
+  const static size_t kNumTunnelDirections = 2;
+  const static uint32_t kPlacementShift = 16;
+  const static uint32_t kPlacementMask = (1 << kPlacementShift) - 1;
+  // Random spots tried for an enemy or rock before searching the whole board for one that fits
+  const static size_t kMaxRandomPlacements = 64;
+  TileGrid game_map_;
+  // Tiles an enemy's tunnel cannot cover because an enemy or tunnel is next to them, in the TileGrid layout
+  vector<uint8_t> blocked_;
+  // Spots that fit the next enemy or rock when the board is searched. Kept between boards so they reuse the memory
+  vector<uint32_t> placements_;
+
+  /**
+   * Gets the random stream of a board, which is unique to its level and attempt
+   */
+  static uint64_t GetStream(size_t level, size_t attempt);
 
   /**
-   * Generates the specified number of the enemies in the map
+   * Generates the specified number of the enemies in the map. Each enemy is placed uniformly at random among every
+   * spot its tunnel fits. A few random spots are tried first, and if none fit the board is searched once for every
+   * spot that does, so generation time is bounded even when the board is nearly full. Stops early if no spot is left
    *
-   * @param num_objects number of enemies
+   * @param num_enemies number of enemies
    */
   void GenerateEnemies(size_t num_enemies);
 
   /**
-   * Generates the specified number of rocks in the map
+   * Generates the specified number of rocks in the map, each uniformly at random among the dirt tiles, in the same
+   * bounded way as the enemies
    *
    * @param num_rocks number of rocks
    */
   void GenerateRocks(size_t num_rocks);
 
   /**
-   * Checks whether the given coordinate is a good spot for an enemy
+   * Checks whether an enemy's tunnel would reach into the space kept clear around the player's starting tunnel
    *
-   * @param x_pos x position
-   * @param y_pos y position
-   * @return true if it is a good spot, false if not
+   * @param x_pos x position of the enemy
+   * @param y_pos y position of the enemy
+   * @param direction 0 for a horizontal tunnel, 1 for a vertical one
    */
-  bool IsGoodSpot(size_t x_pos, size_t y_pos) const;
+  bool IsNearPlayer(size_t x_pos, size_t y_pos, size_t direction) const;
 
   /**
-   * Checks whether given coordinate contains a fygar, pooka, or tunnel
-   *
-   * @param x_pos x position
-   * @param y_pos y position
-   * @return true if there is an enemy, false if not
+   * Checks whether none of the tiles of an enemy's tunnel are next to another enemy or tunnel
    */
-  bool IsEnemyOrTunnel(size_t x_pos, size_t y_pos) const;
+  bool IsTunnelOpen(size_t x_pos, size_t y_pos, size_t direction) const;
 
   /**
-   * Checks whether space is possible for an enemy and adds it if it is possible
-   *
-   * @param x_pos x position
-   * @param y_pos y position
-   * @param direction 0 for horizontal, 1 for vertical
-   * @return true if space possible, false if not
+   * Adds an enemy and its tunnel to the map and marks the tiles around them as blocked
+   */
+  void PlaceEnemy(size_t x_pos, size_t y_pos, size_t direction);
+
+  /**
+   * Marks the tiles that an enemy or tunnel at the given tile is next to
    */
-  bool IsSpacePossible(size_t x_pos, size_t y_pos, size_t direction);
+  void BlockAround(size_t x_pos, size_t y_pos);
+
+  static uint32_t PackPlacement(size_t x_pos, size_t y_pos, size_t direction) {
+    return (uint32_t) (x_pos << kPlacementShift | y_pos << 1 | direction);
+  }
 };
 
 } // namespace dig_dug
\ No newline at end of file
@@ -1,11 +1,13 @@
 #pragma once
 
-#include <cinder/gl/gl.h>
+#include <vector>
+#include <glm/vec2.hpp>
+
+#include "core/fixed_point.h"
 
 namespace dig_dug {
 
 using glm::vec2;
-using ci::Rectf;
 using std::vector;
 
 class Harpoon {
@@ -24,6 +26,26 @@ class Harpoon {
    */
   Harpoon(const vec2& start_pos, const vec2& velocity);
 
+  /**
+   * Initializes the harpoon with a fixed-point position
+   *
+   * @param start_pos position of player
+   * @param direction direction the harpoon is shot in
+   * @param speed fixed-point distance the harpoon moves each tick
+   */
+  Harpoon(const FixedVec2& start_pos, Direction direction, int32_t speed);
+
+  /**
+   * Initializes a harpoon with every part of its state, such as one that was stepped outside of a GameEngine
+   *
+   * @param arrow fixed-point position of the arrow
+   * @param velocity fixed-point velocity
+   * @param step_length fixed-point distance added to the distance traveled on each move
+   * @param distance_traveled fixed-point distance traveled so far
+   */
+  static Harpoon FromState(const FixedVec2& arrow, const FixedVec2& velocity, int32_t step_length,
+                           int32_t distance_traveled);
+
   /**
    * Moves the harpoon based on the velocity of it
    */
@@ -35,10 +57,19 @@ class Harpoon {
 
   vec2 GetVelocity() const;
 
+  const FixedVec2& GetFixedArrowPosition() const;
+
+  int32_t GetFixedDistanceTraveled() const;
+
+  const FixedVec2& GetFixedVelocity() const;
+
+  int32_t GetFixedStepLength() const;
+
  private:
-  vec2 arrow_;
-  vec2 velocity_;
-  double distance_traveled_ = 0;
+  FixedVec2 arrow_;
+  FixedVec2 velocity_;
+  int32_t step_length_ = 0;
+  int32_t distance_traveled_ = 0;
 };
 
-} //namespace dig_dug
\ No newline at end of file
+} //namespace dig_dug
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/latency_histogram.h"
+#include "core/player_action.h"
+
+namespace dig_dug {
+
+using std::size_t;
+
+/**
+ * Collects key presses and releases between simulation ticks and turns them into one InputFrame per tick. Holding a
+ * key repeats its action every tick, however often the operating system repeats the key, and a key tapped between
+ * two ticks still acts for one tick. When several keys are held, the one pressed last wins. A new press is sampled by
+ * the next tick, so it waits at most one tick plus the time until the next frame, and the buffer keeps how long every
+ * press waited
+ */
+class InputBuffer {
+ public:
+  /**
+   * Constructs a buffer with no keys held
+   */
+  InputBuffer() = default;
+
+  /**
+   * Records that the key of an action went down. Repeats of a key that is already held are ignored
+   *
+   * @param action action of the key
+   * @param seconds time of the press, on the same clock as Sample
+   */
+  void Press(PlayerAction action, double seconds);
+
+  /**
+   * Records that the key of an action went up
+   */
+  void Release(PlayerAction action);
+
+  /**
+   * Takes the input for the next tick
+   *
+   * @param seconds time of the tick, on the same clock as Press
+   * @return action of the newest press since the last tick, or else of the newest key still held
+   */
+  InputFrame Sample(double seconds);
+
+  /**
+   * Gets the time from each sampled press until the tick that sampled it, over the life of the buffer
+   */
+  const LatencyHistogram& GetLatencies() const;
+
+  /**
+   * Releases every key and drops presses that were not sampled
+   */
+  void Clear();
+
+  bool IsHeld(PlayerAction action) const;
+
+ private:
+  const static size_t kNumActions = 6;
+
+  // Held keys in the order they were pressed, newest last
+  PlayerAction held_[kNumActions] = {};
+  size_t num_held_ = 0;
+  // Newest press since the last sample, which acts even if its key was already released
+  PlayerAction pending_ = PlayerAction::None;
+  double pending_seconds_ = 0;
+  LatencyHistogram latencies_;
+};
+
+} // namespace dig_dug
@@ -0,0 +1,608 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// DIG_DUG_SCALAR_KERNELS forces the plain loops, for checking them against the vector versions
+#if defined(__AVX2__) && !defined(DIG_DUG_SCALAR_KERNELS)
+#define DIG_DUG_AVX2_KERNELS
+#include <immintrin.h>
+#elif (defined(__SSE2__) || defined(_M_X64)) && !defined(DIG_DUG_SCALAR_KERNELS)
+#define DIG_DUG_SSE2_KERNELS
+#include <emmintrin.h>
+#endif
+
+namespace dig_dug {
+
+using std::size_t;
+
+// Number of lanes in a LaneVector, which is the number of games the batch kernels step at once
+const size_t kLaneWidth = 8;
+
+/*
+ * Eight 32-bit integers, one per game of a batch, that the batch kernels work on together. It is one AVX2 register
+ * when the library is built with AVX2, two SSE2 registers on any other x86-64 build and a plain array everywhere
+ * else, and every operation gives exactly the same results on all three. Masks are lanes of all ones for true and
+ * all zeros for false, like the comparisons return
+ */
+struct LaneVector {
+#if defined(DIG_DUG_AVX2_KERNELS)
+  __m256i value;
+#elif defined(DIG_DUG_SSE2_KERNELS)
+  __m128i low;
+  __m128i high;
+#else
+  int32_t lanes[kLaneWidth];
+#endif
+};
+
+/**
+ * Gets the name of the instruction set the kernels were built for: "avx2", "sse2" or "scalar"
+ */
+inline const char* GetLaneKernelName() {
+#if defined(DIG_DUG_AVX2_KERNELS)
+  return "avx2";
+#elif defined(DIG_DUG_SSE2_KERNELS)
+  return "sse2";
+#else
+  return "scalar";
+#endif
+}
+
+#if defined(DIG_DUG_AVX2_KERNELS)
+
+inline LaneVector LoadLanes(const int32_t* values) {
+  return {_mm256_loadu_si256((const __m256i*) (values))};
+}
+
+inline void StoreLanes(int32_t* values, const LaneVector& lanes) {
+  _mm256_storeu_si256((__m256i*) (values), lanes.value);
+}
+
+inline LaneVector SplatLanes(int32_t value) {
+  return {_mm256_set1_epi32(value)};
+}
+
+inline LaneVector operator+(const LaneVector& left, const LaneVector& right) {
+  return {_mm256_add_epi32(left.value, right.value)};
+}
+
+inline LaneVector operator-(const LaneVector& left, const LaneVector& right) {
+  return {_mm256_sub_epi32(left.value, right.value)};
+}
+
+inline LaneVector operator&(const LaneVector& left, const LaneVector& right) {
+  return {_mm256_and_si256(left.value, right.value)};
+}
+
+inline LaneVector operator|(const LaneVector& left, const LaneVector& right) {
+  return {_mm256_or_si256(left.value, right.value)};
+}
+
+inline LaneVector operator^(const LaneVector& left, const LaneVector& right) {
+  return {_mm256_xor_si256(left.value, right.value)};
+}
+
+/**
+ * Gets the lanes of a value where a mask is false, which is ~mask & value
+ */
+inline LaneVector AndNot(const LaneVector& mask, const LaneVector& value) {
+  return {_mm256_andnot_si256(mask.value, value.value)};
+}
+
+inline LaneVector Equal(const LaneVector& left, const LaneVector& right) {
+  return {_mm256_cmpeq_epi32(left.value, right.value)};
+}
+
+inline LaneVector Greater(const LaneVector& left, const LaneVector& right) {
+  return {_mm256_cmpgt_epi32(left.value, right.value)};
+}
+
+inline LaneVector Less(const LaneVector& left, const LaneVector& right) {
+  return {_mm256_cmpgt_epi32(right.value, left.value)};
+}
+
+/**
+ * Picks each lane from the first value where the mask is true and from the second where it is false
+ */
+inline LaneVector Select(const LaneVector& mask, const LaneVector& if_true, const LaneVector& if_false) {
+  return {_mm256_blendv_epi8(if_false.value, if_true.value, mask.value)};
+}
+
+/**
+ * Gets the low 32 bits of the product of each lane
+ */
+inline LaneVector MultiplyLow(const LaneVector& left, const LaneVector& right) {
+  return {_mm256_mullo_epi32(left.value, right.value)};
+}
+
+/**
+ * Gets the high 32 bits of the 64-bit product of each lane, treating both as unsigned
+ */
+inline LaneVector MultiplyHigh(const LaneVector& left, const LaneVector& right) {
+  __m256i even = _mm256_mul_epu32(left.value, right.value);
+  __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(left.value, 32), _mm256_srli_epi64(right.value, 32));
+  const __m256i kHighWords = _mm256_set_epi32(-1, 0, -1, 0, -1, 0, -1, 0);
+  return {_mm256_or_si256(_mm256_srli_epi64(even, 32), _mm256_and_si256(odd, kHighWords))};
+}
+
+/**
+ * Gets both halves of the 64-bit product of each lane, treating both as unsigned, with half the multiplies of
+ * MultiplyHigh and MultiplyLow
+ */
+inline void MultiplyWide(const LaneVector& left, const LaneVector& right, LaneVector& high, LaneVector& low) {
+  __m256i even = _mm256_mul_epu32(left.value, right.value);
+  __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(left.value, 32), _mm256_srli_epi64(right.value, 32));
+  high.value = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+  low.value = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+}
+
+namespace lane_vector_detail {
+
+// Doubles hold every 32-bit integer and the squares and products the kernels take of them exactly, so the lanes are
+// widened to doubles four at a time for square roots and division
+
+inline __m256d GetLowDoubles(const LaneVector& lanes) {
+  return _mm256_cvtepi32_pd(_mm256_castsi256_si128(lanes.value));
+}
+
+inline __m256d GetHighDoubles(const LaneVector& lanes) {
+  return _mm256_cvtepi32_pd(_mm256_extracti128_si256(lanes.value, 1));
+}
+
+inline LaneVector TruncateDoubles(__m256d low, __m256d high) {
+  return {_mm256_inserti128_si256(_mm256_castsi128_si256(_mm256_cvttpd_epi32(low)), _mm256_cvttpd_epi32(high), 1)};
+}
+
+inline __m256d GetLengths(__m256d x, __m256d y) {
+  return _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)));
+}
+
+} // namespace lane_vector_detail
+
+/**
+ * Gets the length of the vector in each lane rounded down, like Length. It is exact while the squared length is
+ * below 2^52, where the square root of a double never rounds up to the next whole number
+ */
+inline LaneVector LengthLanes(const LaneVector& x, const LaneVector& y) {
+  using namespace lane_vector_detail;
+  return TruncateDoubles(GetLengths(GetLowDoubles(x), GetLowDoubles(y)),
+                         GetLengths(GetHighDoubles(x), GetHighDoubles(y)));
+}
+
+/**
+ * Divides each lane, rounding toward zero like integer division. Lanes divided by zero are zero, and the quotient
+ * must fit in 32 bits
+ */
+inline LaneVector DivideLanes(const LaneVector& numerator, const LaneVector& denominator) {
+  using namespace lane_vector_detail;
+  LaneVector quotient = TruncateDoubles(_mm256_div_pd(GetLowDoubles(numerator), GetLowDoubles(denominator)),
+                                        _mm256_div_pd(GetHighDoubles(numerator), GetHighDoubles(denominator)));
+  return {_mm256_andnot_si256(_mm256_cmpeq_epi32(denominator.value, _mm256_setzero_si256()), quotient.value)};
+}
+
+template <int kBits>
+inline LaneVector ShiftLeft(const LaneVector& lanes) {
+  return {_mm256_slli_epi32(lanes.value, kBits)};
+}
+
+template <int kBits>
+inline LaneVector ShiftRightArithmetic(const LaneVector& lanes) {
+  return {_mm256_srai_epi32(lanes.value, kBits)};
+}
+
+/**
+ * Shifts each lane right, filling with zeros, by the number of bits in the same lane of another value, from 0 to 31
+ */
+inline LaneVector ShiftRightByLanes(const LaneVector& lanes, const LaneVector& bits) {
+  return {_mm256_srlv_epi32(lanes.value, bits.value)};
+}
+
+/**
+ * Reads kLaneWidth bytes into the lanes, zero extended
+ */
+inline LaneVector LoadByteLanes(const uint8_t* values) {
+  return {_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*) (values)))};
+}
+
+/**
+ * Reads the byte at each lane's offset from a base. Three more bytes past every offset must be readable
+ */
+inline LaneVector GatherBytes(const uint8_t* base, const LaneVector& offsets) {
+  __m256i words = _mm256_i32gather_epi32((const int*) (base), offsets.value, 1);
+  return {_mm256_and_si256(words, _mm256_set1_epi32(0xFF))};
+}
+
+/**
+ * Gets one bit per lane of a mask, with lane 0 in the lowest bit
+ */
+inline int GetLaneBits(const LaneVector& mask) {
+  return _mm256_movemask_ps(_mm256_castsi256_ps(mask.value));
+}
+
+#elif defined(DIG_DUG_SSE2_KERNELS)
+
+inline LaneVector LoadLanes(const int32_t* values) {
+  return {_mm_loadu_si128((const __m128i*) (values)), _mm_loadu_si128((const __m128i*) (values + 4))};
+}
+
+inline void StoreLanes(int32_t* values, const LaneVector& lanes) {
+  _mm_storeu_si128((__m128i*) (values), lanes.low);
+  _mm_storeu_si128((__m128i*) (values + 4), lanes.high);
+}
+
+inline LaneVector SplatLanes(int32_t value) {
+  return {_mm_set1_epi32(value), _mm_set1_epi32(value)};
+}
+
+inline LaneVector operator+(const LaneVector& left, const LaneVector& right) {
+  return {_mm_add_epi32(left.low, right.low), _mm_add_epi32(left.high, right.high)};
+}
+
+inline LaneVector operator-(const LaneVector& left, const LaneVector& right) {
+  return {_mm_sub_epi32(left.low, right.low), _mm_sub_epi32(left.high, right.high)};
+}
+
+inline LaneVector operator&(const LaneVector& left, const LaneVector& right) {
+  return {_mm_and_si128(left.low, right.low), _mm_and_si128(left.high, right.high)};
+}
+
+inline LaneVector operator|(const LaneVector& left, const LaneVector& right) {
+  return {_mm_or_si128(left.low, right.low), _mm_or_si128(left.high, right.high)};
+}
+
+inline LaneVector operator^(const LaneVector& left, const LaneVector& right) {
+  return {_mm_xor_si128(left.low, right.low), _mm_xor_si128(left.high, right.high)};
+}
+
+inline LaneVector AndNot(const LaneVector& mask, const LaneVector& value) {
+  return {_mm_andnot_si128(mask.low, value.low), _mm_andnot_si128(mask.high, value.high)};
+}
+
+inline LaneVector Equal(const LaneVector& left, const LaneVector& right) {
+  return {_mm_cmpeq_epi32(left.low, right.low), _mm_cmpeq_epi32(left.high, right.high)};
+}
+
+inline LaneVector Greater(const LaneVector& left, const LaneVector& right) {
+  return {_mm_cmpgt_epi32(left.low, right.low), _mm_cmpgt_epi32(left.high, right.high)};
+}
+
+inline LaneVector Less(const LaneVector& left, const LaneVector& right) {
+  return {_mm_cmplt_epi32(left.low, right.low), _mm_cmplt_epi32(left.high, right.high)};
+}
+
+inline LaneVector Select(const LaneVector& mask, const LaneVector& if_true, const LaneVector& if_false) {
+  return {_mm_or_si128(_mm_and_si128(mask.low, if_true.low), _mm_andnot_si128(mask.low, if_false.low)),
+          _mm_or_si128(_mm_and_si128(mask.high, if_true.high), _mm_andnot_si128(mask.high, if_false.high))};
+}
+
+namespace lane_vector_detail {
+
+// SSE2 only multiplies the even lanes into 64-bit products, so the odd lanes are shifted down and done separately
+
+inline __m128i MultiplyLow(__m128i left, __m128i right) {
+  __m128i even = _mm_mul_epu32(left, right);
+  __m128i odd = _mm_mul_epu32(_mm_srli_epi64(left, 32), _mm_srli_epi64(right, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+inline __m128i MultiplyHigh(__m128i left, __m128i right) {
+  __m128i even = _mm_mul_epu32(left, right);
+  __m128i odd = _mm_mul_epu32(_mm_srli_epi64(left, 32), _mm_srli_epi64(right, 32));
+  const __m128i kHighWords = _mm_set_epi32(-1, 0, -1, 0);
+  return _mm_or_si128(_mm_srli_epi64(even, 32), _mm_and_si128(odd, kHighWords));
+}
+
+} // namespace lane_vector_detail
+
+inline LaneVector MultiplyLow(const LaneVector& left, const LaneVector& right) {
+  return {lane_vector_detail::MultiplyLow(left.low, right.low),
+          lane_vector_detail::MultiplyLow(left.high, right.high)};
+}
+
+inline LaneVector MultiplyHigh(const LaneVector& left, const LaneVector& right) {
+  return {lane_vector_detail::MultiplyHigh(left.low, right.low),
+          lane_vector_detail::MultiplyHigh(left.high, right.high)};
+}
+
+namespace lane_vector_detail {
+
+inline void MultiplyWide(__m128i left, __m128i right, __m128i& high, __m128i& low) {
+  __m128i even = _mm_mul_epu32(left, right);
+  __m128i odd = _mm_mul_epu32(_mm_srli_epi64(left, 32), _mm_srli_epi64(right, 32));
+  const __m128i kHighWords = _mm_set_epi32(-1, 0, -1, 0);
+  high = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_and_si128(odd, kHighWords));
+  low = _mm_or_si128(_mm_andnot_si128(kHighWords, even), _mm_slli_epi64(odd, 32));
+}
+
+// Converts the low and high pair of lanes of one register to doubles, and back
+inline __m128d GetLowDoubles(__m128i lanes) {
+  return _mm_cvtepi32_pd(lanes);
+}
+
+inline __m128d GetHighDoubles(__m128i lanes) {
+  return _mm_cvtepi32_pd(_mm_shuffle_epi32(lanes, _MM_SHUFFLE(3, 2, 3, 2)));
+}
+
+inline __m128i TruncateDoubles(__m128d low, __m128d high) {
+  return _mm_unpacklo_epi64(_mm_cvttpd_epi32(low), _mm_cvttpd_epi32(high));
+}
+
+inline __m128d GetLengths(__m128d x, __m128d y) {
+  return _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y)));
+}
+
+inline __m128i LengthLanes(__m128i x, __m128i y) {
+  return TruncateDoubles(GetLengths(GetLowDoubles(x), GetLowDoubles(y)),
+                         GetLengths(GetHighDoubles(x), GetHighDoubles(y)));
+}
+
+inline __m128i DivideLanes(__m128i numerator, __m128i denominator) {
+  __m128i quotient = TruncateDoubles(_mm_div_pd(GetLowDoubles(numerator), GetLowDoubles(denominator)),
+                                     _mm_div_pd(GetHighDoubles(numerator), GetHighDoubles(denominator)));
+  return _mm_andnot_si128(_mm_cmpeq_epi32(denominator, _mm_setzero_si128()), quotient);
+}
+
+} // namespace lane_vector_detail
+
+inline void MultiplyWide(const LaneVector& left, const LaneVector& right, LaneVector& high, LaneVector& low) {
+  lane_vector_detail::MultiplyWide(left.low, right.low, high.low, low.low);
+  lane_vector_detail::MultiplyWide(left.high, right.high, high.high, low.high);
+}
+
+inline LaneVector LengthLanes(const LaneVector& x, const LaneVector& y) {
+  return {lane_vector_detail::LengthLanes(x.low, y.low), lane_vector_detail::LengthLanes(x.high, y.high)};
+}
+
+inline LaneVector DivideLanes(const LaneVector& numerator, const LaneVector& denominator) {
+  return {lane_vector_detail::DivideLanes(numerator.low, denominator.low),
+          lane_vector_detail::DivideLanes(numerator.high, denominator.high)};
+}
+
+template <int kBits>
+inline LaneVector ShiftLeft(const LaneVector& lanes) {
+  return {_mm_slli_epi32(lanes.low, kBits), _mm_slli_epi32(lanes.high, kBits)};
+}
+
+template <int kBits>
+inline LaneVector ShiftRightArithmetic(const LaneVector& lanes) {
+  return {_mm_srai_epi32(lanes.low, kBits), _mm_srai_epi32(lanes.high, kBits)};
+}
+
+inline LaneVector ShiftRightByLanes(const LaneVector& lanes, const LaneVector& bits) {
+  // SSE2 has no per-lane shift
+  int32_t values[kLaneWidth];
+  int32_t counts[kLaneWidth];
+  StoreLanes(values, lanes);
+  StoreLanes(counts, bits);
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    values[lane] = (int32_t) ((uint32_t) (values[lane]) >> counts[lane]);
+  }
+
+  return LoadLanes(values);
+}
+
+inline LaneVector LoadByteLanes(const uint8_t* values) {
+  const __m128i kZero = _mm_setzero_si128();
+  __m128i words = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*) (values)), kZero);
+  return {_mm_unpacklo_epi16(words, kZero), _mm_unpackhi_epi16(words, kZero)};
+}
+
+inline LaneVector GatherBytes(const uint8_t* base, const LaneVector& offsets) {
+  int32_t values[kLaneWidth];
+  StoreLanes(values, offsets);
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    values[lane] = base[values[lane]];
+  }
+
+  return LoadLanes(values);
+}
+
+inline int GetLaneBits(const LaneVector& mask) {
+  return _mm_movemask_ps(_mm_castsi128_ps(mask.low)) | (_mm_movemask_ps(_mm_castsi128_ps(mask.high)) << 4);
+}
+
+#else
+
+inline LaneVector LoadLanes(const int32_t* values) {
+  LaneVector lanes;
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    lanes.lanes[lane] = values[lane];
+  }
+
+  return lanes;
+}
+
+inline void StoreLanes(int32_t* values, const LaneVector& lanes) {
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    values[lane] = lanes.lanes[lane];
+  }
+}
+
+inline LaneVector SplatLanes(int32_t value) {
+  LaneVector lanes;
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    lanes.lanes[lane] = value;
+  }
+
+  return lanes;
+}
+
+namespace lane_vector_detail {
+
+/**
+ * Applies an operation to the same lane of two values. Arithmetic is done on unsigned values so it wraps around
+ * like the vector instructions instead of overflowing
+ */
+template <typename Operation>
+inline LaneVector ForEachLane(const LaneVector& left, const LaneVector& right, Operation operation) {
+  LaneVector result;
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    result.lanes[lane] = (int32_t) (operation(left.lanes[lane], right.lanes[lane]));
+  }
+
+  return result;
+}
+
+} // namespace lane_vector_detail
+
+inline LaneVector operator+(const LaneVector& left, const LaneVector& right) {
+  return lane_vector_detail::ForEachLane(left, right, [](int32_t a, int32_t b) { return (uint32_t) (a) + b; });
+}
+
+inline LaneVector operator-(const LaneVector& left, const LaneVector& right) {
+  return lane_vector_detail::ForEachLane(left, right, [](int32_t a, int32_t b) { return (uint32_t) (a) - b; });
+}
+
+inline LaneVector operator&(const LaneVector& left, const LaneVector& right) {
+  return lane_vector_detail::ForEachLane(left, right, [](int32_t a, int32_t b) { return a & b; });
+}
+
+inline LaneVector operator|(const LaneVector& left, const LaneVector& right) {
+  return lane_vector_detail::ForEachLane(left, right, [](int32_t a, int32_t b) { return a | b; });
+}
+
+inline LaneVector operator^(const LaneVector& left, const LaneVector& right) {
+  return lane_vector_detail::ForEachLane(left, right, [](int32_t a, int32_t b) { return a ^ b; });
+}
+
+inline LaneVector AndNot(const LaneVector& mask, const LaneVector& value) {
+  return lane_vector_detail::ForEachLane(mask, value, [](int32_t a, int32_t b) { return ~a & b; });
+}
+
+inline LaneVector Equal(const LaneVector& left, const LaneVector& right) {
+  return lane_vector_detail::ForEachLane(left, right, [](int32_t a, int32_t b) { return a == b ? -1 : 0; });
+}
+
+inline LaneVector Greater(const LaneVector& left, const LaneVector& right) {
+  return lane_vector_detail::ForEachLane(left, right, [](int32_t a, int32_t b) { return a > b ? -1 : 0; });
+}
+
+inline LaneVector Less(const LaneVector& left, const LaneVector& right) {
+  return lane_vector_detail::ForEachLane(left, right, [](int32_t a, int32_t b) { return a < b ? -1 : 0; });
+}
+
+inline LaneVector Select(const LaneVector& mask, const LaneVector& if_true, const LaneVector& if_false) {
+  LaneVector result;
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    result.lanes[lane] = mask.lanes[lane] != 0 ? if_true.lanes[lane] : if_false.lanes[lane];
+  }
+
+  return result;
+}
+
+inline LaneVector MultiplyLow(const LaneVector& left, const LaneVector& right) {
+  return lane_vector_detail::ForEachLane(left, right, [](int32_t a, int32_t b) {
+    return (uint32_t) (a) * (uint32_t) (b);
+  });
+}
+
+inline LaneVector MultiplyHigh(const LaneVector& left, const LaneVector& right) {
+  return lane_vector_detail::ForEachLane(left, right, [](int32_t a, int32_t b) {
+    return (uint32_t) (((uint64_t) ((uint32_t) (a)) * (uint32_t) (b)) >> 32);
+  });
+}
+
+inline void MultiplyWide(const LaneVector& left, const LaneVector& right, LaneVector& high, LaneVector& low) {
+  high = MultiplyHigh(left, right);
+  low = MultiplyLow(left, right);
+}
+
+inline LaneVector LengthLanes(const LaneVector& x, const LaneVector& y) {
+  // Squares in doubles like the vector versions, so every build rounds the same way
+  return lane_vector_detail::ForEachLane(x, y, [](int32_t a, int32_t b) {
+    return (int32_t) (std::sqrt((double) (a) * a + (double) (b) * b));
+  });
+}
+
+inline LaneVector DivideLanes(const LaneVector& numerator, const LaneVector& denominator) {
+  return lane_vector_detail::ForEachLane(numerator, denominator, [](int32_t a, int32_t b) {
+    return b != 0 ? a / b : 0;
+  });
+}
+
+template <int kBits>
+inline LaneVector ShiftLeft(const LaneVector& lanes) {
+  return lane_vector_detail::ForEachLane(lanes, lanes, [](int32_t a, int32_t) { return (uint32_t) (a) << kBits; });
+}
+
+template <int kBits>
+inline LaneVector ShiftRightArithmetic(const LaneVector& lanes) {
+  // Right shifts of negative values fill with ones on every compiler this builds with
+  return lane_vector_detail::ForEachLane(lanes, lanes, [](int32_t a, int32_t) { return a >> kBits; });
+}
+
+inline LaneVector ShiftRightByLanes(const LaneVector& lanes, const LaneVector& bits) {
+  return lane_vector_detail::ForEachLane(lanes, bits, [](int32_t a, int32_t b) { return (uint32_t) (a) >> b; });
+}
+
+inline LaneVector LoadByteLanes(const uint8_t* values) {
+  LaneVector lanes;
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    lanes.lanes[lane] = values[lane];
+  }
+
+  return lanes;
+}
+
+inline LaneVector GatherBytes(const uint8_t* base, const LaneVector& offsets) {
+  LaneVector result;
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    result.lanes[lane] = base[offsets.lanes[lane]];
+  }
+
+  return result;
+}
+
+inline int GetLaneBits(const LaneVector& mask) {
+  int bits = 0;
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    bits |= (mask.lanes[lane] < 0 ? 1 : 0) << lane;
+  }
+
+  return bits;
+}
+
+#endif
+
+/**
+ * Checks whether a mask is true in any lane
+ */
+inline bool IsAnyLane(const LaneVector& mask) {
+  return GetLaneBits(mask) != 0;
+}
+
+/**
+ * Checks whether two values differ in each lane
+ */
+inline LaneVector NotEqual(const LaneVector& left, const LaneVector& right) {
+  return AndNot(Equal(left, right), SplatLanes(-1));
+}
+
+/**
+ * Gets the absolute value of each lane. The most negative value stays as it is
+ */
+inline LaneVector AbsLanes(const LaneVector& lanes) {
+  LaneVector sign = ShiftRightArithmetic<31>(lanes);
+  return (lanes ^ sign) - sign;
+}
+
+/**
+ * Compares the lanes as unsigned values
+ */
+inline LaneVector LessUnsigned(const LaneVector& left, const LaneVector& right) {
+  const LaneVector kSignBit = SplatLanes(INT32_MIN);
+  return Less(left ^ kSignBit, right ^ kSignBit);
+}
+
+/**
+ * Gets the lane numbers 0 to kLaneWidth - 1
+ */
+inline LaneVector GetLaneIndices() {
+  const int32_t kIndices[kLaneWidth] = {0, 1, 2, 3, 4, 5, 6, 7};
+  return LoadLanes(kIndices);
+}
+
+} // namespace dig_dug
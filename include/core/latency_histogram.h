@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dig_dug {
+
+using std::size_t;
+using std::vector;
+
+/**
+ * Counts durations in buckets that are at most about 3% wide at any scale, so percentiles of millions of samples
+ * take a few kilobytes instead of a copy of every sample. Durations below kNumSubBuckets get a bucket each
+ */
+class LatencyHistogram {
+ public:
+  /**
+   * Constructs an empty histogram
+   */
+  LatencyHistogram();
+
+  /**
+   * Adds a sample
+   *
+   * @param nanoseconds duration of the sample
+   */
+  void Add(uint64_t nanoseconds);
+
+  /**
+   * Adds every sample of another histogram
+   */
+  void Merge(const LatencyHistogram& other);
+
+  size_t GetCount() const;
+
+  uint64_t GetMax() const;
+
+  /**
+   * Gets a duration that at least a fraction of the samples were no longer than, which is the top of the bucket
+   * holding that sample, or the longest sample if that is shorter
+   *
+   * @param fraction from 0 to 1, like 0.99 for the 99th percentile
+   * @return duration in nanoseconds, or 0 if there are no samples
+   */
+  uint64_t GetPercentile(double fraction) const;
+
+ private:
+  // Each power of two is split into this many buckets
+  const static size_t kSubBucketBits = 5;
+  const static uint64_t kNumSubBuckets = 1 << kSubBucketBits;
+
+  vector<uint64_t> counts_;
+  size_t count_ = 0;
+  uint64_t max_ = 0;
+
+  static size_t GetBucket(uint64_t nanoseconds);
+
+  /**
+   * Gets the longest duration that falls in a bucket
+   */
+  static uint64_t GetBucketTop(size_t bucket);
+};
+
+} // namespace dig_dug
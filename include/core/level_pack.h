@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "core/board_source.h"
+#include "core/game_state_generator.h"
+#include "core/mapped_file.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::string;
+
+/**
+ * Start of a level pack file. The header is followed by one fixed-size record per board, ordered by seed, then level,
+ * then board number, so any board is found with one multiplication. A record is the engine seed as 8 little-endian
+ * bytes, then the tiles in the TileGrid layout at 4 bits each, with the even tiles in the low bits
+ */
+struct LevelPackHeader {
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  // kLevelPackByteOrder as written, which reads differently on a machine with the other byte order
+  uint32_t byte_order = 0;
+  uint32_t board_dimension = 0;
+  uint64_t first_seed = 0;
+  uint64_t num_seeds = 0;
+  // The pack holds levels 1 to num_levels, and boards 1 to boards_per_level of each
+  uint32_t num_levels = 0;
+  uint32_t boards_per_level = 0;
+  uint32_t record_size = 0;
+  uint32_t reserved = 0;
+};
+
+const uint32_t kLevelPackMagic = 0x504C4444;  // "DDLP"
+// Goes up whenever the record layout or the boards the generator makes change
+const uint32_t kLevelPackVersion = 1;
+const uint32_t kLevelPackByteOrder = 0x01020304;
+
+/**
+ * Boards generated ahead of time and stored in a memory-mapped file, for runs that play many games and should not
+ * spend time generating boards. Only the pages of the boards that are played are read. Packs are read-only, so one
+ * pack can serve sessions on any number of threads. Packs are built by BuildLevelPack
+ */
+class LevelPack : public BoardSource {
+ public:
+  // Largest boards a pack can hold
+  const static size_t kMaxDimension = 64;
+
+  /**
+   * Opens a level pack
+   *
+   * @throws std::runtime_error if the file cannot be read or is not a level pack this build can use
+   */
+  explicit LevelPack(const string& path);
+
+  /**
+   * Does nothing, since every board in the pack is always ready
+   */
+  void Prepare(uint64_t seed, size_t level, size_t num_boards) override;
+
+  /**
+   * Gives the generator a board from the pack, if the pack has it. Packs hold boards with the default enemy scale, so
+   * generators with another scale make their own
+   */
+  bool TakeBoard(uint64_t seed, size_t level, size_t num_boards, GameStateGenerator& generator) override;
+
+  /**
+   * Checks whether the pack has a board
+   *
+   * @param num_boards number of the board within its level, starting at 1
+   */
+  bool Contains(uint64_t seed, size_t level, size_t num_boards) const;
+
+  const LevelPackHeader& GetHeader() const;
+
+  /**
+   * Gets the number of boards in the pack
+   */
+  size_t Size() const;
+
+  /**
+   * Gets the size of one record for boards of a dimension
+   */
+  static size_t GetRecordSize(size_t dimension);
+
+  /**
+   * Gets the position of a board in a pack
+   */
+  static size_t GetRecordIndex(const LevelPackHeader& header, uint64_t seed, size_t level, size_t num_boards);
+
+  /**
+   * Writes the board a generator last made into a record
+   *
+   * @param generator generator that just generated the board
+   * @param record GetRecordSize bytes to write to
+   */
+  static void EncodeBoard(const GameStateGenerator& generator, uint8_t* record);
+
+ private:
+  const static uint8_t kTileMask = 0xF;
+  const static size_t kTileBits = 4;
+
+  MappedFile file_;
+  LevelPackHeader header_;
+  const uint8_t* records_ = nullptr;
+};
+
+} // namespace dig_dug
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dig_dug {
+
+using std::size_t;
+using std::string;
+
+/**
+ * Read-only view of a whole file. On POSIX systems the file is memory-mapped, so opening it is cheap and only the
+ * pages that are read get loaded. Elsewhere the file is read into memory
+ */
+class MappedFile {
+ public:
+  /**
+   * Constructs a view of no file
+   */
+  MappedFile() = default;
+
+  /**
+   * Opens a file
+   *
+   * @param path path of the file
+   * @throws std::runtime_error if the file cannot be opened or mapped
+   */
+  explicit MappedFile(const string& path);
+
+  MappedFile(const MappedFile& other) = delete;
+
+  MappedFile& operator=(const MappedFile& other) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  ~MappedFile();
+
+  const uint8_t* GetData() const;
+
+  size_t GetSize() const;
+
+ private:
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  // Holds the file on systems without memory mapping
+  std::vector<uint8_t> buffer_;
+
+  /**
+   * Unmaps the file, leaving a view of no file
+   */
+  void Close();
+};
+
+} // namespace dig_dug
@@ -1,6 +1,8 @@
 #pragma once
 
-#include <cinder/gl/gl.h>
+#include <glm/vec2.hpp>
+
+#include "core/fixed_point.h"
 
 namespace dig_dug {
 
@@ -23,22 +25,46 @@ class Player {
    */
   Player(const vec2& position);
 
+  /**
+   * Initializes a player at the specified fixed-point coordinate
+   */
+  static Player AtFixedPosition(const FixedVec2& position);
+
+  /**
+   * Initializes a player with every part of its state, such as one that was stepped outside of a GameEngine
+   *
+   * @param position fixed-point position
+   * @param prev_velocity fixed-point velocity of the last move
+   * @param orientation way the player faces
+   */
+  static Player FromState(const FixedVec2& position, const FixedVec2& prev_velocity,
+                          CharacterOrientation orientation);
+
   /**
    * Moves the player using the specified velocity
    */
   void Move(const vec2& velocity);
 
+  /**
+   * Moves the player using the specified fixed-point velocity
+   */
+  void MoveFixed(const FixedVec2& velocity);
+
   vec2 GetPosition() const;
 
   vec2 GetPrevVelocity() const;
 
+  const FixedVec2& GetFixedPosition() const;
+
+  const FixedVec2& GetFixedPrevVelocity() const;
+
   CharacterOrientation GetOrientation() const;
 
  private:
-  constexpr static double kSpeed = 5;
-  vec2 position_;
-  vec2 prev_velocity_ {kSpeed, 0};
+  const static int32_t kSpeed = 5 * kFixedOne;
+  FixedVec2 position_;
+  FixedVec2 prev_velocity_ {kSpeed, 0};
   CharacterOrientation orientation_ = CharacterOrientation::Right;
 };
 
-} // namespace dig_dug
\ No newline at end of file
+} // namespace dig_dug
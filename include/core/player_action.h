@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+#include "core/game_engine.h"
+
+namespace dig_dug {
+
+/**
+ * One frame of input, matching the keys of the game
+ */
+enum class PlayerAction : uint8_t {
+  None,
+  Right,
+  Down,
+  Left,
+  Up,
+  Attack
+};
+
+/**
+ * Input for one simulation tick. Human input, bots and replays all drive the game with one of these per tick, so a
+ * game plays out the same way however its input was made
+ */
+struct InputFrame {
+  PlayerAction action = PlayerAction::None;
+  // Seconds from the key press that made this action until the tick that sampled it, or 0 if the action was not a
+  // new press
+  double latency_seconds = 0;
+
+  InputFrame() = default;
+
+  explicit InputFrame(PlayerAction action_value, double latency_seconds_value = 0)
+      : action(action_value), latency_seconds(latency_seconds_value) {}
+};
+
+/**
+ * Applies an action to the engine the same way the game applies a key press
+ */
+void ApplyAction(GameEngine& engine, PlayerAction action);
+
+} // namespace dig_dug
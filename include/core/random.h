@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dig_dug {
+
+/**
+ * Counter-based random number generator using Philox4x32-10. Every output is a pure function of the seed, the stream
+ * and the position within the stream, so a generator can jump straight to any stream or position, and two generators
+ * never share state. Seeded runs give the same numbers on every platform, on any thread
+ */
+class Random {
+ public:
+  /**
+   * Creates a generator at the start of a stream
+   *
+   * @param seed key shared by all streams of one run
+   * @param stream independent sequence to draw from, such as a level number
+   */
+  explicit Random(uint64_t seed = 0, uint64_t stream = 0);
+
+  /**
+   * Gets the next 32 random bits
+   */
+  uint32_t Next();
+
+  /**
+   * Gets a random number from 0 up to, but not including, the bound
+   *
+   * @param bound number of possible values, which must not be 0
+   */
+  uint32_t NextBelow(uint32_t bound);
+
+  /**
+   * Jumps to a position in the current stream, counted in outputs of Next()
+   */
+  void Seek(uint64_t position);
+
+  /**
+   * Jumps to the start of another stream with the same seed
+   */
+  void SetStream(uint64_t stream);
+
+  uint64_t GetPosition() const;
+
+  uint64_t GetSeed() const;
+
+  uint64_t GetStream() const;
+
+  bool operator==(const Random& other) const;
+
+  bool operator!=(const Random& other) const;
+
+  /**
+   * Runs the Philox4x32-10 bijection on one 128-bit counter block
+   *
+   * @param counter four counter words, replaced by the four output words
+   * @param key two key words
+   */
+  static void Philox(uint32_t counter[4], const uint32_t key[2]);
+
+  // Philox4x32 multipliers and Weyl sequence key increments from Salmon et al. 2011, public so the batch kernels can
+  // run the same rounds across many streams at once
+  const static uint32_t kPhiloxMultiplier0 = 0xD2511F53;
+  const static uint32_t kPhiloxMultiplier1 = 0xCD9E8D57;
+  const static uint32_t kPhiloxKeyIncrement0 = 0x9E3779B9;
+  const static uint32_t kPhiloxKeyIncrement1 = 0xBB67AE85;
+  const static size_t kPhiloxRounds = 10;
+  // Number of outputs of each counter block
+  const static size_t kBlockSize = 4;
+
+ private:
+  uint64_t seed_;
+  uint64_t stream_;
+  // Index of the next block of outputs in the stream
+  uint64_t block_ = 0;
+  uint32_t outputs_[kBlockSize] = {};
+  // Number of outputs of the current block that have been used
+  size_t output_index_ = kBlockSize;
+
+  /**
+   * Generates the outputs of the next block and advances to it
+   */
+  void GenerateBlock();
+};
+
+} // namespace dig_dug
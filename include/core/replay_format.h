@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/session_snapshot.h"
+
+namespace dig_dug {
+
+/**
+ * Layout of replay files, which ReplayWriter writes and ReplayReader reads. Integers are little-endian.
+ *
+ * Header, kReplayHeaderSize bytes: kReplayMagic, format version, size of a SessionSnapshot and a reserved zero (32
+ * bits each), seed (64 bits), then starting level, tile size, keyframe interval K, board dimension and enemy scale (32
+ * bits each).
+ *
+ * Inputs: one varint per run of ticks with the same action, holding the run length shifted left by
+ * kReplayActionBits with the action in the low bits. Held keys make long runs, so most games take a few bytes per
+ * second of play. Runs are cut at every keyframe, so playback can start decoding at any keyframe.
+ *
+ * Keyframes, one every K ticks starting at tick 0: offset of the keyframe's first run from the start of the inputs
+ * and hash of the session state (64 bits each), then the SessionSnapshot as raw bytes. Snapshots are copied as they
+ * are laid out in memory, so files only load in builds with the same snapshot size, which the header records.
+ *
+ * Footer, kReplayFooterSize bytes: number of ticks, hash of the final state and offset of the first keyframe (64
+ * bits each), number of keyframes (32 bits) and kReplayEndMagic
+ */
+const uint32_t kReplayMagic = 0x50524444;  // "DDRP"
+const uint32_t kReplayEndMagic = 0x45524444;  // "DDRE"
+const uint32_t kReplayVersion = 3;
+const size_t kReplayHeaderSize = 4 * 4 + 8 + 4 * 5;
+const size_t kReplayFooterSize = 8 * 3 + 4 * 2;
+const size_t kReplayKeyframeSize = 8 * 2 + sizeof(SessionSnapshot);
+const uint32_t kReplayActionBits = 3;
+const uint32_t kReplayActionMask = (1 << kReplayActionBits) - 1;
+
+} // namespace dig_dug
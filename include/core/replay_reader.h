@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "core/game_session.h"
+#include "core/mapped_file.h"
+#include "core/player_action.h"
+#include "core/replay_format.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::string;
+
+/**
+ * Plays back a replay written by ReplayWriter as fast as the simulation runs. The file is memory-mapped, so only
+ * the parts that are played get read. Seeking restores the keyframe at or before the target tick and plays at most
+ * K - 1 ticks from there. Every keyframe passed and the end of the replay are checked against the recorded state
+ * hashes, so a change to the simulation that would make old replays play differently is caught
+ */
+class ReplayReader {
+ public:
+  /**
+   * Opens a replay file
+   *
+   * @throws std::runtime_error if the file cannot be read or is not a replay this build can play
+   */
+  explicit ReplayReader(const string& path);
+
+  /**
+   * Reads a replay from memory, which has to outlive the reader
+   *
+   * @throws std::runtime_error if the data is not a replay this build can play
+   */
+  ReplayReader(const uint8_t* data, size_t size);
+
+  /**
+   * Starts the recorded game from its seed and plays the whole replay
+   *
+   * @param session session to play in, which is replaced
+   * @throws std::runtime_error if the game does not play out the way it was recorded
+   */
+  void Play(GameSession& session);
+
+  /**
+   * Moves playback to a tick, restoring the nearest keyframe at or before it
+   *
+   * @param session session to play in, which is replaced
+   * @param tick number of ticks into the replay, up to GetNumTicks()
+   * @throws std::out_of_range if the tick is past the end
+   * @throws std::runtime_error if the game does not play out the way it was recorded
+   */
+  void Seek(GameSession& session, size_t tick);
+
+  /**
+   * Plays ticks on from the current tick
+   *
+   * @param session session that was last passed to Play or Seek
+   * @param num_ticks number of ticks to play
+   * @throws std::out_of_range if that goes past the end
+   * @throws std::runtime_error if the game does not play out the way it was recorded
+   */
+  void Advance(GameSession& session, size_t num_ticks);
+
+  /**
+   * Gets the number of ticks played so far
+   */
+  size_t GetTick() const;
+
+  size_t GetNumTicks() const;
+
+  uint64_t GetSeed() const;
+
+  size_t GetLevel() const;
+
+  size_t GetTileSize() const;
+
+  /**
+   * Gets the number of tiles along each side of the boards the game was played on
+   */
+  size_t GetBoardDimension() const;
+
+  /**
+   * Gets the number of times the arcade board's enemies and rocks that the boards of the game had
+   */
+  size_t GetEnemyScale() const;
+
+  size_t GetKeyframeInterval() const;
+
+  size_t GetNumKeyframes() const;
+
+ private:
+  MappedFile file_;
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+
+  uint64_t seed_ = 0;
+  size_t level_ = 0;
+  size_t tile_size_ = 0;
+  size_t board_dimension_ = 0;
+  size_t enemy_scale_ = 0;
+  size_t keyframe_interval_ = 0;
+  size_t num_ticks_ = 0;
+  uint64_t final_hash_ = 0;
+  size_t keyframes_offset_ = 0;
+  size_t num_keyframes_ = 0;
+
+  // Playback position, with the offset of the next run in the inputs
+  size_t tick_ = 0;
+  size_t input_offset_ = 0;
+  PlayerAction run_action_ = PlayerAction::None;
+  size_t run_left_ = 0;
+
+  /**
+   * Reads the header and footer and checks that they fit together
+   */
+  void Parse();
+
+  /**
+   * Reads a keyframe's input offset and state hash, and optionally its snapshot
+   */
+  void ReadKeyframe(size_t keyframe, size_t& input_offset, uint64_t& hash, SessionSnapshot* snapshot) const;
+
+  /**
+   * Throws if the session's state does not have the recorded hash
+   */
+  void Verify(const GameSession& session, uint64_t hash) const;
+};
+
+} // namespace dig_dug
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/game_session.h"
+#include "core/player_action.h"
+#include "core/replay_format.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+/**
+ * Records a game as its seed, starting level and the input of every tick, with a snapshot of the whole session every
+ * K ticks so playback can jump into the middle of the game. The format is described in replay_format.h
+ */
+class ReplayWriter {
+ public:
+  // Ten seconds of play at the default tick rate
+  const static size_t kDefaultKeyframeInterval = 600;
+
+  /**
+   * Starts recording a session that was just started and has not ticked yet
+   *
+   * @param session session to record
+   * @param keyframe_interval number of ticks between keyframes
+   * @throws std::invalid_argument if the session has already ticked or the interval is zero
+   */
+  explicit ReplayWriter(const GameSession& session, size_t keyframe_interval = kDefaultKeyframeInterval);
+
+  /**
+   * Records the input of the next tick. Call this right before passing the input to GameSession::Update, for every
+   * update
+   *
+   * @param session recorded session, before the update
+   * @param input input of the tick
+   */
+  void Record(const GameSession& session, const InputFrame& input);
+
+  /**
+   * Finishes the recording with the final state of the session
+   *
+   * @param session recorded session, after the last update
+   * @return contents of the replay file
+   */
+  const vector<uint8_t>& Finish(const GameSession& session);
+
+  /**
+   * Finishes the recording and writes it to a file
+   *
+   * @throws std::runtime_error if the file cannot be written
+   */
+  void Save(const string& path, const GameSession& session);
+
+  size_t GetNumTicks() const;
+
+ private:
+  vector<uint8_t> bytes_;
+  vector<uint8_t> keyframes_;
+  size_t keyframe_interval_;
+  size_t num_ticks_ = 0;
+  size_t num_keyframes_ = 0;
+  PlayerAction run_action_ = PlayerAction::None;
+  size_t run_length_ = 0;
+
+  /**
+   * Ends the run of equal inputs being recorded
+   */
+  void FlushRun();
+
+  /**
+   * Adds a keyframe for the current tick
+   */
+  void AddKeyframe(const GameSession& session);
+};
+
+} // namespace dig_dug
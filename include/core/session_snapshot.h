@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "core/engine_snapshot.h"
+
+namespace dig_dug {
+
+/**
+ * Complete state of a GameSession, in one fixed-size block with no pointers like EngineSnapshot. The board generator
+ * is kept as its seed, level, number of boards made on the level and enemy scale, which is all it needs to make the
+ * same boards
+ */
+struct SessionSnapshot {
+  EngineSnapshot engine;
+  uint64_t seed = 0;
+  uint64_t level = 0;
+  uint64_t num_boards = 0;
+  uint64_t enemy_scale = 0;
+  uint64_t num_ticks = 0;
+  uint64_t live_lost_num_frames = 0;
+  bool is_game_over = false;
+};
+
+static_assert(std::is_trivially_copyable<SessionSnapshot>::value, "Snapshots must be copyable as plain bytes");
+
+} // namespace dig_dug
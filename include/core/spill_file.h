@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dig_dug {
+
+using std::size_t;
+using std::string;
+
+/**
+ * Scratch space for data that does not have to stay in memory, backed by a temporary file mapped for reading and
+ * writing. The file is removed from its folder as soon as it is mapped, so it goes away with the mapping. The
+ * operating system writes pages back to the file and drops them from memory as it needs, and Release drops them
+ * right away. On systems without memory mapping the space is kept in memory
+ */
+class SpillFile {
+ public:
+  /**
+   * Creates the file
+   *
+   * @param directory folder to create the file in
+   * @param size size of the file, which takes no disk space until it is written
+   * @throws std::runtime_error if the file cannot be created or mapped
+   */
+  SpillFile(const string& directory, size_t size);
+
+  SpillFile(const SpillFile& other) = delete;
+
+  SpillFile& operator=(const SpillFile& other) = delete;
+
+  ~SpillFile();
+
+  uint8_t* GetData() {
+    return data_;
+  }
+
+  const uint8_t* GetData() const {
+    return data_;
+  }
+
+  size_t GetSize() const;
+
+  /**
+   * Drops the pages holding a range of the file from memory. Their contents stay in the file, and reading them loads
+   * them again
+   */
+  void Release(size_t offset, size_t size);
+
+ private:
+  uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  // Holds the space on systems without memory mapping
+  std::vector<uint8_t> buffer_;
+};
+
+} // namespace dig_dug
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dig_dug {
+
+using std::size_t;
+
+/**
+ * 64-bit FNV-1a hash of game state, built up one value at a time. Values are hashed as little-endian bytes and never
+ * through the padding of structs, so equal states hash the same on every platform
+ */
+class StateHash {
+ public:
+  StateHash() = default;
+
+  /**
+   * Adds a run of bytes to the hash
+   */
+  void Add(const uint8_t* data, size_t size);
+
+  /**
+   * Adds an integer to the hash as 8 bytes, whatever its type was
+   */
+  void Add(uint64_t value);
+
+  uint64_t Get() const;
+
+ private:
+  const static uint64_t kOffsetBasis = 0xCBF29CE484222325;
+  const static uint64_t kPrime = 0x100000001B3;
+  const static size_t kBitsPerByte = 8;
+
+  uint64_t hash_ = kOffsetBasis;
+};
+
+} // namespace dig_dug
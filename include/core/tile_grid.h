@@ -0,0 +1,299 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dig_dug {
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+enum class TileType : uint8_t {
+  Dirt,
+  Tunnel,
+  Player,
+  Fygar,
+  Pooka,
+  Ghost,
+  Rock,
+};
+
+/**
+ * One tile of a map that changed, and the type it changed to
+ */
+struct TileChange {
+  uint16_t x;
+  uint16_t y;
+  TileType type;
+};
+
+/**
+ * How a TileGrid keeps its tiles
+ */
+enum class TileStorage {
+  // One byte per tile in one buffer
+  Dense,
+  // Square chunks of tiles, where chunks that are all the fill type take no memory
+  Chunked
+};
+
+class SpillFile;
+class StateHash;
+
+/**
+ * Square game map with a byte per tile. Tiles are addressed with [x][y] like the rest of the game, so the tiles of one
+ * x value are next to each other in memory.
+ *
+ * Small grids keep every tile in one contiguous row-major buffer. Large grids are split into chunks of
+ * kChunkDimension tiles per side instead. Chunks that still hold nothing but the fill type are implicit, and the rest
+ * come from a pool, so memory follows the part of the map that was changed rather than its area. Chunked grids can
+ * also spill chunks that were not written to for a while into a memory-mapped file. Tile queries pick the layout
+ * with one branch, so neither layout costs a call through a pointer
+ */
+class TileGrid {
+ public:
+  // Grids with more tiles per side than this are chunked unless asked otherwise
+  const static size_t kMaxDenseDimension = 256;
+  const static size_t kChunkShift = 5;
+  const static size_t kChunkDimension = 1 << kChunkShift;
+  const static size_t kChunkTiles = kChunkDimension * kChunkDimension;
+
+  /**
+   * Constructs an empty grid
+   */
+  TileGrid();
+
+  /**
+   * Constructs a grid with every tile set to the same type, chunked if it has more than kMaxDenseDimension tiles per
+   * side
+   *
+   * @param dimension number of tiles along each side
+   * @param fill type of every tile
+   */
+  TileGrid(size_t dimension, TileType fill);
+
+  /**
+   * Constructs a grid with every tile set to the same type, stored a given way
+   *
+   * @param dimension number of tiles along each side
+   * @param fill type of every tile
+   * @param storage how to keep the tiles
+   */
+  TileGrid(size_t dimension, TileType fill, TileStorage storage);
+
+  /**
+   * Copies a nested [x][y] map into a grid
+   *
+   * @param tiles square map of tiles
+   */
+  explicit TileGrid(const vector<vector<TileType>>& tiles);
+
+  /**
+   * Copies a grid. Chunks the other grid spilled are copied into memory, and the copy does not spill until asked to
+   */
+  TileGrid(const TileGrid& other);
+
+  TileGrid& operator=(const TileGrid& other);
+
+  TileGrid(TileGrid&& other) noexcept;
+
+  TileGrid& operator=(TileGrid&& other) noexcept;
+
+  ~TileGrid();
+
+  /**
+   * Gets the tile at the given coordinate
+   *
+   * @throws std::out_of_range if the coordinate is not on the board
+   */
+  TileType Get(size_t x, size_t y) const;
+
+  /**
+   * Sets the tile at the given coordinate
+   *
+   * @throws std::out_of_range if the coordinate is not on the board
+   */
+  void Set(size_t x, size_t y, TileType type);
+
+  /**
+   * Gets the tile at the given coordinate without checking that it is on the board
+   */
+  TileType GetUnchecked(size_t x, size_t y) const {
+    if (!is_chunked_) {
+      return static_cast<TileType>(tiles_[x * dimension_ + y]);
+    }
+
+    size_t chunk = GetChunkIndex(x, y);
+    uint32_t entry = chunk_table_[chunk];
+    if (entry == kImplicitChunk) {
+      return fill_;
+    }
+
+    return static_cast<TileType>(GetChunkTiles(chunk, entry)[GetTileInChunk(x, y)]);
+  }
+
+  /**
+   * Sets the tile at the given coordinate without checking that it is on the board
+   */
+  void SetUnchecked(size_t x, size_t y, TileType type) {
+    if (!is_chunked_) {
+      tiles_[x * dimension_ + y] = static_cast<uint8_t>(type);
+    } else {
+      SetChunkedTile(x, y, type);
+    }
+  }
+
+  bool IsInBounds(size_t x, size_t y) const;
+
+  size_t GetDimension() const;
+
+  size_t GetNumTiles() const;
+
+  TileStorage GetStorage() const;
+
+  /**
+   * Checks whether a tile is in a chunk that takes no memory, in which case every tile of that chunk is the fill
+   * type. Always false for dense grids
+   */
+  bool IsImplicit(size_t x, size_t y) const {
+    return is_chunked_ && chunk_table_[GetChunkIndex(x, y)] == kImplicitChunk;
+  }
+
+  /**
+   * Gets the tiles of a dense grid in one buffer, in the [x][y] row-major layout
+   *
+   * @return tiles, or nullptr for a chunked grid, which has no such buffer
+   */
+  const uint8_t* GetData() const;
+
+  /**
+   * Copies every tile out of the grid in the dense layout of GetData, whichever way the grid is stored
+   *
+   * @param tiles buffer of GetNumTiles() tiles
+   */
+  void CopyData(uint8_t* tiles) const;
+
+  /**
+   * Copies GetNumTiles() tiles into the grid, in the dense layout of GetData
+   */
+  void SetData(const uint8_t* tiles);
+
+  /**
+   * Sets every tile to the same type, keeping the grid's size and memory. Chunked grids give back every chunk
+   */
+  void Fill(TileType type);
+
+  /**
+   * Spills chunks of a chunked grid into a temporary file once more than a number of chunks are in memory. The chunks
+   * that were written to longest ago go first, and are read from the file in place until they are written again
+   *
+   * @param directory folder for the file
+   * @param max_resident_chunks number of chunks to keep in memory
+   * @throws std::invalid_argument if the grid is not chunked or no chunks may stay in memory
+   * @throws std::runtime_error if the file cannot be created
+   */
+  void SpillTo(const string& directory, size_t max_resident_chunks);
+
+  /**
+   * Gets the number of chunks of a chunked grid in memory, which is 0 for dense grids
+   */
+  size_t GetNumResidentChunks() const;
+
+  /**
+   * Gets the number of chunks of a chunked grid that are in the spill file
+   */
+  size_t GetNumSpilledChunks() const;
+
+  /**
+   * Gets the number of bytes the tiles take in memory, not counting spilled chunks
+   */
+  size_t GetMemoryUsage() const;
+
+  /**
+   * Adds the tiles to a hash. Grids with the same tiles and storage hash the same, whichever chunks are spilled
+   */
+  void AddToHash(StateHash& hash) const;
+
+  /**
+   * Copies the grid into the nested [x][y] layout used by the older accessors
+   */
+  vector<vector<TileType>> ToNestedVector() const;
+
+  bool operator==(const TileGrid& other) const;
+
+  bool operator!=(const TileGrid& other) const;
+
+ private:
+  // Chunk table entry of a chunk that is all fill, and of a chunk that is in the spill file
+  const static uint32_t kImplicitChunk = UINT32_MAX;
+  const static uint32_t kSpilledChunk = UINT32_MAX - 1;
+
+  size_t dimension_ = 0;
+  // Every tile of a dense grid, or the chunk pool of a chunked grid
+  vector<uint8_t> tiles_;
+  bool is_chunked_ = false;
+  TileType fill_ = TileType::Dirt;
+  size_t chunks_per_side_ = 0;
+  // Pool slot of each chunk, in the [x][y] layout of chunks, or one of the special entries
+  vector<uint32_t> chunk_table_;
+  // Chunk held by each pool slot, and when it was last written to
+  vector<uint32_t> slot_chunks_;
+  vector<uint64_t> slot_writes_;
+  vector<uint32_t> free_slots_;
+  uint64_t write_clock_ = 0;
+  size_t num_spilled_chunks_ = 0;
+  size_t max_resident_chunks_ = 0;
+  // Chunk i is kept at offset i * kChunkTiles of the file while it is spilled
+  std::unique_ptr<SpillFile> spill_;
+
+  size_t GetChunkIndex(size_t x, size_t y) const {
+    return (x >> kChunkShift) * chunks_per_side_ + (y >> kChunkShift);
+  }
+
+  static size_t GetTileInChunk(size_t x, size_t y) {
+    return (x & (kChunkDimension - 1)) << kChunkShift | (y & (kChunkDimension - 1));
+  }
+
+  /**
+   * Gets the tiles of a chunk that is in memory or spilled
+   */
+  const uint8_t* GetChunkTiles(size_t chunk, uint32_t entry) const;
+
+  /**
+   * Sets a tile of a chunked grid, giving its chunk memory or loading it from the spill file first if needed
+   */
+  void SetChunkedTile(size_t x, size_t y, TileType type);
+
+  /**
+   * Takes a free pool slot for a chunk, spilling the coldest chunk first if too many are in memory
+   *
+   * @return slot, whose tiles are left as they were
+   */
+  uint32_t AllocateSlot(size_t chunk);
+
+  /**
+   * Moves the chunk that was written to longest ago into the spill file
+   */
+  void SpillColdestChunk();
+
+  /**
+   * Moves the chunks in memory to the front of a pool just big enough for them, giving back the rest
+   */
+  void ShrinkPool();
+
+  /**
+   * Checks whether every tile of a chunk's memory is the fill type
+   */
+  bool IsAllFill(const uint8_t* chunk_tiles) const;
+
+  /**
+   * Sets up an empty grid of a size and storage with every tile the fill type
+   */
+  void Initialize(size_t dimension, TileType fill, TileStorage storage);
+};
+
+} // namespace dig_dug
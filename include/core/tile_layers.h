@@ -0,0 +1,87 @@
+#pragma once
+
+#include "core/bit_board.h"
+#include "core/tile_grid.h"
+
+namespace dig_dug {
+
+/**
+ * Bit board copy of a game map with one layer each for dirt, tunnels and rocks, for boards of up to
+ * BitBoard::kMaxDimension tiles per side. Single tile checks are one bit test and whole board questions are
+ * answered with shifts and masks over all tiles at once
+ */
+class TileLayers {
+ public:
+  /**
+   * Constructs layers for an empty board
+   */
+  TileLayers() = default;
+
+  /**
+   * Builds the layers from a game map
+   *
+   * @param grid game map, at most BitBoard::kMaxDimension tiles per side
+   */
+  explicit TileLayers(const TileGrid& grid);
+
+  /**
+   * Checks whether a board of the given size fits in the layers
+   */
+  static bool CanRepresent(size_t dimension);
+
+  /**
+   * Updates the layers after a tile of the map changes
+   *
+   * @param x x index of the tile
+   * @param y y index of the tile
+   * @param type new type of the tile
+   */
+  void SetTile(size_t x, size_t y, TileType type);
+
+  bool IsDirt(size_t x, size_t y) const {
+    return dirt_.Test(x, y);
+  }
+
+  bool IsTunnel(size_t x, size_t y) const {
+    return tunnels_.Test(x, y);
+  }
+
+  bool IsRock(size_t x, size_t y) const {
+    return rocks_.Test(x, y);
+  }
+
+  const BitBoard& GetBoard() const;
+
+  const BitBoard& GetDirt() const;
+
+  const BitBoard& GetTunnels() const;
+
+  const BitBoard& GetRocks() const;
+
+  /**
+   * Gets every tunnel tile connected through tunnels to the given tile
+   *
+   * @param x x index of the starting tile
+   * @param y y index of the starting tile
+   * @return connected tunnel tiles, empty if the starting tile is not a tunnel
+   */
+  BitBoard GetReachableTunnels(size_t x, size_t y) const;
+
+  /**
+   * Gets the tunnel tiles that connect to three or four other tunnel tiles
+   */
+  BitBoard GetJunctions() const;
+
+  /**
+   * Counts the tiles that have been dug into tunnels
+   */
+  size_t CountTunnels() const;
+
+ private:
+  BitBoard board_;
+  BitBoard dirt_;
+  BitBoard tunnels_;
+  BitBoard rocks_;
+};
+
+} // namespace dig_dug
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/direction.h"
+#include "core/tile_grid.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::vector;
+
+/**
+ * Keeps, for every tile of the board, a 4-bit mask of the neighboring tiles that are tunnels, with bit d set for
+ * Direction d. Walking enemies decide where to go from this mask when they reach a tile, instead of looking at each
+ * neighbor. The masks only change when a tile changes, so the map updates them as it is dug
+ */
+class TunnelExits {
+ public:
+  /**
+   * Constructs exits for an empty board
+   */
+  TunnelExits() = default;
+
+  /**
+   * Finds the exits of every tile of a map, replacing whatever the table held. Does not allocate once the table has
+   * held a board this large
+   *
+   * @param grid game map, at most TileGrid::kMaxDenseDimension tiles per side
+   */
+  void Reset(const TileGrid& grid);
+
+  /**
+   * Checks whether a board of the given size is small enough to keep a mask per tile for
+   */
+  static bool CanRepresent(size_t dimension);
+
+  /**
+   * Updates the exits of the neighbors of a tile after it changes
+   *
+   * @param x x index of the tile
+   * @param y y index of the tile
+   * @param type new type of the tile
+   */
+  void SetTile(size_t x, size_t y, TileType type);
+
+  /**
+   * Gets the mask of neighbors of a tile on the board that are tunnels. Directions off the board are never exits
+   */
+  uint8_t GetExits(size_t x, size_t y) const {
+    return exits_[x * dimension_ + y];
+  }
+
+  static bool HasExit(uint8_t exits, Direction direction) {
+    return (exits & (1 << static_cast<size_t>(direction))) != 0;
+  }
+
+  size_t GetDimension() const;
+
+ private:
+  size_t dimension_ = 0;
+  // Mask of each tile in the TileGrid [x][y] layout
+  vector<uint8_t> exits_;
+};
+
+} // namespace dig_dug
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "core/game_engine.h"
+#include "core/player_action.h"
+#include "core/random.h"
+
+namespace dig_dug {
+
+/**
+ * Plays the game by choosing an action every frame
+ */
+class BotPolicy {
+ public:
+  virtual ~BotPolicy() = default;
+
+  /**
+   * Prepares the policy for a new episode, so an episode plays the same way no matter which policy object runs it
+   *
+   * @param seed seed of the episode
+   */
+  virtual void Reset(uint64_t seed) = 0;
+
+  /**
+   * Chooses the action for the current frame
+   */
+  virtual PlayerAction ChooseAction(const GameEngine& engine) = 0;
+};
+
+/**
+ * Never presses anything
+ */
+class IdlePolicy : public BotPolicy {
+ public:
+  void Reset(uint64_t seed) override;
+
+  PlayerAction ChooseAction(const GameEngine& engine) override;
+};
+
+/**
+ * Holds a random key for a random number of frames, like someone mashing the keys
+ */
+class RandomPolicy : public BotPolicy {
+ public:
+  void Reset(uint64_t seed) override;
+
+  PlayerAction ChooseAction(const GameEngine& engine) override;
+
+ private:
+  Random random_;
+  PlayerAction cur_action_ = PlayerAction::None;
+  size_t remaining_frames_ = 0;
+
+  const static size_t kMaxHoldFrames = 30;
+};
+
+/**
+ * Walks toward the closest enemy and shoots it once the enemy is in front of the player and in range
+ */
+class HunterPolicy : public BotPolicy {
+ public:
+  void Reset(uint64_t seed) override;
+
+  PlayerAction ChooseAction(const GameEngine& engine) override;
+
+ private:
+  // Enemies within this many tiles along the player's row or column are shot at
+  const static size_t kAttackRangeTiles = 3;
+};
+
+/**
+ * Creates a policy from its name: "idle", "random" or "hunter"
+ *
+ * @throws std::invalid_argument if there is no policy with the name
+ */
+std::unique_ptr<BotPolicy> CreateBotPolicy(const std::string& name);
+
+} // namespace dig_dug
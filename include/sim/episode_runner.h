@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/game_session.h"
+#include "core/level_pack.h"
+#include "sim/bot_policy.h"
+
+namespace dig_dug {
+
+using std::size_t;
+using std::vector;
+
+/**
+ * Outcome of one complete game
+ */
+struct EpisodeResult {
+  uint64_t seed = 0;
+  size_t score = 0;
+  size_t level = 0;
+  size_t num_ticks = 0;
+
+  bool operator==(const EpisodeResult& other) const {
+    return seed == other.seed && score == other.score && level == other.level && num_ticks == other.num_ticks;
+  }
+};
+
+/**
+ * Which episodes to play and how
+ */
+struct RunnerConfig {
+  // Board size and enemy scale of stress runs, whose first level starts with over ten thousand enemies
+  const static size_t kStressBoardDimension = 768;
+  const static size_t kStressEnemyScale = 2600;
+
+  // Episodes are played with seeds first_seed to first_seed + num_episodes - 1
+  uint64_t first_seed = 1;
+  size_t num_episodes = 1;
+  std::string policy = "hunter";
+  size_t num_threads = 1;
+  // Episodes still running after this many frames are cut off
+  size_t max_ticks = 100000;
+  // Level pack to take boards from instead of generating them, or empty to generate every board
+  std::string level_pack_path;
+  size_t board_dimension = GameStateGenerator::kDefaultBoardDimension;
+  // Number of times the arcade board's enemies and rocks that each board gets, or 0 to scale with the board side
+  size_t enemy_scale = 0;
+};
+
+/**
+ * Results of every episode of a run, in seed order, and how long the run took
+ */
+struct RunSummary {
+  vector<EpisodeResult> episodes;
+  size_t num_ticks = 0;
+  double seconds = 0;
+
+  double GetEpisodesPerSecond() const;
+
+  double GetTicksPerSecond() const;
+};
+
+/**
+ * Plays many complete games headlessly, spread over several threads. Each worker starts with an even share of the
+ * episodes and steals from the others once it runs out, so long games do not leave threads idle. Every episode only
+ * depends on its seed, so results are the same for any number of threads
+ */
+class EpisodeRunner {
+ public:
+  /**
+   * Prepares a run
+   *
+   * @throws std::invalid_argument if the policy does not exist, there are no threads or the boards are too small or
+   * too large
+   * @throws std::runtime_error if the level pack cannot be opened
+   */
+  explicit EpisodeRunner(const RunnerConfig& config);
+
+  /**
+   * Plays every episode and waits for them to finish
+   *
+   * @throws the first exception thrown by a worker, in worker order, once every worker has stopped
+   */
+  RunSummary Run() const;
+
+  /**
+   * Plays one complete game on the calling thread
+   *
+   * @param seed seed of the game
+   * @param policy bot playing the game
+   * @param max_ticks number of frames after which the game is cut off
+   * @param board_source boards made ahead of time, or nullptr to generate every board
+   * @param board_dimension number of tiles along each side of the boards
+   * @param enemy_scale number of times the arcade board's enemies and rocks that each board gets, or 0 to scale with
+   * the board side
+   */
+  static EpisodeResult PlayEpisode(uint64_t seed, BotPolicy& policy, size_t max_ticks,
+                                   BoardSource* board_source = nullptr,
+                                   size_t board_dimension = GameStateGenerator::kDefaultBoardDimension,
+                                   size_t enemy_scale = 0);
+
+  // Same tile size as the game, since movement speeds are tuned for it
+  const static size_t kTileSize = 100;
+
+ private:
+  RunnerConfig config_;
+  // Shared by every worker, since packs are read-only
+  std::shared_ptr<LevelPack> level_pack_;
+};
+
+} // namespace dig_dug
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "core/level_pack.h"
+
+namespace dig_dug {
+
+using std::size_t;
+
+/**
+ * Which boards to put in a level pack
+ */
+struct LevelPackConfig {
+  // Boards are made for seeds first_seed to first_seed + num_seeds - 1
+  uint64_t first_seed = 1;
+  size_t num_seeds = 1;
+  // Levels 1 to num_levels, with boards 1 to boards_per_level of each
+  size_t num_levels = 1;
+  size_t boards_per_level = 1;
+  size_t board_dimension = GameStateGenerator::kDefaultBoardDimension;
+  size_t num_threads = 1;
+};
+
+/**
+ * Generates every board of a level pack, spread over several threads, and writes the pack to a file. Each thread
+ * fills its own share of the records in place, so the records are written to the file in one go
+ *
+ * @throws std::invalid_argument if the pack would be empty, there are no threads or the boards are larger than packs
+ * hold
+ * @throws std::runtime_error if the file cannot be written
+ */
+void BuildLevelPack(const std::string& path, const LevelPackConfig& config);
+
+} // namespace dig_dug
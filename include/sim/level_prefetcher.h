@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "core/board_source.h"
+#include "core/tile_grid.h"
+#include "sim/spsc_ring.h"
+
+namespace dig_dug {
+
+using std::size_t;
+
+/**
+ * Generates the boards a session will probably need next on a background thread, so starting a level only copies a
+ * finished board. Requests and finished boards pass through lock-free rings, and a board that is not ready in time is
+ * generated by the session as before. One prefetcher serves one session on one thread
+ */
+class LevelPrefetcher : public BoardSource {
+ public:
+  /**
+   * Starts the background thread
+   *
+   * @param board_dimension number of tiles along each side of the boards to make, which has to match the session's.
+   * Boards get the default enemy scale for that size, so sessions with another scale generate their own
+   * @throws std::invalid_argument if the generator cannot make boards of that size
+   */
+  explicit LevelPrefetcher(size_t board_dimension = GameStateGenerator::kDefaultBoardDimension);
+
+  LevelPrefetcher(const LevelPrefetcher&) = delete;
+  LevelPrefetcher& operator=(const LevelPrefetcher&) = delete;
+
+  /**
+   * Stops the background thread, dropping any boards it has not handed over
+   */
+  ~LevelPrefetcher() override;
+
+  /**
+   * Asks the background thread for a board, unless it already has too many requests waiting
+   */
+  void Prepare(uint64_t seed, size_t level, size_t num_boards) override;
+
+  /**
+   * Gives the generator the board if it is finished, dropping finished boards that were asked for before it
+   */
+  bool TakeBoard(uint64_t seed, size_t level, size_t num_boards, GameStateGenerator& generator) override;
+
+  /**
+   * Waits until the background thread has finished every board asked for so far, which is mostly useful for tests
+   */
+  void Wait() const;
+
+ private:
+  /**
+   * Board a session may ask for
+   */
+  struct Request {
+    uint64_t seed = 0;
+    size_t level = 0;
+    size_t num_boards = 0;
+
+    bool operator==(const Request& other) const {
+      return seed == other.seed && level == other.level && num_boards == other.num_boards;
+    }
+  };
+
+  /**
+   * Board finished by the background thread
+   */
+  struct Board {
+    Request request;
+    TileGrid map;
+    uint64_t engine_seed = 0;
+  };
+
+  // Sessions ask for at most two boards at a time, so short rings are plenty
+  const static size_t kRingSize = 8;
+  // How long the background thread sleeps before checking for requests again if it misses a wake-up
+  const static size_t kIdleMicroseconds = 1000;
+
+  size_t board_dimension_;
+  SpscRing<Request, kRingSize> requests_;
+  SpscRing<Board, kRingSize> boards_;
+  // Requests taken by the background thread that are not yet in boards_
+  std::atomic<size_t> num_pending_{0};
+  std::atomic<bool> is_stopping_{false};
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::thread worker_;
+
+  /**
+   * Loop of the background thread
+   */
+  void Work();
+};
+
+} // namespace dig_dug
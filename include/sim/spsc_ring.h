@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "sim/work_stealing_queue.h"
+
+namespace dig_dug {
+
+using std::size_t;
+
+/**
+ * Fixed-size queue between exactly one producer thread and one consumer thread, with no locks. Each side only writes
+ * its own index, and a slot is published by the release store of that index, so a consumer sees every item whole
+ *
+ * @tparam T type of the items, which are moved in and out of slots
+ * @tparam N number of slots, a power of two; the ring holds at most N items
+ */
+template <typename T, size_t N>
+class SpscRing {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "Ring size must be a power of two");
+
+ public:
+  SpscRing() = default;
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  /**
+   * Adds an item, for the producer
+   *
+   * @return true if the item was added, false if the ring was full and the item was left alone
+   */
+  bool TryPush(T& item) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == N) {
+      return false;
+    }
+
+    slots_[tail & (N - 1)] = std::move(item);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Takes the oldest item, for the consumer
+   *
+   * @param item set to the item taken
+   * @return true if an item was taken, false if the ring was empty
+   */
+  bool TryPop(T& item) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    item = std::move(slots_[head & (N - 1)]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Checks whether the ring is empty, which is only exact on the consumer's thread
+   */
+  bool IsEmpty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+ private:
+  // The indices only ever grow, and wrap onto slots through the mask. Padding keeps the consumer's index, the
+  // producer's index and the slots on separate cache lines
+  std::atomic<size_t> head_{0};
+  char head_padding_[kCacheLineSize];
+  std::atomic<size_t> tail_{0};
+  char tail_padding_[kCacheLineSize];
+  T slots_[N];
+};
+
+} // namespace dig_dug
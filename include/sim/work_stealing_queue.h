@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace dig_dug {
+
+using std::size_t;
+
+// Assumed size of a cache line, used to keep data written by different threads apart
+const size_t kCacheLineSize = 64;
+
+/**
+ * Queue of work items owned by one worker thread. The owner takes items from the back, while idle workers steal from
+ * the front, so the owner and thieves rarely want the same end. Each queue starts on its own cache line, so locking
+ * one worker's queue does not slow down the workers using the queues next to it
+ */
+class alignas(kCacheLineSize) WorkStealingQueue {
+ public:
+  WorkStealingQueue() = default;
+
+  /**
+   * Adds an item to the back of the queue
+   */
+  void Push(size_t item);
+
+  /**
+   * Takes the newest item, for the owner of the queue
+   *
+   * @param item set to the item taken
+   * @return true if an item was taken, false if the queue was empty
+   */
+  bool Pop(size_t& item);
+
+  /**
+   * Takes the oldest item, for workers that ran out of their own work
+   *
+   * @param item set to the item taken
+   * @return true if an item was taken, false if the queue was empty
+   */
+  bool Steal(size_t& item);
+
+  size_t Size() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::deque<size_t> items_;
+};
+
+/**
+ * Fixed number of queues, one for each worker, that really start on their own cache lines. Before C++17, new and
+ * std::allocator only align to alignof(std::max_align_t), so a vector of queues could start partway into a line
+ */
+class WorkStealingQueueArray {
+ public:
+  /**
+   * Creates empty queues
+   *
+   * @param size number of queues
+   */
+  explicit WorkStealingQueueArray(size_t size);
+
+  WorkStealingQueueArray(const WorkStealingQueueArray&) = delete;
+
+  WorkStealingQueueArray& operator=(const WorkStealingQueueArray&) = delete;
+
+  ~WorkStealingQueueArray();
+
+  WorkStealingQueue& operator[](size_t index) {
+    return queues_[index];
+  }
+
+  size_t Size() const;
+
+ private:
+  size_t size_;
+  // Room for the queues plus one line, so the first queue can be moved up to a line boundary
+  std::unique_ptr<char[]> storage_;
+  WorkStealingQueue* queues_;
+};
+
+} // namespace dig_dug
@@ -4,8 +4,14 @@
 #include "cinder/app/RendererGl.h"
 #include "cinder/gl/gl.h"
 #include "cinder/Font.h"
+#include "core/checkpoint_file.h"
+#include "core/fixed_timestep.h"
+#include "core/frame_interpolator.h"
 #include "core/game_engine.h"
 #include "core/game_state_generator.h"
+#include "core/game_session.h"
+#include "core/input_buffer.h"
+#include "sim/level_prefetcher.h"
 
 
 namespace dig_dug {
@@ -14,6 +20,7 @@ using ci::gl::Texture2dRef;
 using ci::gl::Texture2d;
 using ci::loadImage;
 using ci::app::KeyEvent;
+using ci::Rectf;
 
  class DigDugApp : public ci::app::App {
   public:
@@ -28,29 +35,38 @@ using ci::app::KeyEvent;
    void draw() override;
 
    /**
-    * Updates the board
+    * Runs the simulation ticks that are due since the last frame
     */
    void update() override;
 
    /**
-    * Updates the player with respect to the key pressed
+    * Holds down the action of a game key until it is released, starts a new game on enter, or saves or loads the game
     *
     * @param event key pressed
     */
-   void keyDown(ci::app::KeyEvent event);
+   void keyDown(ci::app::KeyEvent event) override;
+
+   /**
+    * Releases the action of a game key
+    *
+    * @param event key released
+    */
+   void keyUp(ci::app::KeyEvent event) override;
 
   private:
-   GameStateGenerator generator_;
-   GameEngine engine_;
-   size_t live_lost_num_frames_ = 0;
-   bool game_over_ = false;
+   // Declared before the session so it outlives it
+   LevelPrefetcher prefetcher_;
+   GameSession session_;
+   FixedTimestep timestep_;
+   FrameInterpolator interpolator_;
+   InputBuffer input_;
+   double last_update_seconds_ = 0;
 
    const size_t kTileSize = 100;
-   const size_t kMaxLiveLostFrames = 100;
    const double kWindowSize = 2000;
    const double kMargin = 100;
    const double kBoardToWindowRatio = 0.75;
-   const size_t kLevelUpScore = 200;
+   const std::string kSavePath = "dig_dug_save.ddc";
 
    const Texture2dRef kDirtTexture = Texture2d::create(loadImage("../../../images/dirt_block.png"));
    const Texture2dRef kRockTexture = Texture2d::create(loadImage("../../../images/rock.png"));
@@ -67,30 +83,48 @@ using ci::app::KeyEvent;
    const Texture2dRef kGhostTexture = Texture2d::create(loadImage("../../../images/ghost.png"));
 
 
+   /**
+    * Gets the action of a game key
+    *
+    * @param event key event
+    * @return action, or None if the key is not a game key
+    */
+   static PlayerAction GetKeyAction(const KeyEvent& event);
+
    /**
     * Draws the dirt tiles, tunnels, and rocks
+    *
+    * @param frame view of the current game state
     */
-   void DrawBoard() const;
+   void DrawBoard(const FrameView& frame) const;
 
    /**
     * Draws the player and the harpoon
+    *
+    * @param frame view of the current game state
     */
-   void DrawPlayer() const;
+   void DrawPlayer(const FrameView& frame) const;
 
    /**
     * Draws the enemies
+    *
+    * @param frame view of the current game state
     */
-   void DrawEnemies() const;
+   void DrawEnemies(const FrameView& frame) const;
 
    /**
     * Draws the harpoon
+    *
+    * @param frame view of the current game state
     */
-   void DrawHarpoon() const;
+   void DrawHarpoon(const FrameView& frame) const;
 
    /**
     * Draws the number of lives the player has
+    *
+    * @param frame view of the current game state
     */
-   void DrawLives() const;
+   void DrawLives(const FrameView& frame) const;
 };
 
 } // namespace dig_dug
\ No newline at end of file
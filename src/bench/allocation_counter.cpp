@@ -0,0 +1,82 @@
+#include "bench/allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Relaxed counters, since reads only need to see the allocations of the thread reading them
+std::atomic<size_t> num_allocations(0);
+std::atomic<size_t> num_allocated_bytes(0);
+
+void* Allocate(size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  num_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  // Follows the standard operator new, which asks the new handler for memory until it gives up
+  void* memory;
+  while ((memory = std::malloc(size > 0 ? size : 1)) == nullptr) {
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+
+  return memory;
+}
+
+void* AllocateOrNull(size_t size) noexcept {
+  try {
+    return Allocate(size);
+  } catch (const std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+  return Allocate(size);
+}
+
+void* operator new[](size_t size) {
+  return Allocate(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return AllocateOrNull(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return AllocateOrNull(size);
+}
+
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+  std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+  std::free(memory);
+}
+
+namespace dig_dug {
+
+size_t GetNumAllocations() {
+  return num_allocations.load(std::memory_order_relaxed);
+}
+
+size_t GetNumAllocatedBytes() {
+  return num_allocated_bytes.load(std::memory_order_relaxed);
+}
+
+} // namespace dig_dug
@@ -0,0 +1,182 @@
+#include "bench/engine_benchmarks.h"
+
+#include <memory>
+
+#include "core/batch_game_engine.h"
+#include "core/game_engine.h"
+#include "core/game_state_generator.h"
+#include "core/player_action.h"
+
+namespace dig_dug {
+
+namespace {
+
+const size_t kTileSize = 100;
+// The player turns clockwise after this many moves, so it keeps digging new tunnels without leaving the board for long
+const size_t kMovesPerTurn = 64;
+// Games stepped by each op of the batch cases, which is a whole number of blocks of lanes
+const size_t kNumBatchGames = 64;
+
+/**
+ * State shared by the cases of one board
+ */
+struct EngineFixture {
+  GameStateGenerator generator;
+  TileGrid board;
+  uint64_t engine_seed = 0;
+  GameEngine engine;
+  // Games of the batch cases, which all start on the fixture's board with their own seeds
+  vector<GameEngine> engines;
+  BatchGameEngine batch;
+  vector<PlayerAction> actions;
+  vector<uint8_t> is_player_dead;
+  // Results of the timed calls are added here so the compiler cannot drop the calls
+  size_t sink = 0;
+
+  /**
+   * Replaces the engine with a new one on the fixture's board, which owns its map outright
+   */
+  void ResetEngine() {
+    engine = GameEngine(board, kTileSize, engine_seed);
+  }
+
+  /**
+   * Starts the games of the batch cases over, both as separate engines and in the batch
+   */
+  void ResetGames() {
+    if (batch.GetNumGames() != kNumBatchGames) {
+      batch = BatchGameEngine(kNumBatchGames, kTileSize);
+      actions.assign(kNumBatchGames, PlayerAction::None);
+      is_player_dead.assign(kNumBatchGames, 0);
+    }
+
+    engines.clear();
+    for (size_t game = 0; game < kNumBatchGames; game++) {
+      engines.emplace_back(board, kTileSize, engine_seed + game);
+      batch.ResetGame(game, board, engine_seed + game);
+    }
+  }
+
+  /**
+   * Sets the actions of one tick of the batch cases. Each player walks clockwise like in move_player, starting a
+   * quarter turn from its neighbor, and attacks every so often
+   */
+  void ChooseActions(size_t op) {
+    const PlayerAction kMoves[] = {PlayerAction::Right, PlayerAction::Down, PlayerAction::Left, PlayerAction::Up};
+    for (size_t game = 0; game < kNumBatchGames; game++) {
+      actions[game] = (op + game) % 8 == 0 ? PlayerAction::Attack : kMoves[(op / kMovesPerTurn + game) % 4];
+    }
+  }
+};
+
+} // namespace
+
+vector<BenchmarkCase> MakeEngineBenchmarks(size_t board_dimension, uint64_t seed, size_t enemy_scale) {
+  std::shared_ptr<EngineFixture> fixture = std::make_shared<EngineFixture>();
+  fixture->generator = GameStateGenerator(seed, board_dimension, enemy_scale);
+  fixture->board = fixture->generator.Generate();
+  fixture->engine_seed = fixture->generator.GetEngineSeed();
+  fixture->ResetEngine();
+
+  size_t num_enemies = fixture->engine.GetEnemyView().Size();
+  size_t map_bytes = fixture->engine.GetTileGrid().GetMemoryUsage();
+  auto reset_engine = [fixture]() { fixture->ResetEngine(); };
+  vector<BenchmarkCase> benchmarks;
+
+  auto add = [&](const string& name, const std::function<void()>& setup, const std::function<void(size_t)>& run) {
+    BenchmarkCase benchmark;
+    benchmark.name = name;
+    benchmark.board_dimension = board_dimension;
+    benchmark.enemy_scale = enemy_scale;
+    benchmark.num_enemies = num_enemies;
+    benchmark.map_bytes = map_bytes;
+    benchmark.setup = setup;
+    benchmark.run = run;
+    benchmarks.push_back(benchmark);
+  };
+
+  add("generate", nullptr, [fixture](size_t num_ops) {
+    for (size_t op = 0; op < num_ops; op++) {
+      fixture->sink += fixture->generator.Generate().GetNumTiles();
+    }
+  });
+
+  add("construct_engine", nullptr, [fixture](size_t num_ops) {
+    for (size_t op = 0; op < num_ops; op++) {
+      GameEngine engine(fixture->board, kTileSize, fixture->engine_seed);
+      fixture->sink += engine.GetEnemyView().Size();
+    }
+  });
+
+  add("move_player", reset_engine, [fixture](size_t num_ops) {
+    const vec2 kDirections[] = {vec2(1, 0), vec2(0, 1), vec2(-1, 0), vec2(0, -1)};
+    for (size_t op = 0; op < num_ops; op++) {
+      fixture->engine.MovePlayer(kDirections[op / kMovesPerTurn % 4]);
+    }
+  });
+
+  add("move_enemies", reset_engine, [fixture](size_t num_ops) {
+    for (size_t op = 0; op < num_ops; op++) {
+      fixture->engine.MoveEnemies();
+    }
+  });
+
+  add("attack_enemy", reset_engine, [fixture](size_t num_ops) {
+    for (size_t op = 0; op < num_ops; op++) {
+      fixture->engine.AttackEnemy();
+    }
+  });
+
+  add("is_player_dead", reset_engine, [fixture](size_t num_ops) {
+    for (size_t op = 0; op < num_ops; op++) {
+      if (fixture->engine.IsPlayerDead()) {
+        fixture->engine.SetNumLives(3);
+        fixture->sink++;
+      }
+    }
+  });
+
+  // One op of both cases is a tick of every game, the same as the batch's Step, so their times compare directly
+  auto reset_games = [fixture]() { fixture->ResetGames(); };
+  add("step_engines", reset_games, [fixture](size_t num_ops) {
+    for (size_t op = 0; op < num_ops; op++) {
+      fixture->ChooseActions(op);
+      for (size_t game = 0; game < kNumBatchGames; game++) {
+        GameEngine& engine = fixture->engines[game];
+        ApplyAction(engine, fixture->actions[game]);
+        if (!engine.IsPlayerDead()) {
+          engine.MoveEnemies();
+        }
+      }
+    }
+  });
+
+  add("step_batch", reset_games, [fixture](size_t num_ops) {
+    for (size_t op = 0; op < num_ops; op++) {
+      fixture->ChooseActions(op);
+      fixture->batch.Step(fixture->actions.data(), fixture->is_player_dead.data());
+    }
+  });
+
+  add("get_game_map", reset_engine, [fixture](size_t num_ops) {
+    for (size_t op = 0; op < num_ops; op++) {
+      fixture->sink += fixture->engine.GetGameMap().size();
+    }
+  });
+
+  add("get_enemies", reset_engine, [fixture](size_t num_ops) {
+    for (size_t op = 0; op < num_ops; op++) {
+      fixture->sink += fixture->engine.GetEnemies().size();
+    }
+  });
+
+  add("get_player", reset_engine, [fixture](size_t num_ops) {
+    for (size_t op = 0; op < num_ops; op++) {
+      fixture->sink += (size_t) (fixture->engine.GetPlayer().GetFixedPosition().x);
+    }
+  });
+
+  return benchmarks;
+}
+
+} // namespace dig_dug
@@ -0,0 +1,175 @@
+#include "bench/episode_benchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+#include "core/latency_histogram.h"
+#include "bench/micro_benchmark.h"
+#include "core/game_session.h"
+#include "sim/bot_policy.h"
+#include "sim/episode_runner.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DIG_DUG_HAS_RUSAGE
+#include <sys/resource.h>
+#endif
+
+namespace dig_dug {
+
+double EpisodeBenchmarkResult::GetEpisodesPerSecond() const {
+  return seconds > 0 ? num_episodes / seconds : 0;
+}
+
+double EpisodeBenchmarkResult::GetTicksPerSecond() const {
+  return seconds > 0 ? num_ticks / seconds : 0;
+}
+
+string EpisodeBenchmarkResult::GetKey() const {
+  return policy + "/" + std::to_string(board_dimension);
+}
+
+EpisodeBenchmarkResult RunEpisodeBenchmark(const EpisodeBenchmarkConfig& config) {
+  std::unique_ptr<BotPolicy> policy = CreateBotPolicy(config.policy);
+  GameStateGenerator(config.first_seed, config.board_dimension);
+
+  EpisodeBenchmarkResult result;
+  result.board_dimension = config.board_dimension;
+  result.policy = config.policy;
+  result.num_episodes = config.num_episodes;
+  LatencyHistogram tick_latencies;
+
+  auto start_time = std::chrono::steady_clock::now();
+  for (uint64_t seed = config.first_seed; seed < config.first_seed + config.num_episodes; seed++) {
+    GameSession session(seed, EpisodeRunner::kTileSize, 1, nullptr, config.board_dimension);
+    policy->Reset(seed);
+
+    // Each tick ends where the next one starts, so the clock is read once a tick
+    auto tick_start = std::chrono::steady_clock::now();
+    while (!session.IsGameOver() && session.GetNumTicks() < config.max_ticks) {
+      InputFrame input;
+      if (!session.IsLosingLife()) {
+        input.action = policy->ChooseAction(session.GetEngine());
+      }
+      session.Update(input);
+
+      auto tick_end = std::chrono::steady_clock::now();
+      tick_latencies.Add((uint64_t) (std::chrono::duration_cast<std::chrono::nanoseconds>(tick_end - tick_start)
+                                         .count()));
+      tick_start = tick_end;
+    }
+
+    result.num_ticks += session.GetNumTicks();
+    result.num_levels_cleared += session.GetLevel() - 1;
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+
+  result.seconds = elapsed.count();
+  result.p50_tick_ns = tick_latencies.GetPercentile(0.5);
+  result.p99_tick_ns = tick_latencies.GetPercentile(0.99);
+  result.max_tick_ns = tick_latencies.GetMax();
+  result.peak_resident_bytes = GetPeakResidentBytes();
+  return result;
+}
+
+size_t GetPeakResidentBytes() {
+#ifdef DIG_DUG_HAS_RUSAGE
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+
+  // Linux reports kilobytes and macOS reports bytes
+#ifdef __APPLE__
+  return (size_t) (usage.ru_maxrss);
+#else
+  return (size_t) (usage.ru_maxrss) * 1024;
+#endif
+#else
+  return 0;
+#endif
+}
+
+void WriteEpisodeBenchmarkJson(const string& path, const vector<EpisodeBenchmarkResult>& results,
+                               const string& label) {
+  std::ofstream file(path);
+  if (!file) {
+    throw std::runtime_error("Cannot write benchmark results to " + path);
+  }
+
+  file << "{\n  \"label\": \"" << EscapeJson(label) << "\",\n  \"games\": [\n";
+  for (size_t index = 0; index < results.size(); index++) {
+    const EpisodeBenchmarkResult& result = results[index];
+    char line[512];
+    std::snprintf(line, sizeof(line),
+                  "    {\"board_size\": %zu, \"policy\": \"%s\", \"episodes\": %zu, \"ticks\": %zu, "
+                  "\"levels_cleared\": %zu, \"seconds\": %.3f, \"episodes_per_second\": %.2f, "
+                  "\"ticks_per_second\": %.0f, \"p50_tick_ns\": %llu, \"p99_tick_ns\": %llu, \"max_tick_ns\": %llu, "
+                  "\"peak_rss_bytes\": %zu}%s\n",
+                  result.board_dimension, EscapeJson(result.policy).c_str(), result.num_episodes, result.num_ticks,
+                  result.num_levels_cleared, result.seconds, result.GetEpisodesPerSecond(),
+                  result.GetTicksPerSecond(), (unsigned long long) (result.p50_tick_ns),
+                  (unsigned long long) (result.p99_tick_ns), (unsigned long long) (result.max_tick_ns),
+                  result.peak_resident_bytes, index + 1 < results.size() ? "," : "");
+    file << line;
+  }
+  file << "  ]\n}\n";
+
+  if (!file) {
+    throw std::runtime_error("Cannot write benchmark results to " + path);
+  }
+}
+
+vector<EpisodeBenchmarkResult> ReadEpisodeBenchmarkJson(const string& path) {
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error("Cannot read benchmark results from " + path);
+  }
+
+  vector<EpisodeBenchmarkResult> results;
+  bool has_games = false;
+  string line;
+  while (std::getline(file, line)) {
+    if (line.find("\"games\"") != string::npos) {
+      has_games = true;
+      continue;
+    }
+    if (line.find("\"board_size\"") == string::npos) {
+      continue;
+    }
+
+    char policy[64];
+    double episodes_per_second;
+    double ticks_per_second;
+    unsigned long long p50_tick_ns;
+    unsigned long long p99_tick_ns;
+    unsigned long long max_tick_ns;
+    EpisodeBenchmarkResult result;
+    if (std::sscanf(line.c_str(),
+                    " {\"board_size\": %zu, \"policy\": \"%63[^\"]\", \"episodes\": %zu, \"ticks\": %zu, "
+                    "\"levels_cleared\": %zu, \"seconds\": %lf, \"episodes_per_second\": %lf, "
+                    "\"ticks_per_second\": %lf, \"p50_tick_ns\": %llu, \"p99_tick_ns\": %llu, \"max_tick_ns\": %llu, "
+                    "\"peak_rss_bytes\": %zu",
+                    &result.board_dimension, policy, &result.num_episodes, &result.num_ticks,
+                    &result.num_levels_cleared, &result.seconds, &episodes_per_second, &ticks_per_second,
+                    &p50_tick_ns, &p99_tick_ns, &max_tick_ns, &result.peak_resident_bytes) != 12) {
+      throw std::runtime_error("Cannot read benchmark result: " + line);
+    }
+
+    result.policy = policy;
+    result.p50_tick_ns = p50_tick_ns;
+    result.p99_tick_ns = p99_tick_ns;
+    result.max_tick_ns = max_tick_ns;
+    results.push_back(result);
+  }
+
+  if (!has_games) {
+    throw std::runtime_error(path + " does not hold game benchmark results");
+  }
+
+  return results;
+}
+
+} // namespace dig_dug
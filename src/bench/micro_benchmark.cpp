@@ -0,0 +1,174 @@
+#include "bench/micro_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "bench/allocation_counter.h"
+
+namespace dig_dug {
+
+namespace {
+
+/**
+ * Runs a batch of a case and gets how long it took, in seconds
+ */
+double TimeBatch(const BenchmarkCase& benchmark, size_t num_ops) {
+  if (benchmark.setup) {
+    benchmark.setup();
+  }
+
+  auto start_time = std::chrono::steady_clock::now();
+  benchmark.run(num_ops);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+  return elapsed.count();
+}
+
+} // namespace
+
+string EscapeJson(const string& text) {
+  string escaped;
+  for (char character : text) {
+    if (character == '"' || character == '\\') {
+      escaped += '\\';
+      escaped += character;
+    } else if ((unsigned char) (character) >= 0x20) {
+      escaped += character;
+    }
+  }
+
+  return escaped;
+}
+
+double BenchmarkResult::GetOpsPerSecond() const {
+  return ns_per_op > 0 ? 1e9 / ns_per_op : 0;
+}
+
+string BenchmarkResult::GetKey() const {
+  string key = name + "/" + std::to_string(board_dimension);
+  return enemy_scale > 0 ? key + "/x" + std::to_string(enemy_scale) : key;
+}
+
+BenchmarkResult RunBenchmark(const BenchmarkCase& benchmark, const BenchmarkOptions& options) {
+  // Grows the batch from the time per operation seen so far, overshooting a little so it rarely takes two more tries
+  size_t batch_ops = 1;
+  for (double seconds = TimeBatch(benchmark, batch_ops);
+       seconds < options.min_batch_seconds && batch_ops < options.max_batch_ops;
+       seconds = TimeBatch(benchmark, batch_ops)) {
+    double wanted_ops = seconds > 0 ? options.min_batch_seconds / seconds * batch_ops * 1.2 : batch_ops * 10.0;
+    batch_ops = std::max(batch_ops * 2, (size_t) (wanted_ops));
+    batch_ops = std::min(batch_ops, options.max_batch_ops);
+  }
+
+  vector<double> ns_per_op;
+  size_t num_allocations = 0;
+  size_t num_bytes = 0;
+  for (size_t batch = 0; batch < options.num_batches; batch++) {
+    if (benchmark.setup) {
+      benchmark.setup();
+    }
+
+    size_t start_allocations = GetNumAllocations();
+    size_t start_bytes = GetNumAllocatedBytes();
+    auto start_time = std::chrono::steady_clock::now();
+    benchmark.run(batch_ops);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start_time;
+
+    num_allocations += GetNumAllocations() - start_allocations;
+    num_bytes += GetNumAllocatedBytes() - start_bytes;
+    ns_per_op.push_back(elapsed.count() / batch_ops);
+  }
+
+  std::sort(ns_per_op.begin(), ns_per_op.end());
+  size_t total_ops = batch_ops * options.num_batches;
+
+  BenchmarkResult result;
+  result.name = benchmark.name;
+  result.board_dimension = benchmark.board_dimension;
+  result.enemy_scale = benchmark.enemy_scale;
+  result.num_enemies = benchmark.num_enemies;
+  result.map_bytes = benchmark.map_bytes;
+  result.batch_ops = batch_ops;
+  result.ns_per_op = ns_per_op.empty() ? 0 : ns_per_op[ns_per_op.size() / 2];
+  result.allocs_per_op = total_ops > 0 ? (double) (num_allocations) / total_ops : 0;
+  result.bytes_per_op = total_ops > 0 ? (double) (num_bytes) / total_ops : 0;
+  return result;
+}
+
+void WriteBenchmarkJson(const string& path, const vector<BenchmarkResult>& results, const string& label) {
+  std::ofstream file(path);
+  if (!file) {
+    throw std::runtime_error("Cannot write benchmark results to " + path);
+  }
+
+  file << "{\n  \"label\": \"" << EscapeJson(label) << "\",\n  \"benchmarks\": [\n";
+  for (size_t index = 0; index < results.size(); index++) {
+    const BenchmarkResult& result = results[index];
+    char line[512];
+    std::snprintf(line, sizeof(line),
+                  "    {\"name\": \"%s\", \"board_size\": %zu, \"enemies\": %zu, \"batch_ops\": %zu, "
+                  "\"ns_per_op\": %.3f, \"allocs_per_op\": %.4f, \"bytes_per_op\": %.1f, \"ops_per_second\": %.1f, "
+                  "\"enemy_scale\": %zu, \"map_bytes\": %zu}%s\n",
+                  EscapeJson(result.name).c_str(), result.board_dimension, result.num_enemies, result.batch_ops,
+                  result.ns_per_op, result.allocs_per_op, result.bytes_per_op, result.GetOpsPerSecond(),
+                  result.enemy_scale, result.map_bytes, index + 1 < results.size() ? "," : "");
+    file << line;
+  }
+  file << "  ]\n}\n";
+
+  if (!file) {
+    throw std::runtime_error("Cannot write benchmark results to " + path);
+  }
+}
+
+vector<BenchmarkResult> ReadBenchmarkJson(const string& path) {
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error("Cannot read benchmark results from " + path);
+  }
+
+  vector<BenchmarkResult> results;
+  bool has_benchmarks = false;
+  string line;
+  while (std::getline(file, line)) {
+    if (line.find("\"benchmarks\"") != string::npos) {
+      has_benchmarks = true;
+      continue;
+    }
+    if (line.find("\"name\"") == string::npos) {
+      continue;
+    }
+
+    // Names are the benchmark names this program writes, which have no quotes to escape
+    char name[128];
+    BenchmarkResult result;
+    if (std::sscanf(line.c_str(),
+                    " {\"name\": \"%127[^\"]\", \"board_size\": %zu, \"enemies\": %zu, \"batch_ops\": %zu, "
+                    "\"ns_per_op\": %lf, \"allocs_per_op\": %lf, \"bytes_per_op\": %lf",
+                    name, &result.board_dimension, &result.num_enemies, &result.batch_ops, &result.ns_per_op,
+                    &result.allocs_per_op, &result.bytes_per_op) != 7) {
+      throw std::runtime_error("Cannot read benchmark result: " + line);
+    }
+
+    // Files written before enemy counts could be set have neither field, and were all on default boards
+    size_t extras = line.find("\"enemy_scale\"");
+    if (extras != string::npos &&
+        std::sscanf(line.c_str() + extras, "\"enemy_scale\": %zu, \"map_bytes\": %zu", &result.enemy_scale,
+                    &result.map_bytes) != 2) {
+      throw std::runtime_error("Cannot read benchmark result: " + line);
+    }
+
+    result.name = name;
+    results.push_back(result);
+  }
+
+  if (!has_benchmarks) {
+    throw std::runtime_error(path + " does not hold benchmark results");
+  }
+
+  return results;
+}
+
+} // namespace dig_dug
@@ -0,0 +1,1122 @@
+#include "core/batch_game_engine.h"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace dig_dug {
+
+// Defined here as well so they can be bound to references, like in Catch's REQUIRE
+const size_t BatchGameEngine::kMaxLaneDimension;
+const size_t BatchGameEngine::kMaxLaneEnemies;
+const size_t BatchGameEngine::kMinLaneTileSize;
+const size_t BatchGameEngine::kMaxLaneTileSize;
+
+namespace {
+
+// Tile (x, y) of a lane is byte (x << kLaneDimensionShift) + y of the lane's tiles
+const int kLaneDimensionShift = 4;
+const size_t kLaneTiles = (size_t) (1) << (2 * kLaneDimensionShift);
+static_assert(((size_t) (1) << kLaneDimensionShift) == BatchGameEngine::kMaxLaneDimension,
+              "Lane tiles must be laid out like a BitBoard");
+
+// Gathers read a whole word at each tile, which can run three bytes past the tiles of the last lane
+const size_t kGatherPadding = 3;
+
+// Fixed-point step of a player move of one tile unit, which GameEngine::MovePlayer gets by scaling a unit velocity
+const int32_t kPlayerStep = kFixedOne * (GameEngine::kPlayerSpeed / kFixedOne);
+
+// Outputs a lane keeps, which is two blocks of Random
+const int32_t kLaneBlockSize = (int32_t) (Random::kBlockSize);
+const int32_t kLaneRandomOutputs = 2 * kLaneBlockSize;
+
+const int32_t kGhostFlag = EnemyPool::kGhostFlag;
+const int32_t kHurtFlag = EnemyPool::kHurtFlag;
+const int32_t kInDirtFlag = EnemyPool::kInDirtFlag;
+const int32_t kFacingLeftFlag = EnemyPool::kFacingLeftFlag;
+
+LaneVector LoadRow(const vector<int32_t>& row, size_t first) {
+  return LoadLanes(row.data() + first);
+}
+
+void StoreRow(vector<int32_t>& row, size_t first, const LaneVector& lanes) {
+  StoreLanes(row.data() + first, lanes);
+}
+
+/**
+ * Converts fixed point to whole pixels, truncating toward zero like FixedToPixels
+ */
+LaneVector LanesToPixels(const LaneVector& fixed) {
+  // Negative values are rounded up by adding one less than a pixel before shifting
+  LaneVector bias = ShiftRightArithmetic<31>(fixed) & SplatLanes(kFixedOne - 1);
+  return ShiftRightArithmetic<kFixedShift>(fixed + bias);
+}
+
+/**
+ * Gets the Direction value of each velocity, like GetTravelDirection
+ */
+LaneVector GetTravelDirections(const LaneVector& velocity_x, const LaneVector& velocity_y) {
+  const LaneVector kZero = SplatLanes(0);
+  LaneVector is_horizontal = Equal(velocity_y, kZero);
+  LaneVector is_right = is_horizontal & Greater(velocity_x, kZero);
+  LaneVector is_left = is_horizontal & Less(velocity_x, kZero);
+  LaneVector is_down = Equal(velocity_x, kZero) & Greater(velocity_y, kZero);
+
+  LaneVector vertical = Select(is_down, SplatLanes((int32_t) (Direction::Down)), SplatLanes((int32_t) (Direction::Up)));
+  return Select(is_right, SplatLanes((int32_t) (Direction::Right)),
+                Select(is_left, SplatLanes((int32_t) (Direction::Left)), vertical));
+}
+
+/**
+ * Gets the velocity of moving in each Direction value, like DirectionVelocity
+ */
+void GetDirectionVelocities(const LaneVector& direction, const LaneVector& speed, LaneVector& velocity_x,
+                            LaneVector& velocity_y) {
+  const LaneVector kZero = SplatLanes(0);
+  LaneVector negative_speed = kZero - speed;
+  velocity_x = Select(Equal(direction, SplatLanes((int32_t) (Direction::Right))), speed,
+                      Select(Equal(direction, SplatLanes((int32_t) (Direction::Left))), negative_speed, kZero));
+  velocity_y = Select(Equal(direction, SplatLanes((int32_t) (Direction::Down))), speed,
+                      Select(Equal(direction, SplatLanes((int32_t) (Direction::Up))), negative_speed, kZero));
+}
+
+/**
+ * Sets or clears the facing left flag of enemies whose velocity changed, like EnemyPool::SetVelocity
+ */
+LaneVector FaceAlong(const LaneVector& flags, const LaneVector& is_changed, const LaneVector& velocity_x) {
+  const LaneVector kZero = SplatLanes(0);
+  const LaneVector kFacingLeft = SplatLanes(kFacingLeftFlag);
+  LaneVector faces_right = is_changed & Greater(velocity_x, kZero);
+  LaneVector faces_left = is_changed & Less(velocity_x, kZero);
+  return AndNot(faces_right & kFacingLeft, flags) | (faces_left & kFacingLeft);
+}
+
+} // namespace
+
+BatchGameEngine::BatchGameEngine(size_t num_games, size_t tile_size)
+    : tile_size_(tile_size), num_games_(num_games),
+      num_lanes_((num_games + kLaneWidth - 1) / kLaneWidth * kLaneWidth), games_(num_games) {
+  max_harpoon_distance_ = PixelsToFixed((int32_t) (tile_size * GameEngine::kHarpoonLength
+                                                   / FixedToPixels(GameEngine::kEnemySpeed)));
+  tile_size_reciprocal_ = tile_size > 1 ? (uint32_t) (UINT32_MAX / tile_size + 1) : 0;
+
+  vector<int32_t>* lane_rows[] = {
+      &is_in_lanes_, &board_size_, &player_x_, &player_y_, &player_prev_x_, &player_prev_y_,
+      &is_player_facing_left_, &delayed_turn_x_, &delayed_turn_y_, &is_attacking_, &attack_frames_, &arrow_x_,
+      &arrow_y_, &harpoon_velocity_x_, &harpoon_velocity_y_, &harpoon_step_, &harpoon_distance_, &ghost_chance_,
+      &num_lives_, &num_enemies_, &random_key_0_, &random_key_1_, &random_block_0_, &random_block_1_,
+      &random_stream_0_, &random_stream_1_, &random_output_index_};
+  for (vector<int32_t>* row : lane_rows) {
+    row->assign(num_lanes_, 0);
+  }
+  for (vector<int32_t>& outputs : random_outputs_) {
+    outputs.assign(num_lanes_, 0);
+  }
+
+  vector<int32_t>* enemy_rows[] = {&enemy_x_, &enemy_y_, &enemy_velocity_x_, &enemy_velocity_y_, &enemy_flags_};
+  for (vector<int32_t>* row : enemy_rows) {
+    row->assign(num_lanes_ * kMaxLaneEnemies, 0);
+  }
+
+  score_.assign(num_lanes_, 0);
+  max_enemies_.assign(num_lanes_ / kLaneWidth, 0);
+  tiles_.assign(num_lanes_ * kLaneTiles + kGatherPadding, 0);
+  exits_.assign(num_lanes_ * kLaneTiles + kGatherPadding, 0);
+}
+
+void BatchGameEngine::ResetGame(size_t game, const TileGrid& board, uint64_t seed) {
+  CheckGame(game);
+  GameEngine& engine = games_[game];
+  engine.Reset(board, tile_size_, seed);
+
+  if (FitsInLanes(engine)) {
+    LoadLane(game);
+    is_in_lanes_[game] = -1;
+  } else {
+    is_in_lanes_[game] = 0;
+    num_enemies_[game] = 0;
+  }
+  UpdateMaxEnemies(game - game % kLaneWidth);
+}
+
+void BatchGameEngine::Step(const PlayerAction* actions, uint8_t* is_player_dead) {
+  for (size_t first = 0; first < num_lanes_; first += kLaneWidth) {
+    LaneVector in_lanes = LoadRow(is_in_lanes_, first);
+    if (IsAnyLane(in_lanes)) {
+      ApplyLaneActions(first, in_lanes, actions);
+      LaneVector dies = FindPlayerDeaths(first, in_lanes);
+      MoveLaneEnemies(first, AndNot(dies, in_lanes));
+
+      int dead_lanes = GetLaneBits(dies);
+      for (size_t lane = 0; lane < kLaneWidth && first + lane < num_games_; lane++) {
+        if (is_in_lanes_[first + lane] != 0) {
+          is_player_dead[first + lane] = (uint8_t) ((dead_lanes >> lane) & 1);
+        }
+      }
+    }
+
+    for (size_t game = first; game < first + kLaneWidth && game < num_games_; game++) {
+      if (is_in_lanes_[game] == 0) {
+        GameEngine& engine = games_[game];
+        ApplyAction(engine, actions[game]);
+        bool is_dead = engine.IsPlayerDead();
+        is_player_dead[game] = (uint8_t) (is_dead);
+        if (!is_dead) {
+          engine.MoveEnemies();
+        }
+      }
+    }
+  }
+}
+
+void BatchGameEngine::MovePlayer(size_t game, Direction direction) {
+  CheckGame(game);
+  if (is_in_lanes_[game] == 0) {
+    games_[game].MovePlayer(vec2(GetOffsetX(direction), GetOffsetY(direction)));
+    return;
+  }
+
+  MovePlayers(game - game % kLaneWidth, GetLaneMask(game % kLaneWidth),
+              SplatLanes(GetOffsetX(direction) * kPlayerStep), SplatLanes(GetOffsetY(direction) * kPlayerStep));
+}
+
+void BatchGameEngine::AttackEnemy(size_t game) {
+  CheckGame(game);
+  if (is_in_lanes_[game] == 0) {
+    games_[game].AttackEnemy();
+    return;
+  }
+
+  AttackEnemies(game - game % kLaneWidth, GetLaneMask(game % kLaneWidth));
+}
+
+void BatchGameEngine::CheckPlayerDeaths(uint8_t* is_player_dead) {
+  for (size_t first = 0; first < num_lanes_; first += kLaneWidth) {
+    LaneVector in_lanes = LoadRow(is_in_lanes_, first);
+    int dead_lanes = IsAnyLane(in_lanes) ? GetLaneBits(FindPlayerDeaths(first, in_lanes)) : 0;
+
+    for (size_t lane = 0; lane < kLaneWidth && first + lane < num_games_; lane++) {
+      size_t game = first + lane;
+      if (is_in_lanes_[game] != 0) {
+        is_player_dead[game] = (uint8_t) ((dead_lanes >> lane) & 1);
+      } else {
+        is_player_dead[game] = (uint8_t) (games_[game].IsPlayerDead());
+      }
+    }
+  }
+}
+
+void BatchGameEngine::MoveEnemies(const uint8_t* is_game_moving) {
+  for (size_t first = 0; first < num_lanes_; first += kLaneWidth) {
+    LaneVector moves = LoadRow(is_in_lanes_, first);
+    if (is_game_moving != nullptr) {
+      int32_t is_moving[kLaneWidth] = {};
+      for (size_t lane = 0; lane < kLaneWidth && first + lane < num_games_; lane++) {
+        is_moving[lane] = is_game_moving[first + lane] != 0 ? -1 : 0;
+      }
+      moves = moves & LoadLanes(is_moving);
+    }
+
+    if (IsAnyLane(moves)) {
+      MoveLaneEnemies(first, moves);
+    }
+
+    for (size_t game = first; game < first + kLaneWidth && game < num_games_; game++) {
+      if (is_in_lanes_[game] == 0 && (is_game_moving == nullptr || is_game_moving[game] != 0)) {
+        games_[game].MoveEnemies();
+      }
+    }
+  }
+}
+
+size_t BatchGameEngine::GetNumGames() const {
+  return num_games_;
+}
+
+bool BatchGameEngine::IsGameInLanes(size_t game) const {
+  CheckGame(game);
+  return is_in_lanes_[game] != 0;
+}
+
+const GameEngine& BatchGameEngine::GetGame(size_t game) const {
+  CheckGame(game);
+  if (is_in_lanes_[game] != 0) {
+    StoreLane(game);
+  }
+
+  return games_[game];
+}
+
+const TileGrid& BatchGameEngine::GetTileGrid(size_t game) const {
+  // Digging in the lanes changes the engine's map as it happens
+  CheckGame(game);
+  return games_[game].GetTileGrid();
+}
+
+FixedVec2 BatchGameEngine::GetPlayerPosition(size_t game) const {
+  CheckGame(game);
+  if (is_in_lanes_[game] == 0) {
+    return games_[game].GetPlayerView().GetFixedPosition();
+  }
+
+  return {player_x_[game], player_y_[game]};
+}
+
+FixedVec2 BatchGameEngine::GetPlayerPrevVelocity(size_t game) const {
+  CheckGame(game);
+  if (is_in_lanes_[game] == 0) {
+    return games_[game].GetPlayerView().GetFixedPrevVelocity();
+  }
+
+  return {player_prev_x_[game], player_prev_y_[game]};
+}
+
+size_t BatchGameEngine::GetNumEnemies(size_t game) const {
+  CheckGame(game);
+  if (is_in_lanes_[game] == 0) {
+    return games_[game].GetEnemyView().Size();
+  }
+
+  return (size_t) (num_enemies_[game]);
+}
+
+FixedVec2 BatchGameEngine::GetEnemyPosition(size_t game, size_t enemy) const {
+  CheckEnemy(game, enemy);
+  if (is_in_lanes_[game] == 0) {
+    return games_[game].GetEnemyView().GetPosition(enemy);
+  }
+
+  size_t index = GetEnemyIndex(game, enemy);
+  return {enemy_x_[index], enemy_y_[index]};
+}
+
+FixedVec2 BatchGameEngine::GetEnemyVelocity(size_t game, size_t enemy) const {
+  CheckEnemy(game, enemy);
+  if (is_in_lanes_[game] == 0) {
+    return games_[game].GetEnemyView().GetVelocity(enemy);
+  }
+
+  size_t index = GetEnemyIndex(game, enemy);
+  return {enemy_velocity_x_[index], enemy_velocity_y_[index]};
+}
+
+bool BatchGameEngine::IsEnemyGhost(size_t game, size_t enemy) const {
+  CheckEnemy(game, enemy);
+  if (is_in_lanes_[game] == 0) {
+    return games_[game].GetEnemyView().IsGhost(enemy);
+  }
+
+  return (enemy_flags_[GetEnemyIndex(game, enemy)] & kGhostFlag) != 0;
+}
+
+bool BatchGameEngine::IsEnemyHurt(size_t game, size_t enemy) const {
+  CheckEnemy(game, enemy);
+  if (is_in_lanes_[game] == 0) {
+    return games_[game].GetEnemyView().IsHurt(enemy);
+  }
+
+  return (enemy_flags_[GetEnemyIndex(game, enemy)] & kHurtFlag) != 0;
+}
+
+bool BatchGameEngine::IsPlayerAttacking(size_t game) const {
+  CheckGame(game);
+  if (is_in_lanes_[game] == 0) {
+    return games_[game].IsPlayerAttacking();
+  }
+
+  return is_attacking_[game] != 0;
+}
+
+FixedVec2 BatchGameEngine::GetHarpoonPosition(size_t game) const {
+  CheckGame(game);
+  if (is_in_lanes_[game] == 0) {
+    return games_[game].GetHarpoonView().GetFixedArrowPosition();
+  }
+
+  return {arrow_x_[game], arrow_y_[game]};
+}
+
+size_t BatchGameEngine::GetScore(size_t game) const {
+  CheckGame(game);
+  if (is_in_lanes_[game] == 0) {
+    return games_[game].GetScore();
+  }
+
+  return score_[game];
+}
+
+size_t BatchGameEngine::GetNumLives(size_t game) const {
+  CheckGame(game);
+  if (is_in_lanes_[game] == 0) {
+    return games_[game].GetNumLives();
+  }
+
+  // Lives below zero wrap around the same way as the engine's count
+  return (size_t) ((int64_t) (num_lives_[game]));
+}
+
+void BatchGameEngine::CheckGame(size_t game) const {
+  if (game >= num_games_) {
+    throw std::out_of_range("No game at index " + std::to_string(game));
+  }
+}
+
+void BatchGameEngine::CheckEnemy(size_t game, size_t enemy) const {
+  if (enemy >= GetNumEnemies(game)) {
+    throw std::out_of_range("No enemy at index " + std::to_string(enemy));
+  }
+}
+
+bool BatchGameEngine::FitsInLanes(const GameEngine& engine) const {
+  if (engine.board_size_ > kMaxLaneDimension || engine.enemies_.Size() > kMaxLaneEnemies
+      || tile_size_ < kMinLaneTileSize || tile_size_ > kMaxLaneTileSize
+      || tile_size_ % (size_t) (FixedToPixels(GameEngine::kEnemySpeed)) != 0 || !engine.HasTileLayers()
+      || !engine.HasTunnelExits()) {
+    return false;
+  }
+
+  const EnemyPool& enemies = engine.enemies_;
+  for (size_t index = 0; index < enemies.Size(); index++) {
+    FixedVec2 position = enemies.GetPosition(index);
+    FixedVec2 velocity = enemies.GetVelocity(index);
+    bool is_on_board = position.x >= 0 && position.y >= 0
+                       && engine.GetTileIndex(position.x) < engine.board_size_
+                       && engine.GetTileIndex(position.y) < engine.board_size_;
+    bool moves_along_axis = (velocity.x == 0 || velocity.y == 0)
+                            && std::abs(velocity.x) + std::abs(velocity.y) == GameEngine::kEnemySpeed;
+    if (!enemies.IsGhost(index) && !(is_on_board && engine.IsTileAligned(position) && moves_along_axis)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void BatchGameEngine::LoadLane(size_t game) {
+  const GameEngine& engine = games_[game];
+  board_size_[game] = (int32_t) (engine.board_size_);
+
+  const Player& player = engine.player_;
+  player_x_[game] = player.GetFixedPosition().x;
+  player_y_[game] = player.GetFixedPosition().y;
+  player_prev_x_[game] = player.GetFixedPrevVelocity().x;
+  player_prev_y_[game] = player.GetFixedPrevVelocity().y;
+  is_player_facing_left_[game] = player.GetOrientation() == CharacterOrientation::Left ? -1 : 0;
+  delayed_turn_x_[game] = engine.delayed_turn_velocity_.x;
+  delayed_turn_y_[game] = engine.delayed_turn_velocity_.y;
+
+  const Harpoon& harpoon = engine.harpoon_;
+  is_attacking_[game] = engine.player_attacking_ ? -1 : 0;
+  attack_frames_[game] = (int32_t) (engine.cur_attack_frames_);
+  arrow_x_[game] = harpoon.GetFixedArrowPosition().x;
+  arrow_y_[game] = harpoon.GetFixedArrowPosition().y;
+  harpoon_velocity_x_[game] = harpoon.GetFixedVelocity().x;
+  harpoon_velocity_y_[game] = harpoon.GetFixedVelocity().y;
+  harpoon_step_[game] = harpoon.GetFixedStepLength();
+  harpoon_distance_[game] = harpoon.GetFixedDistanceTraveled();
+
+  ghost_chance_[game] = (int32_t) (engine.ghost_chance_);
+  num_lives_[game] = (int32_t) (engine.num_lives_);
+  score_[game] = engine.score_;
+
+  const EnemyPool& enemies = engine.enemies_;
+  num_enemies_[game] = (int32_t) (enemies.Size());
+  for (size_t slot = 0; slot < kMaxLaneEnemies; slot++) {
+    size_t index = GetEnemyIndex(game, slot);
+    bool has_enemy = slot < enemies.Size();
+    enemy_x_[index] = has_enemy ? enemies.GetPosition(slot).x : 0;
+    enemy_y_[index] = has_enemy ? enemies.GetPosition(slot).y : 0;
+    enemy_velocity_x_[index] = has_enemy ? enemies.GetVelocity(slot).x : 0;
+    enemy_velocity_y_[index] = has_enemy ? enemies.GetVelocity(slot).y : 0;
+    enemy_flags_[index] = has_enemy ? enemies.GetFlags()[slot] : 0;
+  }
+
+  // The second block of the lane is the one the engine's generator is partway through, if any, and the first is
+  // already used up
+  const Random& random = engine.random_;
+  uint64_t seed = random.GetSeed();
+  uint64_t stream = random.GetStream();
+  uint64_t block = random.GetPosition() / Random::kBlockSize;
+  size_t used_outputs = (size_t) (random.GetPosition() % Random::kBlockSize);
+  uint32_t outputs[Random::kBlockSize] = {};
+  int32_t output_index = kLaneRandomOutputs;
+  if (used_outputs > 0) {
+    outputs[0] = (uint32_t) (block);
+    outputs[1] = (uint32_t) (block >> 32);
+    outputs[2] = (uint32_t) (stream);
+    outputs[3] = (uint32_t) (stream >> 32);
+    const uint32_t key[2] = {(uint32_t) (seed), (uint32_t) (seed >> 32)};
+    Random::Philox(outputs, key);
+    block++;
+    output_index = kLaneBlockSize + (int32_t) (used_outputs);
+  }
+
+  random_key_0_[game] = (int32_t) ((uint32_t) (seed));
+  random_key_1_[game] = (int32_t) ((uint32_t) (seed >> 32));
+  random_block_0_[game] = (int32_t) ((uint32_t) (block));
+  random_block_1_[game] = (int32_t) ((uint32_t) (block >> 32));
+  random_stream_0_[game] = (int32_t) ((uint32_t) (stream));
+  random_stream_1_[game] = (int32_t) ((uint32_t) (stream >> 32));
+  for (size_t output = 0; output < Random::kBlockSize; output++) {
+    random_outputs_[output][game] = 0;
+    random_outputs_[Random::kBlockSize + output][game] = (int32_t) (outputs[output]);
+  }
+  random_output_index_[game] = output_index;
+
+  uint8_t* tiles = &tiles_[game * kLaneTiles];
+  uint8_t* exits = &exits_[game * kLaneTiles];
+  for (size_t x = 0; x < kMaxLaneDimension; x++) {
+    for (size_t y = 0; y < kMaxLaneDimension; y++) {
+      bool is_on_board = x < engine.board_size_ && y < engine.board_size_;
+      size_t tile = (x << kLaneDimensionShift) + y;
+      tiles[tile] = (uint8_t) (is_on_board ? engine.game_map_->GetUnchecked(x, y) : TileType::Dirt);
+      exits[tile] = is_on_board ? engine.tunnel_exits_.GetExits(x, y) : 0;
+    }
+  }
+}
+
+void BatchGameEngine::StoreLane(size_t game) const {
+  GameEngine& engine = games_[game];
+  CharacterOrientation orientation = is_player_facing_left_[game] != 0 ? CharacterOrientation::Left
+                                                                       : CharacterOrientation::Right;
+  engine.player_ = Player::FromState({player_x_[game], player_y_[game]},
+                                     {player_prev_x_[game], player_prev_y_[game]}, orientation);
+  engine.delayed_turn_velocity_ = {delayed_turn_x_[game], delayed_turn_y_[game]};
+  engine.harpoon_ = Harpoon::FromState({arrow_x_[game], arrow_y_[game]},
+                                       {harpoon_velocity_x_[game], harpoon_velocity_y_[game]}, harpoon_step_[game],
+                                       harpoon_distance_[game]);
+  engine.player_attacking_ = is_attacking_[game] != 0;
+  engine.cur_attack_frames_ = (size_t) (attack_frames_[game]);
+
+  int32_t x[kMaxLaneEnemies];
+  int32_t y[kMaxLaneEnemies];
+  int32_t velocity_x[kMaxLaneEnemies];
+  int32_t velocity_y[kMaxLaneEnemies];
+  uint8_t flags[kMaxLaneEnemies];
+  for (size_t slot = 0; slot < kMaxLaneEnemies; slot++) {
+    size_t index = GetEnemyIndex(game, slot);
+    x[slot] = enemy_x_[index];
+    y[slot] = enemy_y_[index];
+    velocity_x[slot] = enemy_velocity_x_[index];
+    velocity_y[slot] = enemy_velocity_y_[index];
+    flags[slot] = (uint8_t) (enemy_flags_[index]);
+  }
+  engine.enemies_.Assign((size_t) (num_enemies_[game]), x, y, velocity_x, velocity_y, flags);
+  engine.ResetEnemyGrid();
+
+  engine.ghost_chance_ = (size_t) (ghost_chance_[game]);
+  engine.num_lives_ = (size_t) ((int64_t) (num_lives_[game]));
+  engine.score_ = score_[game];
+
+  uint64_t next_block = (uint64_t) ((uint32_t) (random_block_0_[game]))
+                        | ((uint64_t) ((uint32_t) (random_block_1_[game])) << 32);
+  uint64_t output_index = (uint64_t) (random_output_index_[game]);
+  uint64_t seed = (uint64_t) ((uint32_t) (random_key_0_[game])) | ((uint64_t) ((uint32_t) (random_key_1_[game])) << 32);
+  uint64_t stream = (uint64_t) ((uint32_t) (random_stream_0_[game]))
+                    | ((uint64_t) ((uint32_t) (random_stream_1_[game])) << 32);
+  engine.random_ = Random(seed, stream);
+  engine.random_.Seek(next_block * Random::kBlockSize + output_index - (uint64_t) (kLaneRandomOutputs));
+}
+
+void BatchGameEngine::UpdateMaxEnemies(size_t first) {
+  int32_t max_enemies = 0;
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    max_enemies = num_enemies_[first + lane] > max_enemies ? num_enemies_[first + lane] : max_enemies;
+  }
+
+  max_enemies_[first / kLaneWidth] = (size_t) (max_enemies);
+}
+
+LaneVector BatchGameEngine::DrawRandom(size_t first, const LaneVector& mask) {
+  const LaneVector kZero = SplatLanes(0);
+  const LaneVector kBlockSize = SplatLanes(kLaneBlockSize);
+  LaneVector output_index = LoadRow(random_output_index_, first);
+
+  if (IsAnyLane(mask & Equal(output_index, SplatLanes(kLaneRandomOutputs)))) {
+    // Runs Philox on every lane at once, like Random::Philox, and every lane that has used up its first block moves
+    // on by a block, whether it ran out or not
+    LaneVector moves_on = AndNot(Less(output_index, kBlockSize), SplatLanes(-1));
+    LaneVector block_0 = LoadRow(random_block_0_, first);
+    LaneVector block_1 = LoadRow(random_block_1_, first);
+    LaneVector counter[Random::kBlockSize] = {block_0, block_1, LoadRow(random_stream_0_, first),
+                                              LoadRow(random_stream_1_, first)};
+    LaneVector key_0 = LoadRow(random_key_0_, first);
+    LaneVector key_1 = LoadRow(random_key_1_, first);
+    const LaneVector kMultiplier0 = SplatLanes((int32_t) (Random::kPhiloxMultiplier0));
+    const LaneVector kMultiplier1 = SplatLanes((int32_t) (Random::kPhiloxMultiplier1));
+    const LaneVector kKeyIncrement0 = SplatLanes((int32_t) (Random::kPhiloxKeyIncrement0));
+    const LaneVector kKeyIncrement1 = SplatLanes((int32_t) (Random::kPhiloxKeyIncrement1));
+
+    for (size_t round = 0; round < Random::kPhiloxRounds; round++) {
+      LaneVector high_0;
+      LaneVector low_0;
+      LaneVector high_1;
+      LaneVector low_1;
+      MultiplyWide(kMultiplier0, counter[0], high_0, low_0);
+      MultiplyWide(kMultiplier1, counter[2], high_1, low_1);
+
+      counter[0] = high_1 ^ counter[1] ^ key_0;
+      counter[1] = low_1;
+      counter[2] = high_0 ^ counter[3] ^ key_1;
+      counter[3] = low_0;
+
+      key_0 = key_0 + kKeyIncrement0;
+      key_1 = key_1 + kKeyIncrement1;
+    }
+
+    for (size_t output = 0; output < Random::kBlockSize; output++) {
+      vector<int32_t>& first_block = random_outputs_[output];
+      vector<int32_t>& second_block = random_outputs_[Random::kBlockSize + output];
+      LaneVector second_output = LoadRow(second_block, first);
+      StoreRow(first_block, first, Select(moves_on, second_output, LoadRow(first_block, first)));
+      StoreRow(second_block, first, Select(moves_on, counter[output], second_output));
+    }
+
+    // Masks are -1, so subtracting one adds one to the block, carrying into the high word when the low word wraps
+    block_0 = block_0 - moves_on;
+    block_1 = block_1 - (moves_on & Equal(block_0, kZero));
+    StoreRow(random_block_0_, first, block_0);
+    StoreRow(random_block_1_, first, block_1);
+    output_index = output_index - (moves_on & kBlockSize);
+  }
+
+  // Picks each lane's output with selects on the bits of its index
+  const LaneVector kOne = SplatLanes(1);
+  const LaneVector kTwo = SplatLanes(2);
+  LaneVector is_odd = Equal(output_index & kOne, kOne);
+  LaneVector is_high_pair = Equal(output_index & kTwo, kTwo);
+  LaneVector is_second_block = Equal(output_index & kBlockSize, kBlockSize);
+  const size_t kNumPairs = (size_t) (kLaneRandomOutputs / 2);
+  LaneVector pairs[kNumPairs];
+  for (size_t pair = 0; pair < kNumPairs; pair++) {
+    pairs[pair] = Select(is_odd, LoadRow(random_outputs_[2 * pair + 1], first),
+                         LoadRow(random_outputs_[2 * pair], first));
+  }
+  LaneVector value = Select(is_second_block, Select(is_high_pair, pairs[3], pairs[2]),
+                            Select(is_high_pair, pairs[1], pairs[0]));
+  StoreRow(random_output_index_, first, output_index - mask);
+
+  return value;
+}
+
+LaneVector BatchGameEngine::GatherTiles(const vector<uint8_t>& tiles, size_t first, const LaneVector& x,
+                                        const LaneVector& y) const {
+  LaneVector lane_offsets = SplatLanes((int32_t) (first * kLaneTiles))
+                            + ShiftLeft<2 * kLaneDimensionShift>(GetLaneIndices());
+  LaneVector tile = (ShiftLeft<kLaneDimensionShift>(x) + y) & SplatLanes((int32_t) (kLaneTiles - 1));
+  return GatherBytes(tiles.data(), lane_offsets + tile);
+}
+
+LaneVector BatchGameEngine::DivideIntoTiles(const LaneVector& pixels, LaneVector& remainder) const {
+  // The high word of the product with the rounded up reciprocal is exact while pixels times the tile size stays well
+  // under 2^32, which holds with room to spare for the largest lane boards
+  LaneVector quotient = MultiplyHigh(pixels, SplatLanes((int32_t) (tile_size_reciprocal_)));
+  remainder = pixels - MultiplyLow(quotient, SplatLanes((int32_t) (tile_size_)));
+  return quotient;
+}
+
+LaneVector BatchGameEngine::IsTileAligned(const LaneVector& x, const LaneVector& y) const {
+  // Multiples of the tile size are the pixels whose product with the reciprocal wraps around to below it
+  const LaneVector kReciprocal = SplatLanes((int32_t) (tile_size_reciprocal_));
+  return LessUnsigned(MultiplyLow(LanesToPixels(x), kReciprocal), kReciprocal)
+         & LessUnsigned(MultiplyLow(LanesToPixels(y), kReciprocal), kReciprocal);
+}
+
+LaneVector BatchGameEngine::IsNextTileOpen(size_t first, const LaneVector& velocity_x, const LaneVector& velocity_y,
+                                           const LaneVector& x, const LaneVector& y) const {
+  const LaneVector kZero = SplatLanes(0);
+  const LaneVector kTileSize = SplatLanes((int32_t) (tile_size_));
+  LaneVector direction = GetTravelDirections(velocity_x, velocity_y);
+  // Right and Left are the even directions
+  LaneVector is_horizontal = Equal(direction & SplatLanes(1), kZero);
+  LaneVector position_along = LanesToPixels(Select(is_horizontal, x, y));
+  LaneVector position_across = LanesToPixels(Select(is_horizontal, y, x));
+  LaneVector velocity_along = LanesToPixels(Select(is_horizontal, velocity_x, velocity_y));
+
+  // Objects moving right or down are checked from their far edge, one tile past their position
+  LaneVector lead = Less(direction, SplatLanes((int32_t) (Direction::Left))) & kTileSize;
+  LaneVector next_pixel = position_along + velocity_along + lead;
+  LaneVector board_pixels = MultiplyLow(LoadRow(board_size_, first), kTileSize);
+  LaneVector is_on_board = AndNot(Less(next_pixel, kZero), Less(next_pixel, board_pixels));
+
+  LaneVector remainder;
+  LaneVector next_along = DivideIntoTiles(next_pixel, remainder);
+  LaneVector next_across = DivideIntoTiles(position_across, remainder);
+  LaneVector tile = GatherTiles(tiles_, first, Select(is_horizontal, next_along, next_across),
+                                Select(is_horizontal, next_across, next_along));
+
+  return AndNot(Equal(tile, SplatLanes((int32_t) (TileType::Rock))), is_on_board);
+}
+
+LaneVector BatchGameEngine::FindWalkingEnemiesNear(size_t first, const LaneVector& x, const LaneVector& y) const {
+  const LaneVector kZero = SplatLanes(0);
+  int32_t tile_size_fixed = PixelsToFixed((int32_t) (tile_size_));
+  const LaneVector kTileSize = SplatLanes(tile_size_fixed);
+  uint32_t tile_size_squared = (uint32_t) (tile_size_fixed) * (uint32_t) (tile_size_fixed);
+  const LaneVector kTileSizeSquared = SplatLanes((int32_t) (tile_size_squared));
+  LaneVector num_enemies = LoadRow(num_enemies_, first);
+  LaneVector found = SplatLanes((int32_t) (kMaxLaneEnemies));
+
+  // Goes from the last slot down so the lowest slot that is near wins
+  for (size_t slot = GetMaxEnemies(first); slot-- > 0;) {
+    size_t index = GetEnemyIndex(first, slot);
+    LaneVector offset_x = LoadLanes(&enemy_x_[index]) - x;
+    LaneVector offset_y = LoadLanes(&enemy_y_[index]) - y;
+
+    // Offsets under a tile along both axes square to less than 2^32 between them, and enemies are hardly ever that
+    // close, so the rest is skipped for slots where none are
+    LaneVector is_close = Less(AbsLanes(offset_x), kTileSize) & Less(AbsLanes(offset_y), kTileSize);
+    if (!IsAnyLane(is_close)) {
+      continue;
+    }
+
+    LaneVector is_walking = Greater(num_enemies, SplatLanes((int32_t) (slot)))
+                            & Equal(LoadLanes(&enemy_flags_[index]) & SplatLanes(kGhostFlag), kZero);
+    LaneVector length_squared = MultiplyLow(offset_x, offset_x) + MultiplyLow(offset_y, offset_y);
+    LaneVector is_near = is_walking & is_close & LessUnsigned(length_squared, kTileSizeSquared);
+    found = Select(is_near, SplatLanes((int32_t) (slot)), found);
+  }
+
+  return found;
+}
+
+void BatchGameEngine::SetEnemyFlag(size_t first, const LaneVector& mask, const LaneVector& slot, int32_t flag) {
+  size_t max_enemies = GetMaxEnemies(first);
+  for (size_t current = 0; current < max_enemies; current++) {
+    int32_t* flags = &enemy_flags_[GetEnemyIndex(first, current)];
+    LaneVector is_set = mask & Equal(slot, SplatLanes((int32_t) (current)));
+    StoreLanes(flags, LoadLanes(flags) | (is_set & SplatLanes(flag)));
+  }
+}
+
+void BatchGameEngine::MovePlayers(size_t first, const LaneVector& mask, const LaneVector& velocity_x,
+                                  const LaneVector& velocity_y) {
+  const LaneVector kZero = SplatLanes(0);
+  const LaneVector kTrue = SplatLanes(-1);
+
+  // Resets all attack fields because no enemy is being attacked if the player is moving
+  StoreRow(attack_frames_, first, AndNot(mask, LoadRow(attack_frames_, first)));
+  StoreRow(is_attacking_, first, AndNot(mask, LoadRow(is_attacking_, first)));
+  size_t max_enemies = GetMaxEnemies(first);
+  for (size_t slot = 0; slot < max_enemies; slot++) {
+    int32_t* flags = &enemy_flags_[GetEnemyIndex(first, slot)];
+    StoreLanes(flags, AndNot(mask & SplatLanes(kHurtFlag), LoadLanes(flags)));
+  }
+
+  LaneVector x = LoadRow(player_x_, first);
+  LaneVector y = LoadRow(player_y_, first);
+  LaneVector is_open = mask & IsNextTileOpen(first, velocity_x, velocity_y, x, y);
+  if (!IsAnyLane(is_open)) {
+    return;
+  }
+
+  LaneVector prev_x = LoadRow(player_prev_x_, first);
+  LaneVector prev_y = LoadRow(player_prev_y_, first);
+  LaneVector delayed_x = LoadRow(delayed_turn_x_, first);
+  LaneVector delayed_y = LoadRow(delayed_turn_y_, first);
+  LaneVector is_aligned = is_open & IsTileAligned(x, y);
+  LaneVector is_zero = Equal(velocity_x, kZero) & Equal(velocity_y, kZero);
+  LaneVector is_same = Equal(velocity_x, prev_x) & Equal(velocity_y, prev_y);
+  LaneVector is_opposite = Equal(kZero - velocity_x, prev_x) & Equal(kZero - velocity_y, prev_y);
+  LaneVector is_delayed = AndNot(Equal(delayed_x, kZero) & Equal(delayed_y, kZero), kTrue);
+
+  // Drops a delayed turn that would go off the board or into a rock
+  LaneVector checks_delayed = is_aligned & is_delayed;
+  if (IsAnyLane(checks_delayed)) {
+    LaneVector drops = AndNot(IsNextTileOpen(first, delayed_x, delayed_y, x, y), checks_delayed);
+    delayed_x = AndNot(drops, delayed_x);
+    delayed_y = AndNot(drops, delayed_y);
+    is_delayed = AndNot(drops, is_delayed);
+  }
+
+  // Turns that were asked for in the middle of a tile happen once the player reaches the next one, and until then
+  // the player keeps going the way it was
+  LaneVector turns_now = is_aligned & (is_same | is_zero) & is_delayed;
+  LaneVector keeps_going = AndNot(is_aligned, is_open) & AndNot(is_same | is_opposite, kTrue);
+  LaneVector move_x = Select(turns_now, delayed_x, Select(keeps_going, prev_x, velocity_x));
+  LaneVector move_y = Select(turns_now, delayed_y, Select(keeps_going, prev_y, velocity_y));
+  LaneVector delays_turn = AndNot(is_zero, keeps_going);
+  StoreRow(delayed_turn_x_, first, AndNot(turns_now, Select(delays_turn, velocity_x, delayed_x)));
+  StoreRow(delayed_turn_y_, first, AndNot(turns_now, Select(delays_turn, velocity_y, delayed_y)));
+
+  // Player::MoveFixed
+  x = x + (is_open & move_x);
+  y = y + (is_open & move_y);
+  LaneVector moves = AndNot(Equal(move_x, kZero) & Equal(move_y, kZero), is_open);
+  StoreRow(player_x_, first, x);
+  StoreRow(player_y_, first, y);
+  StoreRow(player_prev_x_, first, Select(moves, move_x, prev_x));
+  StoreRow(player_prev_y_, first, Select(moves, move_y, prev_y));
+  LaneVector is_facing_left = LoadRow(is_player_facing_left_, first);
+  is_facing_left = AndNot(is_open & Greater(move_x, kZero), is_facing_left) | (is_open & Less(move_x, kZero));
+  StoreRow(is_player_facing_left_, first, is_facing_left);
+
+  // A delayed turn digs as if the player were standing still
+  DigUpTiles(first, is_open, x, y, AndNot(turns_now, move_x), AndNot(turns_now, move_y));
+}
+
+void BatchGameEngine::DigUpTiles(size_t first, const LaneVector& mask, const LaneVector& x, const LaneVector& y,
+                                 const LaneVector& velocity_x, const LaneVector& velocity_y) {
+  const LaneVector kZero = SplatLanes(0);
+  const LaneVector kOne = SplatLanes(1);
+  const LaneVector kTileSize = SplatLanes((int32_t) (tile_size_));
+  LaneVector pixel_x = LanesToPixels(x);
+  LaneVector pixel_y = LanesToPixels(y);
+  LaneVector remainder_x;
+  LaneVector remainder_y;
+  LaneVector tile_x = DivideIntoTiles(pixel_x, remainder_x);
+  LaneVector tile_y = DivideIntoTiles(pixel_y, remainder_y);
+
+  // So player does not dig up tile it has not entered yet
+  LaneVector is_entering = AndNot(Equal(remainder_x, kZero) & Equal(remainder_y, kZero), mask);
+  if (!IsAnyLane(is_entering)) {
+    return;
+  }
+
+  // Players moving right or down dig the tile their far edge is in, which is the last tile at the edge of the board,
+  // like GameEngine::GetIndexOfPlayer
+  LaneVector board_size = LoadRow(board_size_, first);
+  LaneVector board_pixels = MultiplyLow(board_size, kTileSize);
+  LaneVector far_x = Select(Equal(pixel_x + kTileSize, board_pixels), board_size - kOne, tile_x + kOne);
+  LaneVector far_y = Select(Equal(pixel_y + kTileSize, board_pixels), board_size - kOne, tile_y + kOne);
+  LaneVector is_right = Greater(velocity_x, kZero) & Equal(velocity_y, kZero);
+  LaneVector is_down = Greater(velocity_y, kZero) & Equal(velocity_x, kZero);
+  LaneVector dig_x = Select(is_right, far_x, tile_x);
+  LaneVector dig_y = Select(is_down, far_y, tile_y);
+
+  // Tiles that are already tunnels stay as they are, so only the first move into a tile leaves the lanes
+  LaneVector digs = is_entering
+                    & NotEqual(GatherTiles(tiles_, first, dig_x, dig_y), SplatLanes((int32_t) (TileType::Tunnel)));
+  int dig_lanes = GetLaneBits(digs);
+  if (dig_lanes == 0) {
+    return;
+  }
+
+  int32_t dig_xs[kLaneWidth];
+  int32_t dig_ys[kLaneWidth];
+  StoreLanes(dig_xs, dig_x);
+  StoreLanes(dig_ys, dig_y);
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    if ((dig_lanes >> lane) & 1) {
+      DigTile(first + lane, (size_t) (dig_xs[lane]), (size_t) (dig_ys[lane]));
+    }
+  }
+}
+
+void BatchGameEngine::DigTile(size_t game, size_t x, size_t y) {
+  GameEngine& engine = games_[game];
+  engine.SetTile(x, y, TileType::Tunnel);
+
+  // Digging a tile opens an exit into it from each of its neighbors
+  size_t lane_tiles = game * kLaneTiles;
+  tiles_[lane_tiles + (x << kLaneDimensionShift) + y] = (uint8_t) (TileType::Tunnel);
+  for (size_t direction = 0; direction < kNumDirections; direction++) {
+    size_t next_x;
+    size_t next_y;
+    if (GetNeighbor(x, y, static_cast<Direction>(direction), engine.board_size_, next_x, next_y)) {
+      exits_[lane_tiles + (next_x << kLaneDimensionShift) + next_y] = engine.tunnel_exits_.GetExits(next_x, next_y);
+    }
+  }
+}
+
+void BatchGameEngine::AttackEnemies(size_t first, const LaneVector& mask) {
+  const LaneVector kTrue = SplatLanes(-1);
+  LaneVector is_attacking = LoadRow(is_attacking_, first);
+  LaneVector starts = AndNot(is_attacking, mask);
+  LaneVector arrow_x = LoadRow(arrow_x_, first);
+  LaneVector arrow_y = LoadRow(arrow_y_, first);
+  LaneVector velocity_x = LoadRow(harpoon_velocity_x_, first);
+  LaneVector velocity_y = LoadRow(harpoon_velocity_y_, first);
+  LaneVector step = LoadRow(harpoon_step_, first);
+  LaneVector distance = LoadRow(harpoon_distance_, first);
+
+  // Creates a harpoon at the player, shot the way the player last moved
+  if (IsAnyLane(starts)) {
+    const LaneVector kHarpoonSpeed = SplatLanes(GameEngine::kHarpoonSpeed);
+    LaneVector direction = GetTravelDirections(LoadRow(player_prev_x_, first), LoadRow(player_prev_y_, first));
+    LaneVector shot_x;
+    LaneVector shot_y;
+    GetDirectionVelocities(direction, kHarpoonSpeed, shot_x, shot_y);
+    arrow_x = Select(starts, LoadRow(player_x_, first), arrow_x);
+    arrow_y = Select(starts, LoadRow(player_y_, first), arrow_y);
+    velocity_x = Select(starts, shot_x, velocity_x);
+    velocity_y = Select(starts, shot_y, velocity_y);
+    step = Select(starts, kHarpoonSpeed, step);
+    distance = AndNot(starts, distance);
+    StoreRow(harpoon_velocity_x_, first, velocity_x);
+    StoreRow(harpoon_velocity_y_, first, velocity_y);
+    StoreRow(harpoon_step_, first, step);
+  }
+  is_attacking = is_attacking | mask;
+
+  LaneVector hurt_slot = FindWalkingEnemiesNear(first, arrow_x, arrow_y);
+  LaneVector hurts = mask & Less(hurt_slot, SplatLanes((int32_t) (kMaxLaneEnemies)));
+  LaneVector attack_frames = LoadRow(attack_frames_, first) - hurts;
+  StoreRow(attack_frames_, first, attack_frames);
+  if (IsAnyLane(hurts)) {
+    SetEnemyFlag(first, hurts, hurt_slot, kHurtFlag);
+  }
+
+  // The harpoon stops when it has gone its full length or reaches the end of the tunnel, and moves on otherwise
+  LaneVector misses = AndNot(hurts, mask);
+  if (IsAnyLane(misses)) {
+    StoreRow(arrow_x_, first, arrow_x);
+    StoreRow(arrow_y_, first, arrow_y);
+    LaneVector is_spent = AndNot(Less(distance, SplatLanes(max_harpoon_distance_)), kTrue);
+    LaneVector stops = misses & (is_spent | AndNot(CanHarpoonsContinue(first), kTrue));
+    is_attacking = AndNot(stops, is_attacking);
+    LaneVector moves = AndNot(stops, misses);
+    arrow_x = arrow_x + (moves & velocity_x);
+    arrow_y = arrow_y + (moves & velocity_y);
+    distance = distance + (moves & step);
+  }
+
+  StoreRow(arrow_x_, first, arrow_x);
+  StoreRow(arrow_y_, first, arrow_y);
+  StoreRow(harpoon_distance_, first, distance);
+  StoreRow(is_attacking_, first, is_attacking);
+
+  int kill_lanes = GetLaneBits(hurts & AndNot(Less(attack_frames, SplatLanes((int32_t) (GameEngine::kAttackFrames))),
+                                              kTrue));
+  if (kill_lanes != 0) {
+    int32_t slots[kLaneWidth];
+    StoreLanes(slots, hurt_slot);
+    for (size_t lane = 0; lane < kLaneWidth; lane++) {
+      if ((kill_lanes >> lane) & 1) {
+        KillEnemy(first + lane, (size_t) (slots[lane]));
+      }
+    }
+  }
+}
+
+LaneVector BatchGameEngine::CanHarpoonsContinue(size_t first) const {
+  const LaneVector kZero = SplatLanes(0);
+  LaneVector arrow_x = LoadRow(arrow_x_, first);
+  LaneVector arrow_y = LoadRow(arrow_y_, first);
+  LaneVector velocity_x = LoadRow(harpoon_velocity_x_, first);
+  LaneVector velocity_y = LoadRow(harpoon_velocity_y_, first);
+
+  // The tile in front of the arrow is checked when it points right or down. Harpoons are always shot along one axis
+  const LaneVector kTileSize = SplatLanes(PixelsToFixed((int32_t) (tile_size_)));
+  LaneVector next_x = arrow_x + (Greater(velocity_x, kZero) & kTileSize);
+  LaneVector next_y = arrow_y + (Greater(velocity_y, kZero) & kTileSize);
+  LaneVector is_negative = Less(arrow_x, kZero) | Less(arrow_y, kZero) | Less(next_x, kZero) | Less(next_y, kZero);
+
+  LaneVector remainder;
+  LaneVector arrow_tile_x = DivideIntoTiles(LanesToPixels(arrow_x), remainder);
+  LaneVector arrow_tile_y = DivideIntoTiles(LanesToPixels(arrow_y), remainder);
+  LaneVector next_tile_x = DivideIntoTiles(LanesToPixels(next_x), remainder);
+  LaneVector next_tile_y = DivideIntoTiles(LanesToPixels(next_y), remainder);
+  LaneVector board_size = LoadRow(board_size_, first);
+  LaneVector is_on_board = Less(arrow_tile_x, board_size) & Less(arrow_tile_y, board_size)
+                           & Less(next_tile_x, board_size) & Less(next_tile_y, board_size);
+
+  const LaneVector kTunnel = SplatLanes((int32_t) (TileType::Tunnel));
+  LaneVector is_in_tunnel = Equal(GatherTiles(tiles_, first, arrow_tile_x, arrow_tile_y), kTunnel)
+                            & Equal(GatherTiles(tiles_, first, next_tile_x, next_tile_y), kTunnel);
+
+  return AndNot(is_negative, is_on_board & is_in_tunnel);
+}
+
+void BatchGameEngine::KillEnemy(size_t game, size_t slot) {
+  size_t last = GetEnemyIndex(game, (size_t) (num_enemies_[game]) - 1);
+  size_t index = GetEnemyIndex(game, slot);
+  enemy_x_[index] = enemy_x_[last];
+  enemy_y_[index] = enemy_y_[last];
+  enemy_velocity_x_[index] = enemy_velocity_x_[last];
+  enemy_velocity_y_[index] = enemy_velocity_y_[last];
+  enemy_flags_[index] = enemy_flags_[last];
+  num_enemies_[game]--;
+  UpdateMaxEnemies(game - game % kLaneWidth);
+
+  attack_frames_[game] = 0;
+  is_attacking_[game] = 0;
+  score_[game] += GameEngine::kEnemyKillScore;
+}
+
+LaneVector BatchGameEngine::FindPlayerDeaths(size_t first, const LaneVector& mask) {
+  LaneVector found = FindWalkingEnemiesNear(first, LoadRow(player_x_, first), LoadRow(player_y_, first));
+  LaneVector dies = mask & Less(found, SplatLanes((int32_t) (kMaxLaneEnemies)));
+  StoreRow(num_lives_, first, LoadRow(num_lives_, first) + dies);
+  return dies;
+}
+
+void BatchGameEngine::MoveLaneEnemies(size_t first, const LaneVector& mask) {
+  const LaneVector kZero = SplatLanes(0);
+  LaneVector num_enemies = LoadRow(num_enemies_, first);
+
+  // Turns an enemy into a ghost if random number below the ghost chance, drawing both numbers whenever the engine
+  // would
+  LaneVector roll = MultiplyHigh(DrawRandom(first, mask), SplatLanes((int32_t) (GameEngine::kGhostChanceScale)));
+  LaneVector ghosts = mask & Less(roll, LoadRow(ghost_chance_, first)) & Greater(num_enemies, kZero);
+  if (IsAnyLane(ghosts)) {
+    SetEnemyFlag(first, ghosts, MultiplyHigh(DrawRandom(first, ghosts), num_enemies), kGhostFlag);
+  }
+
+  LaneVector is_attacking = mask & LoadRow(is_attacking_, first);
+  if (IsAnyLane(is_attacking)) {
+    LaneVector hurt_slot = FindWalkingEnemiesNear(first, LoadRow(arrow_x_, first), LoadRow(arrow_y_, first));
+    SetEnemyFlag(first, is_attacking & Less(hurt_slot, SplatLanes((int32_t) (kMaxLaneEnemies))), hurt_slot,
+                 kHurtFlag);
+  }
+
+  size_t max_enemies = GetMaxEnemies(first);
+  for (size_t slot = 0; slot < max_enemies; slot++) {
+    size_t index = GetEnemyIndex(first, slot);
+    LaneVector flags = LoadLanes(&enemy_flags_[index]);
+    LaneVector moves = mask & Greater(num_enemies, SplatLanes((int32_t) (slot)))
+                       & Equal(flags & SplatLanes(kHurtFlag), kZero);
+    if (!IsAnyLane(moves)) {
+      continue;
+    }
+
+    LaneVector is_ghost = moves & NotEqual(flags & SplatLanes(kGhostFlag), kZero);
+    LaneVector walks = AndNot(is_ghost, moves);
+    if (IsAnyLane(is_ghost)) {
+      walks = walks | MoveGhosts(first, slot, is_ghost);
+    }
+    if (IsAnyLane(walks)) {
+      TurnWalkingEnemies(first, slot, walks);
+    }
+
+    StoreLanes(&enemy_x_[index], LoadLanes(&enemy_x_[index]) + (moves & LoadLanes(&enemy_velocity_x_[index])));
+    StoreLanes(&enemy_y_[index], LoadLanes(&enemy_y_[index]) + (moves & LoadLanes(&enemy_velocity_y_[index])));
+  }
+}
+
+LaneVector BatchGameEngine::MoveGhosts(size_t first, size_t slot, const LaneVector& mask) {
+  const LaneVector kZero = SplatLanes(0);
+  const LaneVector kEnemySpeed = SplatLanes(GameEngine::kEnemySpeed);
+  size_t index = GetEnemyIndex(first, slot);
+  LaneVector x = LoadLanes(&enemy_x_[index]);
+  LaneVector y = LoadLanes(&enemy_y_[index]);
+  LaneVector flags = LoadLanes(&enemy_flags_[index]);
+  LaneVector distance_x = LoadRow(player_x_, first) - x;
+  LaneVector distance_y = LoadRow(player_y_, first) - y;
+  LaneVector distance = LengthLanes(distance_x, distance_y);
+
+  // The space outside the board counts as dirt
+  LaneVector remainder;
+  LaneVector tile_x = DivideIntoTiles(LanesToPixels(x), remainder);
+  LaneVector tile_y = DivideIntoTiles(LanesToPixels(y), remainder);
+  LaneVector board_size = LoadRow(board_size_, first);
+  LaneVector is_on_board = AndNot(Less(x, kZero) | Less(y, kZero), Less(tile_x, board_size) & Less(tile_y, board_size));
+  LaneVector tile = Select(is_on_board, GatherTiles(tiles_, first, tile_x, tile_y),
+                           SplatLanes((int32_t) (TileType::Dirt)));
+  LaneVector is_in_dirt = Equal(tile, SplatLanes((int32_t) (TileType::Dirt)))
+                          | Equal(tile, SplatLanes((int32_t) (TileType::Rock)));
+  flags = flags | (mask & is_in_dirt & SplatLanes(kInDirtFlag));
+
+  // Walks again from the tile it came out on, facing right
+  LaneVector walks = mask & Equal(tile, SplatLanes((int32_t) (TileType::Tunnel)))
+                     & Less(distance, SplatLanes(GameEngine::kGhostDistanceBuffer))
+                     & NotEqual(flags & SplatLanes(kInDirtFlag), kZero);
+  LaneVector chases = AndNot(walks, mask);
+  const LaneVector kTileSize = SplatLanes((int32_t) (tile_size_));
+  x = Select(walks, ShiftLeft<kFixedShift>(MultiplyLow(tile_x, kTileSize)), x);
+  y = Select(walks, ShiftLeft<kFixedShift>(MultiplyLow(tile_y, kTileSize)), y);
+  flags = AndNot(walks & SplatLanes(kGhostFlag | kInDirtFlag | kFacingLeftFlag), flags);
+
+  // A ghost already on top of the player divides by a distance of zero, which stops it
+  LaneVector chase_x = DivideLanes(MultiplyLow(distance_x, kEnemySpeed), distance);
+  LaneVector chase_y = DivideLanes(MultiplyLow(distance_y, kEnemySpeed), distance);
+  LaneVector velocity_x = Select(walks, kEnemySpeed, Select(chases, chase_x, LoadLanes(&enemy_velocity_x_[index])));
+  LaneVector velocity_y = Select(walks, kZero, Select(chases, chase_y, LoadLanes(&enemy_velocity_y_[index])));
+  flags = FaceAlong(flags, chases, velocity_x);
+
+  StoreLanes(&enemy_x_[index], x);
+  StoreLanes(&enemy_y_[index], y);
+  StoreLanes(&enemy_velocity_x_[index], velocity_x);
+  StoreLanes(&enemy_velocity_y_[index], velocity_y);
+  StoreLanes(&enemy_flags_[index], flags);
+  return walks;
+}
+
+void BatchGameEngine::TurnWalkingEnemies(size_t first, size_t slot, const LaneVector& mask) {
+  const LaneVector kZero = SplatLanes(0);
+  const LaneVector kOne = SplatLanes(1);
+  const LaneVector kDirectionMask = SplatLanes((int32_t) (kNumDirections - 1));
+  size_t index = GetEnemyIndex(first, slot);
+  LaneVector x = LoadLanes(&enemy_x_[index]);
+  LaneVector y = LoadLanes(&enemy_y_[index]);
+  LaneVector velocity_x = LoadLanes(&enemy_velocity_x_[index]);
+  LaneVector velocity_y = LoadLanes(&enemy_velocity_y_[index]);
+
+  // Enemy is aligned with a tile on the board
+  LaneVector turns = mask & IsTileAligned(x, y);
+  if (!IsAnyLane(turns)) {
+    return;
+  }
+
+  // The possible moves are forward, left and right in that order, each there if the tile has an exit that way
+  LaneVector direction = GetTravelDirections(velocity_x, velocity_y);
+  LaneVector left = (direction + SplatLanes((int32_t) (kNumDirections - 1))) & kDirectionMask;
+  LaneVector right = (direction + kOne) & kDirectionMask;
+  LaneVector remainder;
+  LaneVector tile_x = DivideIntoTiles(LanesToPixels(x), remainder);
+  LaneVector tile_y = DivideIntoTiles(LanesToPixels(y), remainder);
+  LaneVector exits = GatherTiles(exits_, first, tile_x, tile_y);
+  LaneVector has_forward = ShiftRightByLanes(exits, direction) & kOne;
+  LaneVector has_left = ShiftRightByLanes(exits, left) & kOne;
+  LaneVector has_right = ShiftRightByLanes(exits, right) & kOne;
+  LaneVector num_moves = has_forward + has_left + has_right;
+
+  LaneVector reverses = turns & Equal(num_moves, kZero);
+  LaneVector chooses = AndNot(reverses, turns);
+  LaneVector turns_left = kZero;
+  LaneVector turns_right = kZero;
+  if (IsAnyLane(chooses)) {
+    LaneVector move = MultiplyHigh(DrawRandom(first, chooses), num_moves);
+    turns_left = chooses & Equal(has_left, kOne) & Equal(move, has_forward);
+    turns_right = chooses & Equal(has_right, kOne) & Equal(move, has_forward + has_left);
+  }
+
+  LaneVector speed = AbsLanes(velocity_x) + AbsLanes(velocity_y);
+  LaneVector turn_x;
+  LaneVector turn_y;
+  GetDirectionVelocities(Select(turns_left, left, right), speed, turn_x, turn_y);
+  LaneVector is_turning = turns_left | turns_right;
+  velocity_x = Select(is_turning, turn_x, Select(reverses, kZero - velocity_x, velocity_x));
+  velocity_y = Select(is_turning, turn_y, Select(reverses, kZero - velocity_y, velocity_y));
+
+  int32_t* flags = &enemy_flags_[index];
+  StoreLanes(flags, FaceAlong(LoadLanes(flags), is_turning | reverses, velocity_x));
+  StoreLanes(&enemy_velocity_x_[index], velocity_x);
+  StoreLanes(&enemy_velocity_y_[index], velocity_y);
+}
+
+void BatchGameEngine::ApplyLaneActions(size_t first, const LaneVector& mask, const PlayerAction* actions) {
+  // The last block can run past the end of the actions, so its actions are copied out first
+  static_assert(sizeof(PlayerAction) == 1, "Actions are loaded into the lanes as bytes");
+  uint8_t block_actions[kLaneWidth] = {};
+  const uint8_t* codes = reinterpret_cast<const uint8_t*>(actions + first);
+  if (first + kLaneWidth > num_games_) {
+    for (size_t game = first; game < num_games_; game++) {
+      block_actions[game - first] = static_cast<uint8_t>(actions[game]);
+    }
+    codes = block_actions;
+  }
+
+  // Follows ApplyAction, with the moves in the same order as the directions
+  LaneVector action = LoadByteLanes(codes);
+  LaneVector moves = mask & Greater(action, SplatLanes((int32_t) (PlayerAction::None)))
+                     & Less(action, SplatLanes((int32_t) (PlayerAction::Attack)));
+  if (IsAnyLane(moves)) {
+    LaneVector velocity_x;
+    LaneVector velocity_y;
+    GetDirectionVelocities(action - SplatLanes((int32_t) (PlayerAction::Right)), SplatLanes(kPlayerStep),
+                           velocity_x, velocity_y);
+    MovePlayers(first, moves, velocity_x, velocity_y);
+  }
+
+  LaneVector attacks = mask & Equal(action, SplatLanes((int32_t) (PlayerAction::Attack)));
+  if (IsAnyLane(attacks)) {
+    AttackEnemies(first, attacks);
+  }
+}
+
+LaneVector BatchGameEngine::GetLaneMask(size_t lane) {
+  return Equal(GetLaneIndices(), SplatLanes((int32_t) (lane)));
+}
+
+} // namespace dig_dug
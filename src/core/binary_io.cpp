@@ -0,0 +1,104 @@
+#include "core/binary_io.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace dig_dug {
+
+const size_t kBitsPerByte = 8;
+const size_t kVarintBits = 7;
+const uint8_t kVarintMask = 0x7F;
+const uint8_t kVarintContinue = 0x80;
+
+void PutVarint(vector<uint8_t>& out, uint64_t value) {
+  while (value > kVarintMask) {
+    out.push_back((uint8_t) ((value & kVarintMask) | kVarintContinue));
+    value >>= kVarintBits;
+  }
+
+  out.push_back((uint8_t) (value));
+}
+
+void PutFixed32(vector<uint8_t>& out, uint32_t value) {
+  for (size_t byte = 0; byte < sizeof(value); byte++) {
+    out.push_back((uint8_t) (value >> (byte * kBitsPerByte)));
+  }
+}
+
+void PutFixed64(vector<uint8_t>& out, uint64_t value) {
+  for (size_t byte = 0; byte < sizeof(value); byte++) {
+    out.push_back((uint8_t) (value >> (byte * kBitsPerByte)));
+  }
+}
+
+ByteReader::ByteReader(const uint8_t* data, size_t size) : data_(data), size_(size) {
+}
+
+uint64_t ByteReader::ReadVarint() {
+  uint64_t value = 0;
+
+  for (size_t shift = 0; shift < sizeof(value) * kBitsPerByte; shift += kVarintBits) {
+    Require(1);
+    uint8_t byte = data_[offset_];
+    offset_++;
+
+    value |= (uint64_t) (byte & kVarintMask) << shift;
+    if ((byte & kVarintContinue) == 0) {
+      return value;
+    }
+  }
+
+  throw std::runtime_error("Varint is longer than 64 bits");
+}
+
+uint32_t ByteReader::ReadFixed32() {
+  Require(sizeof(uint32_t));
+  uint32_t value = 0;
+  for (size_t byte = 0; byte < sizeof(value); byte++) {
+    value |= (uint32_t) (data_[offset_ + byte]) << (byte * kBitsPerByte);
+  }
+
+  offset_ += sizeof(value);
+  return value;
+}
+
+uint64_t ByteReader::ReadFixed64() {
+  Require(sizeof(uint64_t));
+  uint64_t value = 0;
+  for (size_t byte = 0; byte < sizeof(value); byte++) {
+    value |= (uint64_t) (data_[offset_ + byte]) << (byte * kBitsPerByte);
+  }
+
+  offset_ += sizeof(value);
+  return value;
+}
+
+void ByteReader::ReadBytes(void* out, size_t size) {
+  Require(size);
+  std::memcpy(out, data_ + offset_, size);
+  offset_ += size;
+}
+
+void ByteReader::Seek(size_t offset) {
+  if (offset > size_) {
+    throw std::runtime_error("Offset is past the end of the data");
+  }
+
+  offset_ = offset;
+}
+
+size_t ByteReader::GetOffset() const {
+  return offset_;
+}
+
+size_t ByteReader::GetNumLeft() const {
+  return size_ - offset_;
+}
+
+void ByteReader::Require(size_t size) const {
+  if (size > size_ - offset_) {
+    throw std::runtime_error("Data ends too early");
+  }
+}
+
+} // namespace dig_dug
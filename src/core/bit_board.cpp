@@ -0,0 +1,166 @@
+#include "core/bit_board.h"
+
+#include <stdexcept>
+
+namespace dig_dug {
+
+namespace {
+
+// Bits of every tile with y = 0 and y = 15 within one 64-bit word
+const uint64_t kMinYMask = 0x0001000100010001ULL;
+const uint64_t kMaxYMask = 0x8000800080008000ULL;
+
+size_t CountBits(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (size_t) (__builtin_popcountll(word));
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (size_t) ((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+} // namespace
+
+BitBoard BitBoard::Full(size_t dimension) {
+  if (dimension > kMaxDimension) {
+    throw std::invalid_argument("Board is too large for a bit board");
+  }
+
+  BitBoard board;
+  for (size_t x = 0; x < dimension; x++) {
+    for (size_t y = 0; y < dimension; y++) {
+      board.Set(x, y);
+    }
+  }
+
+  return board;
+}
+
+size_t BitBoard::Count() const {
+  size_t count = 0;
+  for (size_t word = 0; word < kNumWords; word++) {
+    count += CountBits(words_[word]);
+  }
+
+  return count;
+}
+
+bool BitBoard::IsEmpty() const {
+  return (words_[0] | words_[1] | words_[2] | words_[3]) == 0;
+}
+
+BitBoard BitBoard::ShiftedPlusX() const {
+  return ShiftedLeft(kMaxDimension);
+}
+
+BitBoard BitBoard::ShiftedMinusX() const {
+  return ShiftedRight(kMaxDimension);
+}
+
+BitBoard BitBoard::ShiftedPlusY() const {
+  // Tiles at y = 15 wrap around to y = 0 of the next x, so those bits are cleared
+  BitBoard shifted = ShiftedLeft(1);
+  for (size_t word = 0; word < kNumWords; word++) {
+    shifted.words_[word] &= ~kMinYMask;
+  }
+
+  return shifted;
+}
+
+BitBoard BitBoard::ShiftedMinusY() const {
+  // Tiles at y = 0 wrap around to y = 15 of the previous x, so those bits are cleared
+  BitBoard shifted = ShiftedRight(1);
+  for (size_t word = 0; word < kNumWords; word++) {
+    shifted.words_[word] &= ~kMaxYMask;
+  }
+
+  return shifted;
+}
+
+BitBoard BitBoard::Neighbors() const {
+  BitBoard neighbors = ShiftedPlusX() | ShiftedMinusX() | ShiftedPlusY() | ShiftedMinusY();
+  return neighbors & ~*this;
+}
+
+BitBoard BitBoard::operator&(const BitBoard& other) const {
+  BitBoard result = *this;
+  result &= other;
+  return result;
+}
+
+BitBoard BitBoard::operator|(const BitBoard& other) const {
+  BitBoard result = *this;
+  result |= other;
+  return result;
+}
+
+BitBoard BitBoard::operator^(const BitBoard& other) const {
+  BitBoard result;
+  for (size_t word = 0; word < kNumWords; word++) {
+    result.words_[word] = words_[word] ^ other.words_[word];
+  }
+
+  return result;
+}
+
+BitBoard BitBoard::operator~() const {
+  BitBoard result;
+  for (size_t word = 0; word < kNumWords; word++) {
+    result.words_[word] = ~words_[word];
+  }
+
+  return result;
+}
+
+BitBoard& BitBoard::operator&=(const BitBoard& other) {
+  for (size_t word = 0; word < kNumWords; word++) {
+    words_[word] &= other.words_[word];
+  }
+
+  return *this;
+}
+
+BitBoard& BitBoard::operator|=(const BitBoard& other) {
+  for (size_t word = 0; word < kNumWords; word++) {
+    words_[word] |= other.words_[word];
+  }
+
+  return *this;
+}
+
+bool BitBoard::operator==(const BitBoard& other) const {
+  return words_[0] == other.words_[0] && words_[1] == other.words_[1]
+         && words_[2] == other.words_[2] && words_[3] == other.words_[3];
+}
+
+bool BitBoard::operator!=(const BitBoard& other) const {
+  return !(*this == other);
+}
+
+BitBoard BitBoard::ShiftedLeft(size_t bits) const {
+  BitBoard shifted;
+  for (size_t word = kNumWords; word-- > 0;) {
+    shifted.words_[word] = words_[word] << bits;
+    if (word > 0) {
+      shifted.words_[word] |= words_[word - 1] >> (64 - bits);
+    }
+  }
+
+  return shifted;
+}
+
+BitBoard BitBoard::ShiftedRight(size_t bits) const {
+  BitBoard shifted;
+  for (size_t word = 0; word < kNumWords; word++) {
+    shifted.words_[word] = words_[word] >> bits;
+    if (word + 1 < kNumWords) {
+      shifted.words_[word] |= words_[word + 1] << (64 - bits);
+    }
+  }
+
+  return shifted;
+}
+
+} // namespace dig_dug
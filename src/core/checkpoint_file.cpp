@@ -0,0 +1,72 @@
+#include "core/checkpoint_file.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace dig_dug {
+
+void SaveCheckpoints(const string& path, ConstSpan<SessionSnapshot> snapshots) {
+  CheckpointHeader header;
+  header.magic = kCheckpointMagic;
+  header.version = kCheckpointVersion;
+  header.byte_order = kCheckpointByteOrder;
+  header.snapshot_size = (uint32_t) (sizeof(SessionSnapshot));
+  header.num_snapshots = snapshots.size();
+
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(snapshots.data()),
+             (std::streamsize) (snapshots.size() * sizeof(SessionSnapshot)));
+  if (!file) {
+    throw std::runtime_error("Cannot write " + path);
+  }
+}
+
+void SaveSession(const string& path, const GameSession& session) {
+  SessionSnapshot snapshot = session.Snapshot();
+  SaveCheckpoints(path, ConstSpan<SessionSnapshot>(&snapshot, 1));
+}
+
+void LoadSession(const string& path, GameSession& session) {
+  CheckpointFile file(path);
+  if (file.Size() == 0) {
+    throw std::runtime_error(path + " has no checkpoints");
+  }
+
+  session.Restore(file.GetSnapshots()[0]);
+}
+
+CheckpointFile::CheckpointFile(const string& path) : file_(path) {
+  CheckpointHeader header;
+  if (file_.GetSize() < sizeof(header)) {
+    throw std::runtime_error(path + " is not a checkpoint file");
+  }
+
+  std::memcpy(&header, file_.GetData(), sizeof(header));
+  if (header.magic != kCheckpointMagic) {
+    throw std::runtime_error(path + " is not a checkpoint file");
+  }
+  if (header.version != kCheckpointVersion || header.byte_order != kCheckpointByteOrder
+      || header.snapshot_size != sizeof(SessionSnapshot)) {
+    throw std::runtime_error(path + " was saved by a build with a different snapshot layout");
+  }
+  if (header.num_snapshots != (file_.GetSize() - sizeof(header)) / sizeof(SessionSnapshot)
+      || (file_.GetSize() - sizeof(header)) % sizeof(SessionSnapshot) != 0) {
+    throw std::runtime_error(path + " is cut short");
+  }
+
+  // Mappings start on a page boundary and the header keeps the snapshots aligned after it
+  snapshots_ = ConstSpan<SessionSnapshot>(reinterpret_cast<const SessionSnapshot*>(file_.GetData() + sizeof(header)),
+                                          (size_t) (header.num_snapshots));
+}
+
+ConstSpan<SessionSnapshot> CheckpointFile::GetSnapshots() const {
+  return snapshots_;
+}
+
+size_t CheckpointFile::Size() const {
+  return snapshots_.size();
+}
+
+} // namespace dig_dug
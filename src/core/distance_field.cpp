@@ -0,0 +1,132 @@
+#include "core/distance_field.h"
+
+#include <algorithm>
+
+namespace dig_dug {
+
+// Defined here as well so it can be bound to references, like in std::min
+const uint16_t DistanceField::kUnreachable;
+
+void DistanceField::Reset(const TileGrid& map, size_t root_x, size_t root_y) {
+  dimension_ = map.GetDimension();
+  distances_.resize(dimension_ * dimension_);
+  ReserveQueue();
+  SetRoot(map, root_x, root_y);
+}
+
+void DistanceField::SetRoot(const TileGrid& map, size_t root_x, size_t root_y) {
+  root_x_ = root_x;
+  root_y_ = root_y;
+  std::fill(distances_.begin(), distances_.end(), kUnreachable);
+
+  distances_[root_x * dimension_ + root_y] = 0;
+  queue_.clear();
+  queue_.push_back(PackTile(root_x, root_y));
+  Propagate(map);
+}
+
+void DistanceField::OpenTile(const TileGrid& map, size_t x, size_t y) {
+  size_t tile = x * dimension_ + y;
+  uint16_t distance = distances_[tile];
+
+  for (size_t direction = 0; direction < kNumDirections; direction++) {
+    size_t next_x;
+    size_t next_y;
+
+    if (GetNeighbor(x, y, static_cast<Direction>(direction), dimension_, next_x, next_y)) {
+      uint16_t next_distance = distances_[next_x * dimension_ + next_y];
+      if (next_distance != kUnreachable && next_distance + 1 < distance) {
+        distance = (uint16_t) (next_distance + 1);
+      }
+    }
+  }
+
+  // Tiles dug where no tunnel reaches the root stay unreachable until a path opens
+  if (distance < distances_[tile]) {
+    distances_[tile] = distance;
+    queue_.clear();
+    queue_.push_back(PackTile(x, y));
+    Propagate(map);
+  }
+}
+
+void DistanceField::Clear() {
+  dimension_ = 0;
+  root_x_ = 0;
+  root_y_ = 0;
+}
+
+void DistanceField::Assign(size_t dimension, size_t root_x, size_t root_y, const uint16_t* distances) {
+  dimension_ = dimension;
+  root_x_ = root_x;
+  root_y_ = root_y;
+  distances_.assign(distances, distances + dimension * dimension);
+  ReserveQueue();
+}
+
+bool DistanceField::GetStepToRoot(size_t x, size_t y, Direction& direction) const {
+  uint16_t distance = GetDistance(x, y);
+  if (distance == 0 || distance == kUnreachable) {
+    return false;
+  }
+
+  for (size_t index = 0; index < kNumDirections; index++) {
+    size_t next_x;
+    size_t next_y;
+
+    if (GetNeighbor(x, y, static_cast<Direction>(index), dimension_, next_x, next_y)
+        && GetDistance(next_x, next_y) + 1 == distance) {
+      direction = static_cast<Direction>(index);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+size_t DistanceField::GetRootX() const {
+  return root_x_;
+}
+
+size_t DistanceField::GetRootY() const {
+  return root_y_;
+}
+
+size_t DistanceField::GetDimension() const {
+  return dimension_;
+}
+
+const uint16_t* DistanceField::GetData() const {
+  return distances_.data();
+}
+
+void DistanceField::ReserveQueue() {
+  // A search queues each tunnel at most once. Large boards are mostly dirt, so their queue grows as tunnels are dug
+  size_t num_tiles = dimension_ * dimension_;
+  queue_.reserve(num_tiles < kMaxReservedTiles ? num_tiles : kMaxReservedTiles);
+}
+
+void DistanceField::Propagate(const TileGrid& map) {
+  // Breadth-first order, so each tile is lowered straight to its final distance
+  for (size_t head = 0; head < queue_.size(); head++) {
+    size_t x = queue_[head] >> kQueueShift;
+    size_t y = queue_[head] & kQueueMask;
+    size_t tile = x * dimension_ + y;
+    uint16_t next_distance = (uint16_t) (distances_[tile] + 1);
+
+    if (x + 1 < dimension_) {
+      Relax(map, x + 1, y, tile + dimension_, next_distance);
+    }
+    if (y + 1 < dimension_) {
+      Relax(map, x, y + 1, tile + 1, next_distance);
+    }
+    if (x > 0) {
+      Relax(map, x - 1, y, tile - dimension_, next_distance);
+    }
+    if (y > 0) {
+      Relax(map, x, y - 1, tile - 1, next_distance);
+    }
+  }
+}
+
+} // namespace dig_dug
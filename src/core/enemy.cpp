@@ -3,28 +3,51 @@
 namespace dig_dug {
 
 Enemy::Enemy(const vec2& position, const vec2& velocity, TileType enemy_type) {
-  position_ = position;
-  velocity_ = velocity;
+  position_ = ToFixed(position);
+  velocity_ = ToFixed(velocity);
   type_ = enemy_type;
 }
 
+Enemy Enemy::AtFixedPosition(const FixedVec2& position, const FixedVec2& velocity, TileType enemy_type) {
+  Enemy enemy({0, 0}, {0, 0}, enemy_type);
+  enemy.position_ = position;
+  enemy.velocity_ = velocity;
+  return enemy;
+}
+
 void Enemy::Move() {
   position_ += velocity_;
 }
 
 vec2 Enemy::GetPosition() const {
-  return position_;
+  return ToFloat(position_);
 }
 
 void Enemy::SetPosition(const vec2& position) {
-  position_ = position;
+  position_ = ToFixed(position);
 }
 
 vec2 Enemy::GetVelocity() const {
-  return velocity_;
+  return ToFloat(velocity_);
 }
 
 void Enemy::SetVelocity(const vec2& velocity) {
+  SetFixedVelocity(ToFixed(velocity));
+}
+
+const FixedVec2& Enemy::GetFixedPosition() const {
+  return position_;
+}
+
+void Enemy::SetFixedPosition(const FixedVec2& position) {
+  position_ = position;
+}
+
+const FixedVec2& Enemy::GetFixedVelocity() const {
+  return velocity_;
+}
+
+void Enemy::SetFixedVelocity(const FixedVec2& velocity) {
   velocity_ = velocity;
 
   if (velocity.x > 0) {
@@ -62,6 +85,10 @@ CharacterOrientation Enemy::GetOrientation() const{
   return orientation_;
 }
 
+void Enemy::SetOrientation(CharacterOrientation orientation) {
+  orientation_ = orientation;
+}
+
 bool Enemy::IsInDirt() const {
   return in_dirt_;
 }
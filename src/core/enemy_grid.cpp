@@ -0,0 +1,100 @@
+#include "core/enemy_grid.h"
+
+namespace dig_dug {
+
+// Defined here as well so it can be bound to references, like in vector::assign
+const uint32_t EnemyGrid::kNone;
+
+void EnemyGrid::Reset(const EnemyPool& enemies, int32_t tile_size) {
+  tile_size_ = tile_size;
+
+  // Twice as many buckets as enemies keeps most lists to one tile
+  size_t num_buckets = kMinBuckets;
+  while (num_buckets < 2 * enemies.Size()) {
+    num_buckets *= 2;
+  }
+  bucket_mask_ = (uint32_t) (num_buckets - 1);
+  heads_.assign(num_buckets, kNone);
+
+  next_.resize(enemies.Size());
+  prev_.resize(enemies.Size());
+  tile_x_.resize(enemies.Size());
+  tile_y_.resize(enemies.Size());
+
+  for (size_t index = 0; index < enemies.Size(); index++) {
+    FixedVec2 position = enemies.GetPosition(index);
+    tile_x_[index] = GetTile(position.x);
+    tile_y_[index] = GetTile(position.y);
+    Link(index);
+  }
+}
+
+void EnemyGrid::RemoveAt(size_t index) {
+  size_t last = next_.size() - 1;
+  Unlink(index);
+
+  if (index != last) {
+    Unlink(last);
+    tile_x_[index] = tile_x_[last];
+    tile_y_[index] = tile_y_[last];
+    Link(index);
+  }
+
+  next_.pop_back();
+  prev_.pop_back();
+  tile_x_.pop_back();
+  tile_y_.pop_back();
+}
+
+size_t EnemyGrid::FindWalkingEnemyNear(const EnemyPool& enemies, const FixedVec2& point) const {
+  int64_t max_length_squared = (int64_t) (tile_size_) * tile_size_;
+  int32_t center_x = GetTile(point.x);
+  int32_t center_y = GetTile(point.y);
+  size_t found = enemies.Size();
+
+  for (int32_t tile_x = center_x - 1; tile_x <= center_x + 1; tile_x++) {
+    for (int32_t tile_y = center_y - 1; tile_y <= center_y + 1; tile_y++) {
+      // Buckets can hold other tiles that hash the same, which are skipped so no enemy is looked at twice
+      for (uint32_t index = heads_[GetBucket(tile_x, tile_y)]; index != kNone; index = next_[index]) {
+        if (index < found && tile_x_[index] == tile_x && tile_y_[index] == tile_y && !enemies.IsGhost(index)
+            && LengthSquared(enemies.GetPosition(index) - point) < max_length_squared) {
+          found = index;
+        }
+      }
+    }
+  }
+
+  return found;
+}
+
+size_t EnemyGrid::Size() const {
+  return next_.size();
+}
+
+void EnemyGrid::Link(size_t index) {
+  uint32_t bucket = GetBucket(tile_x_[index], tile_y_[index]);
+  uint32_t head = heads_[bucket];
+
+  next_[index] = head;
+  prev_[index] = kNone;
+  if (head != kNone) {
+    prev_[head] = (uint32_t) (index);
+  }
+  heads_[bucket] = (uint32_t) (index);
+}
+
+void EnemyGrid::Unlink(size_t index) {
+  uint32_t next = next_[index];
+  uint32_t prev = prev_[index];
+
+  if (prev != kNone) {
+    next_[prev] = next;
+  } else {
+    heads_[GetBucket(tile_x_[index], tile_y_[index])] = next;
+  }
+  if (next != kNone) {
+    prev_[next] = prev;
+  }
+}
+
+} // namespace dig_dug
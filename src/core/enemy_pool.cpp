@@ -0,0 +1,191 @@
+#include "core/enemy_pool.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace dig_dug {
+
+EnemyHandle EnemyPool::Add(const Enemy& enemy) {
+  EnemyHandle handle = Add(enemy.GetFixedPosition(), enemy.GetFixedVelocity(), enemy.GetType());
+  size_t index = x_.size() - 1;
+
+  SetGhost(index, enemy.IsGhost());
+  SetInDirt(index, enemy.IsInDirt());
+  SetHurt(index, enemy.IsHurt());
+  SetFlag(index, kFacingLeftFlag, enemy.GetOrientation() == CharacterOrientation::Left);
+
+  return handle;
+}
+
+EnemyHandle EnemyPool::Add(const FixedVec2& position, const FixedVec2& velocity, TileType type) {
+  uint32_t index = (uint32_t) (x_.size());
+  uint32_t slot;
+
+  // Reuses the slot of a removed enemy, whose generation was already advanced when it was freed
+  if (free_slots_.empty()) {
+    slot = (uint32_t) (slots_.size());
+    slots_.push_back({index, 0});
+    // Every slot can end up free at once, so removing enemies never has to allocate
+    free_slots_.reserve(slots_.capacity());
+  } else {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+    slots_[slot].index = index;
+  }
+
+  x_.push_back(position.x);
+  y_.push_back(position.y);
+  velocity_x_.push_back(velocity.x);
+  velocity_y_.push_back(velocity.y);
+  flags_.push_back((uint8_t) (static_cast<uint8_t>(type) << kTypeShift));
+  slot_of_index_.push_back(slot);
+
+  return EnemyHandle(slot, slots_[slot].generation);
+}
+
+bool EnemyPool::Remove(const EnemyHandle& handle) {
+  if (!IsValid(handle)) {
+    return false;
+  }
+
+  RemoveAt(slots_[handle.slot].index);
+  return true;
+}
+
+void EnemyPool::RemoveAt(size_t index) {
+  if (index >= x_.size()) {
+    throw std::out_of_range("No enemy at index " + std::to_string(index));
+  }
+
+  size_t last = x_.size() - 1;
+  uint32_t removed_slot = slot_of_index_[index];
+
+  if (index != last) {
+    x_[index] = x_[last];
+    y_[index] = y_[last];
+    velocity_x_[index] = velocity_x_[last];
+    velocity_y_[index] = velocity_y_[last];
+    flags_[index] = flags_[last];
+    slot_of_index_[index] = slot_of_index_[last];
+    slots_[slot_of_index_[index]].index = (uint32_t) (index);
+  }
+
+  x_.pop_back();
+  y_.pop_back();
+  velocity_x_.pop_back();
+  velocity_y_.pop_back();
+  flags_.pop_back();
+  slot_of_index_.pop_back();
+
+  // Advancing the generation makes every existing handle to the removed enemy stale
+  slots_[removed_slot].generation++;
+  free_slots_.push_back(removed_slot);
+}
+
+void EnemyPool::Clear() {
+  while (!x_.empty()) {
+    RemoveAt(x_.size() - 1);
+  }
+}
+
+void EnemyPool::Assign(size_t count, const int32_t* x, const int32_t* y, const int32_t* velocity_x,
+                       const int32_t* velocity_y, const uint8_t* flags) {
+  Clear();
+
+  for (size_t index = 0; index < count; index++) {
+    Add({x[index], y[index]}, {velocity_x[index], velocity_y[index]},
+        static_cast<TileType>(flags[index] >> kTypeShift));
+    flags_[index] = flags[index];
+  }
+}
+
+bool EnemyPool::IsValid(const EnemyHandle& handle) const {
+  // Freed slots have already moved on to the generation of their next enemy
+  return handle.slot < slots_.size() && slots_[handle.slot].generation == handle.generation;
+}
+
+size_t EnemyPool::GetIndex(const EnemyHandle& handle) const {
+  if (!IsValid(handle)) {
+    throw std::out_of_range("Enemy handle is stale");
+  }
+
+  return slots_[handle.slot].index;
+}
+
+EnemyHandle EnemyPool::GetHandle(size_t index) const {
+  uint32_t slot = slot_of_index_.at(index);
+  return EnemyHandle(slot, slots_[slot].generation);
+}
+
+size_t EnemyPool::Size() const {
+  return x_.size();
+}
+
+bool EnemyPool::IsEmpty() const {
+  return x_.empty();
+}
+
+Enemy EnemyPool::GetEnemy(size_t index) const {
+  Enemy enemy = Enemy::AtFixedPosition(GetPosition(index), GetVelocity(index), GetType(index));
+
+  // Setting the ghost flag first, since turning a ghost back clears whether it is in dirt
+  if (IsGhost(index)) {
+    enemy.SetGhost();
+  }
+
+  enemy.SetInDirt(IsInDirt(index));
+  enemy.SetHurt(IsHurt(index));
+  enemy.SetOrientation(GetOrientation(index));
+
+  return enemy;
+}
+
+vector<Enemy> EnemyPool::ToVector() const {
+  vector<Enemy> enemies;
+  enemies.reserve(x_.size());
+
+  for (size_t index = 0; index < x_.size(); index++) {
+    enemies.push_back(GetEnemy(index));
+  }
+
+  return enemies;
+}
+
+void EnemyPool::SetVelocity(size_t index, const FixedVec2& velocity) {
+  velocity_x_[index] = velocity.x;
+  velocity_y_[index] = velocity.y;
+
+  if (velocity.x > 0) {
+    SetFlag(index, kFacingLeftFlag, false);
+  } else if (velocity.x < 0) {
+    SetFlag(index, kFacingLeftFlag, true);
+  }
+}
+
+void EnemyPool::SetGhost(size_t index, bool is_ghost) {
+  SetFlag(index, kGhostFlag, is_ghost);
+
+  if (!is_ghost) {
+    SetFlag(index, kInDirtFlag, false);
+  }
+}
+
+void EnemyPool::ClearHurt() {
+  for (uint8_t& flags : flags_) {
+    flags &= (uint8_t) (~kHurtFlag);
+  }
+}
+
+ConstSpan<int32_t> EnemyPool::GetPositionsX() const {
+  return ConstSpan<int32_t>(x_.data(), x_.size());
+}
+
+ConstSpan<int32_t> EnemyPool::GetPositionsY() const {
+  return ConstSpan<int32_t>(y_.data(), y_.size());
+}
+
+ConstSpan<uint8_t> EnemyPool::GetFlags() const {
+  return ConstSpan<uint8_t>(flags_.data(), flags_.size());
+}
+
+} // namespace dig_dug
@@ -0,0 +1,61 @@
+#include "core/fixed_point.h"
+
+#include <cmath>
+
+namespace dig_dug {
+
+FixedVec2 ToFixed(const vec2& value) {
+  return FixedVec2((int32_t) (std::lround(value.x * kFixedOne)), (int32_t) (std::lround(value.y * kFixedOne)));
+}
+
+vec2 ToFloat(const FixedVec2& value) {
+  return vec2((float) (value.x) / kFixedOne, (float) (value.y) / kFixedOne);
+}
+
+int64_t LengthSquared(const FixedVec2& value) {
+  return (int64_t) (value.x) * value.x + (int64_t) (value.y) * value.y;
+}
+
+int32_t Length(const FixedVec2& value) {
+  return (int32_t) (IntegerSqrt((uint64_t) (LengthSquared(value))));
+}
+
+uint32_t IntegerSqrt(uint64_t value) {
+  // Digit by digit square root, two bits of the input at a time
+  uint64_t root = 0;
+  uint64_t bit = uint64_t(1) << 62;
+  while (bit > value) {
+    bit >>= 2;
+  }
+
+  while (bit != 0) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+
+    bit >>= 2;
+  }
+
+  return (uint32_t) (root);
+}
+
+FixedVec2 DirectionVelocity(Direction direction, int32_t speed) {
+  return FixedVec2(GetOffsetX(direction) * speed, GetOffsetY(direction) * speed);
+}
+
+Direction GetTravelDirection(const FixedVec2& velocity) {
+  if (velocity.y == 0 && velocity.x > 0) {
+    return Direction::Right;
+  } else if (velocity.y == 0 && velocity.x < 0) {
+    return Direction::Left;
+  } else if (velocity.x == 0 && velocity.y > 0) {
+    return Direction::Down;
+  }
+
+  return Direction::Up;
+}
+
+} // namespace dig_dug
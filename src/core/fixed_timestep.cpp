@@ -0,0 +1,57 @@
+#include "core/fixed_timestep.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace dig_dug {
+
+FixedTimestep::FixedTimestep(size_t ticks_per_second, size_t max_ticks_per_frame)
+    : max_ticks_per_frame_(max_ticks_per_frame) {
+  if (max_ticks_per_frame == 0) {
+    throw std::invalid_argument("A frame must be able to run a tick");
+  }
+
+  SetTickRate(ticks_per_second);
+}
+
+size_t FixedTimestep::Advance(double elapsed_seconds) {
+  if (elapsed_seconds > 0) {
+    accumulated_seconds_ += elapsed_seconds;
+  }
+
+  size_t num_ticks = 0;
+  while (accumulated_seconds_ >= tick_seconds_ && num_ticks < max_ticks_per_frame_) {
+    accumulated_seconds_ -= tick_seconds_;
+    num_ticks++;
+  }
+
+  // Drops the whole ticks that did not fit in this frame, keeping the part of a tick to blend toward
+  accumulated_seconds_ = std::fmod(accumulated_seconds_, tick_seconds_);
+
+  return num_ticks;
+}
+
+double FixedTimestep::GetAlpha() const {
+  return accumulated_seconds_ / tick_seconds_;
+}
+
+void FixedTimestep::SetTickRate(size_t ticks_per_second) {
+  if (ticks_per_second == 0) {
+    throw std::invalid_argument("Tick rate must be positive");
+  }
+
+  double alpha = ticks_per_second_ == 0 ? 0 : GetAlpha();
+  ticks_per_second_ = ticks_per_second;
+  tick_seconds_ = 1.0 / ticks_per_second;
+  accumulated_seconds_ = alpha * tick_seconds_;
+}
+
+size_t FixedTimestep::GetTickRate() const {
+  return ticks_per_second_;
+}
+
+double FixedTimestep::GetTickSeconds() const {
+  return tick_seconds_;
+}
+
+} // namespace dig_dug
@@ -0,0 +1,84 @@
+#include "core/frame_interpolator.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace dig_dug {
+
+// Generation of slots with no captured enemy. Generations count removals from one slot, so they never get this high
+const uint32_t kNoGeneration = UINT32_MAX;
+
+void FrameInterpolator::Capture(const GameEngine& engine) {
+  const EnemyPool& enemies = engine.GetEnemyView();
+
+  has_player_ = true;
+  player_position_ = engine.GetPlayerView().GetFixedPosition();
+  has_arrow_ = engine.IsPlayerAttacking();
+  arrow_position_ = engine.GetHarpoonView().GetFixedArrowPosition();
+  max_step_ = PixelsToFixed((int32_t) (engine.GetTileSize()));
+
+  std::fill(enemy_generations_.begin(), enemy_generations_.end(), kNoGeneration);
+  for (size_t index = 0; index < enemies.Size(); index++) {
+    EnemyHandle handle = enemies.GetHandle(index);
+    if (handle.slot >= enemy_generations_.size()) {
+      enemy_positions_.resize(handle.slot + 1);
+      enemy_generations_.resize(handle.slot + 1, kNoGeneration);
+    }
+
+    enemy_positions_[handle.slot] = enemies.GetPosition(index);
+    enemy_generations_[handle.slot] = handle.generation;
+  }
+}
+
+void FrameInterpolator::Clear() {
+  has_player_ = false;
+  has_arrow_ = false;
+  std::fill(enemy_generations_.begin(), enemy_generations_.end(), kNoGeneration);
+}
+
+vec2 FrameInterpolator::GetPlayerPosition(const GameEngine& engine, double alpha) const {
+  const FixedVec2& current = engine.GetPlayerView().GetFixedPosition();
+  if (!has_player_) {
+    return ToFloat(current);
+  }
+
+  return Blend(player_position_, current, alpha);
+}
+
+vec2 FrameInterpolator::GetEnemyPosition(const GameEngine& engine, size_t index, double alpha) const {
+  const EnemyPool& enemies = engine.GetEnemyView();
+  FixedVec2 current = enemies.GetPosition(index);
+  EnemyHandle handle = enemies.GetHandle(index);
+
+  if (handle.slot >= enemy_generations_.size() || enemy_generations_[handle.slot] != handle.generation) {
+    return ToFloat(current);
+  }
+
+  return Blend(enemy_positions_[handle.slot], current, alpha);
+}
+
+vec2 FrameInterpolator::GetArrowPosition(const GameEngine& engine, double alpha) const {
+  const FixedVec2& current = engine.GetHarpoonView().GetFixedArrowPosition();
+  if (has_arrow_) {
+    return Blend(arrow_position_, current, alpha);
+  }
+
+  // Harpoons are shot from where the player is, so a new one starts out at the player's captured position
+  if (has_player_) {
+    return Blend(player_position_, current, alpha);
+  }
+
+  return ToFloat(current);
+}
+
+vec2 FrameInterpolator::Blend(const FixedVec2& previous, const FixedVec2& current, double alpha) const {
+  if (std::abs(current.x - previous.x) > max_step_ || std::abs(current.y - previous.y) > max_step_) {
+    return ToFloat(current);
+  }
+
+  vec2 from = ToFloat(previous);
+  vec2 to = ToFloat(current);
+  return from + (to - from) * (float) (alpha);
+}
+
+} // namespace dig_dug
@@ -1,73 +1,124 @@
 #include "core/game_engine.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
 namespace dig_dug {
 
+// Defined here as well so it can be bound to references, like in Catch's REQUIRE
+const size_t GameEngine::kEnemyKillScore;
+
+GameEngine::GameEngine(const TileGrid& initial_game_state, size_t tile_size, uint64_t seed) {
+  Reset(initial_game_state, tile_size, seed);
+}
 
-GameEngine::GameEngine(const vector<vector<TileType>>& initial_game_state, size_t tile_size) {
-  size_t center_coord = (initial_game_state.size() / 2) * tile_size;
-  player_ = Player({center_coord, center_coord});
-  board_size_ = initial_game_state.size();
+GameEngine::GameEngine(const vector<vector<TileType>>& initial_game_state, size_t tile_size, uint64_t seed)
+    : GameEngine(TileGrid(initial_game_state), tile_size, seed) {
+}
 
-  // Takes enemies out of board and stores them in enemies_
-  game_map_ = initial_game_state;
+void GameEngine::Reset(const TileGrid& board, size_t tile_size, uint64_t seed) {
+  // Copies the board into the map the engine already holds when it can, instead of allocating a new one
+  board_size_ = board.GetDimension();
+  if (game_map_.use_count() == 1 && game_map_->GetDimension() == board_size_
+      && game_map_->GetStorage() == TileStorage::Dense && board.GetStorage() == TileStorage::Dense) {
+    game_map_->SetData(board.GetData());
+  } else {
+    game_map_ = std::make_shared<TileGrid>(board);
+  }
+
+  tile_size_ = tile_size;
+  random_ = Random(seed);
+  int32_t center_coord = PixelsToFixed((int32_t) ((board_size_ / 2) * tile_size));
+  player_ = Player::AtFixedPosition({center_coord, center_coord});
+  harpoon_ = Harpoon();
+  player_attacking_ = false;
+  cur_attack_frames_ = 0;
+  delayed_turn_velocity_ = {0, 0};
+  num_lives_ = kNumStartingLives;
+  score_ = 0;
+
+  // Takes enemies out of board and stores them in enemies_. Implicit chunks of large boards are all dirt, so the scan
+  // skips to the end of their column
+  TileGrid& game_map = *game_map_;
+  enemies_.Clear();
   for (size_t x = 0; x < board_size_; x++) {
     for (size_t y = 0; y < board_size_; y++) {
-      TileType type = game_map_[x][y];
+      if (game_map.IsImplicit(x, y)) {
+        y |= TileGrid::kChunkDimension - 1;
+        continue;
+      }
+
+      TileType type = game_map.GetUnchecked(x, y);
       if (type == TileType::Pooka || type == TileType::Fygar) {
-        vec2 position {x * tile_size, y * tile_size};
+        FixedVec2 position {PixelsToFixed((int32_t) (x * tile_size)), PixelsToFixed((int32_t) (y * tile_size))};
 
-        vec2 velocity;
-        if (game_map_[x + 1][y] == TileType::Tunnel) {
-          velocity = {kEnemySpeed, 0};
-        } else if (game_map_[x][y + 1] == TileType::Tunnel) {
-          velocity = {0, kEnemySpeed};
+        FixedVec2 velocity;
+        if (game_map.Get(x + 1, y) == TileType::Tunnel) {
+          velocity = DirectionVelocity(Direction::Right, kEnemySpeed);
+        } else if (game_map.Get(x, y + 1) == TileType::Tunnel) {
+          velocity = DirectionVelocity(Direction::Down, kEnemySpeed);
         }
 
-        Enemy enemy (position, velocity, type);
-        enemies_.push_back(enemy);
-        game_map_[x][y] = TileType::Tunnel;
-      }
-
-      if (x == initial_game_state.size() / 2 && y <= initial_game_state.size() / 2) {
-        game_map_[x][y] = TileType::Tunnel;
+        enemies_.Add(position, velocity, type);
+        game_map.SetUnchecked(x, y, TileType::Tunnel);
       }
     }
   }
 
-  enemy_ghost_percentage_ = enemies_.size() * kEnemyDifficulty;
-  tile_size_ = tile_size;
-  max_harpoon_traveling_frames_ = tile_size * kHarpoonLength / (size_t) (kEnemySpeed);
-  
+  // Digs the player's starting tunnel from the top of the board down to the center
+  for (size_t y = 0; y <= board_size_ / 2; y++) {
+    game_map.SetUnchecked(board_size_ / 2, y, TileType::Tunnel);
+  }
+
+  has_layers_ = TileLayers::CanRepresent(board_size_);
+  if (has_layers_) {
+    layers_ = TileLayers(game_map);
+  }
+  has_tunnel_exits_ = TunnelExits::CanRepresent(board_size_);
+  if (has_tunnel_exits_) {
+    tunnel_exits_.Reset(game_map);
+  }
+
+  ghost_chance_ = enemies_.Size() * kGhostChancePerEnemy;
+  max_harpoon_distance_ = PixelsToFixed((int32_t) (tile_size * kHarpoonLength / FixedToPixels(kEnemySpeed)));
+
+  // The distance field is only searched once someone asks for it, so engines on large boards that nobody observes
+  // never hold a distance for every tile
+  distance_field_.Clear();
+  size_t num_tiles = game_map.GetNumTiles();
+  tile_changes_.clear();
+  tile_changes_.reserve(num_tiles < kMaxReservedTileChanges ? num_tiles : kMaxReservedTileChanges);
+  is_map_replaced_ = true;
+  ResetEnemyGrid();
 }
 
 void GameEngine::MoveEnemies() {
-  // Turns an enemy into a ghost if random number below enemy_ghost_percentage_
-  if ((size_t) (rand() % 10000) < enemy_ghost_percentage_ * 100) {
-    size_t ghost_index = rand() % enemies_.size();
-    Enemy& cur_enemy = enemies_[ghost_index];
-    
-    if (!cur_enemy.IsGhost()) {
-      cur_enemy.SetGhost();
-    }
+  // Turns an enemy into a ghost if random number below ghost_chance_
+  if (random_.NextBelow(kGhostChanceScale) < ghost_chance_ && !enemies_.IsEmpty()) {
+    size_t ghost_index = random_.NextBelow((uint32_t) (enemies_.Size()));
+    enemies_.SetGhost(ghost_index, true);
   }
 
-  int enemy_hurt_index = GetHurtEnemy();
-  if (enemy_hurt_index > -1) {
-    enemies_[enemy_hurt_index].SetHurt(true);
+  EnemyHandle hurt_enemy = GetHurtEnemy();
+  if (enemies_.IsValid(hurt_enemy)) {
+    enemies_.SetHurt(enemies_.GetIndex(hurt_enemy), true);
   }
 
-  for (size_t index = 0; index < enemies_.size(); index++) {
-    Enemy& cur_enemy = enemies_[index];
-
-    if (!cur_enemy.IsHurt()) {
-      if (cur_enemy.IsGhost()) {
-        MoveGhostedEnemy(cur_enemy);
+  for (size_t index = 0; index < enemies_.Size(); index++) {
+    if (!enemies_.IsHurt(index)) {
+      if (enemies_.IsGhost(index)) {
+        MoveGhostedEnemy(index);
       
       } else {
-        MoveWalkingEnemy(cur_enemy);
+        MoveWalkingEnemy(index);
       }
 
-      cur_enemy.Move();
+      enemies_.Move(index);
+      if (has_enemy_grid_) {
+        enemy_grid_.Update(index, enemies_.GetPosition(index));
+      }
     }
   }
 }
@@ -77,41 +128,46 @@ void GameEngine::MovePlayer(const vec2& velocity) {
   cur_attack_frames_ = 0;
   player_attacking_ = false;
   
-  for (size_t index = 0; index < enemies_.size(); index++) {
-   enemies_[index].SetHurt(false);
-  }
+  enemies_.ClearHurt();
 
-  const vec2 kZeroVelocity {0, 0};
-  vec2 position = player_.GetPosition();
-  vec2 velocity_with_speed {velocity.x * kPlayerSpeed, velocity.y * kPlayerSpeed};
-  vec2 opposite_velocity {velocity_with_speed.x * -1, velocity_with_speed.y * -1};
-  vec2 player_prev_speed = player_.GetPrevVelocity();
-  bool next_tile_open = IsNextTileOpen(velocity_with_speed, player_.GetPosition());
+  const FixedVec2 kZeroVelocity {0, 0};
+  FixedVec2 position = player_.GetFixedPosition();
+  FixedVec2 unit_velocity = ToFixed(velocity);
+  FixedVec2 velocity_with_speed {unit_velocity.x * FixedToPixels(kPlayerSpeed),
+                                 unit_velocity.y * FixedToPixels(kPlayerSpeed)};
+  FixedVec2 opposite_velocity = -velocity_with_speed;
+  FixedVec2 player_prev_speed = player_.GetFixedPrevVelocity();
+  bool next_tile_open = IsNextTileOpen(velocity_with_speed, position);
 
   if (next_tile_open) {
     // Checks if player is aligned with tile
-    if ((size_t) (position.x) % tile_size_ == 0 && (size_t) (position.y) % tile_size_ == 0) {
+    if (IsTileAligned(position)) {
+      // Drops a delayed turn that would go off the board or into a rock
+      if (delayed_turn_velocity_ != kZeroVelocity && !IsNextTileOpen(delayed_turn_velocity_, position)) {
+        delayed_turn_velocity_ = {0, 0};
+      }
+
       // Check if player tried to turn in the middle of tiles, and performs that move if so
       if ((velocity_with_speed == player_prev_speed || velocity_with_speed == kZeroVelocity)
           && delayed_turn_velocity_ != kZeroVelocity) {
-        player_.Move(delayed_turn_velocity_);
+        player_.MoveFixed(delayed_turn_velocity_);
         delayed_turn_velocity_ = {0, 0};
-        DigUpTiles(player_.GetPosition(), delayed_turn_velocity_);
+        DigUpTiles(player_.GetFixedPosition(), delayed_turn_velocity_);
 
       } else {
-        player_.Move(velocity_with_speed);
-        DigUpTiles(player_.GetPosition(), velocity_with_speed);
+        player_.MoveFixed(velocity_with_speed);
+        DigUpTiles(player_.GetFixedPosition(), velocity_with_speed);
       }
 
     // Moves if movement is in the same axis as the previous move
     } else if (velocity_with_speed == player_prev_speed || opposite_velocity == player_prev_speed) {
-      player_.Move(velocity_with_speed);
-      DigUpTiles(player_.GetPosition(), velocity_with_speed);
+      player_.MoveFixed(velocity_with_speed);
+      DigUpTiles(player_.GetFixedPosition(), velocity_with_speed);
 
     // Moves according to the previous velocity if trying to turn in the middle of tiles
     } else {
-      player_.Move(player_prev_speed);
-      DigUpTiles(player_.GetPosition(), player_prev_speed);
+      player_.MoveFixed(player_prev_speed);
+      DigUpTiles(player_.GetFixedPosition(), player_prev_speed);
 
       if (velocity_with_speed != kZeroVelocity) {
         delayed_turn_velocity_ = velocity_with_speed;
@@ -121,15 +177,9 @@ void GameEngine::MovePlayer(const vec2& velocity) {
 }
 
 bool GameEngine::IsPlayerDead() {
-  for (const Enemy& enemy : enemies_) {
-    vec2 enemy_pos = enemy.GetPosition();
-    vec2 player_pos = player_.GetPosition();
-    double distance = glm::length(enemy_pos - player_pos);
-
-    if (!enemy.IsGhost() && distance < tile_size_) {
-      num_lives_--;
-      return true;
-    }
+  if (FindWalkingEnemyNear(player_.GetFixedPosition()) < enemies_.Size()) {
+    num_lives_--;
+    return true;
   }
 
   return false;
@@ -142,21 +192,24 @@ void GameEngine::AttackEnemy() {
 
   }
 
-  vec2 arrow_position = harpoon_.GetArrowPosition();
-  int hurt_enemy_index = GetHurtEnemy();
-  if (hurt_enemy_index > -1) {
+  EnemyHandle hurt_enemy = GetHurtEnemy();
+  if (enemies_.IsValid(hurt_enemy)) {
     cur_attack_frames_++;
-    enemies_[hurt_enemy_index].SetHurt(true);
+    enemies_.SetHurt(enemies_.GetIndex(hurt_enemy), true);
 
     // Enemy dies
     if (cur_attack_frames_ >= kAttackFrames) {
-      enemies_.erase(enemies_.begin() + hurt_enemy_index);
+      size_t index = enemies_.GetIndex(hurt_enemy);
+      enemies_.RemoveAt(index);
+      if (has_enemy_grid_) {
+        enemy_grid_.RemoveAt(index);
+      }
       cur_attack_frames_ = 0;
       player_attacking_ = false;
       score_ += kEnemyKillScore;
     }
 
-  } else if (harpoon_.GetDistanceTraveled() >= max_harpoon_traveling_frames_
+  } else if (harpoon_.GetFixedDistanceTraveled() >= max_harpoon_distance_
             || !CanHarpoonContinue()) {
     player_attacking_ = false;
 
@@ -166,7 +219,15 @@ void GameEngine::AttackEnemy() {
 }
 
 vector<vector<TileType>> GameEngine::GetGameMap() const {
-  return game_map_;
+  return game_map_->ToNestedVector();
+}
+
+const TileGrid& GameEngine::GetTileGrid() const {
+  return *game_map_;
+}
+
+void GameEngine::SpillMapTo(const string& directory, size_t max_resident_chunks) {
+  GetMutableMap().SpillTo(directory, max_resident_chunks);
 }
 
 Player GameEngine::GetPlayer() const {
@@ -174,7 +235,7 @@ Player GameEngine::GetPlayer() const {
 }
 
 vector<Enemy> GameEngine::GetEnemies() const {
-  return enemies_;
+  return enemies_.ToVector();
 }
 
 size_t GameEngine::GetNumLives() const {
@@ -201,179 +262,488 @@ void GameEngine::SetScore(size_t score) {
   score_ = score;
 }
 
-void GameEngine::MoveWalkingEnemy(Enemy& enemy) const {
-  vec2 cur_position = enemy.GetPosition();
-  vec2 cur_velocity = enemy.GetVelocity();
+size_t GameEngine::GetTileSize() const {
+  return tile_size_;
+}
 
-  // Enemy is aligned with a tile on the board
-  if ((size_t) (cur_position.x) % tile_size_ == 0 && (size_t) (cur_position.y) % tile_size_ == 0) {
-    vector<PossibleMove> possible_moves;
+const FrameView& GameEngine::GetFrameView() const {
+  frame_view_.tiles = game_map_.get();
+  frame_view_.enemies = &enemies_;
+  frame_view_.player = &player_;
+  frame_view_.harpoon = &harpoon_;
+  frame_view_.is_player_attacking = player_attacking_;
+  frame_view_.score = score_;
+  frame_view_.num_lives = num_lives_;
 
-    // check forward tile dirt
-    if (IsNextTileDirt(cur_velocity, cur_position)) {
-      possible_moves.push_back(PossibleMove::Forward);
-    }
+  return frame_view_;
+}
 
-    // check left tile dirt
-    vec2 turn_left_velocity {cur_velocity.y, cur_velocity.x * -1};
-    if (IsNextTileDirt(turn_left_velocity, cur_position)) {
-      possible_moves.push_back(PossibleMove::Left);
-    }
+const EnemyPool& GameEngine::GetEnemyView() const {
+  return enemies_;
+}
+
+const Player& GameEngine::GetPlayerView() const {
+  return player_;
+}
+
+const Harpoon& GameEngine::GetHarpoonView() const {
+  return harpoon_;
+}
+
+const DistanceField& GameEngine::GetDistanceField() const {
+  // Moving the root searches the whole board, so it waits until someone needs the distances
+  size_t player_x;
+  size_t player_y;
+  GetPlayerTile(player_x, player_y);
+
+  if (!HasDistanceField()) {
+    distance_field_.Reset(*game_map_, player_x, player_y);
+  } else if (player_x != distance_field_.GetRootX() || player_y != distance_field_.GetRootY()) {
+    distance_field_.SetRoot(*game_map_, player_x, player_y);
+  }
+
+  return distance_field_;
+}
+
+ConstSpan<TileChange> GameEngine::GetTileChanges() const {
+  return ConstSpan<TileChange>(tile_changes_.data(), tile_changes_.size());
+}
+
+bool GameEngine::IsMapReplaced() const {
+  return is_map_replaced_;
+}
+
+void GameEngine::ClearTileChanges() {
+  tile_changes_.clear();
+  is_map_replaced_ = false;
+}
+
+EngineSnapshot GameEngine::Snapshot() const {
+  if (board_size_ > EngineSnapshot::kMaxDimension) {
+    throw std::invalid_argument("Snapshots hold boards of at most " + std::to_string(EngineSnapshot::kMaxDimension)
+                                + " tiles per side");
+  }
+  if (enemies_.Size() > EngineSnapshot::kMaxEnemies) {
+    throw std::invalid_argument("Snapshots hold at most " + std::to_string(EngineSnapshot::kMaxEnemies) + " enemies");
+  }
+
+  EngineSnapshot snapshot;
+  game_map_->CopyData(snapshot.tiles);
+  snapshot.layers = layers_;
+  snapshot.board_size = (uint32_t) (board_size_);
+  snapshot.tile_size = (uint32_t) (tile_size_);
+  snapshot.has_layers = has_layers_;
+
+  snapshot.player = player_;
+  snapshot.delayed_turn_velocity = delayed_turn_velocity_;
+  snapshot.harpoon = harpoon_;
+  snapshot.is_player_attacking = player_attacking_;
+  snapshot.cur_attack_frames = (uint32_t) (cur_attack_frames_);
+  snapshot.max_harpoon_distance = max_harpoon_distance_;
+
+  snapshot.num_enemies = (uint32_t) (enemies_.Size());
+  ConstSpan<uint8_t> flags = enemies_.GetFlags();
+  for (size_t index = 0; index < enemies_.Size(); index++) {
+    FixedVec2 position = enemies_.GetPosition(index);
+    FixedVec2 velocity = enemies_.GetVelocity(index);
+    snapshot.enemy_x[index] = position.x;
+    snapshot.enemy_y[index] = position.y;
+    snapshot.enemy_velocity_x[index] = velocity.x;
+    snapshot.enemy_velocity_y[index] = velocity.y;
+    snapshot.enemy_flags[index] = flags[index];
+  }
+
+  if (!HasDistanceField()) {
+    GetDistanceField();
+  }
+  std::copy(distance_field_.GetData(), distance_field_.GetData() + board_size_ * board_size_, snapshot.distances);
+  snapshot.distance_root_x = (uint32_t) (distance_field_.GetRootX());
+  snapshot.distance_root_y = (uint32_t) (distance_field_.GetRootY());
+
+  snapshot.ghost_chance = ghost_chance_;
+  snapshot.num_lives = num_lives_;
+  snapshot.score = score_;
+  snapshot.random = random_;
+
+  return snapshot;
+}
+
+void GameEngine::Restore(const EngineSnapshot& snapshot) {
+  if (game_map_.use_count() > 1 || game_map_->GetDimension() != snapshot.board_size) {
+    game_map_ = std::make_shared<TileGrid>(snapshot.board_size, TileType::Dirt);
+  }
+  game_map_->SetData(snapshot.tiles);
+  tile_changes_.clear();
+  is_map_replaced_ = true;
+  layers_ = snapshot.layers;
+  board_size_ = snapshot.board_size;
+  tile_size_ = snapshot.tile_size;
+  has_layers_ = snapshot.has_layers;
+  has_tunnel_exits_ = TunnelExits::CanRepresent(board_size_);
+  if (has_tunnel_exits_) {
+    tunnel_exits_.Reset(*game_map_);
+  }
+
+  player_ = snapshot.player;
+  delayed_turn_velocity_ = snapshot.delayed_turn_velocity;
+  harpoon_ = snapshot.harpoon;
+  player_attacking_ = snapshot.is_player_attacking;
+  cur_attack_frames_ = snapshot.cur_attack_frames;
+  max_harpoon_distance_ = snapshot.max_harpoon_distance;
+
+  enemies_.Assign(snapshot.num_enemies, snapshot.enemy_x, snapshot.enemy_y, snapshot.enemy_velocity_x,
+                  snapshot.enemy_velocity_y, snapshot.enemy_flags);
+  ResetEnemyGrid();
+
+  distance_field_.Assign(snapshot.board_size, snapshot.distance_root_x, snapshot.distance_root_y, snapshot.distances);
+
+  ghost_chance_ = (size_t) (snapshot.ghost_chance);
+  num_lives_ = (size_t) (snapshot.num_lives);
+  score_ = (size_t) (snapshot.score);
+  random_ = snapshot.random;
+}
+
+void GameEngine::AddToHash(StateHash& hash) const {
+  hash.Add(board_size_);
+  hash.Add(tile_size_);
+  game_map_->AddToHash(hash);
+
+  const FixedVec2 kPlayerState[] = {player_.GetFixedPosition(), player_.GetFixedPrevVelocity(),
+                                    delayed_turn_velocity_, harpoon_.GetFixedArrowPosition(),
+                                    harpoon_.GetFixedVelocity()};
+  for (const FixedVec2& value : kPlayerState) {
+    hash.Add((uint32_t) (value.x));
+    hash.Add((uint32_t) (value.y));
+  }
+  hash.Add(static_cast<uint64_t>(player_.GetOrientation()));
+  hash.Add((uint32_t) (harpoon_.GetFixedDistanceTraveled()));
+  hash.Add(player_attacking_);
+  hash.Add(cur_attack_frames_);
+  hash.Add((uint32_t) (max_harpoon_distance_));
+
+  hash.Add(enemies_.Size());
+  ConstSpan<uint8_t> flags = enemies_.GetFlags();
+  for (size_t index = 0; index < enemies_.Size(); index++) {
+    FixedVec2 position = enemies_.GetPosition(index);
+    FixedVec2 velocity = enemies_.GetVelocity(index);
+    hash.Add((uint32_t) (position.x));
+    hash.Add((uint32_t) (position.y));
+    hash.Add((uint32_t) (velocity.x));
+    hash.Add((uint32_t) (velocity.y));
+    hash.Add(flags[index]);
+  }
+
+  hash.Add(ghost_chance_);
+  hash.Add(num_lives_);
+  hash.Add(score_);
+  hash.Add(random_.GetSeed());
+  hash.Add(random_.GetStream());
+  hash.Add(random_.GetPosition());
+}
 
-    // check right tile dirt
-    vec2 turn_right_velocity {cur_velocity.y * -1, cur_velocity.x};
-    if (IsNextTileDirt(turn_right_velocity, cur_position)) {
-      possible_moves.push_back(PossibleMove::Right);
+GameEngine GameEngine::Fork() const {
+  return *this;
+}
+
+void GameEngine::MoveWalkingEnemy(size_t index) {
+  FixedVec2 cur_position = enemies_.GetPosition(index);
+  FixedVec2 cur_velocity = enemies_.GetVelocity(index);
+
+  // Enemy is aligned with a tile on the board
+  if (IsTileAligned(cur_position)) {
+    // At most three ways to go, kept on the stack since every aligned enemy decides on every tick
+    PossibleMove possible_moves[3];
+    uint32_t num_possible_moves = 0;
+    Direction direction = GetTravelDirection(cur_velocity);
+    int32_t speed = std::abs(cur_velocity.x) + std::abs(cur_velocity.y);
+    uint8_t exits = GetWalkingExits(cur_position, cur_velocity);
+
+    if (TunnelExits::HasExit(exits, direction)) {
+      possible_moves[num_possible_moves++] = PossibleMove::Forward;
+    }
+    if (TunnelExits::HasExit(exits, TurnLeft(direction))) {
+      possible_moves[num_possible_moves++] = PossibleMove::Left;
+    }
+    if (TunnelExits::HasExit(exits, TurnRight(direction))) {
+      possible_moves[num_possible_moves++] = PossibleMove::Right;
     }
 
     // set new velocity of enemy
-    if (possible_moves.empty()) {
-      vec2 backwards_velocity {cur_velocity.x * -1, cur_velocity.y * -1};
-      enemy.SetVelocity(backwards_velocity);
+    if (num_possible_moves == 0) {
+      enemies_.SetVelocity(index, -cur_velocity);
     } else {
-      PossibleMove move = possible_moves[rand() % possible_moves.size()];
+      PossibleMove move = possible_moves[random_.NextBelow(num_possible_moves)];
 
       if (move == PossibleMove::Left) {
-        enemy.SetVelocity(turn_left_velocity);
+        enemies_.SetVelocity(index, DirectionVelocity(TurnLeft(direction), speed));
       } else if (move == PossibleMove::Right) {
-        enemy.SetVelocity(turn_right_velocity);
+        enemies_.SetVelocity(index, DirectionVelocity(TurnRight(direction), speed));
       }
     }
   }
 }
 
+uint8_t GameEngine::GetWalkingExits(const FixedVec2& position, const FixedVec2& velocity) const {
+  Direction direction = GetTravelDirection(velocity);
+  int32_t speed = std::abs(velocity.x) + std::abs(velocity.y);
+  int32_t speed_pixels = FixedToPixels(speed);
+  size_t tile_x = GetTileIndex(position.x);
+  size_t tile_y = GetTileIndex(position.y);
+
+  // An enemy on the board moving along one axis by less than a tile steps into a neighbor, whose mask is kept up to
+  // date as the map is dug
+  if (has_tunnel_exits_ && (velocity.x == 0 || velocity.y == 0) && speed_pixels > 0
+      && speed_pixels < (int32_t) (tile_size_) && position.x >= 0 && position.y >= 0
+      && tile_x < board_size_ && tile_y < board_size_) {
+    return tunnel_exits_.GetExits(tile_x, tile_y);
+  }
+
+  uint8_t exits = 0;
+  if (IsNextTileDirt(velocity, position)) {
+    exits |= (uint8_t) (1 << static_cast<size_t>(direction));
+  }
+  if (IsNextTileDirt(DirectionVelocity(TurnLeft(direction), speed), position)) {
+    exits |= (uint8_t) (1 << static_cast<size_t>(TurnLeft(direction)));
+  }
+  if (IsNextTileDirt(DirectionVelocity(TurnRight(direction), speed), position)) {
+    exits |= (uint8_t) (1 << static_cast<size_t>(TurnRight(direction)));
+  }
+
+  return exits;
+}
+
 bool GameEngine::IsNextTileDirt(const vec2& velocity, const vec2& position) const {
-  if (!IsNextTileOpen(velocity, position)) {
+  return IsNextTileDirt(ToFixed(velocity), ToFixed(position));
+}
+
+bool GameEngine::IsNextTileOpen(const vec2& velocity, const vec2& position) const {
+  return IsNextTileOpen(ToFixed(velocity), ToFixed(position));
+}
+
+bool GameEngine::IsNextTileDirt(const FixedVec2& velocity, const FixedVec2& position) const {
+  size_t next_x;
+  size_t next_y;
+  if (!GetNextTile(velocity, position, next_x, next_y)) {
     return false;
   }
 
-  int next_x;
-  int next_y;
-  // Gets the correct next x and y index for the given position and velocity
-  if (velocity.x > 0 && velocity.y == 0) {
-    next_x = GetIndexOfPlayer((size_t) (position.x + velocity.x));
-    next_y = (int) (position.y) / (int) (tile_size_);
+  return IsTunnelTile(next_x, next_y);
+}
+
+bool GameEngine::IsNextTileOpen(const FixedVec2& velocity, const FixedVec2& position) const {
+  size_t next_x;
+  size_t next_y;
+  if (!GetNextTile(velocity, position, next_x, next_y)) {
+    return false;
+  }
 
-  } else if (velocity.x == 0 && velocity.y > 0) {
-    next_x = (int) (position.x) / (int) (tile_size_);
-    next_y = GetIndexOfPlayer((size_t) (position.y + velocity.y));
+  return !IsRockTile(next_x, next_y);
+}
 
-  } else if (velocity.x < 0 && velocity.y == 0) {
-    next_x = ((int) (position.x) + (int) (velocity.x)) / (int) (tile_size_);
-    next_y = (int) (position.y) / (int) (tile_size_);
+const TileLayers& GameEngine::GetTileLayers() const {
+  return layers_;
+}
 
-  } else {
-    next_y = ((int) (position.y) + (int) (velocity.y)) / (int) (tile_size_);
-    next_x = (int) (position.x) / (int) (tile_size_);
+bool GameEngine::HasTileLayers() const {
+  return has_layers_;
+}
+
+const TunnelExits& GameEngine::GetTunnelExits() const {
+  return tunnel_exits_;
+}
+
+bool GameEngine::HasTunnelExits() const {
+  return has_tunnel_exits_;
+}
+
+bool GameEngine::GetNextTile(const FixedVec2& velocity, const FixedVec2& position,
+                             size_t& next_x, size_t& next_y) const {
+  Direction direction = GetTravelDirection(velocity);
+  bool is_horizontal = IsHorizontal(direction);
+  int32_t position_along = FixedToPixels(is_horizontal ? position.x : position.y);
+  int32_t position_across = FixedToPixels(is_horizontal ? position.y : position.x);
+  int32_t velocity_along = FixedToPixels(is_horizontal ? velocity.x : velocity.y);
+
+  // Objects moving right or down are checked from their far edge, one tile past their position
+  int32_t lead = GetOffsetX(direction) + GetOffsetY(direction) > 0 ? (int32_t) (tile_size_) : 0;
+  int32_t next_pixel = position_along + velocity_along + lead;
+  if (next_pixel < 0 || next_pixel >= (int32_t) (board_size_ * tile_size_)) {
+    return false;
   }
 
-  if (game_map_[next_x][next_y] == TileType::Tunnel) {
-    return true;
+  size_t next_along = (size_t) (next_pixel) / tile_size_;
+  size_t next_across = (size_t) (position_across) / tile_size_;
+  next_x = is_horizontal ? next_along : next_across;
+  next_y = is_horizontal ? next_across : next_along;
+
+  return true;
+}
+
+bool GameEngine::IsTileAligned(const FixedVec2& position) const {
+  return FixedToPixels(position.x) % tile_size_ == 0 && FixedToPixels(position.y) % tile_size_ == 0;
+}
+
+bool GameEngine::IsWithinTile(const FixedVec2& offset) const {
+  int64_t tile_size_fixed = PixelsToFixed((int32_t) (tile_size_));
+  return LengthSquared(offset) < tile_size_fixed * tile_size_fixed;
+}
+
+size_t GameEngine::GetTileIndex(int32_t position) const {
+  return (size_t) (FixedToPixels(position)) / tile_size_;
+}
+
+bool GameEngine::IsTunnelTile(size_t x, size_t y) const {
+  if (has_layers_) {
+    return layers_.IsTunnel(x, y);
   }
 
-  return false;
+  return game_map_->GetUnchecked(x, y) == TileType::Tunnel;
 }
 
-bool GameEngine::IsNextTileOpen(const vec2 &velocity, const vec2 &position) const {
-  if (velocity.x > 0 && velocity.y == 0) {
-    size_t next_x = (size_t) (position.x) + (size_t) (velocity.x) + tile_size_;
-    if (next_x < board_size_ * tile_size_
-        && game_map_[next_x / tile_size_][(size_t) (position.y) / tile_size_] != TileType::Rock) {
-      return true;
-    }
+bool GameEngine::IsRockTile(size_t x, size_t y) const {
+  if (has_layers_) {
+    return layers_.IsRock(x, y);
+  }
 
-  } else if (velocity.x == 0 && velocity.y > 0) {
-    size_t next_y = (size_t) (position.y) + (size_t) (velocity.y) + tile_size_;
-    if (next_y < board_size_ * tile_size_
-        && game_map_[(size_t) (position.x) / tile_size_][next_y / tile_size_] != TileType::Rock) {
-      return true;
-    }
+  return game_map_->GetUnchecked(x, y) == TileType::Rock;
+}
 
-  } else if (velocity.x < 0 && velocity.y == 0) {
-    int next_x = ((int) (position.x) + (int) (velocity.x));
-    if (next_x >= 0 && game_map_[next_x / tile_size_][(size_t) (position.y) / tile_size_] != TileType::Rock) {
-      return true;
-    }
+TileGrid& GameEngine::GetMutableMap() {
+  // Forks share one map until one of them changes it
+  if (game_map_.use_count() > 1) {
+    game_map_ = std::make_shared<TileGrid>(*game_map_);
+  }
 
-  } else {
-    int next_y = ((int) (position.y) + (int) (velocity.y));
-    if (next_y >= 0 && game_map_[(size_t) (position.x) / tile_size_][next_y / tile_size_] != TileType::Rock) {
-      return true;
-    }
+  return *game_map_;
+}
+
+void GameEngine::SetTile(size_t x, size_t y, TileType type) {
+  // The player digs the tile it is on every move, which should not take a fork's own copy of the map
+  if (game_map_->GetUnchecked(x, y) == type) {
+    return;
   }
 
-  return false;
+  bool was_tunnel = game_map_->GetUnchecked(x, y) == TileType::Tunnel;
+  GetMutableMap().SetUnchecked(x, y, type);
+  tile_changes_.push_back({(uint16_t) (x), (uint16_t) (y), type});
+
+  if (has_layers_) {
+    layers_.SetTile(x, y, type);
+  }
+  if (has_tunnel_exits_) {
+    tunnel_exits_.SetTile(x, y, type);
+  }
+
+  // Digging only shortens paths, but filling in a tunnel can lengthen any of them
+  if (!HasDistanceField()) {
+    return;
+  }
+  if (type == TileType::Tunnel) {
+    distance_field_.OpenTile(*game_map_, x, y);
+  } else if (was_tunnel) {
+    distance_field_.SetRoot(*game_map_, distance_field_.GetRootX(), distance_field_.GetRootY());
+  }
 }
 
-void GameEngine::MoveGhostedEnemy(Enemy& enemy) const {
-  vec2 enemy_position = enemy.GetPosition();
-  vec2 player_position = player_.GetPosition();
-  vec2 distance_vector = player_position - enemy_position;
-  double distance = glm::length(distance_vector);
-  TileType tile = game_map_[(size_t) (enemy_position.x) / tile_size_][(size_t) (enemy_position.y) / tile_size_];
-  
+bool GameEngine::HasDistanceField() const {
+  return distance_field_.GetDimension() == board_size_;
+}
+
+void GameEngine::GetPlayerTile(size_t& x, size_t& y) const {
+  FixedVec2 position = player_.GetFixedPosition();
+  x = ((size_t) (FixedToPixels(position.x)) + tile_size_ / 2) / tile_size_;
+  y = ((size_t) (FixedToPixels(position.y)) + tile_size_ / 2) / tile_size_;
+}
+
+
+void GameEngine::MoveGhostedEnemy(size_t index) {
+  FixedVec2 enemy_position = enemies_.GetPosition(index);
+  FixedVec2 distance_vector = player_.GetFixedPosition() - enemy_position;
+  int32_t distance = Length(distance_vector);
+  size_t tile_x = GetTileIndex(enemy_position.x);
+  size_t tile_y = GetTileIndex(enemy_position.y);
+
+  // Walking enemies turn around up to a tile past the edge, and the space outside the board counts as dirt
+  bool is_on_board = enemy_position.x >= 0 && enemy_position.y >= 0 && tile_x < board_size_ && tile_y < board_size_;
+  TileType tile = is_on_board ? game_map_->GetUnchecked(tile_x, tile_y) : TileType::Dirt;
+
   if (tile == TileType::Dirt || tile == TileType::Rock) {
-    enemy.SetInDirt(true);
+    enemies_.SetInDirt(index, true);
   }
 
   // Enemy walks again and is not ghost anymore
   if (tile == TileType::Tunnel
-      && distance < kGhostDistanceBuffer && enemy.IsInDirt()) {
-    enemy.SetGhost();
-    enemy.SetPosition({((size_t) (enemy_position.x) / tile_size_) * tile_size_,
-                       ((size_t) (enemy_position.y) / tile_size_) * tile_size_});
+      && distance < kGhostDistanceBuffer && enemies_.IsInDirt(index)) {
+    enemies_.SetGhost(index, false);
+    enemies_.SetPosition(index, {PixelsToFixed((int32_t) (tile_x * tile_size_)),
+                                 PixelsToFixed((int32_t) (tile_y * tile_size_))});
     // Makes sure velocity of enemy is correct now that it is walking again
-    enemy.SetVelocity({kEnemySpeed, 0});
-    MoveWalkingEnemy(enemy);
+    enemies_.SetVelocity(index, DirectionVelocity(Direction::Right, kEnemySpeed));
+    MoveWalkingEnemy(index);
+
+  } else if (distance == 0) {
+    // Ghost is already on top of the player
+    enemies_.SetVelocity(index, {0, 0});
 
   } else {
-    vec2 new_velocity {distance_vector.x / distance * kEnemySpeed, distance_vector.y / distance * kEnemySpeed};
-    enemy.SetVelocity(new_velocity);
+    FixedVec2 new_velocity {(int32_t) ((int64_t) (distance_vector.x) * kEnemySpeed / distance),
+                            (int32_t) ((int64_t) (distance_vector.y) * kEnemySpeed / distance)};
+    enemies_.SetVelocity(index, new_velocity);
   }
 }
 
-void GameEngine::DigUpTiles(const vec2& player_pos, const vec2& velocity) {
+void GameEngine::DigUpTiles(const FixedVec2& player_pos, const FixedVec2& velocity) {
   // So player does not dig up tile it has not entered yet
-  if ((size_t) (player_pos.x) % tile_size_ == 0 && (size_t) (player_pos.y) % tile_size_ == 0) {
+  if (IsTileAligned(player_pos)) {
     return;
   }
 
+  size_t pixel_x = (size_t) (FixedToPixels(player_pos.x));
+  size_t pixel_y = (size_t) (FixedToPixels(player_pos.y));
   if (velocity.x > 0 && velocity.y == 0) {
-    game_map_[GetIndexOfPlayer((size_t) (player_pos.x))][(size_t) (player_pos.y) / tile_size_] = TileType::Tunnel;
+    SetTile(GetIndexOfPlayer(pixel_x), pixel_y / tile_size_, TileType::Tunnel);
 
   } else if (velocity.y > 0 && velocity.x == 0) {
-    game_map_[(size_t) (player_pos.x) / tile_size_][GetIndexOfPlayer((size_t) (player_pos.y))] = TileType::Tunnel;
+    SetTile(pixel_x / tile_size_, GetIndexOfPlayer(pixel_y), TileType::Tunnel);
 
   } else {
-    game_map_[(size_t) (player_pos.x) / tile_size_][(size_t) (player_pos.y) / tile_size_] = TileType::Tunnel;
+    SetTile(pixel_x / tile_size_, pixel_y / tile_size_, TileType::Tunnel);
   }
 }
 
 void GameEngine::CreateHarpoon() {
-  vec2 player_position = player_.GetPosition();
-  vec2 player_prev_velocity = player_.GetPrevVelocity();
-  vec2 harpoon_velocity_unit_vector = player_prev_velocity / glm::length(player_prev_velocity);
-  vec2 harpoon_velocity = {harpoon_velocity_unit_vector.x * kHarpoonSpeed, harpoon_velocity_unit_vector.y * kHarpoonSpeed};
-
-  harpoon_ = Harpoon(player_position, harpoon_velocity);
+  Direction direction = GetTravelDirection(player_.GetFixedPrevVelocity());
+  harpoon_ = Harpoon(player_.GetFixedPosition(), direction, kHarpoonSpeed);
 }
 
-int GameEngine::GetHurtEnemy() const {
+EnemyHandle GameEngine::GetHurtEnemy() const {
   if (!player_attacking_) {
-    return -1;
+    return EnemyHandle();
   }
 
-  for (size_t index = 0; index < enemies_.size(); index++) {
-    vec2 enemy_pos = enemies_[index].GetPosition();
-    vec2 harpoon_pos = harpoon_.GetArrowPosition();
-    double distance = glm::length(enemy_pos - harpoon_pos);
+  size_t index = FindWalkingEnemyNear(harpoon_.GetFixedArrowPosition());
+  return index < enemies_.Size() ? enemies_.GetHandle(index) : EnemyHandle();
+}
 
-    if (!enemies_[index].IsGhost() && distance < tile_size_) {
+size_t GameEngine::FindWalkingEnemyNear(const FixedVec2& point) const {
+  if (has_enemy_grid_) {
+    return enemy_grid_.FindWalkingEnemyNear(enemies_, point);
+  }
+
+  for (size_t index = 0; index < enemies_.Size(); index++) {
+    if (!enemies_.IsGhost(index) && IsWithinTile(enemies_.GetPosition(index) - point)) {
       return index;
     }
   }
 
-  return -1;
+  return enemies_.Size();
+}
+
+void GameEngine::ResetEnemyGrid() {
+  has_enemy_grid_ = enemies_.Size() >= kMinGridEnemies;
+  if (has_enemy_grid_) {
+    enemy_grid_.Reset(enemies_, PixelsToFixed((int32_t) (tile_size_)));
+  }
 }
 
 size_t GameEngine::GetIndexOfPlayer(size_t position) const {
@@ -391,27 +761,29 @@ size_t GameEngine::GetIndexOfPlayer(size_t position) const {
 }
 
 bool GameEngine::CanHarpoonContinue() const {
-  vec2 arrow_pos = harpoon_.GetArrowPosition();
-  vec2 harpoon_velocity = harpoon_.GetVelocity();
-  vec2 unit_harpoon_velocity = harpoon_velocity / glm::length(harpoon_velocity);
-  vec2 next_pos = arrow_pos;
+  FixedVec2 arrow_pos = harpoon_.GetFixedArrowPosition();
+  FixedVec2 harpoon_velocity = harpoon_.GetFixedVelocity();
+  FixedVec2 next_pos = arrow_pos;
 
+  // The tile in front of the arrow is checked when it points right or down
   if (harpoon_velocity.x > 0 || harpoon_velocity.y > 0) {
-    next_pos.x += unit_harpoon_velocity.x * tile_size_;
-    next_pos.y += unit_harpoon_velocity.y * tile_size_;
+    Direction direction = GetTravelDirection(harpoon_velocity);
+    next_pos += DirectionVelocity(direction, PixelsToFixed((int32_t) (tile_size_)));
+  }
+
+  if (arrow_pos.x < 0 || arrow_pos.y < 0 || next_pos.x < 0 || next_pos.y < 0) {
+    return false;
   }
 
-  size_t arrow_x = (size_t) (arrow_pos.x) / tile_size_;
-  size_t arrow_y = (size_t) (arrow_pos.y) / tile_size_;
-  size_t next_x = (size_t) (next_pos.x) / tile_size_;
-  size_t next_y = (size_t) (next_pos.y) / tile_size_;
+  size_t arrow_x = GetTileIndex(arrow_pos.x);
+  size_t arrow_y = GetTileIndex(arrow_pos.y);
+  size_t next_x = GetTileIndex(next_pos.x);
+  size_t next_y = GetTileIndex(next_pos.y);
 
-  if (arrow_pos.x >= 0 && arrow_x < board_size_
-      && arrow_pos.y >= 0 && arrow_y < board_size_
-      && next_pos.x >= 0 && next_x < board_size_
-      && next_pos.y >= 0 && next_y < board_size_
-      && game_map_[arrow_x][arrow_y] == TileType::Tunnel
-      && game_map_[next_x][next_y] == TileType::Tunnel) {
+  if (arrow_x < board_size_ && arrow_y < board_size_
+      && next_x < board_size_ && next_y < board_size_
+      && IsTunnelTile(arrow_x, arrow_y)
+      && IsTunnelTile(next_x, next_y)) {
     return true;
   }
 
@@ -0,0 +1,162 @@
+#include "core/game_session.h"
+
+namespace dig_dug {
+
+GameSession::GameSession(uint64_t seed, size_t tile_size, size_t level, BoardSource* board_source,
+                         size_t board_dimension, size_t enemy_scale)
+    : generator_(seed, board_dimension, enemy_scale), tile_size_(tile_size), board_source_(board_source) {
+  NewGame(seed, level);
+}
+
+void GameSession::Update(const InputFrame& input) {
+  if (game_over_) {
+    return;
+  }
+
+  if (!IsLosingLife()) {
+    ApplyAction(engine_, input.action);
+  }
+
+  num_ticks_++;
+
+  if (engine_.GetEnemyView().IsEmpty()) {
+    live_lost_num_frames_ = 0;
+    generator_.IncreaseLevel();
+    StartLevel(engine_.GetNumLives(), engine_.GetScore() + kLevelUpScore);
+
+  } else if (engine_.GetNumLives() > 0 && live_lost_num_frames_ == 0) {
+    if (engine_.IsPlayerDead()) {
+      live_lost_num_frames_++;
+    } else {
+      engine_.MoveEnemies();
+    }
+
+  } else if (live_lost_num_frames_ > 0) {
+    live_lost_num_frames_++;
+
+    if (live_lost_num_frames_ > kMaxLiveLostFrames) {
+      live_lost_num_frames_ = 0;
+      StartLevel(engine_.GetNumLives(), engine_.GetScore());
+    }
+
+  } else {
+    game_over_ = true;
+  }
+}
+
+void GameSession::NewGame(uint64_t seed, size_t level) {
+  generator_ = GameStateGenerator(seed, generator_.GetBoardDimension(), generator_.GetEnemyScale());
+  generator_.SetLevel(level);
+  NextBoard();
+  engine_.Reset(generator_.GetTileGrid(), tile_size_, generator_.GetEngineSeed());
+  live_lost_num_frames_ = 0;
+  num_ticks_ = 0;
+  game_over_ = false;
+}
+
+void GameSession::SetBoardSource(BoardSource* source) {
+  board_source_ = source;
+}
+
+SessionSnapshot GameSession::Snapshot() const {
+  SessionSnapshot snapshot;
+  snapshot.engine = engine_.Snapshot();
+  snapshot.seed = generator_.GetSeed();
+  snapshot.level = generator_.GetLevel();
+  snapshot.num_boards = generator_.GetNumBoards();
+  snapshot.enemy_scale = generator_.GetEnemyScale();
+  snapshot.num_ticks = num_ticks_;
+  snapshot.live_lost_num_frames = live_lost_num_frames_;
+  snapshot.is_game_over = game_over_;
+
+  return snapshot;
+}
+
+void GameSession::Restore(const SessionSnapshot& snapshot) {
+  generator_ = GameStateGenerator(snapshot.seed, snapshot.engine.board_size, (size_t) (snapshot.enemy_scale));
+  generator_.Resume((size_t) (snapshot.level), (size_t) (snapshot.num_boards));
+
+  engine_.Restore(snapshot.engine);
+  tile_size_ = snapshot.engine.tile_size;
+  num_ticks_ = (size_t) (snapshot.num_ticks);
+  live_lost_num_frames_ = (size_t) (snapshot.live_lost_num_frames);
+  game_over_ = snapshot.is_game_over;
+  PrepareNextBoards();
+}
+
+uint64_t GameSession::GetStateHash() const {
+  StateHash hash;
+  engine_.AddToHash(hash);
+  hash.Add(generator_.GetSeed());
+  hash.Add(generator_.GetLevel());
+  hash.Add(generator_.GetNumBoards());
+  hash.Add(num_ticks_);
+  hash.Add(live_lost_num_frames_);
+  hash.Add(game_over_);
+
+  return hash.Get();
+}
+
+bool GameSession::IsGameOver() const {
+  return game_over_;
+}
+
+bool GameSession::IsLosingLife() const {
+  return live_lost_num_frames_ > 0;
+}
+
+size_t GameSession::GetLevel() const {
+  return generator_.GetLevel();
+}
+
+size_t GameSession::GetScore() const {
+  return engine_.GetScore();
+}
+
+size_t GameSession::GetNumTicks() const {
+  return num_ticks_;
+}
+
+GameEngine& GameSession::GetEngine() {
+  return engine_;
+}
+
+const GameEngine& GameSession::GetEngine() const {
+  return engine_;
+}
+
+const GameStateGenerator& GameSession::GetGenerator() const {
+  return generator_;
+}
+
+void GameSession::StartLevel(size_t num_lives, size_t score) {
+  NextBoard();
+  engine_.Reset(generator_.GetTileGrid(), tile_size_, generator_.GetEngineSeed());
+  engine_.SetNumLives(num_lives);
+  engine_.SetScore(score);
+}
+
+void GameSession::NextBoard() {
+  uint64_t seed = generator_.GetSeed();
+  size_t level = generator_.GetLevel();
+  size_t num_boards = generator_.GetNumBoards() + 1;
+
+  if (board_source_ == nullptr || !board_source_->TakeBoard(seed, level, num_boards, generator_)) {
+    generator_.Generate();
+  }
+
+  PrepareNextBoards();
+}
+
+void GameSession::PrepareNextBoards() {
+  if (board_source_ == nullptr) {
+    return;
+  }
+
+  // The player either clears the level or loses a life and gets another board of it
+  uint64_t seed = generator_.GetSeed();
+  board_source_->Prepare(seed, generator_.GetLevel() + 1, 1);
+  board_source_->Prepare(seed, generator_.GetLevel(), generator_.GetNumBoards() + 1);
+}
+
+} // namespace dig_dug
@@ -1,15 +1,53 @@
 #include "core/game_state_generator.h"
 
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "core/direction.h"
+
 namespace dig_dug {
 
-vector<vector<TileType>> GameStateGenerator::Generate() {
-  game_map_.clear();
+// Defined here as well so they can be bound to references, like in Catch's REQUIRE
+const size_t GameStateGenerator::kDefaultBoardDimension;
+const size_t GameStateGenerator::kMinBoardDimension;
+const size_t GameStateGenerator::kMaxBoardDimension;
+const size_t GameStateGenerator::kMaxDefaultEnemyScale;
+
+GameStateGenerator::GameStateGenerator(uint64_t seed, size_t board_dimension, size_t enemy_scale)
+    : seed_(seed), random_(seed), board_dimension_(board_dimension) {
+  if (!IsValidDimension(board_dimension)) {
+    throw std::invalid_argument("Boards must have " + std::to_string(kMinBoardDimension) + " to "
+                                + std::to_string(kMaxBoardDimension) + " tiles per side");
+  }
+
+  enemy_scale_ = enemy_scale > 0 ? enemy_scale : GetDefaultEnemyScale(board_dimension);
+}
+
+bool GameStateGenerator::IsValidDimension(size_t board_dimension) {
+  return board_dimension >= kMinBoardDimension && board_dimension <= kMaxBoardDimension;
+}
+
+size_t GameStateGenerator::GetDefaultEnemyScale(size_t board_dimension) {
+  size_t side_scale = board_dimension / kDefaultBoardDimension;
+  if (side_scale < 1) {
+    return 1;
+  }
+
+  return side_scale < kMaxDefaultEnemyScale ? side_scale : kMaxDefaultEnemyScale;
+}
+
+const TileGrid& GameStateGenerator::Generate() {
   const size_t kMaxEnemies = 8;
   const size_t kMaxLevelWithAdditionalEnemy = 10;
   const size_t kMinRocks = 3;
   size_t num_enemies;
+  random_ = Random(seed_, GetStream(level_, attempt_));
+  attempt_++;
+  // Every board starts with a pooka, so boards do not depend on the ones generated before them
+  cur_enemy = TileType::Pooka;
   // 3 or 4 rocks
-  size_t num_rocks = (rand() % 2) + kMinRocks;
+  size_t num_rocks = random_.NextBelow(2) + kMinRocks;
   // Number of enemies starts at 4 and increases by 1 every 2 levels
   // Sets the maximum number of enemies if the current level plugged into the formula results in a number of enemies
   // greater than the limit
@@ -19,128 +57,190 @@ vector<vector<TileType>> GameStateGenerator::Generate() {
     num_enemies = kMaxEnemies;
   }
 
-  // Sets default map with all dirt
-  for (size_t i = 0; i < kBoardDimension_; i++) {
-    vector<TileType> cur_row;
-    for (size_t j = 0; j < kBoardDimension_; j++) {
-      cur_row.push_back(TileType::Dirt);
-    }
+  num_enemies *= enemy_scale_;
+  num_rocks *= enemy_scale_;
 
-    game_map_.push_back(cur_row);
+  // Sets default map with all dirt, reusing the last board's memory
+  if (game_map_.GetDimension() == board_dimension_) {
+    game_map_.Fill(TileType::Dirt);
+  } else {
+    game_map_ = TileGrid(board_dimension_, TileType::Dirt);
   }
 
   GenerateEnemies(num_enemies);
   GenerateRocks(num_rocks);
+  engine_seed_ = ((uint64_t) (random_.Next()) << 32) | random_.Next();
 
   return game_map_;
 
 }
 
 void GameStateGenerator::IncreaseLevel() {
-  level_++;
+  SetLevel(level_ + 1);
+}
+
+void GameStateGenerator::SetLevel(size_t level) {
+  level_ = level;
+  attempt_ = 0;
 }
 
 size_t GameStateGenerator::GetLevel() const {
   return level_;
 }
 
+size_t GameStateGenerator::GetNumBoards() const {
+  return attempt_;
+}
+
+void GameStateGenerator::Resume(size_t level, size_t num_boards) {
+  SetLevel(level);
+  if (num_boards > 0) {
+    attempt_ = num_boards - 1;
+    Generate();
+  }
+}
+
+void GameStateGenerator::SetBoard(size_t level, size_t num_boards, const uint8_t* tiles, uint64_t engine_seed) {
+  level_ = level;
+  attempt_ = num_boards;
+  if (game_map_.GetDimension() != board_dimension_) {
+    game_map_ = TileGrid(board_dimension_, TileType::Dirt);
+  }
+  game_map_.SetData(tiles);
+  engine_seed_ = engine_seed;
+}
+
+void GameStateGenerator::SetBoard(size_t level, size_t num_boards, TileGrid map, uint64_t engine_seed) {
+  level_ = level;
+  attempt_ = num_boards;
+  game_map_ = std::move(map);
+  engine_seed_ = engine_seed;
+}
+
+uint64_t GameStateGenerator::GetSeed() const {
+  return seed_;
+}
+
+size_t GameStateGenerator::GetBoardDimension() const {
+  return board_dimension_;
+}
+
+size_t GameStateGenerator::GetEnemyScale() const {
+  return enemy_scale_;
+}
+
+uint64_t GameStateGenerator::GetEngineSeed() const {
+  return engine_seed_;
+}
+
 vector<vector<TileType>> GameStateGenerator::GetGameMap() const {
+  return game_map_.ToNestedVector();
+}
+
+const TileGrid& GameStateGenerator::GetTileGrid() const {
   return game_map_;
 }
 
 void GameStateGenerator::GenerateEnemies(size_t num_enemies) {
-  size_t mid_value = static_cast<int>(kBoardDimension_ / 2);
+  const size_t kSpotsPerDirection = (board_dimension_ - kTunnelSize_) * (board_dimension_ - kTunnelSize_);
+  blocked_.assign(board_dimension_ * board_dimension_, 0);
 
   for (size_t num = 0; num < num_enemies; num++) {
-    bool is_space_possible = false;
-    while (!is_space_possible) {
-      is_space_possible = true;
-
-      size_t x_pos = rand() % (kBoardDimension_ - kTunnelSize_);
-      size_t y_pos = rand() % (kBoardDimension_ - kTunnelSize_);
-      // 0 - horizontal; 1 - vertical
-      size_t direction = rand() % 2;
-
-      // Find different coordinates if the selected ones will lead to a tunnel intersecting the player's starting place
-      if ((x_pos >= mid_value - kTunnelSize_ && x_pos <= mid_value + 1 && y_pos <= mid_value + 1 && direction == 0)
-          || (x_pos >= mid_value - 1 && x_pos <= mid_value + 1 && direction == 1)) {
-        is_space_possible = false;
-        continue;
+    uint32_t placement = 0;
+    bool is_placed = false;
+
+    // Draws spots like the game always has, which is quick while the board is mostly empty
+    for (size_t attempt = 0; attempt < kMaxRandomPlacements && !is_placed; attempt++) {
+      uint32_t spot = random_.NextBelow((uint32_t) (kSpotsPerDirection * kNumTunnelDirections));
+      size_t direction = spot / kSpotsPerDirection;
+      size_t x_pos = spot % kSpotsPerDirection / (board_dimension_ - kTunnelSize_);
+      size_t y_pos = spot % (board_dimension_ - kTunnelSize_);
+
+      if (!IsNearPlayer(x_pos, y_pos, direction) && IsTunnelOpen(x_pos, y_pos, direction)) {
+        placement = PackPlacement(x_pos, y_pos, direction);
+        is_placed = true;
+      }
+    }
+
+    // Then picks among every spot that fits. Either way each spot that fits is equally likely
+    if (!is_placed) {
+      placements_.clear();
+      for (size_t direction = 0; direction < kNumTunnelDirections; direction++) {
+        for (size_t x_pos = 0; x_pos < board_dimension_ - kTunnelSize_; x_pos++) {
+          for (size_t y_pos = 0; y_pos < board_dimension_ - kTunnelSize_; y_pos++) {
+            if (!IsNearPlayer(x_pos, y_pos, direction) && IsTunnelOpen(x_pos, y_pos, direction)) {
+              placements_.push_back(PackPlacement(x_pos, y_pos, direction));
+            }
+          }
+        }
       }
 
-      is_space_possible = IsSpacePossible(x_pos, y_pos, direction);
+      if (placements_.empty()) {
+        return;
+      }
+      placement = placements_[random_.NextBelow((uint32_t) (placements_.size()))];
     }
+
+    PlaceEnemy(placement >> kPlacementShift, (placement & kPlacementMask) >> 1, placement & 1);
   }
 }
 
 void GameStateGenerator::GenerateRocks(size_t num_rocks) {
+  const size_t kNumTiles = board_dimension_ * board_dimension_;
+
   for (size_t num = 0; num < num_rocks; num++) {
-    bool is_space_possible = false;
-    while (!is_space_possible) {
-      is_space_possible = true;
+    size_t tile = kNumTiles;
 
-      size_t x_pos = rand() % kBoardDimension_;
-      size_t y_pos = rand() % kBoardDimension_;
+    for (size_t attempt = 0; attempt < kMaxRandomPlacements && tile == kNumTiles; attempt++) {
+      size_t spot = random_.NextBelow((uint32_t) (kNumTiles));
+      if (game_map_.GetUnchecked(spot / board_dimension_, spot % board_dimension_) == TileType::Dirt) {
+        tile = spot;
+      }
+    }
 
-      if (game_map_[x_pos][y_pos] != TileType::Dirt) {
-        is_space_possible = false;
-        continue;
+    if (tile == kNumTiles) {
+      placements_.clear();
+      for (size_t spot = 0; spot < kNumTiles; spot++) {
+        if (game_map_.GetUnchecked(spot / board_dimension_, spot % board_dimension_) == TileType::Dirt) {
+          placements_.push_back((uint32_t) (spot));
+        }
       }
 
-      game_map_[x_pos][y_pos] = TileType::Rock;
+      if (placements_.empty()) {
+        return;
+      }
+      tile = placements_[random_.NextBelow((uint32_t) (placements_.size()))];
     }
-  }
-}
 
-bool GameStateGenerator::IsGoodSpot(size_t x_pos, size_t y_pos) const {
-  // Checks if there is an enemy or tunnel in a (kEnemyBuffer)-block radius of the current coordinate
-  if (IsEnemyOrTunnel(x_pos + kEnemyBuffer, y_pos)
-      || IsEnemyOrTunnel(x_pos + kEnemyBuffer, y_pos + kEnemyBuffer)
-      || IsEnemyOrTunnel(x_pos + kEnemyBuffer, y_pos - kEnemyBuffer)
-      || IsEnemyOrTunnel(x_pos, y_pos + kEnemyBuffer)
-      || IsEnemyOrTunnel(x_pos, y_pos - kEnemyBuffer)
-      || IsEnemyOrTunnel(x_pos - kEnemyBuffer, y_pos)
-      || IsEnemyOrTunnel(x_pos - kEnemyBuffer, y_pos + kEnemyBuffer)
-      || IsEnemyOrTunnel(x_pos - kEnemyBuffer, y_pos + kEnemyBuffer)) {
-    return false;
+    game_map_.SetUnchecked(tile / board_dimension_, tile % board_dimension_, TileType::Rock);
   }
-
-  return true;
 }
 
-bool GameStateGenerator::IsEnemyOrTunnel(size_t x_pos, size_t y_pos) const {
-  if (x_pos < 0 || x_pos >= kBoardDimension_ || y_pos < 0 || y_pos >= kBoardDimension_) {
-    return false;
-  }
+bool GameStateGenerator::IsNearPlayer(size_t x_pos, size_t y_pos, size_t direction) const {
+  size_t mid_value = board_dimension_ / 2;
 
-  if (game_map_[x_pos][y_pos] == TileType::Fygar
-      || game_map_[x_pos][y_pos] == TileType::Pooka
-      || game_map_[x_pos][y_pos] == TileType::Tunnel) {
-    return true;
+  if (direction == 0) {
+    return x_pos >= mid_value - kTunnelSize_ && x_pos <= mid_value + 1 && y_pos <= mid_value + 1;
   }
 
-  return false;
+  return x_pos >= mid_value - 1 && x_pos <= mid_value + 1;
 }
 
-bool GameStateGenerator::IsSpacePossible(size_t x_pos, size_t y_pos, size_t direction) {
-  size_t x_val;
-  size_t y_val;
-  // Checks if every space in tunnel is not next to another enemy or tunnel
+bool GameStateGenerator::IsTunnelOpen(size_t x_pos, size_t y_pos, size_t direction) const {
   for (size_t tunnel_space = 0; tunnel_space < kTunnelSize_; tunnel_space++) {
-    if (direction == 0) {
-      x_val = x_pos + tunnel_space;
-      y_val = y_pos;
-    } else {
-      x_val = x_pos;
-      y_val = y_pos + tunnel_space;
-    }
+    size_t x_val = direction == 0 ? x_pos + tunnel_space : x_pos;
+    size_t y_val = direction == 0 ? y_pos : y_pos + tunnel_space;
 
-    if (!IsGoodSpot(x_val, y_val)) {
+    if (blocked_[x_val * board_dimension_ + y_val] != 0) {
       return false;
     }
   }
 
-  game_map_[x_pos][y_pos] = cur_enemy;
+  return true;
+}
+
+void GameStateGenerator::PlaceEnemy(size_t x_pos, size_t y_pos, size_t direction) {
+  game_map_.SetUnchecked(x_pos, y_pos, cur_enemy);
 
   // Makes sure different enemy is added next
   if (cur_enemy == TileType::Pooka) {
@@ -150,19 +250,37 @@ bool GameStateGenerator::IsSpacePossible(size_t x_pos, size_t y_pos, size_t dire
   }
 
   // Creates tunnels on the enemy's path
-  for (size_t tunnel_space = 1; tunnel_space < kTunnelSize_; tunnel_space++) {
-    if (direction == 0) {
-      x_val = x_pos + tunnel_space;
-      y_val = y_pos;
-    } else {
-      x_val = x_pos;
-      y_val = y_pos + tunnel_space;
+  for (size_t tunnel_space = 0; tunnel_space < kTunnelSize_; tunnel_space++) {
+    size_t x_val = direction == 0 ? x_pos + tunnel_space : x_pos;
+    size_t y_val = direction == 0 ? y_pos : y_pos + tunnel_space;
+
+    if (tunnel_space > 0) {
+      game_map_.SetUnchecked(x_val, y_val, TileType::Tunnel);
     }
+    BlockAround(x_val, y_val);
+  }
+}
+
+void GameStateGenerator::BlockAround(size_t x_pos, size_t y_pos) {
+  // Neighbors that have always been checked for enemies and tunnels around a new tunnel tile. The (-1, -1) diagonal
+  // was never one of them, and it stays out so boards are placed by the same rules as before
+  const int32_t kNeighborOffsetX[] = {1, 1, 1, 0, 0, -1, -1};
+  const int32_t kNeighborOffsetY[] = {0, 1, -1, 1, -1, 0, 1};
+
+  // A tile is blocked if this tile is one of its neighbors
+  for (size_t neighbor = 0; neighbor < sizeof(kNeighborOffsetX) / sizeof(kNeighborOffsetX[0]); neighbor++) {
+    size_t blocked_x;
+    size_t blocked_y;
 
-    game_map_[x_val][y_val] = TileType::Tunnel;
+    if (GetNeighbor(x_pos, y_pos, -kNeighborOffsetX[neighbor], -kNeighborOffsetY[neighbor], board_dimension_,
+                    blocked_x, blocked_y)) {
+      blocked_[blocked_x * board_dimension_ + blocked_y] = 1;
+    }
   }
+}
 
-  return true;
+uint64_t GameStateGenerator::GetStream(size_t level, size_t attempt) {
+  return ((uint64_t) (level) << 32) | (uint32_t) (attempt);
 }
 
 } // namespace dig_dug
\ No newline at end of file
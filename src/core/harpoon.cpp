@@ -4,25 +4,58 @@ namespace dig_dug {
 
 
 Harpoon::Harpoon(const vec2& start_pos, const vec2& velocity) {
+  arrow_ = ToFixed(start_pos);
+  velocity_ = ToFixed(velocity);
+  step_length_ = Length(velocity_);
+}
+
+Harpoon::Harpoon(const FixedVec2& start_pos, Direction direction, int32_t speed) {
   arrow_ = start_pos;
-  velocity_ = velocity;
+  velocity_ = DirectionVelocity(direction, speed);
+  step_length_ = speed;
+}
+
+Harpoon Harpoon::FromState(const FixedVec2& arrow, const FixedVec2& velocity, int32_t step_length,
+                           int32_t distance_traveled) {
+  Harpoon harpoon;
+  harpoon.arrow_ = arrow;
+  harpoon.velocity_ = velocity;
+  harpoon.step_length_ = step_length;
+  harpoon.distance_traveled_ = distance_traveled;
+  return harpoon;
 }
 
 void Harpoon::Move() {
   arrow_ += velocity_;
-  distance_traveled_ += glm::length(velocity_);
+  distance_traveled_ += step_length_;
 }
 
 vec2 Harpoon::GetArrowPosition() const {
-  return arrow_;
+  return ToFloat(arrow_);
 }
 
 double Harpoon::GetDistanceTraveled() const {
-  return distance_traveled_;
+  return (double) (distance_traveled_) / kFixedOne;
 }
 
 vec2 Harpoon::GetVelocity() const {
+  return ToFloat(velocity_);
+}
+
+const FixedVec2& Harpoon::GetFixedArrowPosition() const {
+  return arrow_;
+}
+
+int32_t Harpoon::GetFixedDistanceTraveled() const {
+  return distance_traveled_;
+}
+
+const FixedVec2& Harpoon::GetFixedVelocity() const {
   return velocity_;
 }
 
-} //namespace dig_dug
\ No newline at end of file
+int32_t Harpoon::GetFixedStepLength() const {
+  return step_length_;
+}
+
+} //namespace dig_dug
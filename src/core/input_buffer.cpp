@@ -0,0 +1,65 @@
+#include "core/input_buffer.h"
+
+namespace dig_dug {
+
+void InputBuffer::Press(PlayerAction action, double seconds) {
+  if (action == PlayerAction::None || IsHeld(action)) {
+    return;
+  }
+
+  held_[num_held_] = action;
+  num_held_++;
+  pending_ = action;
+  pending_seconds_ = seconds;
+}
+
+void InputBuffer::Release(PlayerAction action) {
+  for (size_t index = 0; index < num_held_; index++) {
+    if (held_[index] == action) {
+      for (size_t next = index + 1; next < num_held_; next++) {
+        held_[next - 1] = held_[next];
+      }
+
+      num_held_--;
+      return;
+    }
+  }
+}
+
+InputFrame InputBuffer::Sample(double seconds) {
+  const double kNanosecondsPerSecond = 1e9;
+
+  if (pending_ != PlayerAction::None) {
+    InputFrame frame(pending_, seconds - pending_seconds_);
+    pending_ = PlayerAction::None;
+    latencies_.Add(frame.latency_seconds > 0 ? (uint64_t) (frame.latency_seconds * kNanosecondsPerSecond) : 0);
+    return frame;
+  }
+
+  if (num_held_ > 0) {
+    return InputFrame(held_[num_held_ - 1]);
+  }
+
+  return InputFrame();
+}
+
+const LatencyHistogram& InputBuffer::GetLatencies() const {
+  return latencies_;
+}
+
+void InputBuffer::Clear() {
+  num_held_ = 0;
+  pending_ = PlayerAction::None;
+}
+
+bool InputBuffer::IsHeld(PlayerAction action) const {
+  for (size_t index = 0; index < num_held_; index++) {
+    if (held_[index] == action) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+} // namespace dig_dug
@@ -0,0 +1,84 @@
+#include "core/latency_histogram.h"
+
+namespace dig_dug {
+
+LatencyHistogram::LatencyHistogram() : counts_(GetBucket(UINT64_MAX) + 1, 0) {
+}
+
+void LatencyHistogram::Add(uint64_t nanoseconds) {
+  counts_[GetBucket(nanoseconds)]++;
+  count_++;
+  if (nanoseconds > max_) {
+    max_ = nanoseconds;
+  }
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  for (size_t bucket = 0; bucket < counts_.size(); bucket++) {
+    counts_[bucket] += other.counts_[bucket];
+  }
+
+  count_ += other.count_;
+  if (other.max_ > max_) {
+    max_ = other.max_;
+  }
+}
+
+size_t LatencyHistogram::GetCount() const {
+  return count_;
+}
+
+uint64_t LatencyHistogram::GetMax() const {
+  return max_;
+}
+
+uint64_t LatencyHistogram::GetPercentile(double fraction) const {
+  if (count_ == 0) {
+    return 0;
+  }
+
+  // Rank of the sample, counting from 1, that the percentile falls on
+  size_t rank = (size_t) (fraction * count_ + 0.5);
+  if (rank < 1) {
+    rank = 1;
+  } else if (rank > count_) {
+    rank = count_;
+  }
+
+  size_t seen = 0;
+  for (size_t bucket = 0; bucket < counts_.size(); bucket++) {
+    seen += counts_[bucket];
+    if (seen >= rank) {
+      uint64_t top = GetBucketTop(bucket);
+      return top < max_ ? top : max_;
+    }
+  }
+
+  return max_;
+}
+
+size_t LatencyHistogram::GetBucket(uint64_t nanoseconds) {
+  if (nanoseconds < kNumSubBuckets) {
+    return (size_t) (nanoseconds);
+  }
+
+  // Drops the bits below the kSubBucketBits bits under the highest set bit
+  size_t shift = 0;
+  while ((nanoseconds >> shift) >= 2 * kNumSubBuckets) {
+    shift++;
+  }
+
+  return (shift + 1) * kNumSubBuckets + (size_t) ((nanoseconds >> shift) - kNumSubBuckets);
+}
+
+uint64_t LatencyHistogram::GetBucketTop(size_t bucket) {
+  if (bucket < kNumSubBuckets) {
+    return bucket;
+  }
+
+  size_t shift = bucket / kNumSubBuckets - 1;
+  uint64_t sub_bucket = bucket % kNumSubBuckets + kNumSubBuckets;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+} // namespace dig_dug
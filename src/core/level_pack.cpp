@@ -0,0 +1,93 @@
+#include "core/level_pack.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "core/binary_io.h"
+
+namespace dig_dug {
+
+LevelPack::LevelPack(const string& path) : file_(path) {
+  if (file_.GetSize() < sizeof(header_)) {
+    throw std::runtime_error(path + " is not a level pack");
+  }
+
+  std::memcpy(&header_, file_.GetData(), sizeof(header_));
+  if (header_.magic != kLevelPackMagic) {
+    throw std::runtime_error(path + " is not a level pack");
+  }
+  if (header_.version != kLevelPackVersion || header_.byte_order != kLevelPackByteOrder) {
+    throw std::runtime_error(path + " was built by another version of the game");
+  }
+  if (header_.board_dimension > kMaxDimension || header_.record_size != GetRecordSize(header_.board_dimension)) {
+    throw std::runtime_error(path + " has boards of an unsupported size");
+  }
+  if ((file_.GetSize() - sizeof(header_)) / header_.record_size != Size()
+      || (file_.GetSize() - sizeof(header_)) % header_.record_size != 0) {
+    throw std::runtime_error(path + " is cut short");
+  }
+
+  records_ = file_.GetData() + sizeof(header_);
+}
+
+void LevelPack::Prepare(uint64_t seed, size_t level, size_t num_boards) {
+}
+
+bool LevelPack::TakeBoard(uint64_t seed, size_t level, size_t num_boards, GameStateGenerator& generator) {
+  if (!Contains(seed, level, num_boards) || generator.GetBoardDimension() != header_.board_dimension ||
+      generator.GetEnemyScale() != GameStateGenerator::GetDefaultEnemyScale(header_.board_dimension)) {
+    return false;
+  }
+
+  const uint8_t* record = records_ + GetRecordIndex(header_, seed, level, num_boards) * header_.record_size;
+  ByteReader reader(record, sizeof(uint64_t));
+  uint64_t engine_seed = reader.ReadFixed64();
+  const uint8_t* packed_tiles = record + sizeof(uint64_t);
+
+  uint8_t tiles[kMaxDimension * kMaxDimension];
+  size_t num_tiles = header_.board_dimension * header_.board_dimension;
+  for (size_t tile = 0; tile < num_tiles; tile++) {
+    tiles[tile] = (uint8_t) ((packed_tiles[tile / 2] >> (tile % 2 * kTileBits)) & kTileMask);
+  }
+
+  generator.SetBoard(level, num_boards, tiles, engine_seed);
+  return true;
+}
+
+bool LevelPack::Contains(uint64_t seed, size_t level, size_t num_boards) const {
+  return seed >= header_.first_seed && seed - header_.first_seed < header_.num_seeds && level >= 1
+      && level <= header_.num_levels && num_boards >= 1 && num_boards <= header_.boards_per_level;
+}
+
+const LevelPackHeader& LevelPack::GetHeader() const {
+  return header_;
+}
+
+size_t LevelPack::Size() const {
+  return (size_t) (header_.num_seeds) * header_.num_levels * header_.boards_per_level;
+}
+
+size_t LevelPack::GetRecordSize(size_t dimension) {
+  return sizeof(uint64_t) + (dimension * dimension + 1) / 2;
+}
+
+size_t LevelPack::GetRecordIndex(const LevelPackHeader& header, uint64_t seed, size_t level, size_t num_boards) {
+  return ((size_t) (seed - header.first_seed) * header.num_levels + (level - 1)) * header.boards_per_level
+      + (num_boards - 1);
+}
+
+void LevelPack::EncodeBoard(const GameStateGenerator& generator, uint8_t* record) {
+  vector<uint8_t> engine_seed;
+  PutFixed64(engine_seed, generator.GetEngineSeed());
+  std::memcpy(record, engine_seed.data(), engine_seed.size());
+
+  const TileGrid& map = generator.GetTileGrid();
+  uint8_t* packed_tiles = record + sizeof(uint64_t);
+  std::memset(packed_tiles, 0, GetRecordSize(map.GetDimension()) - sizeof(uint64_t));
+  for (size_t tile = 0; tile < map.GetNumTiles(); tile++) {
+    packed_tiles[tile / 2] |= (uint8_t) ((map.GetData()[tile] & kTileMask) << (tile % 2 * kTileBits));
+  }
+}
+
+} // namespace dig_dug
@@ -0,0 +1,109 @@
+#include "core/mapped_file.h"
+
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DIG_DUG_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace dig_dug {
+
+#ifdef DIG_DUG_HAS_MMAP
+
+MappedFile::MappedFile(const string& path) {
+  int file = open(path.c_str(), O_RDONLY);
+  if (file < 0) {
+    throw std::runtime_error("Cannot open " + path);
+  }
+
+  struct stat info;
+  if (fstat(file, &info) != 0) {
+    close(file);
+    throw std::runtime_error("Cannot read the size of " + path);
+  }
+
+  size_ = (size_t) (info.st_size);
+  // Empty files cannot be mapped, and there is nothing to read anyway
+  if (size_ > 0) {
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+    if (data == MAP_FAILED) {
+      close(file);
+      throw std::runtime_error("Cannot map " + path);
+    }
+
+    data_ = static_cast<const uint8_t*>(data);
+  }
+
+  // The mapping stays valid after the file is closed
+  close(file);
+}
+
+void MappedFile::Close() {
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+
+  data_ = nullptr;
+  size_ = 0;
+}
+
+#else
+
+MappedFile::MappedFile(const string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Cannot open " + path);
+  }
+
+  buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+}
+
+void MappedFile::Close() {
+  buffer_.clear();
+  data_ = nullptr;
+  size_ = 0;
+}
+
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    Close();
+    // Moving a vector keeps its buffer, so data_ still points into it
+    buffer_ = std::move(other.buffer_);
+    data_ = other.data_;
+    size_ = other.size_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  Close();
+}
+
+const uint8_t* MappedFile::GetData() const {
+  return data_;
+}
+
+size_t MappedFile::GetSize() const {
+  return size_;
+}
+
+} // namespace dig_dug
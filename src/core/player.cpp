@@ -3,11 +3,30 @@
 namespace dig_dug {
 
 Player::Player(const vec2& position) {
-  position_ = position;
+  position_ = ToFixed(position);
+}
+
+Player Player::AtFixedPosition(const FixedVec2& position) {
+  Player player;
+  player.position_ = position;
+  return player;
+}
+
+Player Player::FromState(const FixedVec2& position, const FixedVec2& prev_velocity,
+                         CharacterOrientation orientation) {
+  Player player;
+  player.position_ = position;
+  player.prev_velocity_ = prev_velocity;
+  player.orientation_ = orientation;
+  return player;
 }
 
 void Player::Move(const vec2& velocity) {
-  vec2 kZeroVector = {0, 0};
+  MoveFixed(ToFixed(velocity));
+}
+
+void Player::MoveFixed(const FixedVec2& velocity) {
+  FixedVec2 kZeroVector = {0, 0};
   position_ += velocity;
 
   if (velocity != kZeroVector) {
@@ -22,10 +41,18 @@ void Player::Move(const vec2& velocity) {
 }
 
 vec2 Player::GetPosition() const {
-  return position_;
+  return ToFloat(position_);
 }
 
 vec2 Player::GetPrevVelocity() const {
+  return ToFloat(prev_velocity_);
+}
+
+const FixedVec2& Player::GetFixedPosition() const {
+  return position_;
+}
+
+const FixedVec2& Player::GetFixedPrevVelocity() const {
   return prev_velocity_;
 }
 
@@ -33,4 +60,4 @@ CharacterOrientation Player::GetOrientation() const {
   return orientation_;
 }
 
-} // namespace dig_dug
\ No newline at end of file
+} // namespace dig_dug
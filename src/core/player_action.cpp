@@ -0,0 +1,32 @@
+#include "core/player_action.h"
+
+namespace dig_dug {
+
+void ApplyAction(GameEngine& engine, PlayerAction action) {
+  switch (action) {
+    case PlayerAction::Right:
+      engine.MovePlayer({1, 0});
+      break;
+
+    case PlayerAction::Down:
+      engine.MovePlayer({0, 1});
+      break;
+
+    case PlayerAction::Left:
+      engine.MovePlayer({-1, 0});
+      break;
+
+    case PlayerAction::Up:
+      engine.MovePlayer({0, -1});
+      break;
+
+    case PlayerAction::Attack:
+      engine.AttackEnemy();
+      break;
+
+    case PlayerAction::None:
+      break;
+  }
+}
+
+} // namespace dig_dug
@@ -0,0 +1,98 @@
+#include "core/random.h"
+
+namespace dig_dug {
+
+Random::Random(uint64_t seed, uint64_t stream) : seed_(seed), stream_(stream) {
+}
+
+uint32_t Random::Next() {
+  if (output_index_ == kBlockSize) {
+    GenerateBlock();
+  }
+
+  return outputs_[output_index_++];
+}
+
+uint32_t Random::NextBelow(uint32_t bound) {
+  // Scales the output into the range instead of taking a remainder, which is faster and less biased
+  return (uint32_t) (((uint64_t) (Next()) * bound) >> 32);
+}
+
+void Random::Seek(uint64_t position) {
+  block_ = position / kBlockSize;
+  output_index_ = kBlockSize;
+
+  size_t skipped_outputs = (size_t) (position % kBlockSize);
+  if (skipped_outputs > 0) {
+    GenerateBlock();
+    output_index_ = skipped_outputs;
+  }
+}
+
+void Random::SetStream(uint64_t stream) {
+  stream_ = stream;
+  Seek(0);
+}
+
+uint64_t Random::GetPosition() const {
+  // The current block has already been counted once any of its outputs are generated
+  if (output_index_ == kBlockSize) {
+    return block_ * kBlockSize;
+  }
+
+  return (block_ - 1) * kBlockSize + output_index_;
+}
+
+uint64_t Random::GetSeed() const {
+  return seed_;
+}
+
+uint64_t Random::GetStream() const {
+  return stream_;
+}
+
+bool Random::operator==(const Random& other) const {
+  return seed_ == other.seed_ && stream_ == other.stream_ && GetPosition() == other.GetPosition();
+}
+
+bool Random::operator!=(const Random& other) const {
+  return !(*this == other);
+}
+
+void Random::Philox(uint32_t counter[4], const uint32_t key[2]) {
+  uint32_t key_0 = key[0];
+  uint32_t key_1 = key[1];
+
+  for (size_t round = 0; round < kPhiloxRounds; round++) {
+    uint64_t product_0 = (uint64_t) (kPhiloxMultiplier0) * counter[0];
+    uint64_t product_1 = (uint64_t) (kPhiloxMultiplier1) * counter[2];
+
+    uint32_t next_0 = (uint32_t) (product_1 >> 32) ^ counter[1] ^ key_0;
+    uint32_t next_1 = (uint32_t) (product_1);
+    uint32_t next_2 = (uint32_t) (product_0 >> 32) ^ counter[3] ^ key_1;
+    uint32_t next_3 = (uint32_t) (product_0);
+
+    counter[0] = next_0;
+    counter[1] = next_1;
+    counter[2] = next_2;
+    counter[3] = next_3;
+
+    key_0 += kPhiloxKeyIncrement0;
+    key_1 += kPhiloxKeyIncrement1;
+  }
+}
+
+void Random::GenerateBlock() {
+  // The low half of the counter is the block index and the high half is the stream
+  outputs_[0] = (uint32_t) (block_);
+  outputs_[1] = (uint32_t) (block_ >> 32);
+  outputs_[2] = (uint32_t) (stream_);
+  outputs_[3] = (uint32_t) (stream_ >> 32);
+  const uint32_t key[2] = {(uint32_t) (seed_), (uint32_t) (seed_ >> 32)};
+
+  Philox(outputs_, key);
+  block_++;
+  output_index_ = 0;
+}
+
+} // namespace dig_dug
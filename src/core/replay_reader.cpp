@@ -0,0 +1,183 @@
+#include "core/replay_reader.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "core/binary_io.h"
+
+namespace dig_dug {
+
+ReplayReader::ReplayReader(const string& path) : file_(path) {
+  data_ = file_.GetData();
+  size_ = file_.GetSize();
+  Parse();
+}
+
+ReplayReader::ReplayReader(const uint8_t* data, size_t size) : data_(data), size_(size) {
+  Parse();
+}
+
+void ReplayReader::Play(GameSession& session) {
+  session = GameSession(seed_, tile_size_, level_, nullptr, board_dimension_, enemy_scale_);
+  tick_ = 0;
+  input_offset_ = 0;
+  run_left_ = 0;
+
+  uint64_t hash;
+  size_t input_offset;
+  ReadKeyframe(0, input_offset, hash, nullptr);
+  Verify(session, hash);
+
+  Advance(session, num_ticks_);
+}
+
+void ReplayReader::Seek(GameSession& session, size_t tick) {
+  if (tick > num_ticks_) {
+    throw std::out_of_range("Tick is past the end of the replay");
+  }
+
+  // Replays that end on a whole interval have no keyframe at the very end
+  size_t keyframe = std::min(tick / keyframe_interval_, num_keyframes_ - 1);
+  SessionSnapshot snapshot;
+  uint64_t hash;
+  ReadKeyframe(keyframe, input_offset_, hash, &snapshot);
+  tick_ = keyframe * keyframe_interval_;
+  run_left_ = 0;
+
+  session.Restore(snapshot);
+  Verify(session, hash);
+  Advance(session, tick - tick_);
+}
+
+void ReplayReader::Advance(GameSession& session, size_t num_ticks) {
+  if (num_ticks > num_ticks_ - tick_) {
+    throw std::out_of_range("Playing past the end of the replay");
+  }
+
+  size_t inputs_size = keyframes_offset_ - kReplayHeaderSize;
+  ByteReader inputs(data_ + kReplayHeaderSize, inputs_size);
+  inputs.Seek(input_offset_);
+
+  for (size_t tick = 0; tick < num_ticks; tick++) {
+    if (run_left_ == 0) {
+      uint64_t run = inputs.ReadVarint();
+      run_action_ = static_cast<PlayerAction>(run & kReplayActionMask);
+      run_left_ = (size_t) (run >> kReplayActionBits);
+    }
+
+    session.Update(InputFrame(run_action_));
+    run_left_--;
+    tick_++;
+
+    if (tick_ % keyframe_interval_ == 0 && tick_ / keyframe_interval_ < num_keyframes_) {
+      uint64_t hash;
+      size_t input_offset;
+      ReadKeyframe(tick_ / keyframe_interval_, input_offset, hash, nullptr);
+      Verify(session, hash);
+    }
+  }
+
+  input_offset_ = inputs.GetOffset();
+  if (tick_ == num_ticks_) {
+    Verify(session, final_hash_);
+  }
+}
+
+size_t ReplayReader::GetTick() const {
+  return tick_;
+}
+
+size_t ReplayReader::GetNumTicks() const {
+  return num_ticks_;
+}
+
+uint64_t ReplayReader::GetSeed() const {
+  return seed_;
+}
+
+size_t ReplayReader::GetLevel() const {
+  return level_;
+}
+
+size_t ReplayReader::GetTileSize() const {
+  return tile_size_;
+}
+
+size_t ReplayReader::GetBoardDimension() const {
+  return board_dimension_;
+}
+
+size_t ReplayReader::GetEnemyScale() const {
+  return enemy_scale_;
+}
+
+size_t ReplayReader::GetKeyframeInterval() const {
+  return keyframe_interval_;
+}
+
+size_t ReplayReader::GetNumKeyframes() const {
+  return num_keyframes_;
+}
+
+void ReplayReader::Parse() {
+  if (size_ < kReplayHeaderSize + kReplayFooterSize) {
+    throw std::runtime_error("Replay is too short");
+  }
+
+  ByteReader header(data_, size_);
+  if (header.ReadFixed32() != kReplayMagic) {
+    throw std::runtime_error("Not a replay file");
+  }
+  if (header.ReadFixed32() != kReplayVersion) {
+    throw std::runtime_error("Replay was written in another version of the format");
+  }
+  if (header.ReadFixed32() != sizeof(SessionSnapshot)) {
+    throw std::runtime_error("Replay was written by a build with a different snapshot layout");
+  }
+  header.ReadFixed32();
+  seed_ = header.ReadFixed64();
+  level_ = header.ReadFixed32();
+  tile_size_ = header.ReadFixed32();
+  keyframe_interval_ = header.ReadFixed32();
+  board_dimension_ = header.ReadFixed32();
+  enemy_scale_ = header.ReadFixed32();
+  if (!GameStateGenerator::IsValidDimension(board_dimension_)) {
+    throw std::runtime_error("Replay has boards of " + std::to_string(board_dimension_) + " tiles per side");
+  }
+
+  ByteReader footer(data_ + size_ - kReplayFooterSize, kReplayFooterSize);
+  num_ticks_ = (size_t) (footer.ReadFixed64());
+  final_hash_ = footer.ReadFixed64();
+  keyframes_offset_ = (size_t) (footer.ReadFixed64());
+  num_keyframes_ = footer.ReadFixed32();
+  if (footer.ReadFixed32() != kReplayEndMagic) {
+    throw std::runtime_error("Replay is incomplete");
+  }
+
+  // Keyframe 0 is always there, and one more for every whole interval before the last tick
+  size_t expected_keyframes = keyframe_interval_ == 0 ? 0 : (num_ticks_ + keyframe_interval_ - 1) / keyframe_interval_;
+  if (keyframe_interval_ == 0 || num_keyframes_ != std::max(expected_keyframes, (size_t) (1))
+      || keyframes_offset_ < kReplayHeaderSize
+      || keyframes_offset_ + num_keyframes_ * kReplayKeyframeSize + kReplayFooterSize != size_) {
+    throw std::runtime_error("Replay sections do not fit together");
+  }
+}
+
+void ReplayReader::ReadKeyframe(size_t keyframe, size_t& input_offset, uint64_t& hash,
+                                SessionSnapshot* snapshot) const {
+  ByteReader reader(data_ + keyframes_offset_ + keyframe * kReplayKeyframeSize, kReplayKeyframeSize);
+  input_offset = (size_t) (reader.ReadFixed64());
+  hash = reader.ReadFixed64();
+  if (snapshot != nullptr) {
+    reader.ReadBytes(snapshot, sizeof(SessionSnapshot));
+  }
+}
+
+void ReplayReader::Verify(const GameSession& session, uint64_t hash) const {
+  if (session.GetStateHash() != hash) {
+    throw std::runtime_error("Replay diverged from the recording by tick " + std::to_string(tick_));
+  }
+}
+
+} // namespace dig_dug
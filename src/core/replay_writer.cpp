@@ -0,0 +1,95 @@
+#include "core/replay_writer.h"
+
+#include <fstream>
+#include <stdexcept>
+
+#include "core/binary_io.h"
+
+namespace dig_dug {
+
+ReplayWriter::ReplayWriter(const GameSession& session, size_t keyframe_interval)
+    : keyframe_interval_(keyframe_interval) {
+  if (session.GetNumTicks() > 0) {
+    throw std::invalid_argument("Replays have to start at the beginning of a game");
+  }
+  if (keyframe_interval == 0) {
+    throw std::invalid_argument("Keyframe interval must be positive");
+  }
+
+  PutFixed32(bytes_, kReplayMagic);
+  PutFixed32(bytes_, kReplayVersion);
+  PutFixed32(bytes_, (uint32_t) (sizeof(SessionSnapshot)));
+  PutFixed32(bytes_, 0);
+  PutFixed64(bytes_, session.GetGenerator().GetSeed());
+  PutFixed32(bytes_, (uint32_t) (session.GetLevel()));
+  PutFixed32(bytes_, (uint32_t) (session.GetEngine().GetTileSize()));
+  PutFixed32(bytes_, (uint32_t) (keyframe_interval));
+  PutFixed32(bytes_, (uint32_t) (session.GetGenerator().GetBoardDimension()));
+  PutFixed32(bytes_, (uint32_t) (session.GetGenerator().GetEnemyScale()));
+
+  AddKeyframe(session);
+}
+
+void ReplayWriter::Record(const GameSession& session, const InputFrame& input) {
+  if (num_ticks_ > 0 && num_ticks_ % keyframe_interval_ == 0) {
+    FlushRun();
+    AddKeyframe(session);
+  }
+
+  if (input.action != run_action_) {
+    FlushRun();
+    run_action_ = input.action;
+  }
+
+  run_length_++;
+  num_ticks_++;
+}
+
+const vector<uint8_t>& ReplayWriter::Finish(const GameSession& session) {
+  FlushRun();
+
+  uint64_t keyframes_offset = bytes_.size();
+  bytes_.insert(bytes_.end(), keyframes_.begin(), keyframes_.end());
+  keyframes_.clear();
+
+  PutFixed64(bytes_, num_ticks_);
+  PutFixed64(bytes_, session.GetStateHash());
+  PutFixed64(bytes_, keyframes_offset);
+  PutFixed32(bytes_, (uint32_t) (num_keyframes_));
+  PutFixed32(bytes_, kReplayEndMagic);
+
+  return bytes_;
+}
+
+void ReplayWriter::Save(const string& path, const GameSession& session) {
+  const vector<uint8_t>& bytes = Finish(session);
+
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(bytes.data()), (std::streamsize) (bytes.size()));
+  if (!file) {
+    throw std::runtime_error("Cannot write " + path);
+  }
+}
+
+size_t ReplayWriter::GetNumTicks() const {
+  return num_ticks_;
+}
+
+void ReplayWriter::FlushRun() {
+  if (run_length_ > 0) {
+    PutVarint(bytes_, (uint64_t) (run_length_) << kReplayActionBits | static_cast<uint64_t>(run_action_));
+    run_length_ = 0;
+  }
+}
+
+void ReplayWriter::AddKeyframe(const GameSession& session) {
+  SessionSnapshot snapshot = session.Snapshot();
+  const uint8_t* snapshot_bytes = reinterpret_cast<const uint8_t*>(&snapshot);
+
+  PutFixed64(keyframes_, bytes_.size() - kReplayHeaderSize);
+  PutFixed64(keyframes_, session.GetStateHash());
+  keyframes_.insert(keyframes_.end(), snapshot_bytes, snapshot_bytes + sizeof(snapshot));
+  num_keyframes_++;
+}
+
+} // namespace dig_dug
@@ -0,0 +1,85 @@
+#include "core/spill_file.h"
+
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DIG_DUG_HAS_MMAP
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace dig_dug {
+
+#ifdef DIG_DUG_HAS_MMAP
+
+SpillFile::SpillFile(const string& directory, size_t size) : size_(size) {
+  string path = directory + "/dig_dug_spill_XXXXXX";
+  std::vector<char> path_buffer(path.begin(), path.end());
+  path_buffer.push_back('\0');
+
+  // Creates a file no one else has, so several spill files can share a folder
+  int file = mkstemp(path_buffer.data());
+  if (file < 0) {
+    throw std::runtime_error("Cannot create a spill file in " + directory);
+  }
+  unlink(path_buffer.data());
+
+  if (size_ > 0) {
+    if (ftruncate(file, (off_t) (size_)) != 0) {
+      close(file);
+      throw std::runtime_error("Cannot size a spill file in " + directory);
+    }
+
+    void* data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (data == MAP_FAILED) {
+      close(file);
+      throw std::runtime_error("Cannot map a spill file in " + directory);
+    }
+    data_ = static_cast<uint8_t*>(data);
+  }
+
+  // The mapping keeps the file alive after it is closed
+  close(file);
+}
+
+SpillFile::~SpillFile() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+}
+
+void SpillFile::Release(size_t offset, size_t size) {
+  // Whole pages are dropped, which only costs the neighbors of the range a reload
+  size_t page_size = (size_t) (sysconf(_SC_PAGESIZE));
+  size_t begin = offset / page_size * page_size;
+  size_t end = (offset + size + page_size - 1) / page_size * page_size;
+  if (end > size_) {
+    end = size_;
+  }
+
+  if (begin < end) {
+    madvise(data_ + begin, end - begin, MADV_DONTNEED);
+  }
+}
+
+#else
+
+SpillFile::SpillFile(const string& directory, size_t size) : size_(size) {
+  buffer_.resize(size_);
+  data_ = buffer_.data();
+}
+
+SpillFile::~SpillFile() {
+}
+
+void SpillFile::Release(size_t offset, size_t size) {
+}
+
+#endif
+
+size_t SpillFile::GetSize() const {
+  return size_;
+}
+
+} // namespace dig_dug
@@ -0,0 +1,21 @@
+#include "core/state_hash.h"
+
+namespace dig_dug {
+
+void StateHash::Add(const uint8_t* data, size_t size) {
+  for (size_t index = 0; index < size; index++) {
+    hash_ = (hash_ ^ data[index]) * kPrime;
+  }
+}
+
+void StateHash::Add(uint64_t value) {
+  for (size_t byte = 0; byte < sizeof(value); byte++) {
+    hash_ = (hash_ ^ ((value >> (byte * kBitsPerByte)) & 0xFF)) * kPrime;
+  }
+}
+
+uint64_t StateHash::Get() const {
+  return hash_;
+}
+
+} // namespace dig_dug
@@ -0,0 +1,367 @@
+#include "core/tile_grid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "core/spill_file.h"
+#include "core/state_hash.h"
+
+namespace dig_dug {
+
+// Defined here as well so it can be bound to references, like in vector::assign
+const uint32_t TileGrid::kImplicitChunk;
+
+TileGrid::TileGrid() = default;
+
+TileGrid::TileGrid(size_t dimension, TileType fill)
+    : TileGrid(dimension, fill, dimension > kMaxDenseDimension ? TileStorage::Chunked : TileStorage::Dense) {
+}
+
+TileGrid::TileGrid(size_t dimension, TileType fill, TileStorage storage) {
+  Initialize(dimension, fill, storage);
+}
+
+TileGrid::TileGrid(const vector<vector<TileType>>& tiles) {
+  Initialize(tiles.size(), TileType::Dirt,
+             tiles.size() > kMaxDenseDimension ? TileStorage::Chunked : TileStorage::Dense);
+
+  for (size_t x = 0; x < dimension_; x++) {
+    if (tiles[x].size() != dimension_) {
+      throw std::invalid_argument("Game map must be square");
+    }
+
+    for (size_t y = 0; y < dimension_; y++) {
+      SetUnchecked(x, y, tiles[x][y]);
+    }
+  }
+}
+
+TileGrid::TileGrid(const TileGrid& other)
+    : dimension_(other.dimension_), tiles_(other.tiles_), is_chunked_(other.is_chunked_), fill_(other.fill_),
+      chunks_per_side_(other.chunks_per_side_), chunk_table_(other.chunk_table_), slot_chunks_(other.slot_chunks_),
+      slot_writes_(other.slot_writes_), free_slots_(other.free_slots_), write_clock_(other.write_clock_) {
+  if (other.num_spilled_chunks_ == 0) {
+    return;
+  }
+
+  for (size_t chunk = 0; chunk < chunk_table_.size(); chunk++) {
+    if (chunk_table_[chunk] == kSpilledChunk) {
+      uint32_t slot = AllocateSlot(chunk);
+      std::memcpy(&tiles_[slot * kChunkTiles], other.GetChunkTiles(chunk, kSpilledChunk), kChunkTiles);
+      chunk_table_[chunk] = slot;
+    }
+  }
+}
+
+TileGrid& TileGrid::operator=(const TileGrid& other) {
+  if (this != &other) {
+    TileGrid copy(other);
+    *this = std::move(copy);
+  }
+
+  return *this;
+}
+
+TileGrid::TileGrid(TileGrid&& other) noexcept = default;
+
+TileGrid& TileGrid::operator=(TileGrid&& other) noexcept = default;
+
+TileGrid::~TileGrid() = default;
+
+TileType TileGrid::Get(size_t x, size_t y) const {
+  if (!IsInBounds(x, y)) {
+    throw std::out_of_range("Tile is not on the board");
+  }
+
+  return GetUnchecked(x, y);
+}
+
+void TileGrid::Set(size_t x, size_t y, TileType type) {
+  if (!IsInBounds(x, y)) {
+    throw std::out_of_range("Tile is not on the board");
+  }
+
+  SetUnchecked(x, y, type);
+}
+
+bool TileGrid::IsInBounds(size_t x, size_t y) const {
+  return x < dimension_ && y < dimension_;
+}
+
+size_t TileGrid::GetDimension() const {
+  return dimension_;
+}
+
+size_t TileGrid::GetNumTiles() const {
+  return dimension_ * dimension_;
+}
+
+TileStorage TileGrid::GetStorage() const {
+  return is_chunked_ ? TileStorage::Chunked : TileStorage::Dense;
+}
+
+const uint8_t* TileGrid::GetData() const {
+  return is_chunked_ ? nullptr : tiles_.data();
+}
+
+void TileGrid::CopyData(uint8_t* tiles) const {
+  if (!is_chunked_) {
+    std::copy(tiles_.begin(), tiles_.end(), tiles);
+    return;
+  }
+
+  for (size_t x = 0; x < dimension_; x++) {
+    for (size_t y = 0; y < dimension_; y++) {
+      tiles[x * dimension_ + y] = static_cast<uint8_t>(GetUnchecked(x, y));
+    }
+  }
+}
+
+void TileGrid::SetData(const uint8_t* tiles) {
+  if (!is_chunked_) {
+    std::copy(tiles, tiles + tiles_.size(), tiles_.begin());
+    return;
+  }
+
+  // Tiles that match the fill leave implicit chunks alone, so only chunks with other tiles take memory
+  for (size_t x = 0; x < dimension_; x++) {
+    for (size_t y = 0; y < dimension_; y++) {
+      SetChunkedTile(x, y, static_cast<TileType>(tiles[x * dimension_ + y]));
+    }
+  }
+}
+
+void TileGrid::Fill(TileType type) {
+  if (!is_chunked_) {
+    std::fill(tiles_.begin(), tiles_.end(), static_cast<uint8_t>(type));
+    return;
+  }
+
+  fill_ = type;
+  std::fill(chunk_table_.begin(), chunk_table_.end(), kImplicitChunk);
+  tiles_.clear();
+  slot_chunks_.clear();
+  slot_writes_.clear();
+  free_slots_.clear();
+  num_spilled_chunks_ = 0;
+}
+
+void TileGrid::SpillTo(const string& directory, size_t max_resident_chunks) {
+  if (!is_chunked_) {
+    throw std::invalid_argument("Only chunked grids can spill");
+  }
+  if (max_resident_chunks == 0) {
+    throw std::invalid_argument("Spilling grids need to keep at least one chunk in memory");
+  }
+
+  // A grid that already spills keeps its file, since spilled chunks are in it
+  if (spill_ == nullptr) {
+    spill_.reset(new SpillFile(directory, chunk_table_.size() * kChunkTiles));
+  }
+
+  max_resident_chunks_ = max_resident_chunks;
+  if (GetNumResidentChunks() <= max_resident_chunks_) {
+    return;
+  }
+
+  while (GetNumResidentChunks() > max_resident_chunks_) {
+    SpillColdestChunk();
+  }
+  ShrinkPool();
+}
+
+size_t TileGrid::GetNumResidentChunks() const {
+  return slot_chunks_.size() - free_slots_.size();
+}
+
+size_t TileGrid::GetNumSpilledChunks() const {
+  return num_spilled_chunks_;
+}
+
+size_t TileGrid::GetMemoryUsage() const {
+  return tiles_.capacity() + chunk_table_.capacity() * sizeof(uint32_t)
+      + slot_chunks_.capacity() * sizeof(uint32_t) + slot_writes_.capacity() * sizeof(uint64_t)
+      + free_slots_.capacity() * sizeof(uint32_t);
+}
+
+void TileGrid::AddToHash(StateHash& hash) const {
+  if (!is_chunked_) {
+    hash.Add(tiles_.data(), tiles_.size());
+    return;
+  }
+
+  // Chunks that hold only the fill type hash like implicit ones, so it does not matter how they got that way
+  hash.Add(static_cast<uint64_t>(fill_));
+  for (size_t chunk = 0; chunk < chunk_table_.size(); chunk++) {
+    if (chunk_table_[chunk] != kImplicitChunk) {
+      const uint8_t* chunk_tiles = GetChunkTiles(chunk, chunk_table_[chunk]);
+
+      if (!IsAllFill(chunk_tiles)) {
+        hash.Add(chunk);
+        hash.Add(chunk_tiles, kChunkTiles);
+      }
+    }
+  }
+}
+
+vector<vector<TileType>> TileGrid::ToNestedVector() const {
+  vector<vector<TileType>> tiles(dimension_, vector<TileType>(dimension_));
+
+  for (size_t x = 0; x < dimension_; x++) {
+    for (size_t y = 0; y < dimension_; y++) {
+      tiles[x][y] = GetUnchecked(x, y);
+    }
+  }
+
+  return tiles;
+}
+
+bool TileGrid::operator==(const TileGrid& other) const {
+  if (!is_chunked_ && !other.is_chunked_) {
+    return dimension_ == other.dimension_ && tiles_ == other.tiles_;
+  }
+  if (dimension_ != other.dimension_) {
+    return false;
+  }
+
+  for (size_t x = 0; x < dimension_; x++) {
+    for (size_t y = 0; y < dimension_; y++) {
+      if (GetUnchecked(x, y) != other.GetUnchecked(x, y)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool TileGrid::operator!=(const TileGrid& other) const {
+  return !(*this == other);
+}
+
+const uint8_t* TileGrid::GetChunkTiles(size_t chunk, uint32_t entry) const {
+  if (entry == kSpilledChunk) {
+    return spill_->GetData() + chunk * kChunkTiles;
+  }
+
+  return tiles_.data() + entry * kChunkTiles;
+}
+
+void TileGrid::SetChunkedTile(size_t x, size_t y, TileType type) {
+  size_t chunk = GetChunkIndex(x, y);
+  uint32_t slot = chunk_table_[chunk];
+
+  if (slot == kImplicitChunk) {
+    if (type == fill_) {
+      return;
+    }
+
+    slot = AllocateSlot(chunk);
+    std::fill(&tiles_[slot * kChunkTiles], &tiles_[slot * kChunkTiles] + kChunkTiles, static_cast<uint8_t>(fill_));
+    chunk_table_[chunk] = slot;
+
+  } else if (slot == kSpilledChunk) {
+    slot = AllocateSlot(chunk);
+    std::memcpy(&tiles_[slot * kChunkTiles], spill_->GetData() + chunk * kChunkTiles, kChunkTiles);
+    chunk_table_[chunk] = slot;
+    num_spilled_chunks_--;
+
+  } else {
+    slot_writes_[slot] = ++write_clock_;
+  }
+
+  tiles_[slot * kChunkTiles + GetTileInChunk(x, y)] = static_cast<uint8_t>(type);
+}
+
+uint32_t TileGrid::AllocateSlot(size_t chunk) {
+  if (spill_ != nullptr && GetNumResidentChunks() >= max_resident_chunks_) {
+    SpillColdestChunk();
+  }
+
+  uint32_t slot;
+  if (!free_slots_.empty()) {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  } else {
+    slot = (uint32_t) (slot_chunks_.size());
+    slot_chunks_.push_back(kImplicitChunk);
+    slot_writes_.push_back(0);
+    tiles_.resize(tiles_.size() + kChunkTiles);
+  }
+
+  slot_chunks_[slot] = (uint32_t) (chunk);
+  slot_writes_[slot] = ++write_clock_;
+  return slot;
+}
+
+void TileGrid::SpillColdestChunk() {
+  // Free slots hold kImplicitChunk, and only happen after chunks were spilled
+  uint32_t coldest = kImplicitChunk;
+  for (size_t slot = 0; slot < slot_chunks_.size(); slot++) {
+    if (slot_chunks_[slot] != kImplicitChunk && (coldest == kImplicitChunk || slot_writes_[slot] < slot_writes_[coldest])) {
+      coldest = (uint32_t) (slot);
+    }
+  }
+  if (coldest == kImplicitChunk) {
+    return;
+  }
+
+  size_t chunk = slot_chunks_[coldest];
+  std::memcpy(spill_->GetData() + chunk * kChunkTiles, &tiles_[coldest * kChunkTiles], kChunkTiles);
+  spill_->Release(chunk * kChunkTiles, kChunkTiles);
+  chunk_table_[chunk] = kSpilledChunk;
+  slot_chunks_[coldest] = kImplicitChunk;
+  free_slots_.push_back(coldest);
+  num_spilled_chunks_++;
+}
+
+void TileGrid::ShrinkPool() {
+  vector<uint8_t> tiles;
+  vector<uint32_t> slot_chunks;
+  vector<uint64_t> slot_writes;
+  tiles.reserve(GetNumResidentChunks() * kChunkTiles);
+  slot_chunks.reserve(GetNumResidentChunks());
+  slot_writes.reserve(GetNumResidentChunks());
+
+  for (size_t slot = 0; slot < slot_chunks_.size(); slot++) {
+    if (slot_chunks_[slot] != kImplicitChunk) {
+      chunk_table_[slot_chunks_[slot]] = (uint32_t) (slot_chunks.size());
+      tiles.insert(tiles.end(), &tiles_[slot * kChunkTiles], &tiles_[slot * kChunkTiles] + kChunkTiles);
+      slot_chunks.push_back(slot_chunks_[slot]);
+      slot_writes.push_back(slot_writes_[slot]);
+    }
+  }
+
+  tiles_.swap(tiles);
+  slot_chunks_.swap(slot_chunks);
+  slot_writes_.swap(slot_writes);
+  vector<uint32_t>().swap(free_slots_);
+}
+
+bool TileGrid::IsAllFill(const uint8_t* chunk_tiles) const {
+  uint8_t fill = static_cast<uint8_t>(fill_);
+  for (size_t tile = 0; tile < kChunkTiles; tile++) {
+    if (chunk_tiles[tile] != fill) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void TileGrid::Initialize(size_t dimension, TileType fill, TileStorage storage) {
+  dimension_ = dimension;
+  fill_ = fill;
+  is_chunked_ = storage == TileStorage::Chunked;
+
+  if (is_chunked_) {
+    chunks_per_side_ = (dimension + kChunkDimension - 1) >> kChunkShift;
+    chunk_table_.assign(chunks_per_side_ * chunks_per_side_, kImplicitChunk);
+  } else {
+    tiles_.assign(dimension * dimension, static_cast<uint8_t>(fill));
+  }
+}
+
+} // namespace dig_dug
@@ -0,0 +1,84 @@
+#include "core/tile_layers.h"
+
+namespace dig_dug {
+
+TileLayers::TileLayers(const TileGrid& grid) {
+  size_t dimension = grid.GetDimension();
+  board_ = BitBoard::Full(dimension);
+
+  for (size_t x = 0; x < dimension; x++) {
+    for (size_t y = 0; y < dimension; y++) {
+      SetTile(x, y, grid.GetUnchecked(x, y));
+    }
+  }
+}
+
+bool TileLayers::CanRepresent(size_t dimension) {
+  return dimension <= BitBoard::kMaxDimension;
+}
+
+void TileLayers::SetTile(size_t x, size_t y, TileType type) {
+  dirt_.Clear(x, y);
+  tunnels_.Clear(x, y);
+  rocks_.Clear(x, y);
+
+  if (type == TileType::Dirt) {
+    dirt_.Set(x, y);
+  } else if (type == TileType::Tunnel) {
+    tunnels_.Set(x, y);
+  } else if (type == TileType::Rock) {
+    rocks_.Set(x, y);
+  }
+}
+
+const BitBoard& TileLayers::GetBoard() const {
+  return board_;
+}
+
+const BitBoard& TileLayers::GetDirt() const {
+  return dirt_;
+}
+
+const BitBoard& TileLayers::GetTunnels() const {
+  return tunnels_;
+}
+
+const BitBoard& TileLayers::GetRocks() const {
+  return rocks_;
+}
+
+BitBoard TileLayers::GetReachableTunnels(size_t x, size_t y) const {
+  BitBoard reached;
+  if (!tunnels_.Test(x, y)) {
+    return reached;
+  }
+
+  reached.Set(x, y);
+  // Grows the region by one tile in every direction until no new tunnel tiles are added
+  BitBoard frontier = reached;
+  while (!frontier.IsEmpty()) {
+    frontier = frontier.Neighbors() & tunnels_ & ~reached;
+    reached |= frontier;
+  }
+
+  return reached;
+}
+
+BitBoard TileLayers::GetJunctions() const {
+  BitBoard plus_x = tunnels_.ShiftedMinusX();
+  BitBoard minus_x = tunnels_.ShiftedPlusX();
+  BitBoard plus_y = tunnels_.ShiftedMinusY();
+  BitBoard minus_y = tunnels_.ShiftedPlusY();
+
+  // A tile has at least three tunnel neighbors if some three of the four neighbor masks contain it
+  BitBoard three_or_more = (plus_x & minus_x & plus_y) | (plus_x & minus_x & minus_y)
+                           | (plus_x & plus_y & minus_y) | (minus_x & plus_y & minus_y);
+
+  return three_or_more & tunnels_;
+}
+
+size_t TileLayers::CountTunnels() const {
+  return tunnels_.Count();
+}
+
+} // namespace dig_dug
@@ -0,0 +1,42 @@
+#include "core/tunnel_exits.h"
+
+namespace dig_dug {
+
+void TunnelExits::Reset(const TileGrid& grid) {
+  dimension_ = grid.GetDimension();
+  exits_.assign(dimension_ * dimension_, 0);
+
+  for (size_t x = 0; x < dimension_; x++) {
+    for (size_t y = 0; y < dimension_; y++) {
+      if (grid.GetUnchecked(x, y) == TileType::Tunnel) {
+        SetTile(x, y, TileType::Tunnel);
+      }
+    }
+  }
+}
+
+bool TunnelExits::CanRepresent(size_t dimension) {
+  // Chunked boards only take memory for the chunks that were changed, which a mask per tile would undo
+  return dimension <= TileGrid::kMaxDenseDimension;
+}
+
+void TunnelExits::SetTile(size_t x, size_t y, TileType type) {
+  for (size_t index = 0; index < kNumDirections; index++) {
+    Direction direction = static_cast<Direction>(index);
+    size_t next_x;
+    size_t next_y;
+
+    // The neighbor reaches this tile by going the opposite way
+    if (GetNeighbor(x, y, direction, dimension_, next_x, next_y)) {
+      uint8_t bit = (uint8_t) (1 << static_cast<size_t>(Reverse(direction)));
+      uint8_t& exits = exits_[next_x * dimension_ + next_y];
+      exits = type == TileType::Tunnel ? (uint8_t) (exits | bit) : (uint8_t) (exits & ~bit);
+    }
+  }
+}
+
+size_t TunnelExits::GetDimension() const {
+  return dimension_;
+}
+
+} // namespace dig_dug
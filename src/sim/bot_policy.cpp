@@ -0,0 +1,105 @@
+#include "sim/bot_policy.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+namespace dig_dug {
+
+void IdlePolicy::Reset(uint64_t seed) {
+}
+
+PlayerAction IdlePolicy::ChooseAction(const GameEngine& engine) {
+  return PlayerAction::None;
+}
+
+void RandomPolicy::Reset(uint64_t seed) {
+  random_ = Random(seed);
+  cur_action_ = PlayerAction::None;
+  remaining_frames_ = 0;
+}
+
+PlayerAction RandomPolicy::ChooseAction(const GameEngine& engine) {
+  const uint32_t kNumActions = 6;
+
+  if (remaining_frames_ == 0) {
+    cur_action_ = static_cast<PlayerAction>(random_.NextBelow(kNumActions));
+    remaining_frames_ = random_.NextBelow(kMaxHoldFrames) + 1;
+  }
+
+  remaining_frames_--;
+  return cur_action_;
+}
+
+void HunterPolicy::Reset(uint64_t seed) {
+}
+
+PlayerAction HunterPolicy::ChooseAction(const GameEngine& engine) {
+  // Keeps shooting until the harpoon hits something or runs out
+  if (engine.IsPlayerAttacking()) {
+    return PlayerAction::Attack;
+  }
+
+  const EnemyPool& enemies = engine.GetEnemyView();
+  const Player& player = engine.GetPlayerView();
+  FixedVec2 player_position = player.GetFixedPosition();
+
+  bool has_target = false;
+  FixedVec2 target_offset;
+  int64_t target_distance = 0;
+  for (size_t index = 0; index < enemies.Size(); index++) {
+    FixedVec2 offset = enemies.GetPosition(index) - player_position;
+    int64_t distance = LengthSquared(offset);
+
+    if (!enemies.IsGhost(index) && (!has_target || distance < target_distance)) {
+      has_target = true;
+      target_offset = offset;
+      target_distance = distance;
+    }
+  }
+
+  if (!has_target) {
+    return PlayerAction::None;
+  }
+
+  Direction toward;
+  if (std::abs(target_offset.x) >= std::abs(target_offset.y)) {
+    toward = target_offset.x > 0 ? Direction::Right : Direction::Left;
+  } else {
+    toward = target_offset.y > 0 ? Direction::Down : Direction::Up;
+  }
+
+  int32_t tile = PixelsToFixed((int32_t) (engine.GetTileSize()));
+  int32_t range = tile * (int32_t) (kAttackRangeTiles);
+  bool is_in_row = std::abs(target_offset.y) < tile / 2 && std::abs(target_offset.x) <= range;
+  bool is_in_column = std::abs(target_offset.x) < tile / 2 && std::abs(target_offset.y) <= range;
+  bool is_facing_target = GetTravelDirection(player.GetFixedPrevVelocity()) == toward;
+
+  if ((is_in_row || is_in_column) && is_facing_target) {
+    return PlayerAction::Attack;
+  }
+
+  switch (toward) {
+    case Direction::Right:
+      return PlayerAction::Right;
+    case Direction::Down:
+      return PlayerAction::Down;
+    case Direction::Left:
+      return PlayerAction::Left;
+    default:
+      return PlayerAction::Up;
+  }
+}
+
+std::unique_ptr<BotPolicy> CreateBotPolicy(const std::string& name) {
+  if (name == "idle") {
+    return std::unique_ptr<BotPolicy>(new IdlePolicy());
+  } else if (name == "random") {
+    return std::unique_ptr<BotPolicy>(new RandomPolicy());
+  } else if (name == "hunter") {
+    return std::unique_ptr<BotPolicy>(new HunterPolicy());
+  }
+
+  throw std::invalid_argument("Unknown bot policy " + name);
+}
+
+} // namespace dig_dug
@@ -0,0 +1,139 @@
+#include "sim/episode_runner.h"
+
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "sim/work_stealing_queue.h"
+
+namespace dig_dug {
+
+double RunSummary::GetEpisodesPerSecond() const {
+  return seconds > 0 ? episodes.size() / seconds : 0;
+}
+
+double RunSummary::GetTicksPerSecond() const {
+  return seconds > 0 ? num_ticks / seconds : 0;
+}
+
+EpisodeRunner::EpisodeRunner(const RunnerConfig& config) : config_(config) {
+  if (config_.num_threads == 0) {
+    throw std::invalid_argument("Runner needs at least one thread");
+  }
+
+  if (!GameStateGenerator::IsValidDimension(config_.board_dimension)) {
+    throw std::invalid_argument("Cannot play boards with " + std::to_string(config_.board_dimension)
+                                + " tiles per side");
+  }
+
+  // Fails early on a bad policy name instead of on every worker thread
+  CreateBotPolicy(config_.policy);
+
+  if (!config_.level_pack_path.empty()) {
+    level_pack_ = std::make_shared<LevelPack>(config_.level_pack_path);
+  }
+}
+
+RunSummary EpisodeRunner::Run() const {
+  RunSummary summary;
+  summary.episodes.resize(config_.num_episodes);
+  size_t num_workers = config_.num_threads;
+  WorkStealingQueueArray queues(num_workers);
+  vector<vector<EpisodeResult>> worker_results(num_workers);
+  vector<std::exception_ptr> worker_errors(num_workers);
+
+  // Each worker starts with a contiguous block of the episodes
+  for (size_t worker = 0; worker < num_workers; worker++) {
+    size_t begin = worker * config_.num_episodes / num_workers;
+    size_t end = (worker + 1) * config_.num_episodes / num_workers;
+
+    for (size_t episode = begin; episode < end; episode++) {
+      queues[worker].Push(episode);
+    }
+  }
+
+  auto start_time = std::chrono::steady_clock::now();
+
+  vector<std::thread> threads;
+  for (size_t worker = 0; worker < num_workers; worker++) {
+    threads.emplace_back([this, worker, num_workers, &queues, &worker_results, &worker_errors]() {
+      // An exception leaving a thread would terminate the program, so it is kept for Run to throw after the join
+      try {
+        // Sessions, engines and policies live on the worker's own stack and heap, and results are only shared once
+        // the worker finishes, so workers never write to the same cache lines while playing
+        std::unique_ptr<BotPolicy> policy = CreateBotPolicy(config_.policy);
+        vector<EpisodeResult> results;
+        size_t episode;
+
+        while (true) {
+          bool has_episode = queues[worker].Pop(episode);
+
+          // No new work is added during a run, so once every queue is empty the worker is done
+          for (size_t offset = 1; offset < num_workers && !has_episode; offset++) {
+            has_episode = queues[(worker + offset) % num_workers].Steal(episode);
+          }
+
+          if (!has_episode) {
+            break;
+          }
+
+          results.push_back(PlayEpisode(config_.first_seed + episode, *policy, config_.max_ticks, level_pack_.get(),
+                                        config_.board_dimension, config_.enemy_scale));
+        }
+
+        worker_results[worker] = std::move(results);
+      } catch (...) {
+        worker_errors[worker] = std::current_exception();
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (const std::exception_ptr& error : worker_errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+  summary.seconds = elapsed.count();
+  for (const vector<EpisodeResult>& results : worker_results) {
+    for (const EpisodeResult& result : results) {
+      summary.episodes[result.seed - config_.first_seed] = result;
+      summary.num_ticks += result.num_ticks;
+    }
+  }
+
+  return summary;
+}
+
+EpisodeResult EpisodeRunner::PlayEpisode(uint64_t seed, BotPolicy& policy, size_t max_ticks,
+                                         BoardSource* board_source, size_t board_dimension, size_t enemy_scale) {
+  GameSession session(seed, kTileSize, 1, board_source, board_dimension, enemy_scale);
+  policy.Reset(seed);
+
+  while (!session.IsGameOver() && session.GetNumTicks() < max_ticks) {
+    InputFrame input;
+    if (!session.IsLosingLife()) {
+      input.action = policy.ChooseAction(session.GetEngine());
+    }
+
+    session.Update(input);
+  }
+
+  EpisodeResult result;
+  result.seed = seed;
+  result.score = session.GetScore();
+  result.level = session.GetLevel();
+  result.num_ticks = session.GetNumTicks();
+
+  return result;
+}
+
+} // namespace dig_dug
@@ -0,0 +1,80 @@
+#include "sim/level_pack_builder.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dig_dug {
+
+using std::vector;
+
+void BuildLevelPack(const std::string& path, const LevelPackConfig& config) {
+  if (config.num_seeds == 0 || config.num_levels == 0 || config.boards_per_level == 0) {
+    throw std::invalid_argument("Level pack needs at least one board");
+  }
+  if (config.num_threads == 0) {
+    throw std::invalid_argument("Level pack needs at least one thread to build it");
+  }
+  if (config.board_dimension > LevelPack::kMaxDimension) {
+    throw std::invalid_argument("Level packs hold boards of at most " + std::to_string(LevelPack::kMaxDimension)
+                                + " tiles per side");
+  }
+  // Fails on the caller's thread on boards the generator cannot make
+  GameStateGenerator(config.first_seed, config.board_dimension);
+
+  LevelPackHeader header;
+  header.magic = kLevelPackMagic;
+  header.version = kLevelPackVersion;
+  header.byte_order = kLevelPackByteOrder;
+  header.board_dimension = (uint32_t) (config.board_dimension);
+  header.first_seed = config.first_seed;
+  header.num_seeds = config.num_seeds;
+  header.num_levels = (uint32_t) (config.num_levels);
+  header.boards_per_level = (uint32_t) (config.boards_per_level);
+  header.record_size = (uint32_t) (LevelPack::GetRecordSize(header.board_dimension));
+
+  size_t num_boards = config.num_seeds * config.num_levels * config.boards_per_level;
+  vector<uint8_t> pack(sizeof(header) + num_boards * header.record_size);
+  std::memcpy(pack.data(), &header, sizeof(header));
+  uint8_t* records = pack.data() + sizeof(header);
+
+  // Every board only depends on its seed, level and number, so threads take contiguous blocks of seeds
+  size_t num_workers = config.num_threads < config.num_seeds ? config.num_threads : config.num_seeds;
+  vector<std::thread> threads;
+  for (size_t worker = 0; worker < num_workers; worker++) {
+    size_t begin = worker * config.num_seeds / num_workers;
+    size_t end = (worker + 1) * config.num_seeds / num_workers;
+
+    threads.emplace_back([&header, &config, records, begin, end]() {
+      for (size_t seed_index = begin; seed_index < end; seed_index++) {
+        uint64_t seed = config.first_seed + seed_index;
+        GameStateGenerator generator(seed, config.board_dimension);
+
+        for (size_t level = 1; level <= config.num_levels; level++) {
+          generator.SetLevel(level);
+
+          for (size_t board = 1; board <= config.boards_per_level; board++) {
+            generator.Generate();
+            size_t index = LevelPack::GetRecordIndex(header, seed, level, board);
+            LevelPack::EncodeBoard(generator, records + index * header.record_size);
+          }
+        }
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(pack.data()), (std::streamsize) (pack.size()));
+  if (!file) {
+    throw std::runtime_error("Cannot write " + path);
+  }
+}
+
+} // namespace dig_dug
@@ -0,0 +1,97 @@
+#include "sim/level_prefetcher.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace dig_dug {
+
+// Defined here as well so it can be bound to references, like in std::chrono::microseconds
+const size_t LevelPrefetcher::kIdleMicroseconds;
+
+LevelPrefetcher::LevelPrefetcher(size_t board_dimension) : board_dimension_(board_dimension) {
+  // Fails on the caller's thread rather than the background one
+  if (!GameStateGenerator::IsValidDimension(board_dimension_)) {
+    throw std::invalid_argument("Cannot prefetch boards with " + std::to_string(board_dimension_) + " tiles per side");
+  }
+  worker_ = std::thread(&LevelPrefetcher::Work, this);
+}
+
+LevelPrefetcher::~LevelPrefetcher() {
+  is_stopping_.store(true);
+  wake_.notify_one();
+  worker_.join();
+}
+
+void LevelPrefetcher::Prepare(uint64_t seed, size_t level, size_t num_boards) {
+  Request request;
+  request.seed = seed;
+  request.level = level;
+  request.num_boards = num_boards;
+
+  // The count goes up first so Wait never sees a request that is queued but not counted
+  num_pending_.fetch_add(1);
+  if (!requests_.TryPush(request)) {
+    num_pending_.fetch_sub(1);
+    return;
+  }
+
+  // Notifying without the lock can miss a thread that is about to sleep, which then only sleeps kIdleMicroseconds
+  wake_.notify_one();
+}
+
+bool LevelPrefetcher::TakeBoard(uint64_t seed, size_t level, size_t num_boards, GameStateGenerator& generator) {
+  Request wanted;
+  wanted.seed = seed;
+  wanted.level = level;
+  wanted.num_boards = num_boards;
+
+  // Boards come out in the order they were asked for, so any before the wanted one are for paths the game did not take
+  Board board;
+  while (boards_.TryPop(board)) {
+    if (board.request == wanted && board.map.GetDimension() == generator.GetBoardDimension() &&
+        generator.GetEnemyScale() == GameStateGenerator::GetDefaultEnemyScale(board_dimension_)) {
+      generator.SetBoard(level, num_boards, std::move(board.map), board.engine_seed);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void LevelPrefetcher::Wait() const {
+  while (num_pending_.load() > 0) {
+    std::this_thread::yield();
+  }
+}
+
+void LevelPrefetcher::Work() {
+  GameStateGenerator generator(0, board_dimension_);
+  Request request;
+
+  while (!is_stopping_.load()) {
+    if (!requests_.TryPop(request)) {
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      wake_.wait_for(lock, std::chrono::microseconds(kIdleMicroseconds),
+                     [this]() { return is_stopping_.load() || !requests_.IsEmpty(); });
+      continue;
+    }
+
+    if (generator.GetSeed() != request.seed) {
+      generator = GameStateGenerator(request.seed, board_dimension_);
+    }
+    generator.Resume(request.level, request.num_boards);
+
+    Board board;
+    board.request = request;
+    board.map = generator.GetTileGrid();
+    board.engine_seed = generator.GetEngineSeed();
+
+    // A full ring means the session is not taking boards, so this one would only be dropped later anyway
+    boards_.TryPush(board);
+    num_pending_.fetch_sub(1);
+  }
+}
+
+} // namespace dig_dug
@@ -0,0 +1,61 @@
+#include "sim/work_stealing_queue.h"
+
+#include <cstdint>
+#include <new>
+
+namespace dig_dug {
+
+void WorkStealingQueue::Push(size_t item) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  items_.push_back(item);
+}
+
+bool WorkStealingQueue::Pop(size_t& item) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (items_.empty()) {
+    return false;
+  }
+
+  item = items_.back();
+  items_.pop_back();
+  return true;
+}
+
+bool WorkStealingQueue::Steal(size_t& item) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (items_.empty()) {
+    return false;
+  }
+
+  item = items_.front();
+  items_.pop_front();
+  return true;
+}
+
+size_t WorkStealingQueue::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return items_.size();
+}
+
+WorkStealingQueueArray::WorkStealingQueueArray(size_t size)
+    : size_(size), storage_(new char[size * sizeof(WorkStealingQueue) + kCacheLineSize]) {
+  uintptr_t address = reinterpret_cast<uintptr_t>(storage_.get());
+  uintptr_t aligned = (address + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+  queues_ = reinterpret_cast<WorkStealingQueue*>(aligned);
+
+  for (size_t index = 0; index < size_; index++) {
+    new (&queues_[index]) WorkStealingQueue();
+  }
+}
+
+WorkStealingQueueArray::~WorkStealingQueueArray() {
+  for (size_t index = 0; index < size_; index++) {
+    queues_[index].~WorkStealingQueue();
+  }
+}
+
+size_t WorkStealingQueueArray::Size() const {
+  return size_;
+}
+
+} // namespace dig_dug
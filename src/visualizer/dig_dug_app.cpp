@@ -1,13 +1,14 @@
 #include "visualizer/dig_dug_app.h"
 
+#include <cstdio>
+#include <stdexcept>
+
 namespace dig_dug {
 
 DigDugApp::DigDugApp() {
-  srand((unsigned int) (time(0)));
+  // Boards after the first are generated in the background while the player is still on the one before
+  session_ = GameSession((uint64_t) (time(0)), kTileSize, 1, &prefetcher_);
   ci::app::setWindowSize((int) (kWindowSize), (int) (kWindowSize));
-
-  generator_.Generate();
-  engine_ = GameEngine(generator_.GetGameMap(), kTileSize);
 }
 
 void DigDugApp::draw() {
@@ -22,14 +23,17 @@ void DigDugApp::draw() {
   const double kLevelScreenYFraction = 1.0 / 4.0;
   const double kScoreScreenXFraction = 1.0 / 2.0;
   const double kScoreScreenYFraction = 3.0 / 8.0;
+  const double kLatencyScreenYFraction = 1.0 / 2.0;
   const double kLevelSize = 3.0 / 4.0;
   const double kScoreSize = 3.0 / 4.0;
+  const double kLatencySize = 1.0 / 4.0;
+  const double kNanosecondsPerMillisecond = 1e6;
 
   ci::Color8u background_color(0, 0, 0);
   ci::gl::clear(background_color);
 
   // Draws the game over screen
-  if (game_over_) {
+  if (session_.IsGameOver()) {
     ci::gl::drawStringCentered("Game Over",
                                {kWindowSize * kGameOverScreenXFraction, kWindowSize * kGameOverScreenYFraction},
                                ci::Color("red"),
@@ -44,114 +48,118 @@ void DigDugApp::draw() {
                                                     kMargin + kBoardToWindowRatio * kWindowSize});
     ci::gl::color(ci::Color("white"));
     ci::gl::drawStrokedRect(game_board_background);
-    ci::gl::drawStringCentered("Level " + std::to_string(generator_.GetLevel()),
+    ci::gl::drawStringCentered("Level " + std::to_string(session_.GetLevel()),
                                {kWindowSize * kLevelScreenXFraction, kMargin * kLevelScreenYFraction},
                                ci::Color("white"),
                                ci::Font("Helvetica Neue", (float) (kMargin * kLevelSize)));
 
-    ci::gl::drawStringCentered("Score: " + std::to_string(engine_.GetScore()),
+    ci::gl::drawStringCentered("Score: " + std::to_string(session_.GetScore()),
                                {kWindowSize - (kWindowSize - kWindowSize * kBoardToWindowRatio)
                                * kScoreScreenXFraction,kWindowSize * kScoreScreenYFraction},
                                ci::Color("white"),
                                ci::Font("Helvetica Neue", (float) (kMargin * kScoreSize)));
 
-    DrawLives();
-    DrawBoard();
-    DrawPlayer();
-    DrawEnemies();
+    // Time from a key press until the tick that acted on it, over every press so far
+    const LatencyHistogram& latencies = input_.GetLatencies();
+    char latency_text[64];
+    snprintf(latency_text, sizeof(latency_text), "Input lag p50 %.1f ms, p99 %.1f ms",
+             latencies.GetPercentile(0.5) / kNanosecondsPerMillisecond,
+             latencies.GetPercentile(0.99) / kNanosecondsPerMillisecond);
+    ci::gl::drawStringCentered(latency_text,
+                               {kWindowSize - (kWindowSize - kWindowSize * kBoardToWindowRatio)
+                               * kScoreScreenXFraction, kWindowSize * kLatencyScreenYFraction},
+                               ci::Color("white"),
+                               ci::Font("Helvetica Neue", (float) (kMargin * kLatencySize)));
+
+    const FrameView& frame = session_.GetEngine().GetFrameView();
+    DrawLives(frame);
+
+    // The game is drawn in its own pixels, scaled so a board of any size fills the board's part of the window
+    ci::gl::ScopedModelMatrix board_transform;
+    float board_scale = (float) (kBoardToWindowRatio * kWindowSize / (frame.tiles->GetDimension() * kTileSize));
+    ci::gl::translate((float) (kMargin), (float) (kMargin));
+    ci::gl::scale(board_scale, board_scale);
+    DrawBoard(frame);
+    DrawPlayer(frame);
+    DrawEnemies(frame);
   }
 }
 
 void DigDugApp::update() {
-  if (game_over_) {
-    return;
+  double now = ci::app::getElapsedSeconds();
+  size_t num_ticks = timestep_.Advance(now - last_update_seconds_);
+  last_update_seconds_ = now;
+
+  for (size_t tick = 0; tick < num_ticks; tick++) {
+    interpolator_.Capture(session_.GetEngine());
+    session_.Update(input_.Sample(now));
   }
+}
 
-  vector<Enemy> enemies = engine_.GetEnemies();
-
-  if (enemies.empty()) {
-    size_t num_lives = engine_.GetNumLives();
-    size_t score = engine_.GetScore();
-    live_lost_num_frames_ = 0;
-    generator_.IncreaseLevel();
-    generator_.Generate();
-    engine_ = GameEngine(generator_.GetGameMap(), kTileSize);
-    engine_.SetNumLives(num_lives);
-    engine_.SetScore(score + kLevelUpScore);
-
-  } else if (engine_.GetNumLives() > 0 && live_lost_num_frames_ == 0) {
-    if (engine_.IsPlayerDead()) {
-      live_lost_num_frames_++;
-    } else {
-      engine_.MoveEnemies();
+void DigDugApp::keyDown(KeyEvent event) {
+  if (event.getCode() == KeyEvent::KEY_RETURN) {
+    session_.NewGame((uint64_t) (time(0)));
+    input_.Clear();
+    interpolator_.Clear();
+
+  } else if (event.getCode() == KeyEvent::KEY_F5) {
+    // Saving is best effort, so a folder that cannot be written to does not end the game
+    try {
+      SaveSession(kSavePath, session_);
+    } catch (const std::runtime_error&) {
     }
 
-  } else if (live_lost_num_frames_ > 0){
-    live_lost_num_frames_++;
-
-    if (live_lost_num_frames_ > kMaxLiveLostFrames) {
-      live_lost_num_frames_ = 0;
-      size_t new_lives = engine_.GetNumLives();
-      size_t score = engine_.GetScore();
-      generator_.Generate();
-      engine_ = GameEngine(generator_.GetGameMap(), kTileSize);
-      engine_.SetNumLives(new_lives);
-      engine_.SetScore(score);
+  } else if (event.getCode() == KeyEvent::KEY_F9) {
+    // Keeps playing the current game if there is no save to load
+    try {
+      LoadSession(kSavePath, session_);
+      input_.Clear();
+      interpolator_.Clear();
+    } catch (const std::runtime_error&) {
     }
 
   } else {
-    game_over_ = true;
+    input_.Press(GetKeyAction(event), ci::app::getElapsedSeconds());
   }
 }
 
-void DigDugApp::keyDown(KeyEvent event) {
-  vec2 right_velocity {1, 0};
-  vec2 left_velocity {-1, 0};
-  vec2 up_velocity {0, -1};
-  vec2 down_velocity {0, 1};
+void DigDugApp::keyUp(KeyEvent event) {
+  input_.Release(GetKeyAction(event));
+}
 
+PlayerAction DigDugApp::GetKeyAction(const KeyEvent& event) {
   switch (event.getCode()) {
     case KeyEvent::KEY_SPACE:
-      engine_.AttackEnemy();
-      break;
+      return PlayerAction::Attack;
 
     case KeyEvent::KEY_RIGHT:
-      engine_.MovePlayer(right_velocity);
-      break;
+      return PlayerAction::Right;
 
     case KeyEvent::KEY_DOWN:
-      engine_.MovePlayer(down_velocity);
-      break;
+      return PlayerAction::Down;
 
     case KeyEvent::KEY_LEFT:
-      engine_.MovePlayer(left_velocity);
-      break;
+      return PlayerAction::Left;
 
     case KeyEvent::KEY_UP:
-      engine_.MovePlayer(up_velocity);
-      break;
-
-    case KeyEvent::KEY_RETURN:
-      generator_ = GameStateGenerator();
-      generator_.Generate();
-      engine_ = GameEngine(generator_.GetGameMap(), kTileSize);
-      game_over_ = false;
-      break;
+      return PlayerAction::Up;
+
+    default:
+      return PlayerAction::None;
   }
 }
 
-void DigDugApp::DrawBoard() const {
-  vector<vector<TileType>> game_map = engine_.GetGameMap();
-  size_t size = game_map.size();
+void DigDugApp::DrawBoard(const FrameView& frame) const {
+  const TileGrid& game_map = *frame.tiles;
+  size_t size = game_map.GetDimension();
 
   for (size_t x = 0; x < size; x++) {
     for (size_t y = 0; y < size; y++) {
-      TileType tile = game_map[x][y];
+      TileType tile = game_map.GetUnchecked(x, y);
       if (tile == TileType::Dirt || tile == TileType::Rock) {
         size_t x_pixel_val = x * kTileSize;
         size_t y_pixel_val = y * kTileSize;
-        Rectf block({x_pixel_val + kMargin, y_pixel_val + kMargin},
-                    {x_pixel_val + kTileSize + kMargin, y_pixel_val + kTileSize + kMargin});
+        Rectf block({x_pixel_val, y_pixel_val}, {x_pixel_val + kTileSize, y_pixel_val + kTileSize});
 
         ci::gl::draw(kDirtTexture, block);
 
@@ -163,12 +171,11 @@ void DigDugApp::DrawBoard() const {
   }
 }
 
-void DigDugApp::DrawPlayer() const {
-  Player player = engine_.GetPlayer();
-  vec2 position = player.GetPosition();
+void DigDugApp::DrawPlayer(const FrameView& frame) const {
+  const Player& player = *frame.player;
+  vec2 position = interpolator_.GetPlayerPosition(session_.GetEngine(), timestep_.GetAlpha());
 
-  Rectf player_rect({position.x + kMargin, position.y + kMargin},
-                    {position.x + kTileSize + kMargin, position.y + kTileSize + kMargin});
+  Rectf player_rect({position.x, position.y}, {position.x + kTileSize, position.y + kTileSize});
 
   if (player.GetOrientation() == CharacterOrientation::Right) {
     ci::gl::draw(kPlayerRightTexture, player_rect);
@@ -176,22 +183,20 @@ void DigDugApp::DrawPlayer() const {
     ci::gl::draw(kPlayerLeftTexture, player_rect);
   }
 
-  if (engine_.IsPlayerAttacking()) {
-    DrawHarpoon();
+  if (frame.is_player_attacking) {
+    DrawHarpoon(frame);
   }
 }
 
-void DigDugApp::DrawEnemies() const {
-  vector<Enemy> enemies = engine_.GetEnemies();
-
-  for (Enemy enemy : enemies)  {
-    vec2 position = enemy.GetPosition();
-    TileType type = enemy.GetType();
-    CharacterOrientation orientation = enemy.GetOrientation();
-    Rectf enemy_rect({position.x + kMargin, position.y + kMargin},
-                     {position.x + kTileSize + kMargin, position.y + kTileSize + kMargin});
+void DigDugApp::DrawEnemies(const FrameView& frame) const {
+  const EnemyPool& enemies = *frame.enemies;
+  for (size_t index = 0; index < enemies.Size(); index++) {
+    vec2 position = interpolator_.GetEnemyPosition(session_.GetEngine(), index, timestep_.GetAlpha());
+    TileType type = enemies.GetType(index);
+    CharacterOrientation orientation = enemies.GetOrientation(index);
+    Rectf enemy_rect({position.x, position.y}, {position.x + kTileSize, position.y + kTileSize});
 
-    if (enemy.IsGhost()) {
+    if (enemies.IsGhost(index)) {
       ci::gl::draw(kGhostTexture, enemy_rect);
 
     } else if (type == TileType::Fygar) {
@@ -211,44 +216,37 @@ void DigDugApp::DrawEnemies() const {
   }
 }
 
-void DigDugApp::DrawHarpoon() const {
-  Player player = engine_.GetPlayer();
-  vec2 position = player.GetPosition();
-
-  Harpoon harpoon = engine_.GetHarpoon();
-  vec2 velocity = harpoon.GetVelocity();
-  vec2 arrow_pos = harpoon.GetArrowPosition();
+void DigDugApp::DrawHarpoon(const FrameView& frame) const {
+  vec2 position = interpolator_.GetPlayerPosition(session_.GetEngine(), timestep_.GetAlpha());
+  vec2 velocity = frame.harpoon->GetVelocity();
+  vec2 arrow_pos = interpolator_.GetArrowPosition(session_.GetEngine(), timestep_.GetAlpha());
 
   if (velocity.x > 0 && velocity.y == 0) {
-    Rectf harpoon_rect ({position.x + kTileSize + kMargin, position.y + kMargin},
-                        {arrow_pos.x + kTileSize + kMargin, arrow_pos.y + kTileSize + kMargin});
+    Rectf harpoon_rect ({position.x + kTileSize, position.y}, {arrow_pos.x + kTileSize, arrow_pos.y + kTileSize});
     ci::gl::draw(kHarpoonRightTexture, harpoon_rect);
 
   } else if (velocity.x < 0 && velocity.y == 0) {
-    Rectf harpoon_rect ({arrow_pos.x + kMargin, arrow_pos.y + kMargin},
-                        {position.x + kMargin, position.y + kTileSize + kMargin});
+    Rectf harpoon_rect ({arrow_pos.x, arrow_pos.y}, {position.x, position.y + kTileSize});
     ci::gl::draw(kHarpoonLeftTexture, harpoon_rect);
 
   } else if (velocity.y > 0 && velocity.x == 0) {
-    Rectf harpoon_rect({position.x + kMargin, position.y + kTileSize + kMargin},
-                       {arrow_pos.x + kTileSize + kMargin, arrow_pos.y + kTileSize + kMargin});
+    Rectf harpoon_rect({position.x, position.y + kTileSize}, {arrow_pos.x + kTileSize, arrow_pos.y + kTileSize});
     ci::gl::draw(kHarpoonDownTexture, harpoon_rect);
 
   } else {
-    Rectf harpoon_rect({arrow_pos.x + kMargin, arrow_pos.y + kMargin},
-                       {position.x + kTileSize + kMargin, position.y + kTileSize + kMargin});
+    Rectf harpoon_rect({arrow_pos.x, arrow_pos.y}, {position.x + kTileSize, position.y + kTileSize});
     ci::gl::draw(kHarpoonUpTexture, harpoon_rect);
   }
 }
 
-void DigDugApp::DrawLives() const {
+void DigDugApp::DrawLives(const FrameView& frame) const {
   const size_t kPlayerWidth = 90;
   const size_t kPlayerHeight = 90;
   const double kDifferenceBetweenPlayerImages = 100.0;
   const size_t kMarginDivisor = 2;
   double end_of_game_board = kMargin + kBoardToWindowRatio * kWindowSize;
 
-  for (size_t life = 0; life < engine_.GetNumLives(); life++) {
+  for (size_t life = 0; life < frame.num_lives; life++) {
     double start_x = end_of_game_board + kMargin / kMarginDivisor + life * kDifferenceBetweenPlayerImages;
     Rectf player_rect({start_x, kMargin}, {start_x + kPlayerWidth, kMargin + kPlayerHeight});
     ci::gl::draw(kPlayerRightTexture, player_rect);
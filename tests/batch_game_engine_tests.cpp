@@ -0,0 +1,283 @@
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <string>
+
+#include "core/batch_game_engine.h"
+#include "core/game_state_generator.h"
+#include "core/state_hash.h"
+#include "sim/bot_policy.h"
+
+using dig_dug::BatchGameEngine;
+using dig_dug::GameEngine;
+using dig_dug::GameStateGenerator;
+using dig_dug::TileGrid;
+using dig_dug::Direction;
+using dig_dug::StateHash;
+using dig_dug::TileType;
+using dig_dug::EnemyPool;
+using dig_dug::FixedVec2;
+using dig_dug::PlayerAction;
+using dig_dug::BotPolicy;
+using dig_dug::CreateBotPolicy;
+
+/**
+ * Checks that one game of a batch is in exactly the same state as an engine
+ */
+void RequireSameGame(const BatchGameEngine& batch, size_t game, const GameEngine& engine) {
+  const EnemyPool& enemies = engine.GetEnemyView();
+
+  REQUIRE(batch.GetPlayerPosition(game) == engine.GetPlayerView().GetFixedPosition());
+  REQUIRE(batch.GetPlayerPrevVelocity(game) == engine.GetPlayerView().GetFixedPrevVelocity());
+  REQUIRE(batch.GetScore(game) == engine.GetScore());
+  REQUIRE(batch.GetNumLives(game) == engine.GetNumLives());
+  REQUIRE(batch.IsPlayerAttacking(game) == engine.IsPlayerAttacking());
+  if (engine.IsPlayerAttacking()) {
+    REQUIRE(batch.GetHarpoonPosition(game) == engine.GetHarpoonView().GetFixedArrowPosition());
+  }
+
+  REQUIRE(batch.GetNumEnemies(game) == enemies.Size());
+  for (size_t index = 0; index < enemies.Size(); index++) {
+    REQUIRE(batch.GetEnemyPosition(game, index) == enemies.GetPosition(index));
+    REQUIRE(batch.GetEnemyVelocity(game, index) == enemies.GetVelocity(index));
+    REQUIRE(batch.IsEnemyGhost(game, index) == enemies.IsGhost(index));
+    REQUIRE(batch.IsEnemyHurt(game, index) == enemies.IsHurt(index));
+  }
+}
+
+/**
+ * Checks that the engine of one game of a batch hashes the same as another engine, which covers the whole state of
+ * the game including its random numbers
+ */
+void RequireSameHash(const BatchGameEngine& batch, size_t game, const GameEngine& engine) {
+  StateHash batch_hash;
+  batch.GetGame(game).AddToHash(batch_hash);
+  StateHash engine_hash;
+  engine.AddToHash(engine_hash);
+  REQUIRE(batch_hash.Get() == engine_hash.Get());
+}
+
+TEST_CASE("Batch game engine setup") {
+  const size_t kTileSize = 100;
+  BatchGameEngine batch(3, kTileSize);
+
+  SECTION("Number of games") {
+    REQUIRE(batch.GetNumGames() == 3);
+  }
+
+  SECTION("Game out of range") {
+    TileGrid board(12, TileType::Dirt);
+    REQUIRE_THROWS_AS(batch.ResetGame(3, board, 1), std::out_of_range);
+    REQUIRE_THROWS_AS(batch.GetScore(3), std::out_of_range);
+  }
+
+  SECTION("Boards of any size and number of enemies") {
+    GameStateGenerator generator(5, 64);
+    const TileGrid& board = generator.Generate();
+    GameEngine engine(board, kTileSize, 9);
+    batch.ResetGame(2, board, 9);
+
+    REQUIRE(batch.GetNumEnemies(2) > 8);
+    REQUIRE_FALSE(batch.IsGameInLanes(2));
+    RequireSameGame(batch, 2, engine);
+  }
+
+  SECTION("Tile sizes the lanes cannot hold") {
+    GameStateGenerator generator(5);
+    BatchGameEngine small_tiles(1, BatchGameEngine::kMinLaneTileSize - 1);
+    small_tiles.ResetGame(0, generator.Generate(), 9);
+    BatchGameEngine large_tiles(1, BatchGameEngine::kMaxLaneTileSize + 1);
+    large_tiles.ResetGame(0, generator.Generate(), 9);
+    // Enemies moving 4 pixels a tick would walk past the boundaries of 102 pixel tiles
+    BatchGameEngine uneven_tiles(1, 102);
+    uneven_tiles.ResetGame(0, generator.Generate(), 9);
+
+    REQUIRE_FALSE(small_tiles.IsGameInLanes(0));
+    REQUIRE_FALSE(large_tiles.IsGameInLanes(0));
+    REQUIRE_FALSE(uneven_tiles.IsGameInLanes(0));
+  }
+
+  SECTION("Enemy out of range") {
+    batch.ResetGame(0, TileGrid(12, TileType::Dirt), 1);
+    REQUIRE_THROWS_AS(batch.GetEnemyPosition(0, 0), std::out_of_range);
+  }
+
+  SECTION("Starting state matches the engine") {
+    GameStateGenerator generator(5);
+    const TileGrid& board = generator.Generate();
+    GameEngine engine(board, kTileSize, 9);
+    batch.ResetGame(1, board, 9);
+
+    REQUIRE(batch.IsGameInLanes(1));
+    RequireSameGame(batch, 1, engine);
+    RequireSameHash(batch, 1, engine);
+    REQUIRE(batch.GetTileGrid(1) == engine.GetTileGrid());
+  }
+}
+
+TEST_CASE("Batch games play out like engines") {
+  const size_t kTileSize = 100;
+  const size_t kNumGames = 19;
+  const size_t kNumFrames = 1500;
+
+  BatchGameEngine batch(kNumGames, kTileSize);
+  std::vector<std::unique_ptr<GameEngine>> engines;
+  std::vector<std::unique_ptr<BotPolicy>> policies;
+  for (size_t game = 0; game < kNumGames; game++) {
+    GameStateGenerator generator(game + 1);
+    generator.SetLevel(game % 4);
+    const TileGrid& board = generator.Generate();
+
+    engines.emplace_back(new GameEngine(board, kTileSize, generator.GetEngineSeed()));
+    batch.ResetGame(game, board, generator.GetEngineSeed());
+
+    // Hunters kill enemies and random players wander into them, which covers every branch between them
+    policies.push_back(CreateBotPolicy(game % 2 == 0 ? "hunter" : "random"));
+    policies.back()->Reset(game + 100);
+  }
+
+  std::vector<PlayerAction> actions(kNumGames);
+  std::vector<uint8_t> is_player_dead(kNumGames);
+  size_t num_kills = 0;
+  size_t num_deaths = 0;
+  for (size_t frame = 0; frame < kNumFrames; frame++) {
+    for (size_t game = 0; game < kNumGames; game++) {
+      actions[game] = policies[game]->ChooseAction(*engines[game]);
+    }
+
+    batch.Step(actions.data(), is_player_dead.data());
+
+    for (size_t game = 0; game < kNumGames; game++) {
+      GameEngine& engine = *engines[game];
+      size_t score = engine.GetScore();
+      ApplyAction(engine, actions[game]);
+      bool is_dead = engine.IsPlayerDead();
+      if (!is_dead) {
+        engine.MoveEnemies();
+      }
+
+      num_kills += engine.GetScore() > score ? 1 : 0;
+      num_deaths += is_dead ? 1 : 0;
+      REQUIRE(is_player_dead[game] == (uint8_t) (is_dead));
+      RequireSameGame(batch, game, engine);
+    }
+  }
+
+  for (size_t game = 0; game < kNumGames; game++) {
+    REQUIRE(batch.GetTileGrid(game) == engines[game]->GetTileGrid());
+    RequireSameHash(batch, game, *engines[game]);
+    // Every game stayed in the lanes, so the kernels stepped all of them
+    REQUIRE(batch.IsGameInLanes(game));
+  }
+
+  // Makes sure the run actually covered kills and deaths
+  REQUIRE(num_kills > 0);
+  REQUIRE(num_deaths > 0);
+}
+
+TEST_CASE("Batch games called one step at a time play out like engines") {
+  const size_t kTileSize = 40;
+  const size_t kNumFrames = 600;
+
+  // Games 0 and 2 are too large for the lanes, so the batch mixes lanes with engines in one block
+  const size_t kBoardDimensions[] = {64, 12, 20, 16, 8, 12, 14, 10, 12, 16};
+  const size_t kNumGames = sizeof(kBoardDimensions) / sizeof(kBoardDimensions[0]);
+  BatchGameEngine batch(kNumGames, kTileSize);
+  std::vector<std::unique_ptr<GameEngine>> engines;
+  std::vector<std::unique_ptr<BotPolicy>> policies;
+  for (size_t game = 0; game < kNumGames; game++) {
+    GameStateGenerator generator(game + 30, kBoardDimensions[game]);
+    generator.SetLevel(game % 3);
+    const TileGrid& board = generator.Generate();
+
+    engines.emplace_back(new GameEngine(board, kTileSize, generator.GetEngineSeed()));
+    batch.ResetGame(game, board, generator.GetEngineSeed());
+    policies.push_back(CreateBotPolicy(game % 2 == 0 ? "random" : "hunter"));
+    policies.back()->Reset(game + 7);
+  }
+  REQUIRE_FALSE(batch.IsGameInLanes(0));
+  REQUIRE_FALSE(batch.IsGameInLanes(2));
+  REQUIRE(batch.IsGameInLanes(1));
+
+  std::vector<uint8_t> is_player_dead(kNumGames);
+  std::vector<uint8_t> is_game_moving(kNumGames);
+  for (size_t frame = 0; frame < kNumFrames; frame++) {
+    for (size_t game = 0; game < kNumGames; game++) {
+      PlayerAction action = policies[game]->ChooseAction(*engines[game]);
+      ApplyAction(*engines[game], action);
+
+      if (action == PlayerAction::Attack) {
+        batch.AttackEnemy(game);
+      } else if (action != PlayerAction::None) {
+        batch.MovePlayer(game, static_cast<Direction>((size_t) (action) - (size_t) (PlayerAction::Right)));
+      }
+    }
+
+    batch.CheckPlayerDeaths(is_player_dead.data());
+    for (size_t game = 0; game < kNumGames; game++) {
+      bool is_dead = engines[game]->IsPlayerDead();
+      REQUIRE(is_player_dead[game] == (uint8_t) (is_dead));
+
+      // Every third game sits a frame out now and then
+      is_game_moving[game] = (uint8_t) ((game + frame) % 3 != 0 || frame % 2 == 0);
+      if (is_game_moving[game] != 0) {
+        engines[game]->MoveEnemies();
+      }
+    }
+
+    batch.MoveEnemies(is_game_moving.data());
+    for (size_t game = 0; game < kNumGames; game++) {
+      RequireSameGame(batch, game, *engines[game]);
+    }
+
+    // Copying a game out of the lanes into its engine must not change how it plays on
+    if (frame % 97 == 0) {
+      for (size_t game = 0; game < kNumGames; game++) {
+        RequireSameHash(batch, game, *engines[game]);
+      }
+    }
+  }
+
+  for (size_t game = 0; game < kNumGames; game++) {
+    REQUIRE(batch.GetTileGrid(game) == engines[game]->GetTileGrid());
+    RequireSameHash(batch, game, *engines[game]);
+  }
+}
+
+TEST_CASE("Batch games the lanes cannot step play out in their engine") {
+  const size_t kTileSize = 100;
+  const size_t kNumFrames = 200;
+
+  // An enemy buried in dirt starts with no velocity, which the lanes would not turn like the engine does
+  TileGrid buried(12, TileType::Dirt);
+  buried.Set(2, 9, TileType::Pooka);
+  GameStateGenerator generator(3);
+  const TileGrid& board = generator.Generate();
+
+  BatchGameEngine batch(2, kTileSize);
+  batch.ResetGame(0, buried, 4);
+  batch.ResetGame(1, board, 4);
+  GameEngine buried_engine(buried, kTileSize, 4);
+  GameEngine engine(board, kTileSize, 4);
+  REQUIRE_FALSE(batch.IsGameInLanes(0));
+  REQUIRE(batch.IsGameInLanes(1));
+
+  std::vector<PlayerAction> actions = {PlayerAction::Left, PlayerAction::Down};
+  std::vector<uint8_t> is_player_dead(2);
+  for (size_t frame = 0; frame < kNumFrames; frame++) {
+    batch.Step(actions.data(), is_player_dead.data());
+    GameEngine* engines[] = {&buried_engine, &engine};
+    for (size_t game = 0; game < 2; game++) {
+      ApplyAction(*engines[game], actions[game]);
+      if (!engines[game]->IsPlayerDead()) {
+        engines[game]->MoveEnemies();
+      }
+      RequireSameGame(batch, game, *engines[game]);
+    }
+  }
+
+  REQUIRE_FALSE(batch.IsGameInLanes(0));
+  REQUIRE(batch.IsGameInLanes(1));
+  RequireSameHash(batch, 0, buried_engine);
+  RequireSameHash(batch, 1, engine);
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "core/checkpoint_file.h"
+
+using dig_dug::CheckpointFile;
+using dig_dug::CheckpointHeader;
+using dig_dug::ConstSpan;
+using dig_dug::GameSession;
+using dig_dug::InputFrame;
+using dig_dug::PlayerAction;
+using dig_dug::SessionSnapshot;
+using std::vector;
+
+/**
+ * Overwrites part of a file in place
+ */
+void PatchFile(const char* path, size_t offset, const void* data, size_t size) {
+  std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+  file.seekp((std::streamoff) (offset));
+  file.write(static_cast<const char*>(data), (std::streamsize) (size));
+}
+
+TEST_CASE("Checkpoint files") {
+  const char* kPath = "checkpoint_file_tests.ddc";
+  vector<SessionSnapshot> snapshots;
+  vector<uint64_t> hashes;
+
+  for (uint64_t seed = 0; seed < 20; seed++) {
+    GameSession session(seed, 100);
+    for (size_t tick = 0; tick < seed * 50; tick++) {
+      session.Update(InputFrame(tick % 60 < 30 ? PlayerAction::Attack : PlayerAction::Up));
+    }
+
+    snapshots.push_back(session.Snapshot());
+    hashes.push_back(session.GetStateHash());
+  }
+  dig_dug::SaveCheckpoints(kPath, ConstSpan<SessionSnapshot>(snapshots.data(), snapshots.size()));
+
+  SECTION("Loads every snapshot in place") {
+    CheckpointFile file(kPath);
+    REQUIRE(file.Size() == snapshots.size());
+
+    GameSession session;
+    for (size_t index = 0; index < file.Size(); index++) {
+      session.Restore(file.GetSnapshots()[index]);
+      REQUIRE(session.GetStateHash() == hashes[index]);
+    }
+  }
+
+  SECTION("Saving and loading one session") {
+    GameSession session;
+    session.Restore(snapshots[7]);
+    dig_dug::SaveSession(kPath, session);
+
+    GameSession loaded;
+    dig_dug::LoadSession(kPath, loaded);
+    REQUIRE(loaded.GetStateHash() == hashes[7]);
+    REQUIRE(loaded.GetLevel() == session.GetLevel());
+    REQUIRE(loaded.GetScore() == session.GetScore());
+  }
+
+  SECTION("Rejects another version") {
+    uint32_t version = dig_dug::kCheckpointVersion + 1;
+    PatchFile(kPath, offsetof(CheckpointHeader, version), &version, sizeof(version));
+    REQUIRE_THROWS_AS(CheckpointFile(kPath), std::runtime_error);
+  }
+
+  SECTION("Rejects another snapshot layout") {
+    uint32_t snapshot_size = sizeof(SessionSnapshot) + 8;
+    PatchFile(kPath, offsetof(CheckpointHeader, snapshot_size), &snapshot_size, sizeof(snapshot_size));
+    REQUIRE_THROWS_AS(CheckpointFile(kPath), std::runtime_error);
+  }
+
+  SECTION("Rejects a file that was cut short") {
+    uint64_t num_snapshots = snapshots.size() + 1;
+    PatchFile(kPath, offsetof(CheckpointHeader, num_snapshots), &num_snapshots, sizeof(num_snapshots));
+    REQUIRE_THROWS_AS(CheckpointFile(kPath), std::runtime_error);
+  }
+
+  SECTION("Rejects an empty file for a session") {
+    dig_dug::SaveCheckpoints(kPath, ConstSpan<SessionSnapshot>());
+    GameSession session;
+    REQUIRE(CheckpointFile(kPath).Size() == 0);
+    REQUIRE_THROWS_AS(dig_dug::LoadSession(kPath, session), std::runtime_error);
+  }
+
+  std::remove(kPath);
+}
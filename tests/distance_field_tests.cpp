@@ -0,0 +1,198 @@
+#include <catch2/catch.hpp>
+
+#include "core/distance_field.h"
+#include "core/game_engine.h"
+#include "core/game_state_generator.h"
+#include "core/player_action.h"
+
+using dig_dug::DistanceField;
+using dig_dug::Direction;
+using dig_dug::GameEngine;
+using dig_dug::GameStateGenerator;
+using dig_dug::EngineSnapshot;
+using dig_dug::PlayerAction;
+using dig_dug::Random;
+using dig_dug::TileGrid;
+using dig_dug::TileType;
+
+/**
+ * Checks that two fields have the same root and distances
+ */
+void RequireSameField(const DistanceField& field, const DistanceField& other) {
+  REQUIRE(field.GetDimension() == other.GetDimension());
+  REQUIRE(field.GetRootX() == other.GetRootX());
+  REQUIRE(field.GetRootY() == other.GetRootY());
+
+  for (size_t x = 0; x < field.GetDimension(); x++) {
+    for (size_t y = 0; y < field.GetDimension(); y++) {
+      REQUIRE(field.GetDistance(x, y) == other.GetDistance(x, y));
+    }
+  }
+}
+
+TEST_CASE("Distances through tunnels") {
+  // Tunnel along x = 0 and y = 4, with a rock in the corner and a dead end at (4, 0)
+  TileGrid map(5, TileType::Dirt);
+  for (size_t index = 0; index < 5; index++) {
+    map.Set(0, index, TileType::Tunnel);
+    map.Set(index, 4, TileType::Tunnel);
+  }
+  map.Set(4, 4, TileType::Rock);
+  map.Set(4, 0, TileType::Tunnel);
+
+  DistanceField field;
+  field.Reset(map, 0, 0);
+
+  SECTION("Distances follow the tunnels") {
+    REQUIRE(field.GetDistance(0, 0) == 0);
+    REQUIRE(field.GetDistance(0, 4) == 4);
+    REQUIRE(field.GetDistance(3, 4) == 7);
+  }
+
+  SECTION("Dirt, rocks and cut off tunnels are unreachable") {
+    REQUIRE(field.GetDistance(1, 1) == DistanceField::kUnreachable);
+    REQUIRE(field.GetDistance(4, 4) == DistanceField::kUnreachable);
+    REQUIRE(field.GetDistance(4, 0) == DistanceField::kUnreachable);
+  }
+
+  SECTION("Steps lead back to the root") {
+    Direction direction;
+    REQUIRE(field.GetStepToRoot(3, 4, direction));
+    REQUIRE(direction == Direction::Left);
+    REQUIRE(field.GetStepToRoot(0, 4, direction));
+    REQUIRE(direction == Direction::Up);
+    REQUIRE_FALSE(field.GetStepToRoot(0, 0, direction));
+    REQUIRE_FALSE(field.GetStepToRoot(4, 0, direction));
+  }
+
+  SECTION("Opening a tile shortens paths") {
+    map.Set(1, 0, TileType::Tunnel);
+    field.OpenTile(map, 1, 0);
+    map.Set(1, 1, TileType::Tunnel);
+    field.OpenTile(map, 1, 1);
+
+    REQUIRE(field.GetDistance(1, 1) == 2);
+    REQUIRE(field.GetDistance(4, 0) == DistanceField::kUnreachable);
+  }
+
+  SECTION("Opening a tile connects a cut off tunnel") {
+    for (size_t x = 1; x < 4; x++) {
+      map.Set(x, 0, TileType::Tunnel);
+      field.OpenTile(map, x, 0);
+    }
+
+    REQUIRE(field.GetDistance(4, 0) == 4);
+  }
+
+  SECTION("Digging away from the tunnels leaves the tile unreachable") {
+    map.Set(2, 2, TileType::Tunnel);
+    field.OpenTile(map, 2, 2);
+
+    REQUIRE(field.GetDistance(2, 2) == DistanceField::kUnreachable);
+  }
+
+  SECTION("Moving the root") {
+    field.SetRoot(map, 3, 4);
+
+    REQUIRE(field.GetDistance(3, 4) == 0);
+    REQUIRE(field.GetDistance(0, 0) == 7);
+  }
+}
+
+TEST_CASE("Incremental updates match a full search") {
+  Random random(11);
+
+  for (size_t board = 0; board < 20; board++) {
+    GameStateGenerator generator(board + 1);
+    TileGrid map = generator.Generate();
+    for (size_t x = 0; x < map.GetDimension(); x++) {
+      for (size_t y = 0; y < map.GetDimension(); y++) {
+        if (map.GetUnchecked(x, y) != TileType::Rock && map.GetUnchecked(x, y) != TileType::Dirt) {
+          map.SetUnchecked(x, y, TileType::Tunnel);
+        }
+      }
+    }
+
+    size_t root_x = random.NextBelow((uint32_t) (map.GetDimension()));
+    size_t root_y = random.NextBelow((uint32_t) (map.GetDimension()));
+    DistanceField field;
+    field.Reset(map, root_x, root_y);
+
+    for (size_t dig = 0; dig < 60; dig++) {
+      size_t x = random.NextBelow((uint32_t) (map.GetDimension()));
+      size_t y = random.NextBelow((uint32_t) (map.GetDimension()));
+      map.SetUnchecked(x, y, TileType::Tunnel);
+      field.OpenTile(map, x, y);
+    }
+
+    DistanceField rebuilt;
+    rebuilt.Reset(map, root_x, root_y);
+    RequireSameField(field, rebuilt);
+  }
+}
+
+TEST_CASE("Engine keeps the distance field up to date") {
+  GameStateGenerator generator(6);
+  GameEngine engine(generator.Generate(), 100, generator.GetEngineSeed());
+  Random random(3);
+
+  SECTION("Rooted at the player's tile from the start") {
+    size_t center = engine.GetTileGrid().GetDimension() / 2;
+    REQUIRE(engine.GetDistanceField().GetRootX() == center);
+    REQUIRE(engine.GetDistanceField().GetRootY() == center);
+    REQUIRE(engine.GetDistanceField().GetDistance(center, 0) == center);
+  }
+
+  SECTION("Matches a full search after moving and digging") {
+    const uint32_t kNumMoves = 4;
+    for (size_t frame = 0; frame < 400; frame++) {
+      ApplyAction(engine, static_cast<PlayerAction>(random.NextBelow(kNumMoves) + 1));
+    }
+
+    const DistanceField& field = engine.GetDistanceField();
+    DistanceField rebuilt;
+    rebuilt.Reset(engine.GetTileGrid(), field.GetRootX(), field.GetRootY());
+    RequireSameField(field, rebuilt);
+
+    int32_t tile_size = (int32_t) (engine.GetTileSize());
+    int32_t center_x = dig_dug::FixedToPixels(engine.GetPlayerView().GetFixedPosition().x) + tile_size / 2;
+    REQUIRE(field.GetRootX() == (size_t) (center_x / tile_size));
+  }
+
+  SECTION("Restored with a snapshot") {
+    EngineSnapshot snapshot = engine.Snapshot();
+    DistanceField before = engine.GetDistanceField();
+    for (size_t frame = 0; frame < 200; frame++) {
+      engine.MovePlayer({0, 1});
+    }
+    engine.Restore(snapshot);
+
+    RequireSameField(engine.GetDistanceField(), before);
+  }
+}
+
+TEST_CASE("Distance field on a large board") {
+  GameStateGenerator generator(2, 512);
+  GameEngine engine(generator.Generate(), 100, generator.GetEngineSeed());
+  Random random(5);
+
+  // Digs before anyone asks for the field, which is only searched once it is asked for
+  const uint32_t kNumMoves = 4;
+  for (size_t frame = 0; frame < 300; frame++) {
+    ApplyAction(engine, static_cast<PlayerAction>(random.NextBelow(kNumMoves) + 1));
+  }
+
+  const DistanceField& field = engine.GetDistanceField();
+  REQUIRE(field.GetDimension() == 512);
+  DistanceField rebuilt;
+  rebuilt.Reset(engine.GetTileGrid(), field.GetRootX(), field.GetRootY());
+  RequireSameField(field, rebuilt);
+
+  // Later digging keeps it up to date
+  for (size_t frame = 0; frame < 300; frame++) {
+    ApplyAction(engine, static_cast<PlayerAction>(random.NextBelow(kNumMoves) + 1));
+  }
+  const DistanceField& updated = engine.GetDistanceField();
+  rebuilt.Reset(engine.GetTileGrid(), updated.GetRootX(), updated.GetRootY());
+  RequireSameField(updated, rebuilt);
+}
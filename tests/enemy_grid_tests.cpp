@@ -0,0 +1,92 @@
+#include <catch2/catch.hpp>
+
+#include "core/enemy_grid.h"
+#include "core/random.h"
+
+using dig_dug::EnemyGrid;
+using dig_dug::EnemyPool;
+using dig_dug::FixedVec2;
+using dig_dug::Random;
+using dig_dug::TileType;
+
+namespace {
+
+const int32_t kTileSize = 100;
+
+/**
+ * Finds the first walking enemy within a tile of a point by looking at every enemy
+ */
+size_t ScanForEnemy(const EnemyPool& pool, const FixedVec2& point) {
+  for (size_t index = 0; index < pool.Size(); index++) {
+    if (!pool.IsGhost(index) && LengthSquared(pool.GetPosition(index) - point) < kTileSize * kTileSize) {
+      return index;
+    }
+  }
+
+  return pool.Size();
+}
+
+FixedVec2 RandomPosition(Random& random) {
+  // Includes positions just off the top and left of the board
+  return {(int32_t) (random.NextBelow(2000)) - 200, (int32_t) (random.NextBelow(2000)) - 200};
+}
+
+} // namespace
+
+TEST_CASE("Enemy grid") {
+  Random random(11);
+  EnemyPool pool;
+  for (size_t enemy = 0; enemy < 300; enemy++) {
+    pool.Add(RandomPosition(random), {0, 0}, TileType::Pooka);
+    pool.SetGhost(enemy, random.NextBelow(4) == 0);
+  }
+
+  EnemyGrid grid;
+  grid.Reset(pool, kTileSize);
+
+  SECTION("Finds the same enemy as a scan over every enemy") {
+    REQUIRE(grid.Size() == 300);
+
+    size_t num_found = 0;
+    for (size_t query = 0; query < 2000; query++) {
+      FixedVec2 point = RandomPosition(random);
+      size_t found = grid.FindWalkingEnemyNear(pool, point);
+
+      REQUIRE(found == ScanForEnemy(pool, point));
+      num_found += found < pool.Size() ? 1 : 0;
+    }
+
+    REQUIRE(num_found > 100);
+  }
+
+  SECTION("Follows enemies as they move and are removed") {
+    for (size_t step = 0; step < 50; step++) {
+      for (size_t index = 0; index < pool.Size(); index++) {
+        FixedVec2 velocity {(int32_t) (random.NextBelow(41)) - 20, (int32_t) (random.NextBelow(41)) - 20};
+        pool.SetPosition(index, pool.GetPosition(index) + velocity);
+        grid.Update(index, pool.GetPosition(index));
+      }
+
+      size_t removed = random.NextBelow((uint32_t) (pool.Size()));
+      pool.RemoveAt(removed);
+      grid.RemoveAt(removed);
+
+      for (size_t query = 0; query < 50; query++) {
+        FixedVec2 point = RandomPosition(random);
+        REQUIRE(grid.FindWalkingEnemyNear(pool, point) == ScanForEnemy(pool, point));
+      }
+    }
+
+    REQUIRE(grid.Size() == 250);
+  }
+
+  SECTION("Removing every enemy leaves nothing to find") {
+    while (!pool.IsEmpty()) {
+      grid.RemoveAt(0);
+      pool.RemoveAt(0);
+    }
+
+    REQUIRE(grid.Size() == 0);
+    REQUIRE(grid.FindWalkingEnemyNear(pool, {500, 500}) == 0);
+  }
+}
@@ -0,0 +1,151 @@
+#include <catch2/catch.hpp>
+
+#include "core/enemy_pool.h"
+
+using dig_dug::EnemyPool;
+using dig_dug::EnemyHandle;
+using dig_dug::Enemy;
+using dig_dug::FixedVec2;
+using dig_dug::TileType;
+using dig_dug::CharacterOrientation;
+
+TEST_CASE("Adding enemies to the pool") {
+  EnemyPool pool;
+  EnemyHandle pooka = pool.Add({100, 200}, {4, 0}, TileType::Pooka);
+  EnemyHandle fygar = pool.Add({300, 400}, {-4, 0}, TileType::Fygar);
+
+  SECTION("Enemies are stored in order") {
+    REQUIRE(pool.Size() == 2);
+    REQUIRE(pool.GetIndex(pooka) == 0);
+    REQUIRE(pool.GetIndex(fygar) == 1);
+    REQUIRE(pool.GetHandle(1) == fygar);
+  }
+
+  SECTION("Fields are stored separately") {
+    REQUIRE(pool.GetPosition(1) == FixedVec2(300, 400));
+    REQUIRE(pool.GetVelocity(1) == FixedVec2(-4, 0));
+    REQUIRE(pool.GetType(0) == TileType::Pooka);
+    REQUIRE(pool.GetType(1) == TileType::Fygar);
+    REQUIRE(pool.GetPositionsX()[1] == 300);
+    REQUIRE(pool.GetPositionsY()[0] == 200);
+  }
+
+  SECTION("Flags share one byte with the type") {
+    pool.SetHurt(0, true);
+    pool.SetGhost(1, true);
+    pool.SetInDirt(1, true);
+
+    REQUIRE(pool.IsHurt(0));
+    REQUIRE_FALSE(pool.IsGhost(0));
+    REQUIRE(pool.IsGhost(1));
+    REQUIRE(pool.IsInDirt(1));
+    REQUIRE(pool.GetType(1) == TileType::Fygar);
+
+    pool.SetGhost(1, false);
+    REQUIRE_FALSE(pool.IsInDirt(1));
+
+    pool.ClearHurt();
+    REQUIRE_FALSE(pool.IsHurt(0));
+  }
+
+  SECTION("Velocity sets the orientation") {
+    pool.SetVelocity(0, {-4, 0});
+    REQUIRE(pool.GetOrientation(0) == CharacterOrientation::Left);
+
+    pool.SetVelocity(0, {0, 4});
+    REQUIRE(pool.GetOrientation(0) == CharacterOrientation::Left);
+
+    pool.Move(0);
+    REQUIRE(pool.GetPosition(0) == FixedVec2(100, 204));
+  }
+}
+
+TEST_CASE("Removing enemies from the pool") {
+  EnemyPool pool;
+  EnemyHandle first = pool.Add({0, 0}, {0, 0}, TileType::Pooka);
+  EnemyHandle second = pool.Add({1, 0}, {0, 0}, TileType::Pooka);
+  EnemyHandle third = pool.Add({2, 0}, {0, 0}, TileType::Fygar);
+
+  SECTION("Last enemy moves into the removed index") {
+    REQUIRE(pool.Remove(first));
+
+    REQUIRE(pool.Size() == 2);
+    REQUIRE(pool.GetIndex(third) == 0);
+    REQUIRE(pool.GetPosition(0) == FixedVec2(2, 0));
+    REQUIRE(pool.GetType(0) == TileType::Fygar);
+    REQUIRE(pool.GetIndex(second) == 1);
+  }
+
+  SECTION("Handles of removed enemies are stale") {
+    pool.Remove(second);
+
+    REQUIRE_FALSE(pool.IsValid(second));
+    REQUIRE_FALSE(pool.Remove(second));
+    REQUIRE_THROWS_AS(pool.GetIndex(second), std::out_of_range);
+  }
+
+  SECTION("Reused slots do not revive old handles") {
+    pool.Remove(second);
+    EnemyHandle fourth = pool.Add({3, 0}, {0, 0}, TileType::Pooka);
+
+    REQUIRE(fourth.slot == second.slot);
+    REQUIRE_FALSE(pool.IsValid(second));
+    REQUIRE(pool.GetPosition(pool.GetIndex(fourth)) == FixedVec2(3, 0));
+  }
+
+  SECTION("Removing the last enemy") {
+    pool.RemoveAt(2);
+
+    REQUIRE(pool.Size() == 2);
+    REQUIRE_FALSE(pool.IsValid(third));
+    REQUIRE_THROWS_AS(pool.RemoveAt(2), std::out_of_range);
+  }
+
+  SECTION("Clearing the pool") {
+    pool.Clear();
+
+    REQUIRE(pool.IsEmpty());
+    REQUIRE_FALSE(pool.IsValid(first));
+    REQUIRE_FALSE(pool.IsValid(EnemyHandle()));
+  }
+
+  SECTION("Assigning replaces every enemy") {
+    const int32_t kX[] = {5, 6};
+    const int32_t kY[] = {7, 8};
+    const int32_t kVelocityX[] = {0, -4};
+    const int32_t kVelocityY[] = {4, 0};
+    const uint8_t kFlags[] = {
+        (uint8_t) (EnemyPool::kGhostFlag | static_cast<uint8_t>(TileType::Fygar) << EnemyPool::kTypeShift),
+        (uint8_t) (EnemyPool::kFacingLeftFlag | static_cast<uint8_t>(TileType::Pooka) << EnemyPool::kTypeShift)};
+    pool.Assign(2, kX, kY, kVelocityX, kVelocityY, kFlags);
+
+    REQUIRE(pool.Size() == 2);
+    REQUIRE_FALSE(pool.IsValid(first));
+    REQUIRE(pool.GetPosition(1) == FixedVec2(6, 8));
+    REQUIRE(pool.GetVelocity(0) == FixedVec2(0, 4));
+    REQUIRE(pool.GetType(0) == TileType::Fygar);
+    REQUIRE(pool.IsGhost(0));
+    REQUIRE(pool.GetOrientation(1) == CharacterOrientation::Left);
+    REQUIRE(pool.GetIndex(pool.GetHandle(1)) == 1);
+  }
+}
+
+TEST_CASE("Copying enemies in and out of the pool") {
+  Enemy enemy({7, 7}, {-1, 0}, TileType::Fygar);
+  enemy.SetFixedVelocity(enemy.GetFixedVelocity());
+  enemy.SetGhost();
+  enemy.SetInDirt(true);
+
+  EnemyPool pool;
+  pool.Add(enemy);
+  Enemy copy = pool.GetEnemy(0);
+
+  REQUIRE(copy.GetFixedPosition() == enemy.GetFixedPosition());
+  REQUIRE(copy.GetFixedVelocity() == enemy.GetFixedVelocity());
+  REQUIRE(copy.GetType() == TileType::Fygar);
+  REQUIRE(copy.IsGhost());
+  REQUIRE(copy.IsInDirt());
+  REQUIRE_FALSE(copy.IsHurt());
+  REQUIRE(copy.GetOrientation() == CharacterOrientation::Left);
+  REQUIRE(pool.ToVector().size() == 1);
+}
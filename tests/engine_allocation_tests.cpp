@@ -0,0 +1,117 @@
+#include <catch2/catch.hpp>
+
+#include "bench/allocation_counter.h"
+#include "core/game_engine.h"
+#include "core/game_state_generator.h"
+#include "core/player_action.h"
+#include "core/state_hash.h"
+#include "sim/bot_policy.h"
+
+using dig_dug::GameEngine;
+using dig_dug::GameStateGenerator;
+using dig_dug::HunterPolicy;
+using dig_dug::PlayerAction;
+using dig_dug::StateHash;
+using dig_dug::TileGrid;
+
+uint64_t HashEngine(const GameEngine& engine) {
+  StateHash hash;
+  engine.AddToHash(hash);
+  return hash.Get();
+}
+
+/**
+ * Plays the hunter bot through a run of boards, starting over on the next board whenever the player dies or clears
+ * one, and counts the allocations the engine made during ticks. The engine has to be able to kill enemies, so the
+ * bot shoots at them
+ *
+ * @return allocations made by MovePlayer, AttackEnemy, IsPlayerDead and MoveEnemies
+ */
+size_t CountTickAllocations(size_t board_dimension, size_t num_ticks, size_t& num_kills) {
+  GameStateGenerator generator(7, board_dimension);
+  GameEngine engine(generator.Generate(), 100, generator.GetEngineSeed());
+  HunterPolicy policy;
+  policy.Reset(7);
+
+  size_t num_allocations = 0;
+  num_kills = 0;
+  for (size_t tick = 0; tick < num_ticks; tick++) {
+    PlayerAction action = policy.ChooseAction(engine);
+    size_t score = engine.GetScore();
+
+    size_t start = dig_dug::GetNumAllocations();
+    dig_dug::ApplyAction(engine, action);
+    bool is_player_dead = engine.IsPlayerDead();
+    if (!is_player_dead) {
+      engine.MoveEnemies();
+    }
+    num_allocations += dig_dug::GetNumAllocations() - start;
+
+    num_kills += (engine.GetScore() - score) / GameEngine::kEnemyKillScore;
+    if (is_player_dead || engine.GetEnemyView().IsEmpty()) {
+      engine.Reset(generator.Generate(), 100, generator.GetEngineSeed());
+    }
+  }
+
+  return num_allocations;
+}
+
+TEST_CASE("Steady-state ticks do not allocate") {
+  size_t num_kills;
+
+  SECTION("Default board") {
+    REQUIRE(CountTickAllocations(GameStateGenerator::kDefaultBoardDimension, 20000, num_kills) == 0);
+    REQUIRE(num_kills > 0);
+  }
+
+  SECTION("Largest board with reserved buffers") {
+    REQUIRE(CountTickAllocations(64, 20000, num_kills) == 0);
+    REQUIRE(num_kills > 0);
+  }
+}
+
+TEST_CASE("Resetting an engine") {
+  GameStateGenerator generator(11);
+  TileGrid first_board = generator.Generate();
+  TileGrid second_board = generator.Generate();
+  GameEngine engine(first_board, 100, 5);
+  for (size_t tick = 0; tick < 200; tick++) {
+    engine.MovePlayer({0, 1});
+    engine.AttackEnemy();
+    engine.MoveEnemies();
+  }
+
+  SECTION("Leaves the engine the same as a new one") {
+    engine.SetScore(500);
+    engine.Reset(second_board, 100, 9);
+    GameEngine fresh(second_board, 100, 9);
+
+    REQUIRE(HashEngine(engine) == HashEngine(fresh));
+    REQUIRE(engine.GetTileChanges().size() == 0);
+    REQUIRE(engine.IsMapReplaced());
+    REQUIRE(engine.GetDistanceField().GetDistance(0, 0) == fresh.GetDistanceField().GetDistance(0, 0));
+  }
+
+  SECTION("Does not allocate on a board of the same size") {
+    size_t start = dig_dug::GetNumAllocations();
+    engine.Reset(second_board, 100, 9);
+
+    REQUIRE(dig_dug::GetNumAllocations() == start);
+  }
+
+  SECTION("Leaves a fork's map alone") {
+    GameEngine fork = engine.Fork();
+    TileGrid fork_map = fork.GetTileGrid();
+    engine.Reset(second_board, 100, 9);
+
+    REQUIRE(fork.GetTileGrid() == fork_map);
+    REQUIRE(HashEngine(engine) == HashEngine(GameEngine(second_board, 100, 9)));
+  }
+
+  SECTION("Moves to a board of another size") {
+    TileGrid large_board = GameStateGenerator(11, 40).Generate();
+    engine.Reset(large_board, 100, 9);
+
+    REQUIRE(HashEngine(engine) == HashEngine(GameEngine(large_board, 100, 9)));
+  }
+}
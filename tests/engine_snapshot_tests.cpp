@@ -0,0 +1,177 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+
+#include "core/game_engine.h"
+#include "core/game_state_generator.h"
+#include "core/player_action.h"
+
+using dig_dug::GameEngine;
+using dig_dug::GameStateGenerator;
+using dig_dug::EngineSnapshot;
+using dig_dug::EnemyPool;
+using dig_dug::TileGrid;
+using dig_dug::TileType;
+using dig_dug::PlayerAction;
+using dig_dug::Random;
+
+/**
+ * Plays random actions the same way the game loop does
+ */
+void PlayRandomFrames(GameEngine& engine, size_t num_frames, uint64_t seed) {
+  const uint32_t kNumActions = 6;
+  Random random(seed);
+
+  for (size_t frame = 0; frame < num_frames; frame++) {
+    ApplyAction(engine, static_cast<PlayerAction>(random.NextBelow(kNumActions)));
+    if (!engine.IsPlayerDead()) {
+      engine.MoveEnemies();
+    }
+  }
+}
+
+void RequireSameState(const GameEngine& engine, const GameEngine& other) {
+  const EnemyPool& enemies = engine.GetEnemyView();
+  const EnemyPool& other_enemies = other.GetEnemyView();
+
+  REQUIRE(engine.GetTileGrid() == other.GetTileGrid());
+  REQUIRE(engine.GetPlayerView().GetFixedPosition() == other.GetPlayerView().GetFixedPosition());
+  REQUIRE(engine.GetPlayerView().GetFixedPrevVelocity() == other.GetPlayerView().GetFixedPrevVelocity());
+  REQUIRE(engine.GetScore() == other.GetScore());
+  REQUIRE(engine.GetNumLives() == other.GetNumLives());
+  REQUIRE(engine.IsPlayerAttacking() == other.IsPlayerAttacking());
+  REQUIRE(engine.GetHarpoonView().GetFixedArrowPosition() == other.GetHarpoonView().GetFixedArrowPosition());
+
+  REQUIRE(enemies.Size() == other_enemies.Size());
+  for (size_t index = 0; index < enemies.Size(); index++) {
+    REQUIRE(enemies.GetPosition(index) == other_enemies.GetPosition(index));
+    REQUIRE(enemies.GetVelocity(index) == other_enemies.GetVelocity(index));
+    REQUIRE(enemies.GetFlags()[index] == other_enemies.GetFlags()[index]);
+  }
+}
+
+TEST_CASE("Restoring a snapshot") {
+  GameStateGenerator generator(3);
+  GameEngine engine(generator.Generate(), 100, generator.GetEngineSeed());
+  PlayRandomFrames(engine, 200, 1);
+  EngineSnapshot snapshot = engine.Snapshot();
+  GameEngine before = engine;
+
+  SECTION("Returns to the captured state") {
+    PlayRandomFrames(engine, 300, 2);
+    engine.Restore(snapshot);
+
+    RequireSameState(engine, before);
+  }
+
+  SECTION("Plays out the same way again, including the random numbers") {
+    PlayRandomFrames(engine, 300, 2);
+    GameEngine first_run = engine;
+    engine.Restore(snapshot);
+    PlayRandomFrames(engine, 300, 2);
+
+    RequireSameState(engine, first_run);
+  }
+
+  SECTION("Restores into a different engine") {
+    GameEngine other;
+    other.Restore(snapshot);
+    PlayRandomFrames(engine, 300, 2);
+    PlayRandomFrames(other, 300, 2);
+
+    RequireSameState(engine, other);
+  }
+
+  SECTION("Unused space is zero") {
+    for (size_t index = snapshot.num_enemies; index < EngineSnapshot::kMaxEnemies; index++) {
+      REQUIRE(snapshot.enemy_x[index] == 0);
+      REQUIRE(snapshot.enemy_flags[index] == 0);
+    }
+
+    size_t num_tiles = snapshot.board_size * snapshot.board_size;
+    for (size_t tile = num_tiles; tile < EngineSnapshot::kMaxDimension * EngineSnapshot::kMaxDimension; tile++) {
+      REQUIRE(snapshot.tiles[tile] == 0);
+    }
+  }
+}
+
+TEST_CASE("Snapshots of chunked maps") {
+  // Small boards are dense unless asked otherwise, so this copies a generated board into a chunked grid
+  GameStateGenerator generator(3);
+  const TileGrid& board = generator.Generate();
+  TileGrid chunked(board.GetDimension(), TileType::Dirt, dig_dug::TileStorage::Chunked);
+  chunked.SetData(board.GetData());
+
+  GameEngine engine(chunked, 100, generator.GetEngineSeed());
+  GameEngine dense(board, 100, generator.GetEngineSeed());
+  PlayRandomFrames(engine, 200, 1);
+  PlayRandomFrames(dense, 200, 1);
+  REQUIRE(engine.GetTileGrid().GetStorage() == dig_dug::TileStorage::Chunked);
+
+  SECTION("Hold the same tiles as snapshots of dense maps") {
+    EngineSnapshot snapshot = engine.Snapshot();
+    EngineSnapshot dense_snapshot = dense.Snapshot();
+    size_t num_tiles = snapshot.board_size * snapshot.board_size;
+
+    REQUIRE(std::equal(snapshot.tiles, snapshot.tiles + num_tiles, dense_snapshot.tiles));
+  }
+
+  SECTION("Restore to the captured state") {
+    EngineSnapshot snapshot = engine.Snapshot();
+    GameEngine before = engine;
+    PlayRandomFrames(engine, 300, 2);
+    engine.Restore(snapshot);
+
+    RequireSameState(engine, before);
+  }
+}
+
+TEST_CASE("Snapshot limits") {
+  SECTION("Board too large") {
+    GameEngine engine(TileGrid(20, TileType::Dirt), 100);
+    REQUIRE_THROWS_AS(engine.Snapshot(), std::invalid_argument);
+  }
+
+  SECTION("Too many enemies") {
+    TileGrid board(12, TileType::Dirt);
+    for (size_t y = 0; y <= EngineSnapshot::kMaxEnemies; y++) {
+      board.Set(0, y, TileType::Fygar);
+    }
+
+    GameEngine engine(board, 100);
+    REQUIRE_THROWS_AS(engine.Snapshot(), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Forking an engine") {
+  GameStateGenerator generator(4);
+  GameEngine engine(generator.Generate(), 100, generator.GetEngineSeed());
+  GameEngine fork = engine.Fork();
+
+  SECTION("Fork shares the map") {
+    REQUIRE(&fork.GetTileGrid() == &engine.GetTileGrid());
+  }
+
+  SECTION("Moving along a tunnel keeps the map shared") {
+    fork.MovePlayer({0, -1});
+    REQUIRE(&fork.GetTileGrid() == &engine.GetTileGrid());
+  }
+
+  SECTION("Digging copies the map") {
+    TileGrid original = engine.GetTileGrid();
+    for (size_t frame = 0; frame < 30; frame++) {
+      fork.MovePlayer({0, 1});
+    }
+
+    REQUIRE(&fork.GetTileGrid() != &engine.GetTileGrid());
+    REQUIRE(fork.GetTileGrid() != original);
+    REQUIRE(engine.GetTileGrid() == original);
+  }
+
+  SECTION("Fork plays out like the engine") {
+    PlayRandomFrames(engine, 500, 5);
+    PlayRandomFrames(fork, 500, 5);
+
+    RequireSameState(engine, fork);
+  }
+}
@@ -0,0 +1,83 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include "bench/episode_benchmark.h"
+#include "bench/micro_benchmark.h"
+#include "sim/episode_runner.h"
+
+using dig_dug::EpisodeBenchmarkConfig;
+using dig_dug::EpisodeBenchmarkResult;
+using dig_dug::EpisodeRunner;
+using dig_dug::RunnerConfig;
+
+TEST_CASE("Benchmarking whole games") {
+  EpisodeBenchmarkConfig config;
+  config.first_seed = 4;
+  config.num_episodes = 3;
+  config.max_ticks = 20000;
+
+  SECTION("Games play the same as in the episode runner") {
+    EpisodeBenchmarkResult result = dig_dug::RunEpisodeBenchmark(config);
+
+    RunnerConfig runner_config;
+    runner_config.first_seed = 4;
+    runner_config.num_episodes = 3;
+    runner_config.max_ticks = 20000;
+    dig_dug::RunSummary summary = EpisodeRunner(runner_config).Run();
+
+    REQUIRE(result.num_episodes == 3);
+    REQUIRE(result.num_ticks == summary.num_ticks);
+    REQUIRE(result.board_dimension == 15);
+    REQUIRE(result.policy == "hunter");
+  }
+
+  SECTION("Ticks are timed") {
+    EpisodeBenchmarkResult result = dig_dug::RunEpisodeBenchmark(config);
+
+    REQUIRE(result.seconds > 0);
+    REQUIRE(result.GetEpisodesPerSecond() > 0);
+    REQUIRE(result.GetTicksPerSecond() > result.GetEpisodesPerSecond());
+    REQUIRE(result.p50_tick_ns <= result.p99_tick_ns);
+    REQUIRE(result.p99_tick_ns <= result.max_tick_ns);
+  }
+
+  SECTION("Unknown policies are rejected") {
+    config.policy = "cheater";
+    REQUIRE_THROWS_AS(dig_dug::RunEpisodeBenchmark(config), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Game benchmark results as JSON") {
+  const std::string kPath = "episode_benchmark_test.json";
+
+  std::vector<EpisodeBenchmarkResult> results(1);
+  results[0].board_dimension = 15;
+  results[0].policy = "hunter";
+  results[0].num_episodes = 100;
+  results[0].num_ticks = 250000;
+  results[0].num_levels_cleared = 42;
+  results[0].seconds = 0.5;
+  results[0].p50_tick_ns = 120;
+  results[0].p99_tick_ns = 900;
+  results[0].max_tick_ns = 35000;
+  results[0].peak_resident_bytes = 4 << 20;
+
+  dig_dug::WriteEpisodeBenchmarkJson(kPath, results, "main");
+  std::vector<EpisodeBenchmarkResult> read = dig_dug::ReadEpisodeBenchmarkJson(kPath);
+
+  REQUIRE(read.size() == 1);
+  REQUIRE(read[0].GetKey() == "hunter/15");
+  REQUIRE(read[0].num_ticks == 250000);
+  REQUIRE(read[0].num_levels_cleared == 42);
+  REQUIRE(read[0].GetEpisodesPerSecond() == Approx(200));
+  REQUIRE(read[0].p99_tick_ns == 900);
+  REQUIRE(read[0].peak_resident_bytes == 4 << 20);
+
+  // Microbenchmark results are a different file
+  REQUIRE_THROWS_AS(dig_dug::ReadBenchmarkJson(kPath), std::runtime_error);
+
+  std::remove(kPath.c_str());
+}
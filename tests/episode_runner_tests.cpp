@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+
+#include "sim/episode_runner.h"
+#include "sim/work_stealing_queue.h"
+
+using dig_dug::EpisodeRunner;
+using dig_dug::EpisodeResult;
+using dig_dug::RunnerConfig;
+using dig_dug::RunSummary;
+using dig_dug::WorkStealingQueue;
+using dig_dug::WorkStealingQueueArray;
+using dig_dug::IdlePolicy;
+using dig_dug::HunterPolicy;
+
+TEST_CASE("Work stealing queue") {
+  WorkStealingQueue queue;
+  queue.Push(1);
+  queue.Push(2);
+  queue.Push(3);
+  size_t item;
+
+  SECTION("Owner takes the newest item") {
+    REQUIRE(queue.Pop(item));
+    REQUIRE(item == 3);
+  }
+
+  SECTION("Thieves take the oldest item") {
+    REQUIRE(queue.Steal(item));
+    REQUIRE(item == 1);
+    REQUIRE(queue.Size() == 2);
+  }
+
+  SECTION("Empty queue") {
+    while (queue.Pop(item)) {
+    }
+
+    REQUIRE_FALSE(queue.Pop(item));
+    REQUIRE_FALSE(queue.Steal(item));
+  }
+}
+
+TEST_CASE("Work stealing queue array") {
+  WorkStealingQueueArray queues(5);
+
+  SECTION("Every queue starts on its own cache line") {
+    REQUIRE(queues.Size() == 5);
+    for (size_t index = 0; index < queues.Size(); index++) {
+      REQUIRE(reinterpret_cast<uintptr_t>(&queues[index]) % dig_dug::kCacheLineSize == 0);
+    }
+  }
+
+  SECTION("Queues are independent") {
+    size_t item;
+    queues[1].Push(7);
+
+    REQUIRE_FALSE(queues[0].Pop(item));
+    REQUIRE(queues[1].Pop(item));
+    REQUIRE(item == 7);
+  }
+}
+
+TEST_CASE("Playing single episodes") {
+  SECTION("Idle player loses every life without scoring") {
+    IdlePolicy policy;
+    EpisodeResult result = EpisodeRunner::PlayEpisode(3, policy, 100000);
+
+    REQUIRE(result.seed == 3);
+    REQUIRE(result.score == 0);
+    REQUIRE(result.level == 1);
+    REQUIRE(result.num_ticks < 100000);
+  }
+
+  SECTION("Episodes are cut off after the tick limit") {
+    IdlePolicy policy;
+    REQUIRE(EpisodeRunner::PlayEpisode(3, policy, 50).num_ticks == 50);
+  }
+
+  SECTION("Same seed plays out the same way") {
+    HunterPolicy policy;
+    EpisodeResult first = EpisodeRunner::PlayEpisode(5, policy, 20000);
+    EpisodeResult second = EpisodeRunner::PlayEpisode(5, policy, 20000);
+
+    REQUIRE(first == second);
+  }
+
+  SECTION("Stress boards start with over ten thousand enemies") {
+    dig_dug::GameSession session(3, 100, 1, nullptr, RunnerConfig::kStressBoardDimension,
+                                 RunnerConfig::kStressEnemyScale);
+    REQUIRE(session.GetEngine().GetEnemyView().Size() > 10000);
+
+    HunterPolicy policy;
+    EpisodeResult result = EpisodeRunner::PlayEpisode(3, policy, 300, nullptr, RunnerConfig::kStressBoardDimension,
+                                                      RunnerConfig::kStressEnemyScale);
+    REQUIRE(result.num_ticks == 300);
+  }
+}
+
+TEST_CASE("Running episodes on several threads") {
+  RunnerConfig config;
+  config.first_seed = 10;
+  config.num_episodes = 12;
+  config.policy = "random";
+  config.max_ticks = 5000;
+
+  RunSummary alone = EpisodeRunner(config).Run();
+  config.num_threads = 4;
+  RunSummary threaded = EpisodeRunner(config).Run();
+
+  SECTION("Results are in seed order") {
+    REQUIRE(threaded.episodes.size() == 12);
+    for (size_t index = 0; index < threaded.episodes.size(); index++) {
+      REQUIRE(threaded.episodes[index].seed == 10 + index);
+    }
+  }
+
+  SECTION("Results do not depend on the number of threads") {
+    REQUIRE(threaded.episodes == alone.episodes);
+    REQUIRE(threaded.num_ticks == alone.num_ticks);
+  }
+
+  SECTION("Bad configurations") {
+    config.policy = "sleepy";
+    REQUIRE_THROWS_AS(EpisodeRunner(config), std::invalid_argument);
+
+    config.policy = "idle";
+    config.num_threads = 0;
+    REQUIRE_THROWS_AS(EpisodeRunner(config), std::invalid_argument);
+
+    config.num_threads = 1;
+    config.board_dimension = dig_dug::GameStateGenerator::kMinBoardDimension - 1;
+    REQUIRE_THROWS_AS(EpisodeRunner(config), std::invalid_argument);
+  }
+}
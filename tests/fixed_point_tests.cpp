@@ -0,0 +1,90 @@
+#include <catch2/catch.hpp>
+
+#include "core/fixed_point.h"
+#include "core/direction.h"
+#include "core/enemy.h"
+#include "core/harpoon.h"
+
+using dig_dug::FixedVec2;
+using dig_dug::Direction;
+using dig_dug::Enemy;
+using dig_dug::Harpoon;
+using dig_dug::TileType;
+using dig_dug::kFixedOne;
+using glm::vec2;
+
+TEST_CASE("Fixed-point conversions") {
+  SECTION("Whole pixels convert exactly") {
+    FixedVec2 fixed = dig_dug::ToFixed({700, 1400});
+    REQUIRE(fixed == FixedVec2(700 * kFixedOne, 1400 * kFixedOne));
+    REQUIRE(dig_dug::ToFloat(fixed) == vec2(700, 1400));
+  }
+
+  SECTION("Fractions round to the nearest unit") {
+    FixedVec2 fixed = dig_dug::ToFixed({0.5f, -0.25f});
+    REQUIRE(fixed == FixedVec2(kFixedOne / 2, -kFixedOne / 4));
+  }
+
+  SECTION("Converting to pixels truncates toward zero") {
+    REQUIRE(dig_dug::FixedToPixels(kFixedOne * 5 / 2) == 2);
+    REQUIRE(dig_dug::FixedToPixels(-kFixedOne * 5 / 2) == -2);
+  }
+}
+
+TEST_CASE("Integer lengths") {
+  SECTION("Integer square root") {
+    REQUIRE(dig_dug::IntegerSqrt(0) == 0);
+    REQUIRE(dig_dug::IntegerSqrt(15) == 3);
+    REQUIRE(dig_dug::IntegerSqrt(16) == 4);
+    REQUIRE(dig_dug::IntegerSqrt(uint64_t(1) << 62) == (uint32_t(1) << 31));
+  }
+
+  SECTION("Length of a vector") {
+    REQUIRE(dig_dug::Length(FixedVec2(3 * kFixedOne, 4 * kFixedOne)) == 5 * kFixedOne);
+    REQUIRE(dig_dug::LengthSquared(FixedVec2(-3, 4)) == 25);
+  }
+}
+
+TEST_CASE("Directions") {
+  SECTION("Turning") {
+    REQUIRE(dig_dug::TurnLeft(Direction::Right) == Direction::Up);
+    REQUIRE(dig_dug::TurnRight(Direction::Right) == Direction::Down);
+    REQUIRE(dig_dug::TurnLeft(Direction::Up) == Direction::Left);
+    REQUIRE(dig_dug::TurnRight(Direction::Up) == Direction::Right);
+    REQUIRE(dig_dug::Reverse(Direction::Down) == Direction::Up);
+  }
+
+  SECTION("Velocities from the offset table") {
+    REQUIRE(dig_dug::DirectionVelocity(Direction::Left, 4) == FixedVec2(-4, 0));
+    REQUIRE(dig_dug::DirectionVelocity(Direction::Down, 4) == FixedVec2(0, 4));
+  }
+
+  SECTION("Direction of travel of a velocity") {
+    REQUIRE(dig_dug::GetTravelDirection({5, 0}) == Direction::Right);
+    REQUIRE(dig_dug::GetTravelDirection({-5, 0}) == Direction::Left);
+    REQUIRE(dig_dug::GetTravelDirection({0, 5}) == Direction::Down);
+    REQUIRE(dig_dug::GetTravelDirection({0, -5}) == Direction::Up);
+    REQUIRE(dig_dug::GetTravelDirection({0, 0}) == Direction::Up);
+  }
+}
+
+TEST_CASE("Objects keep fixed-point state") {
+  SECTION("Enemy movement is exact") {
+    Enemy enemy = Enemy::AtFixedPosition({0, 0}, {kFixedOne / 3, 0}, TileType::Pooka);
+    for (size_t move = 0; move < 3; move++) {
+      enemy.Move();
+    }
+
+    REQUIRE(enemy.GetFixedPosition() == FixedVec2(kFixedOne / 3 * 3, 0));
+  }
+
+  SECTION("Harpoon tracks distance in fixed point") {
+    Harpoon harpoon(FixedVec2(0, 0), Direction::Up, 20 * kFixedOne);
+    harpoon.Move();
+    harpoon.Move();
+
+    REQUIRE(harpoon.GetFixedArrowPosition() == FixedVec2(0, -40 * kFixedOne));
+    REQUIRE(harpoon.GetFixedDistanceTraveled() == 40 * kFixedOne);
+    REQUIRE(harpoon.GetDistanceTraveled() == 40);
+  }
+}
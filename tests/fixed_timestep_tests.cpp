@@ -0,0 +1,156 @@
+#include <catch2/catch.hpp>
+
+#include "core/fixed_timestep.h"
+#include "core/frame_interpolator.h"
+#include "core/game_state_generator.h"
+
+using dig_dug::EngineSnapshot;
+using dig_dug::FixedTimestep;
+using dig_dug::FrameInterpolator;
+using dig_dug::GameEngine;
+using dig_dug::GameStateGenerator;
+using dig_dug::TileGrid;
+using dig_dug::TileType;
+using glm::vec2;
+
+TEST_CASE("Fixed timestep") {
+  FixedTimestep timestep(50, 4);
+
+  SECTION("Rejects a zero rate") {
+    REQUIRE_THROWS_AS(FixedTimestep(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(FixedTimestep(60, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(timestep.SetTickRate(0), std::invalid_argument);
+  }
+
+  SECTION("Short frames build up to a tick") {
+    REQUIRE(timestep.Advance(0.015) == 0);
+    REQUIRE(timestep.GetAlpha() == Approx(0.75));
+    REQUIRE(timestep.Advance(0.015) == 1);
+    REQUIRE(timestep.GetAlpha() == Approx(0.5));
+  }
+
+  SECTION("Long frames run several ticks") {
+    REQUIRE(timestep.Advance(0.07) == 3);
+    REQUIRE(timestep.GetAlpha() == Approx(0.5));
+  }
+
+  SECTION("Same number of ticks for any frame rate") {
+    FixedTimestep fast(50, 4);
+    size_t num_ticks = 0;
+    size_t num_fast_ticks = 0;
+    for (size_t frame = 0; frame < 600; frame++) {
+      num_ticks += timestep.Advance(1.0 / 60);
+    }
+    for (size_t frame = 0; frame < 1440; frame++) {
+      num_fast_ticks += fast.Advance(1.0 / 144);
+    }
+
+    REQUIRE(num_ticks >= 499);
+    REQUIRE(num_ticks <= 500);
+    REQUIRE(num_fast_ticks >= 499);
+    REQUIRE(num_fast_ticks <= 500);
+  }
+
+  SECTION("Stalls drop the ticks past the limit") {
+    REQUIRE(timestep.Advance(2.005) == 4);
+    REQUIRE(timestep.GetAlpha() == Approx(0.25));
+    REQUIRE(timestep.Advance(0) == 0);
+  }
+
+  SECTION("Negative times are ignored") {
+    REQUIRE(timestep.Advance(-1) == 0);
+    REQUIRE(timestep.GetAlpha() == 0);
+  }
+
+  SECTION("Changing the rate keeps the fraction of a tick") {
+    timestep.Advance(0.01);
+    timestep.SetTickRate(100);
+    REQUIRE(timestep.GetTickRate() == 100);
+    REQUIRE(timestep.GetTickSeconds() == Approx(0.01));
+    REQUIRE(timestep.GetAlpha() == Approx(0.5));
+  }
+}
+
+TEST_CASE("Interpolating between ticks") {
+  GameStateGenerator generator(2);
+  GameEngine engine(generator.Generate(), 100, generator.GetEngineSeed());
+  FrameInterpolator interpolator;
+
+  SECTION("Draws at the current state before anything is captured") {
+    REQUIRE(interpolator.GetPlayerPosition(engine, 0) == engine.GetPlayerView().GetPosition());
+    REQUIRE(interpolator.GetEnemyPosition(engine, 0, 0) == dig_dug::ToFloat(engine.GetEnemyView().GetPosition(0)));
+  }
+
+  SECTION("Player moves from the captured position to the current one") {
+    vec2 before = engine.GetPlayerView().GetPosition();
+    interpolator.Capture(engine);
+    engine.MovePlayer({1, 0});
+    vec2 after = engine.GetPlayerView().GetPosition();
+
+    REQUIRE(interpolator.GetPlayerPosition(engine, 0) == before);
+    REQUIRE(interpolator.GetPlayerPosition(engine, 1) == after);
+    REQUIRE(interpolator.GetPlayerPosition(engine, 0.5).x == Approx((before.x + after.x) / 2));
+  }
+
+  SECTION("Enemies move from the captured positions to the current ones") {
+    const dig_dug::EnemyPool& enemies = engine.GetEnemyView();
+    std::vector<vec2> before;
+    for (size_t index = 0; index < enemies.Size(); index++) {
+      before.push_back(dig_dug::ToFloat(enemies.GetPosition(index)));
+    }
+
+    interpolator.Capture(engine);
+    engine.MoveEnemies();
+
+    for (size_t index = 0; index < enemies.Size(); index++) {
+      vec2 after = dig_dug::ToFloat(enemies.GetPosition(index));
+      vec2 halfway = interpolator.GetEnemyPosition(engine, index, 0.5);
+
+      REQUIRE(interpolator.GetEnemyPosition(engine, index, 0) == before[index]);
+      REQUIRE(halfway.x == Approx((before[index].x + after.x) / 2));
+      REQUIRE(halfway.y == Approx((before[index].y + after.y) / 2));
+    }
+  }
+
+  SECTION("Harpoon comes out of the captured player and moves from the captured arrow") {
+    vec2 player = engine.GetPlayerView().GetPosition();
+    interpolator.Capture(engine);
+    engine.AttackEnemy();
+
+    REQUIRE(interpolator.GetArrowPosition(engine, 0) == player);
+    REQUIRE(interpolator.GetArrowPosition(engine, 1) == engine.GetHarpoonView().GetArrowPosition());
+
+    vec2 before = engine.GetHarpoonView().GetArrowPosition();
+    interpolator.Capture(engine);
+    engine.AttackEnemy();
+
+    REQUIRE(interpolator.GetArrowPosition(engine, 0) == before);
+    REQUIRE(interpolator.GetArrowPosition(engine, 1) == engine.GetHarpoonView().GetArrowPosition());
+  }
+
+  SECTION("Jumps farther than a tile are not blended") {
+    EngineSnapshot start = engine.Snapshot();
+    for (size_t frame = 0; frame < 30; frame++) {
+      engine.MovePlayer({0, 1});
+    }
+    interpolator.Capture(engine);
+    engine.Restore(start);
+
+    REQUIRE(interpolator.GetPlayerPosition(engine, 0) == engine.GetPlayerView().GetPosition());
+  }
+
+  SECTION("Enemies that were not captured are drawn where they are") {
+    GameEngine empty(TileGrid(12, TileType::Dirt), 100);
+    interpolator.Capture(empty);
+
+    REQUIRE(interpolator.GetEnemyPosition(engine, 0, 0) == dig_dug::ToFloat(engine.GetEnemyView().GetPosition(0)));
+  }
+
+  SECTION("Clearing forgets the captured state") {
+    interpolator.Capture(engine);
+    engine.MovePlayer({1, 0});
+    interpolator.Clear();
+
+    REQUIRE(interpolator.GetPlayerPosition(engine, 0) == engine.GetPlayerView().GetPosition());
+  }
+}
@@ -0,0 +1,62 @@
+#include <catch2/catch.hpp>
+
+#include "core/game_engine.h"
+#include "core/frame_view.h"
+
+using dig_dug::GameStateGenerator;
+using dig_dug::GameEngine;
+using dig_dug::FrameView;
+using dig_dug::ConstSpan;
+using dig_dug::Enemy;
+using std::vector;
+using glm::vec2;
+
+TEST_CASE("Const span") {
+  int values[3] = {4, 5, 6};
+  ConstSpan<int> span(values, 3);
+
+  REQUIRE(span.size() == 3);
+  REQUIRE(span[1] == 5);
+  REQUIRE(span.end() - span.begin() == 3);
+  REQUIRE(ConstSpan<int>().empty());
+}
+
+TEST_CASE("Frame view of the engine state") {
+  GameStateGenerator generator;
+  generator.Generate();
+  GameEngine engine(generator.GetTileGrid(), 100);
+
+  SECTION("View refers to the engine state instead of copying it") {
+    const FrameView& frame = engine.GetFrameView();
+    REQUIRE(frame.tiles == &engine.GetTileGrid());
+    REQUIRE(frame.player == &engine.GetPlayerView());
+    REQUIRE(frame.harpoon == &engine.GetHarpoonView());
+    REQUIRE(frame.enemies == &engine.GetEnemyView());
+  }
+
+  SECTION("The same view is reused every frame") {
+    const FrameView* first_frame = &engine.GetFrameView();
+    engine.MoveEnemies();
+    REQUIRE(&engine.GetFrameView() == first_frame);
+  }
+
+  SECTION("View matches the by-value getters") {
+    engine.MovePlayer({1, 0});
+    engine.MoveEnemies();
+    engine.AttackEnemy();
+
+    const FrameView& frame = engine.GetFrameView();
+    vector<Enemy> enemies = engine.GetEnemies();
+    REQUIRE(frame.enemies->Size() == enemies.size());
+    for (size_t index = 0; index < enemies.size(); index++) {
+      REQUIRE(frame.enemies->GetEnemy(index).GetPosition() == enemies[index].GetPosition());
+    }
+
+    REQUIRE(frame.player->GetPosition() == engine.GetPlayer().GetPosition());
+    REQUIRE(frame.harpoon->GetArrowPosition() == engine.GetHarpoon().GetArrowPosition());
+    REQUIRE(frame.is_player_attacking == engine.IsPlayerAttacking());
+    REQUIRE(frame.score == engine.GetScore());
+    REQUIRE(frame.num_lives == engine.GetNumLives());
+    REQUIRE(frame.tiles->ToNestedVector() == engine.GetGameMap());
+  }
+}
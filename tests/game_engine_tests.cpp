@@ -4,6 +4,7 @@
 
 using dig_dug::GameStateGenerator;
 using dig_dug::GameEngine;
+using dig_dug::TileGrid;
 using dig_dug::TileType;
 using dig_dug::Player;
 using dig_dug::Enemy;
@@ -45,8 +46,8 @@ TEST_CASE("Constructing Game Engine") {
 
   SECTION("Check tunnel in middle of board") {
     size_t is_tunnel_in_middle = true;
-    size_t x = 8;
-    for (size_t y = 0; y <= 8; y++) {
+    size_t x = 7;
+    for (size_t y = 0; y <= 7; y++) {
       if (game_map[x][y] != TileType::Tunnel) {
         is_tunnel_in_middle = false;
       }
@@ -69,8 +70,9 @@ TEST_CASE("Constructing Game Engine") {
     }
 
     SECTION("Check velocities of enemies") {
-      vec2 horizontal_velocity {1, 0};
-      vec2 vertical_velocity {0, 1};
+      float speed = (float) (dig_dug::FixedToPixels(GameEngine::kEnemySpeed));
+      vec2 horizontal_velocity {speed, 0};
+      vec2 vertical_velocity {0, speed};
 
       for (Enemy enemy : enemies) {
         vec2 velocity = enemy.GetVelocity();
@@ -132,7 +134,7 @@ TEST_CASE("Moving the player") {
 
   SECTION("Test player position") {
     SECTION("Move right") {
-      vec2 new_position {701, 700};
+      vec2 new_position {710, 700};
       engine.MovePlayer({1, 0});
       Player player = engine.GetPlayer();
       REQUIRE(player.GetPosition() == new_position);
@@ -143,14 +145,15 @@ TEST_CASE("Moving the player") {
         }
         engine.MovePlayer({1, 0});
 
+        // The edge check counts the pixel just past the player's far side, so it stops a step short of the edge
         player = engine.GetPlayer();
-        new_position = {1400, 700};
+        new_position = {1390, 700};
         REQUIRE(player.GetPosition() == new_position);
       }
     }
 
     SECTION("Move down") {
-      vec2 new_position {700, 701};
+      vec2 new_position {700, 710};
       engine.MovePlayer({0, 1});
       Player player = engine.GetPlayer();
       REQUIRE(player.GetPosition() == new_position);
@@ -162,13 +165,13 @@ TEST_CASE("Moving the player") {
         engine.MovePlayer({0, 1});
 
         player = engine.GetPlayer();
-        new_position = {700, 1400};
+        new_position = {700, 1390};
         REQUIRE(player.GetPosition() == new_position);
       }
     }
 
     SECTION("Move left") {
-      vec2 new_position {699, 700};
+      vec2 new_position {690, 700};
       engine.MovePlayer({-1, 0});
       Player player = engine.GetPlayer();
       REQUIRE(player.GetPosition() == new_position);
@@ -186,7 +189,7 @@ TEST_CASE("Moving the player") {
     }
 
     SECTION("Move up") {
-      vec2 new_position {700, 699};
+      vec2 new_position {700, 690};
       engine.MovePlayer({0, -1});
       Player player = engine.GetPlayer();
       REQUIRE(player.GetPosition() == new_position);
@@ -204,7 +207,7 @@ TEST_CASE("Moving the player") {
     }
 
     SECTION("Player tries to turn in the middle of tiles") {
-      vec2 new_position {702, 700};
+      vec2 new_position {720, 700};
       engine.MovePlayer({1, 0});
       engine.MovePlayer({0, 1});
       Player player = engine.GetPlayer();
@@ -212,7 +215,8 @@ TEST_CASE("Moving the player") {
     }
 
     SECTION("Player tries to turn in middle of tiles, then turns when it reaches a tile boundary") {
-      vec2 new_position {800, 701};
+      // Keeps going down until it lines up with the next tile, since it cannot stop in the middle of one
+      vec2 new_position {800, 800};
 
       engine.MovePlayer({1, 0});
       engine.MovePlayer({0, 1});
@@ -253,108 +257,79 @@ TEST_CASE("Moving the player") {
 }
 
 TEST_CASE("Testing player death") {
-  GameStateGenerator generator;
-  generator.Generate();
-  GameEngine engine (generator.GetGameMap(), 100);
+  // Pooka one tile below the player's starting tile
+  TileGrid board(15, TileType::Dirt);
+  board.Set(7, 8, TileType::Pooka);
+  GameEngine engine (board, 100);
 
   SECTION("Testing when player is still alive") {
-    REQUIRE_FALSE(engine.CheckPlayerDeath());
+    REQUIRE_FALSE(engine.IsPlayerDead());
+    REQUIRE(engine.GetNumLives() == 3);
   }
 
   SECTION("Testing player death") {
-    Enemy enemy = engine.GetEnemies()[0];
-    vec2 enemy_position = enemy.GetPosition();
-
-    for (size_t move = 0; move < 700; move++) {
-      engine.MovePlayer({-1, 0});
-      engine.MovePlayer({0, -1});
-    }
-
-    for (size_t player_x = 0; player_x < enemy_position.x - 50; player_x++) {
-      engine.MovePlayer({1, 0});
-    }
-
-    for (size_t player_y = 0; player_y <= enemy_position.y; player_y++) {
-      engine.MovePlayer({0, 1});
-    }
+    engine.MovePlayer({0, 1});
 
-    REQUIRE(engine.CheckPlayerDeath());
+    REQUIRE(engine.IsPlayerDead());
 
     SECTION("Checking if lives were decremented") {
-      REQUIRE(engine.GetLives() == 2);
+      REQUIRE(engine.GetNumLives() == 2);
     }
   }
 }
 
 TEST_CASE("Testing player attacking") {
-  GameStateGenerator generator;
-  generator.Generate();
-  GameEngine engine (generator.GetGameMap(), 100);
+  // The player's starting tunnel runs up from the center of the board, and harpoons only travel through tunnels, so
+  // the player steps up into it to aim the harpoon upward
+  TileGrid empty_board(15, TileType::Dirt);
+  GameEngine engine (empty_board, 100);
+  engine.MovePlayer({0, -1});
 
   SECTION("Harpoon extends until length limit") {
     engine.AttackEnemy();
 
     SECTION("Check that harpoon has launched") {
-      REQUIRE(engine.GetIsAttacking());
+      REQUIRE(engine.IsPlayerAttacking());
     }
 
-    engine.AttackEnemy();
-    engine.AttackEnemy();
-    engine.AttackEnemy();
+    size_t num_attacks = 1;
+    while (engine.IsPlayerAttacking() && num_attacks < 100) {
+      engine.AttackEnemy();
+      num_attacks++;
+    }
 
     SECTION("Check that harpoon has went away") {
-      REQUIRE_FALSE(engine.GetIsAttacking());
+      REQUIRE_FALSE(engine.IsPlayerAttacking());
+      REQUIRE(num_attacks < 100);
+      REQUIRE(engine.GetHarpoon().GetArrowPosition().y < 590);
     }
   }
 
-  SECTION("Harpoon hurts enemy") {
-    Enemy enemy = engine.GetEnemies()[0];
-    vec2 enemy_position = enemy.GetPosition();
+  // Pooka in the starting tunnel, two tiles above the player's starting tile
+  TileGrid board(15, TileType::Dirt);
+  board.Set(7, 5, TileType::Pooka);
+  engine = GameEngine(board, 100);
+  engine.MovePlayer({0, -1});
 
-    for (size_t move = 0; move < 700; move++) {
-      engine.MovePlayer({-1, 0});
-      engine.MovePlayer({0, -1});
-    }
-
-    for (size_t player_x = 0; player_x < enemy_position.x; player_x++) {
-      engine.MovePlayer({1, 0});
-    }
-
-    for (size_t player_y = 0; player_y < enemy_position.y - 200; player_y++) {
-      engine.MovePlayer({0, 1});
+  SECTION("Harpoon hurts enemy") {
+    for (size_t attack = 0; attack < 10; attack++) {
+      engine.AttackEnemy();
     }
 
-    engine.AttackEnemy();
-    engine.AttackEnemy();
-    engine.AttackEnemy();
-
-    enemy = engine.GetEnemies()[0];
-    REQUIRE(enemy.GetIsHurt());
+    Enemy enemy = engine.GetEnemies()[0];
+    REQUIRE(enemy.IsHurt());
+    REQUIRE(engine.IsPlayerAttacking());
   }
 
   SECTION("Harpoon kills enemy") {
-    Enemy enemy = engine.GetEnemies()[0];
-    vec2 enemy_position = enemy.GetPosition();
-
-    for (size_t move = 0; move < 700; move++) {
-      engine.MovePlayer({-1, 0});
-      engine.MovePlayer({0, -1});
-    }
-
-    for (size_t player_x = 0; player_x < enemy_position.x; player_x++) {
-      engine.MovePlayer({1, 0});
-    }
-
-    for (size_t player_y = 0; player_y < enemy_position.y - 200; player_y++) {
-      engine.MovePlayer({0, 1});
-    }
-
-    for (size_t attack = 0; attack < 5; attack++) {
+    // Attacking again after the kill would shoot a new harpoon, so this stops once the enemy is gone
+    for (size_t attack = 0; attack < 100 && !engine.GetEnemies().empty(); attack++) {
       engine.AttackEnemy();
     }
 
     vector<Enemy> enemies = engine.GetEnemies();
-    REQUIRE(enemies.size() == 3);
-    REQUIRE(engine.GetIsAttacking() == false);
+    REQUIRE(enemies.empty());
+    REQUIRE(engine.IsPlayerAttacking() == false);
+    REQUIRE(engine.GetScore() == GameEngine::kEnemyKillScore);
   }
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+
+#include "core/game_session.h"
+
+using dig_dug::GameSession;
+using dig_dug::GameStateGenerator;
+
+TEST_CASE("Game session flow") {
+  GameSession session(7, 100);
+
+  SECTION("New game starts on the first level") {
+    REQUIRE(session.GetLevel() == 1);
+    REQUIRE(session.GetScore() == 0);
+    REQUIRE(session.GetNumTicks() == 0);
+    REQUIRE(session.GetEngine().GetNumLives() == 3);
+    REQUIRE_FALSE(session.IsGameOver());
+  }
+
+  SECTION("First board matches a generator with the same seed") {
+    GameStateGenerator generator(7);
+    REQUIRE(session.GetGenerator().GetTileGrid() == generator.Generate());
+  }
+
+  SECTION("Level restarts after a pause when the player dies") {
+    while (!session.IsLosingLife()) {
+      session.Update();
+    }
+    REQUIRE(session.GetEngine().GetNumLives() == 2);
+
+    for (size_t frame = 1; frame < GameSession::kMaxLiveLostFrames; frame++) {
+      session.Update();
+    }
+    REQUIRE(session.IsLosingLife());
+
+    session.Update();
+    REQUIRE_FALSE(session.IsLosingLife());
+    REQUIRE(session.GetEngine().GetNumLives() == 2);
+    REQUIRE(session.GetLevel() == 1);
+  }
+
+  SECTION("Game ends once every life is lost") {
+    while (!session.IsGameOver()) {
+      session.Update();
+    }
+
+    size_t num_ticks = session.GetNumTicks();
+    session.Update();
+    REQUIRE(session.GetNumTicks() == num_ticks);
+    REQUIRE(session.GetEngine().GetNumLives() == 0);
+
+    session.NewGame(8);
+    REQUIRE_FALSE(session.IsGameOver());
+    REQUIRE(session.GetEngine().GetNumLives() == 3);
+  }
+}
+
+TEST_CASE("Game sessions on large boards") {
+  GameSession session(3, 100, 1, nullptr, 128);
+
+  SECTION("Every board of the game has the session's size") {
+    REQUIRE(session.GetEngine().GetTileGrid().GetDimension() == 128);
+    REQUIRE(session.GetEngine().GetEnemyView().Size() > 8);
+
+    while (!session.IsGameOver()) {
+      session.Update();
+      REQUIRE(session.GetEngine().GetTileGrid().GetDimension() == 128);
+    }
+
+    session.NewGame(4);
+    REQUIRE(session.GetEngine().GetTileGrid().GetDimension() == 128);
+  }
+
+  SECTION("Snapshots only hold small boards") {
+    REQUIRE_THROWS_AS(session.Snapshot(), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Game sessions on chunked boards") {
+  GameSession session(5, 100, 1, nullptr, 1024);
+  dig_dug::GameEngine& engine = session.GetEngine();
+  const dig_dug::TileGrid& map = engine.GetTileGrid();
+
+  SECTION("Maps only hold memory for the chunks that were changed") {
+    REQUIRE(map.GetStorage() == dig_dug::TileStorage::Chunked);
+
+    // Only the player's starting tunnel is dug on an empty board
+    dig_dug::GameEngine empty(dig_dug::TileGrid(1024, dig_dug::TileType::Dirt), 100, 5);
+    REQUIRE(empty.GetTileGrid().GetNumResidentChunks() == 17);
+    REQUIRE(empty.GetTileGrid().GetMemoryUsage() < map.GetNumTiles() / 16);
+  }
+
+  SECTION("Spilled maps play the same as maps in memory") {
+    GameSession other(5, 100, 1, nullptr, 1024);
+    other.GetEngine().SpillMapTo(".", 8);
+
+    for (size_t tick = 0; tick < 200 && !session.IsGameOver(); tick++) {
+      session.Update();
+      other.Update();
+    }
+
+    REQUIRE(other.GetEngine().GetTileGrid().GetNumResidentChunks() <= 8);
+    REQUIRE(other.GetEngine().GetTileGrid().GetMemoryUsage() < map.GetMemoryUsage() / 8);
+    REQUIRE(other.GetEngine().GetTileGrid() == map);
+    REQUIRE(other.GetEngine().GetPlayer().GetFixedPosition() == engine.GetPlayer().GetFixedPosition());
+  }
+}
+
+namespace {
+
+/**
+ * Counts the chunks of a map that hold any tile that is not dirt, which are the only ones that need memory
+ */
+size_t CountDugChunks(const dig_dug::TileGrid& map, size_t& num_dug_tiles) {
+  const size_t kChunkDimension = dig_dug::TileGrid::kChunkDimension;
+  size_t num_chunks = 0;
+  num_dug_tiles = 0;
+
+  for (size_t chunk_x = 0; chunk_x < map.GetDimension(); chunk_x += kChunkDimension) {
+    for (size_t chunk_y = 0; chunk_y < map.GetDimension(); chunk_y += kChunkDimension) {
+      size_t chunk_tiles = 0;
+      for (size_t x = chunk_x; x < chunk_x + kChunkDimension; x++) {
+        for (size_t y = chunk_y; y < chunk_y + kChunkDimension; y++) {
+          chunk_tiles += map.GetUnchecked(x, y) != dig_dug::TileType::Dirt ? 1 : 0;
+        }
+      }
+
+      num_chunks += chunk_tiles > 0 ? 1 : 0;
+      num_dug_tiles += chunk_tiles;
+    }
+  }
+
+  return num_chunks;
+}
+
+} // namespace
+
+TEST_CASE("Game sessions on the largest boards") {
+  GameSession session(5, 100, 1, nullptr, GameStateGenerator::kMaxBoardDimension);
+  const dig_dug::TileGrid& map = session.GetEngine().GetTileGrid();
+  const size_t kNumChunks = map.GetNumTiles() / dig_dug::TileGrid::kChunkTiles;
+
+  SECTION("Boards start mostly dirt") {
+    size_t num_dug_tiles = 0;
+    size_t num_dug_chunks = CountDugChunks(map, num_dug_tiles);
+
+    REQUIRE(session.GetEngine().GetEnemyView().Size() <= 8 * GameStateGenerator::kMaxDefaultEnemyScale);
+    REQUIRE(num_dug_tiles < map.GetNumTiles() / 1000);
+    REQUIRE(map.GetNumResidentChunks() == num_dug_chunks);
+    REQUIRE(map.GetNumResidentChunks() < kNumChunks / 10);
+    // The pool grows by doubling, and the chunk table takes about 64 chunks' worth of memory on this board
+    REQUIRE(map.GetMemoryUsage() < 2 * (num_dug_chunks + 64) * dig_dug::TileGrid::kChunkTiles);
+  }
+
+  SECTION("Memory grows with the tunnels the player digs") {
+    size_t start_chunks = map.GetNumResidentChunks();
+    const dig_dug::InputFrame kMoves[] = {dig_dug::InputFrame(dig_dug::PlayerAction::Left),
+                                          dig_dug::InputFrame(dig_dug::PlayerAction::Down)};
+
+    // Long runs of moves leave the starting tunnel and dig through untouched chunks
+    for (size_t tick = 0; tick < 4000 && !session.IsLosingLife(); tick++) {
+      session.Update(kMoves[tick / 2000]);
+    }
+
+    size_t num_dug_tiles = 0;
+    size_t num_dug_chunks = CountDugChunks(map, num_dug_tiles);
+    REQUIRE(map.GetNumResidentChunks() == num_dug_chunks);
+    REQUIRE(map.GetNumResidentChunks() > start_chunks);
+    REQUIRE(map.GetNumResidentChunks() < kNumChunks / 10);
+    REQUIRE(map.GetMemoryUsage() < 2 * (num_dug_chunks + 64) * dig_dug::TileGrid::kChunkTiles);
+  }
+}
@@ -1,5 +1,8 @@
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "core/game_state_generator.h"
 
 using dig_dug::GameStateGenerator;
@@ -149,4 +152,114 @@ TEST_CASE("GameStateGenerator Initialization and testing advancing levels") {
     generator.IncreaseLevel();
     REQUIRE(generator.GetLevel() == 3);
   }
-}
\ No newline at end of file
+}
+TEST_CASE("Enemies are placed apart on every board") {
+  const size_t kMaxLevel = 12;
+
+  for (uint64_t seed = 0; seed < 300; seed++) {
+    GameStateGenerator generator(seed);
+    generator.SetLevel(seed % kMaxLevel + 1);
+    const dig_dug::TileGrid& map = generator.Generate();
+    size_t size = map.GetDimension();
+
+    // Numbers each enemy's tiles, with 0 for the tiles of no enemy
+    vector<size_t> group(size * size, 0);
+    size_t num_enemies = 0;
+    for (size_t x = 0; x < size; x++) {
+      for (size_t y = 0; y < size; y++) {
+        TileType tile = map.GetUnchecked(x, y);
+        if (tile == TileType::Pooka || tile == TileType::Fygar) {
+          num_enemies++;
+          bool is_horizontal = x + 1 < size && map.GetUnchecked(x + 1, y) == TileType::Tunnel;
+          for (size_t tunnel_space = 0; tunnel_space < 3; tunnel_space++) {
+            group[(is_horizontal ? x + tunnel_space : x) * size + (is_horizontal ? y : y + tunnel_space)] = num_enemies;
+          }
+        }
+      }
+    }
+
+    size_t level = generator.GetLevel();
+    REQUIRE(num_enemies == (level <= 10 ? (level - 1) / 2 + 4 : 8));
+
+    for (size_t x = 0; x + 1 < size; x++) {
+      for (size_t y = 0; y + 1 < size; y++) {
+        size_t tile = group[x * size + y];
+        size_t right = group[(x + 1) * size + y];
+        size_t below = group[x * size + y + 1];
+        REQUIRE((tile == 0 || right == 0 || tile == right));
+        REQUIRE((tile == 0 || below == 0 || tile == below));
+      }
+    }
+  }
+}
+
+TEST_CASE("Boards of other sizes") {
+  SECTION("Arcade boards are the default") {
+    GameStateGenerator sized(9, GameStateGenerator::kDefaultBoardDimension);
+    GameStateGenerator generator(9);
+    REQUIRE(sized.Generate() == generator.Generate());
+  }
+
+  SECTION("Enemies and rocks grow with the side of the board") {
+    const size_t kDimensions[] = {8, 21, 64, 256};
+
+    for (size_t dimension : kDimensions) {
+      GameStateGenerator generator(4, dimension);
+      generator.SetLevel(11);
+      const dig_dug::TileGrid& map = generator.Generate();
+      REQUIRE(map.GetDimension() == dimension);
+      REQUIRE(generator.GetBoardDimension() == dimension);
+
+      size_t num_enemies = 0;
+      size_t num_rocks = 0;
+      for (size_t tile = 0; tile < map.GetNumTiles(); tile++) {
+        TileType type = static_cast<TileType>(map.GetData()[tile]);
+        num_enemies += type == TileType::Pooka || type == TileType::Fygar ? 1 : 0;
+        num_rocks += type == TileType::Rock ? 1 : 0;
+      }
+
+      size_t enemy_scale = std::max<size_t>(dimension / 15, 1);
+      REQUIRE(generator.GetEnemyScale() == enemy_scale);
+      // Boards smaller than the arcade board run out of room for enemies
+      REQUIRE(num_enemies <= 8 * enemy_scale);
+      if (dimension > 15) {
+        REQUIRE(num_enemies * 2 > 8 * enemy_scale);
+      }
+      REQUIRE(num_rocks >= 3 * enemy_scale);
+      REQUIRE(num_rocks <= 4 * enemy_scale);
+    }
+  }
+
+  SECTION("Large boards get a capped number of enemies") {
+    REQUIRE(GameStateGenerator::GetDefaultEnemyScale(8) == 1);
+    REQUIRE(GameStateGenerator::GetDefaultEnemyScale(GameStateGenerator::kDefaultBoardDimension) == 1);
+    REQUIRE(GameStateGenerator::GetDefaultEnemyScale(300) == 20);
+    REQUIRE(GameStateGenerator::GetDefaultEnemyScale(GameStateGenerator::kMaxBoardDimension) ==
+            GameStateGenerator::kMaxDefaultEnemyScale);
+  }
+
+  SECTION("Enemy counts can be set apart from the size") {
+    GameStateGenerator crowded(4, 64, 40);
+    crowded.SetLevel(11);
+    const dig_dug::TileGrid& map = crowded.Generate();
+    REQUIRE(crowded.GetEnemyScale() == 40);
+
+    size_t num_enemies = 0;
+    for (size_t tile = 0; tile < map.GetNumTiles(); tile++) {
+      TileType type = static_cast<TileType>(map.GetData()[tile]);
+      num_enemies += type == TileType::Pooka || type == TileType::Fygar ? 1 : 0;
+    }
+
+    REQUIRE(num_enemies <= 8 * 40);
+    REQUIRE(num_enemies * 2 > 8 * 40);
+  }
+
+  SECTION("Sizes outside the supported range are rejected") {
+    REQUIRE_THROWS_AS(GameStateGenerator(1, GameStateGenerator::kMinBoardDimension - 1), std::invalid_argument);
+    REQUIRE_THROWS_AS(GameStateGenerator(1, GameStateGenerator::kMaxBoardDimension + 1), std::invalid_argument);
+    REQUIRE_FALSE(GameStateGenerator::IsValidDimension(GameStateGenerator::kMinBoardDimension - 1));
+    REQUIRE(GameStateGenerator::IsValidDimension(GameStateGenerator::kMinBoardDimension));
+    REQUIRE(GameStateGenerator::IsValidDimension(GameStateGenerator::kMaxBoardDimension));
+    REQUIRE_FALSE(GameStateGenerator::IsValidDimension(GameStateGenerator::kMaxBoardDimension + 1));
+  }
+}
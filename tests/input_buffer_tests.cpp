@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include "core/game_session.h"
+#include "core/input_buffer.h"
+
+using dig_dug::GameSession;
+using dig_dug::InputBuffer;
+using dig_dug::InputFrame;
+using dig_dug::PlayerAction;
+
+TEST_CASE("Buffering input between ticks") {
+  InputBuffer buffer;
+
+  SECTION("No keys means no action") {
+    REQUIRE(buffer.Sample(0).action == PlayerAction::None);
+  }
+
+  SECTION("Held keys act every tick") {
+    buffer.Press(PlayerAction::Right, 0);
+    REQUIRE(buffer.Sample(0.01).action == PlayerAction::Right);
+    REQUIRE(buffer.Sample(0.02).action == PlayerAction::Right);
+
+    buffer.Release(PlayerAction::Right);
+    REQUIRE(buffer.Sample(0.03).action == PlayerAction::None);
+    REQUIRE_FALSE(buffer.IsHeld(PlayerAction::Right));
+  }
+
+  SECTION("Key repeats do not change anything") {
+    buffer.Press(PlayerAction::Attack, 0);
+    buffer.Sample(0.01);
+    buffer.Press(PlayerAction::Attack, 0.02);
+    buffer.Press(PlayerAction::Attack, 0.03);
+
+    InputFrame frame = buffer.Sample(0.04);
+    REQUIRE(frame.action == PlayerAction::Attack);
+    REQUIRE(frame.latency_seconds == 0);
+  }
+
+  SECTION("Taps between ticks act once") {
+    buffer.Press(PlayerAction::Up, 0);
+    buffer.Release(PlayerAction::Up);
+
+    REQUIRE(buffer.Sample(0.01).action == PlayerAction::Up);
+    REQUIRE(buffer.Sample(0.02).action == PlayerAction::None);
+  }
+
+  SECTION("Newest key wins") {
+    buffer.Press(PlayerAction::Left, 0);
+    buffer.Press(PlayerAction::Down, 0.005);
+    REQUIRE(buffer.Sample(0.01).action == PlayerAction::Down);
+
+    buffer.Release(PlayerAction::Down);
+    REQUIRE(buffer.Sample(0.02).action == PlayerAction::Left);
+  }
+
+  SECTION("Latency is the time from the press to the tick") {
+    buffer.Press(PlayerAction::Right, 1.0);
+    REQUIRE(buffer.Sample(1.0125).latency_seconds == Approx(0.0125));
+  }
+
+  SECTION("Latencies of sampled presses are kept") {
+    buffer.Press(PlayerAction::Right, 1.0);
+    buffer.Sample(1.002);
+    buffer.Sample(1.004);
+    buffer.Press(PlayerAction::Up, 1.005);
+    buffer.Sample(1.015);
+
+    // Holding a key is not a new press, so the tick in between adds nothing
+    REQUIRE(buffer.GetLatencies().GetCount() == 2);
+    REQUIRE(buffer.GetLatencies().GetMax() >= uint64_t(9000000));
+    REQUIRE(buffer.GetLatencies().GetMax() <= uint64_t(11000000));
+  }
+
+  SECTION("Clearing releases everything") {
+    buffer.Press(PlayerAction::Right, 0);
+    buffer.Clear();
+    REQUIRE(buffer.Sample(0.01).action == PlayerAction::None);
+  }
+}
+
+TEST_CASE("Sessions take one input frame per tick") {
+  GameSession session(5, 100);
+
+  SECTION("A frame moves the player one step") {
+    GameSession other(5, 100);
+    ApplyAction(other.GetEngine(), PlayerAction::Right);
+    session.Update(InputFrame(PlayerAction::Right));
+
+    REQUIRE(session.GetEngine().GetPlayerView().GetFixedPosition() ==
+            other.GetEngine().GetPlayerView().GetFixedPosition());
+  }
+
+  SECTION("Recorded frames replay to the same game") {
+    InputBuffer buffer;
+    std::vector<InputFrame> recording;
+    const PlayerAction kKeys[] = {PlayerAction::Down, PlayerAction::Attack, PlayerAction::Left, PlayerAction::Up};
+
+    for (size_t tick = 0; tick < 600; tick++) {
+      double seconds = tick / 60.0;
+      if (tick % 40 == 0) {
+        buffer.Clear();
+        buffer.Press(kKeys[(tick / 40) % 4], seconds - 0.001);
+      }
+
+      InputFrame input = buffer.Sample(seconds);
+      recording.push_back(input);
+      session.Update(input);
+    }
+
+    GameSession replay(5, 100);
+    for (const InputFrame& input : recording) {
+      replay.Update(input);
+    }
+
+    REQUIRE(replay.GetNumTicks() == session.GetNumTicks());
+    REQUIRE(replay.GetScore() == session.GetScore());
+    REQUIRE(replay.GetEngine().GetTileGrid() == session.GetEngine().GetTileGrid());
+    REQUIRE(replay.GetEngine().GetPlayerView().GetFixedPosition() ==
+            session.GetEngine().GetPlayerView().GetFixedPosition());
+  }
+
+  SECTION("Input is ignored while a life is being lost") {
+    while (!session.IsLosingLife()) {
+      session.Update();
+    }
+
+    dig_dug::FixedVec2 position = session.GetEngine().GetPlayerView().GetFixedPosition();
+    session.Update(InputFrame(PlayerAction::Right));
+    REQUIRE(session.GetEngine().GetPlayerView().GetFixedPosition() == position);
+  }
+}
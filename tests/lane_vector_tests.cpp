@@ -0,0 +1,154 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "core/fixed_point.h"
+#include "core/lane_vector.h"
+#include "core/random.h"
+
+using dig_dug::LaneVector;
+using dig_dug::Random;
+using dig_dug::kLaneWidth;
+using std::vector;
+
+namespace {
+
+/**
+ * Gets lanes of random values, with some small values and the extremes mixed in
+ */
+void FillLanes(Random& random, int32_t values[]) {
+  const int32_t kEdgeValues[] = {0, 1, -1, INT32_MIN, INT32_MAX, 255, -256};
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    uint32_t choice = random.NextBelow(3);
+    if (choice == 0) {
+      values[lane] = kEdgeValues[random.NextBelow(sizeof(kEdgeValues) / sizeof(kEdgeValues[0]))];
+    } else if (choice == 1) {
+      values[lane] = (int32_t) (random.NextBelow(4000)) - 2000;
+    } else {
+      values[lane] = (int32_t) (random.Next());
+    }
+  }
+}
+
+vector<int32_t> ToVector(const LaneVector& lanes) {
+  vector<int32_t> values(kLaneWidth);
+  dig_dug::StoreLanes(values.data(), lanes);
+  return values;
+}
+
+} // namespace
+
+TEST_CASE("Lane vectors match scalar math") {
+  Random random(17);
+  const size_t kNumTrials = 500;
+
+  for (size_t trial = 0; trial < kNumTrials; trial++) {
+    int32_t a[kLaneWidth];
+    int32_t b[kLaneWidth];
+    FillLanes(random, a);
+    FillLanes(random, b);
+    LaneVector left = dig_dug::LoadLanes(a);
+    LaneVector right = dig_dug::LoadLanes(b);
+
+    vector<int32_t> sum = ToVector(left + right);
+    vector<int32_t> difference = ToVector(left - right);
+    vector<int32_t> low = ToVector(dig_dug::MultiplyLow(left, right));
+    vector<int32_t> high = ToVector(dig_dug::MultiplyHigh(left, right));
+    vector<int32_t> less = ToVector(dig_dug::Less(left, right));
+    vector<int32_t> greater = ToVector(dig_dug::Greater(left, right));
+    vector<int32_t> less_unsigned = ToVector(dig_dug::LessUnsigned(left, right));
+    vector<int32_t> selected = ToVector(dig_dug::Select(dig_dug::Less(left, right), left, right));
+    vector<int32_t> absolute = ToVector(dig_dug::AbsLanes(left));
+    vector<int32_t> shifted = ToVector(dig_dug::ShiftRightByLanes(left, right & dig_dug::SplatLanes(31)));
+    int bits = dig_dug::GetLaneBits(dig_dug::Less(left, right));
+
+    for (size_t lane = 0; lane < kLaneWidth; lane++) {
+      uint32_t x = (uint32_t) (a[lane]);
+      uint32_t y = (uint32_t) (b[lane]);
+      REQUIRE(sum[lane] == (int32_t) (x + y));
+      REQUIRE(difference[lane] == (int32_t) (x - y));
+      REQUIRE(low[lane] == (int32_t) (x * y));
+      REQUIRE(high[lane] == (int32_t) (((uint64_t) (x) * y) >> 32));
+      REQUIRE(less[lane] == (a[lane] < b[lane] ? -1 : 0));
+      REQUIRE(greater[lane] == (a[lane] > b[lane] ? -1 : 0));
+      REQUIRE(less_unsigned[lane] == (x < y ? -1 : 0));
+      REQUIRE(selected[lane] == (a[lane] < b[lane] ? a[lane] : b[lane]));
+      REQUIRE(absolute[lane] == (a[lane] == INT32_MIN ? INT32_MIN : (a[lane] < 0 ? -a[lane] : a[lane])));
+      REQUIRE(shifted[lane] == (int32_t) (x >> (y & 31)));
+      REQUIRE(((bits >> lane) & 1) == (a[lane] < b[lane] ? 1 : 0));
+    }
+  }
+}
+
+TEST_CASE("Lane vectors gather bytes") {
+  vector<uint8_t> bytes(64 + 3);
+  for (size_t index = 0; index < bytes.size(); index++) {
+    bytes[index] = (uint8_t) (index * 37 + 11);
+  }
+
+  const int32_t kOffsets[kLaneWidth] = {0, 63, 5, 5, 31, 1, 62, 40};
+  vector<int32_t> gathered = ToVector(dig_dug::GatherBytes(bytes.data(), dig_dug::LoadLanes(kOffsets)));
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    REQUIRE(gathered[lane] == bytes[kOffsets[lane]]);
+  }
+}
+
+TEST_CASE("Lane vectors load bytes") {
+  const uint8_t kBytes[kLaneWidth] = {0, 1, 127, 128, 200, 255, 7, 64};
+  vector<int32_t> loaded = ToVector(dig_dug::LoadByteLanes(kBytes));
+  for (size_t lane = 0; lane < kLaneWidth; lane++) {
+    REQUIRE(loaded[lane] == kBytes[lane]);
+  }
+}
+
+TEST_CASE("Lane vectors take lengths and divide like integers") {
+  Random random(23);
+  const size_t kNumTrials = 2000;
+
+  for (size_t trial = 0; trial < kNumTrials; trial++) {
+    // Coordinates as far apart as the largest lane boards allow, and some right next to each other
+    int32_t range = trial % 2 == 0 ? (1 << 21) : 4;
+    int32_t x[kLaneWidth];
+    int32_t y[kLaneWidth];
+    int32_t numerator[kLaneWidth];
+    int32_t denominator[kLaneWidth];
+    for (size_t lane = 0; lane < kLaneWidth; lane++) {
+      x[lane] = (int32_t) (random.NextBelow((uint32_t) (2 * range))) - range;
+      y[lane] = (int32_t) (random.NextBelow((uint32_t) (2 * range))) - range;
+      numerator[lane] = (int32_t) (random.Next() >> 1) - (INT32_MAX / 2);
+      denominator[lane] = lane == 0 ? 0 : (int32_t) (random.NextBelow((uint32_t) (2 * range))) - range;
+    }
+
+    vector<int32_t> lengths = ToVector(dig_dug::LengthLanes(dig_dug::LoadLanes(x), dig_dug::LoadLanes(y)));
+    vector<int32_t> quotients = ToVector(dig_dug::DivideLanes(dig_dug::LoadLanes(numerator),
+                                                              dig_dug::LoadLanes(denominator)));
+    for (size_t lane = 0; lane < kLaneWidth; lane++) {
+      REQUIRE(lengths[lane] == dig_dug::Length({x[lane], y[lane]}));
+      REQUIRE(quotients[lane] == (denominator[lane] != 0 ? numerator[lane] / denominator[lane] : 0));
+    }
+  }
+}
+
+TEST_CASE("Lane vectors multiply into both halves") {
+  Random random(29);
+  const size_t kNumTrials = 500;
+
+  for (size_t trial = 0; trial < kNumTrials; trial++) {
+    int32_t a[kLaneWidth];
+    int32_t b[kLaneWidth];
+    FillLanes(random, a);
+    FillLanes(random, b);
+    LaneVector high;
+    LaneVector low;
+    dig_dug::MultiplyWide(dig_dug::LoadLanes(a), dig_dug::LoadLanes(b), high, low);
+
+    vector<int32_t> highs = ToVector(high);
+    vector<int32_t> lows = ToVector(low);
+    for (size_t lane = 0; lane < kLaneWidth; lane++) {
+      uint64_t product = (uint64_t) ((uint32_t) (a[lane])) * (uint32_t) (b[lane]);
+      REQUIRE(highs[lane] == (int32_t) ((uint32_t) (product >> 32)));
+      REQUIRE(lows[lane] == (int32_t) ((uint32_t) (product)));
+    }
+  }
+}
@@ -0,0 +1,59 @@
+#include <catch2/catch.hpp>
+
+#include "core/latency_histogram.h"
+
+using dig_dug::LatencyHistogram;
+
+TEST_CASE("Latency histogram") {
+  LatencyHistogram histogram;
+
+  SECTION("Empty histograms have no percentiles") {
+    REQUIRE(histogram.GetCount() == 0);
+    REQUIRE(histogram.GetPercentile(0.5) == 0);
+  }
+
+  SECTION("Short durations are counted exactly") {
+    for (uint64_t nanoseconds = 1; nanoseconds <= 20; nanoseconds++) {
+      histogram.Add(nanoseconds);
+    }
+
+    REQUIRE(histogram.GetCount() == 20);
+    REQUIRE(histogram.GetMax() == 20);
+    REQUIRE(histogram.GetPercentile(0.5) == 10);
+    REQUIRE(histogram.GetPercentile(0.95) == 19);
+    REQUIRE(histogram.GetPercentile(1) == 20);
+  }
+
+  SECTION("Long durations are within a few percent") {
+    for (uint64_t nanoseconds = 1000; nanoseconds <= 100000; nanoseconds += 1000) {
+      histogram.Add(nanoseconds);
+    }
+
+    REQUIRE(histogram.GetPercentile(0.5) >= 50000);
+    REQUIRE(histogram.GetPercentile(0.5) <= 51600);
+    REQUIRE(histogram.GetPercentile(0.99) >= 99000);
+    REQUIRE(histogram.GetPercentile(0.99) <= 100000);
+    REQUIRE(histogram.GetPercentile(1) == 100000);
+  }
+
+  SECTION("Extreme durations have buckets") {
+    histogram.Add(0);
+    histogram.Add(UINT64_MAX);
+
+    REQUIRE(histogram.GetPercentile(0.5) == 0);
+    REQUIRE(histogram.GetPercentile(1) == UINT64_MAX);
+  }
+
+  SECTION("Merging adds the other histogram's samples") {
+    LatencyHistogram other;
+    other.Add(500);
+    other.Add(700);
+    histogram.Add(100);
+    histogram.Merge(other);
+
+    REQUIRE(histogram.GetCount() == 3);
+    REQUIRE(histogram.GetMax() == 700);
+    REQUIRE(histogram.GetPercentile(0.5) >= 500);
+    REQUIRE(histogram.GetPercentile(0.5) < 520);
+  }
+}
@@ -0,0 +1,108 @@
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "core/level_pack.h"
+#include "sim/episode_runner.h"
+#include "sim/level_pack_builder.h"
+
+using dig_dug::BotPolicy;
+using dig_dug::EpisodeRunner;
+using dig_dug::GameStateGenerator;
+using dig_dug::LevelPack;
+using dig_dug::LevelPackConfig;
+using std::vector;
+
+/**
+ * Reads a whole file
+ */
+vector<char> ReadPackFile(const char* path) {
+  std::ifstream file(path, std::ios::binary);
+  return vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+TEST_CASE("Level packs") {
+  const char* kPath = "level_pack_tests.ddl";
+  LevelPackConfig config;
+  config.first_seed = 5;
+  config.num_seeds = 12;
+  config.num_levels = 4;
+  config.boards_per_level = 3;
+  config.num_threads = 3;
+  dig_dug::BuildLevelPack(kPath, config);
+  LevelPack pack(kPath);
+
+  SECTION("Every board matches the generator") {
+    REQUIRE(pack.Size() == 12 * 4 * 3);
+
+    for (uint64_t seed = 5; seed < 17; seed++) {
+      GameStateGenerator generated(seed);
+      GameStateGenerator loaded(seed);
+
+      for (size_t level = 1; level <= 4; level++) {
+        generated.SetLevel(level);
+        for (size_t board = 1; board <= 3; board++) {
+          generated.Generate();
+          REQUIRE(pack.TakeBoard(seed, level, board, loaded));
+
+          REQUIRE(loaded.GetLevel() == level);
+          REQUIRE(loaded.GetNumBoards() == board);
+          REQUIRE(loaded.GetEngineSeed() == generated.GetEngineSeed());
+          REQUIRE(loaded.GetGameMap() == generated.GetGameMap());
+        }
+      }
+    }
+  }
+
+  SECTION("Boards outside the pack are left to the generator") {
+    GameStateGenerator generator(4);
+    REQUIRE_FALSE(pack.TakeBoard(4, 1, 1, generator));
+    REQUIRE_FALSE(pack.TakeBoard(17, 1, 1, generator));
+    REQUIRE_FALSE(pack.TakeBoard(5, 5, 1, generator));
+    REQUIRE_FALSE(pack.TakeBoard(5, 1, 4, generator));
+    REQUIRE_FALSE(pack.TakeBoard(5, 0, 1, generator));
+    REQUIRE(generator.GetNumBoards() == 0);
+  }
+
+  SECTION("Packs do not depend on the number of threads") {
+    config.num_threads = 1;
+    dig_dug::BuildLevelPack("level_pack_tests_single.ddl", config);
+    REQUIRE(ReadPackFile("level_pack_tests_single.ddl") == ReadPackFile(kPath));
+    std::remove("level_pack_tests_single.ddl");
+  }
+
+  SECTION("Episodes play the same with a pack") {
+    std::unique_ptr<BotPolicy> policy = dig_dug::CreateBotPolicy("hunter");
+
+    for (uint64_t seed = 5; seed < 17; seed++) {
+      REQUIRE(EpisodeRunner::PlayEpisode(seed, *policy, 20000, &pack)
+                  == EpisodeRunner::PlayEpisode(seed, *policy, 20000));
+    }
+  }
+
+  SECTION("Files that are not whole packs are rejected") {
+    vector<char> bytes = ReadPackFile(kPath);
+
+    std::ofstream(kPath, std::ios::binary).write(bytes.data(), (std::streamsize) (bytes.size() - 1));
+    REQUIRE_THROWS_AS(LevelPack(kPath), std::runtime_error);
+
+    bytes[0] = 'X';
+    std::ofstream(kPath, std::ios::binary).write(bytes.data(), (std::streamsize) (bytes.size()));
+    REQUIRE_THROWS_AS(LevelPack(kPath), std::runtime_error);
+
+    REQUIRE_THROWS_AS(LevelPack("level_pack_tests_missing.ddl"), std::runtime_error);
+  }
+
+  SECTION("Empty packs cannot be built") {
+    config.num_seeds = 0;
+    REQUIRE_THROWS_AS(dig_dug::BuildLevelPack(kPath, config), std::invalid_argument);
+  }
+
+  std::remove(kPath);
+}
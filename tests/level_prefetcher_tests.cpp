@@ -0,0 +1,93 @@
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <memory>
+
+#include "sim/episode_runner.h"
+#include "sim/level_prefetcher.h"
+#include "sim/spsc_ring.h"
+
+using dig_dug::BotPolicy;
+using dig_dug::EpisodeRunner;
+using dig_dug::GameStateGenerator;
+using dig_dug::LevelPrefetcher;
+using dig_dug::SpscRing;
+
+TEST_CASE("Single producer, single consumer ring") {
+  SpscRing<size_t, 4> ring;
+  size_t item = 0;
+  REQUIRE(ring.IsEmpty());
+  REQUIRE_FALSE(ring.TryPop(item));
+
+  SECTION("Items come out in order") {
+    for (size_t value = 1; value <= 4; value++) {
+      REQUIRE(ring.TryPush(value));
+    }
+
+    size_t extra = 5;
+    REQUIRE_FALSE(ring.TryPush(extra));
+
+    for (size_t value = 1; value <= 4; value++) {
+      REQUIRE(ring.TryPop(item));
+      REQUIRE(item == value);
+    }
+    REQUIRE(ring.IsEmpty());
+  }
+
+  SECTION("Slots are reused after wrapping around") {
+    for (size_t value = 0; value < 10; value++) {
+      REQUIRE(ring.TryPush(value));
+      REQUIRE(ring.TryPop(item));
+      REQUIRE(item == value);
+    }
+  }
+}
+
+TEST_CASE("Level prefetcher") {
+  LevelPrefetcher prefetcher;
+
+  SECTION("Prepared boards match the generator") {
+    prefetcher.Prepare(3, 2, 1);
+    prefetcher.Wait();
+
+    GameStateGenerator generated(3);
+    generated.SetLevel(2);
+    generated.Generate();
+
+    GameStateGenerator loaded(3);
+    REQUIRE(prefetcher.TakeBoard(3, 2, 1, loaded));
+    REQUIRE(loaded.GetLevel() == 2);
+    REQUIRE(loaded.GetNumBoards() == 1);
+    REQUIRE(loaded.GetEngineSeed() == generated.GetEngineSeed());
+    REQUIRE(loaded.GetGameMap() == generated.GetGameMap());
+  }
+
+  SECTION("Boards that were not prepared are not handed out") {
+    GameStateGenerator generator(3);
+    REQUIRE_FALSE(prefetcher.TakeBoard(3, 1, 1, generator));
+    REQUIRE(generator.GetNumBoards() == 0);
+  }
+
+  SECTION("Boards for paths the game did not take are dropped") {
+    prefetcher.Prepare(3, 2, 1);
+    prefetcher.Prepare(3, 1, 2);
+    prefetcher.Wait();
+
+    GameStateGenerator generator(3);
+    REQUIRE(prefetcher.TakeBoard(3, 1, 2, generator));
+    REQUIRE_FALSE(prefetcher.TakeBoard(3, 2, 1, generator));
+  }
+
+  SECTION("Episodes play the same with a prefetcher") {
+    std::unique_ptr<BotPolicy> policy = dig_dug::CreateBotPolicy("hunter");
+
+    for (uint64_t seed = 1; seed <= 6; seed++) {
+      REQUIRE(EpisodeRunner::PlayEpisode(seed, *policy, 20000, &prefetcher)
+                  == EpisodeRunner::PlayEpisode(seed, *policy, 20000));
+    }
+  }
+
+  SECTION("Board sizes the generator cannot make are rejected") {
+    REQUIRE_THROWS_AS(LevelPrefetcher(GameStateGenerator::kMinBoardDimension - 1), std::invalid_argument);
+  }
+}
@@ -0,0 +1,153 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "bench/allocation_counter.h"
+#include "bench/engine_benchmarks.h"
+#include "bench/micro_benchmark.h"
+
+using dig_dug::BenchmarkCase;
+using dig_dug::BenchmarkOptions;
+using dig_dug::BenchmarkResult;
+
+TEST_CASE("Counting allocations") {
+  size_t start_allocations = dig_dug::GetNumAllocations();
+  size_t start_bytes = dig_dug::GetNumAllocatedBytes();
+
+  std::unique_ptr<std::vector<int>> numbers(new std::vector<int>(100));
+
+  REQUIRE(dig_dug::GetNumAllocations() - start_allocations == 2);
+  REQUIRE(dig_dug::GetNumAllocatedBytes() - start_bytes >= 100 * sizeof(int));
+
+  SECTION("Nothrow allocations are counted too") {
+    size_t start_nothrow = dig_dug::GetNumAllocations();
+    int* number = new (std::nothrow) int(1);
+    int* digits = new (std::nothrow) int[10];
+
+    REQUIRE(dig_dug::GetNumAllocations() - start_nothrow == 2);
+    delete number;
+    delete[] digits;
+  }
+}
+
+TEST_CASE("Running benchmarks") {
+  BenchmarkOptions options;
+  options.min_batch_seconds = 0.001;
+  options.num_batches = 3;
+
+  SECTION("Operations are timed and their allocations counted") {
+    size_t num_setups = 0;
+    BenchmarkCase benchmark;
+    benchmark.name = "allocate";
+    benchmark.board_dimension = 15;
+    benchmark.setup = [&num_setups]() {
+      num_setups++;
+      std::vector<int> untimed(10);
+    };
+    benchmark.run = [](size_t num_ops) {
+      for (size_t op = 0; op < num_ops; op++) {
+        std::vector<int> numbers(op % 7 + 1);
+      }
+    };
+
+    BenchmarkResult result = dig_dug::RunBenchmark(benchmark, options);
+    REQUIRE(result.name == "allocate");
+    REQUIRE(result.board_dimension == 15);
+    REQUIRE(result.batch_ops > 1);
+    REQUIRE(result.ns_per_op > 0);
+    REQUIRE(result.allocs_per_op == 1);
+    REQUIRE(result.GetOpsPerSecond() > 0);
+    REQUIRE(num_setups > 3);
+  }
+
+  SECTION("Batches stop growing at the limit") {
+    options.min_batch_seconds = 10;
+    options.max_batch_ops = 64;
+
+    BenchmarkCase benchmark;
+    benchmark.run = [](size_t num_ops) {};
+    REQUIRE(dig_dug::RunBenchmark(benchmark, options).batch_ops == 64);
+  }
+
+  SECTION("Every engine benchmark runs on a small board") {
+    std::vector<BenchmarkCase> benchmarks = dig_dug::MakeEngineBenchmarks(15, 3);
+    REQUIRE(benchmarks.size() == 11);
+
+    for (const BenchmarkCase& benchmark : benchmarks) {
+      BenchmarkResult result = dig_dug::RunBenchmark(benchmark, options);
+      REQUIRE(result.board_dimension == 15);
+      REQUIRE(result.num_enemies > 0);
+      REQUIRE(result.map_bytes > 0);
+      REQUIRE(result.ns_per_op > 0);
+    }
+  }
+
+  SECTION("Engine benchmarks can set the number of enemies") {
+    std::vector<BenchmarkCase> benchmarks = dig_dug::MakeEngineBenchmarks(64, 3);
+    std::vector<BenchmarkCase> crowded = dig_dug::MakeEngineBenchmarks(64, 3, 40);
+
+    REQUIRE(crowded[0].enemy_scale == 40);
+    REQUIRE(crowded[0].num_enemies > benchmarks[0].num_enemies * 5);
+    REQUIRE(dig_dug::RunBenchmark(crowded[0], options).GetKey() == crowded[0].name + "/64/x40");
+  }
+}
+
+TEST_CASE("Benchmark results as JSON") {
+  const std::string kPath = "benchmark_results_test.json";
+
+  std::vector<BenchmarkResult> results(2);
+  results[0].name = "move_enemies";
+  results[0].board_dimension = 64;
+  results[0].num_enemies = 72;
+  results[0].batch_ops = 4096;
+  results[0].ns_per_op = 1234.5;
+  results[0].allocs_per_op = 0.25;
+  results[0].bytes_per_op = 16;
+  results[0].map_bytes = 4096;
+  results[1].name = "generate";
+  results[1].board_dimension = 15;
+  results[1].enemy_scale = 3;
+
+  SECTION("Results read back the same") {
+    dig_dug::WriteBenchmarkJson(kPath, results, "commit \"abc\"");
+    std::vector<BenchmarkResult> read = dig_dug::ReadBenchmarkJson(kPath);
+
+    REQUIRE(read.size() == 2);
+    REQUIRE(read[0].GetKey() == "move_enemies/64");
+    REQUIRE(read[0].num_enemies == 72);
+    REQUIRE(read[0].batch_ops == 4096);
+    REQUIRE(read[0].ns_per_op == Approx(1234.5));
+    REQUIRE(read[0].allocs_per_op == Approx(0.25));
+    REQUIRE(read[0].bytes_per_op == Approx(16));
+    REQUIRE(read[0].map_bytes == 4096);
+    REQUIRE(read[1].GetKey() == "generate/15/x3");
+  }
+
+  SECTION("Results from before enemy counts could be set read back") {
+    std::FILE* file = std::fopen(kPath.c_str(), "w");
+    std::fputs("{\n  \"label\": \"old\",\n  \"benchmarks\": [\n"
+               "    {\"name\": \"generate\", \"board_size\": 15, \"enemies\": 4, \"batch_ops\": 8, "
+               "\"ns_per_op\": 2.000, \"allocs_per_op\": 0.0000, \"bytes_per_op\": 0.0, \"ops_per_second\": 5.0}\n"
+               "  ]\n}\n",
+               file);
+    std::fclose(file);
+
+    std::vector<BenchmarkResult> read = dig_dug::ReadBenchmarkJson(kPath);
+    REQUIRE(read.size() == 1);
+    REQUIRE(read[0].GetKey() == "generate/15");
+    REQUIRE(read[0].map_bytes == 0);
+  }
+
+  SECTION("Other files are rejected") {
+    std::FILE* file = std::fopen(kPath.c_str(), "w");
+    std::fputs("{}\n", file);
+    std::fclose(file);
+
+    REQUIRE_THROWS_AS(dig_dug::ReadBenchmarkJson(kPath), std::runtime_error);
+  }
+
+  std::remove(kPath.c_str());
+}
@@ -0,0 +1,188 @@
+#include <catch2/catch.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "core/random.h"
+#include "core/game_engine.h"
+#include "core/game_state_generator.h"
+
+using dig_dug::Random;
+using dig_dug::GameEngine;
+using dig_dug::GameStateGenerator;
+using dig_dug::TileGrid;
+using glm::vec2;
+using std::vector;
+
+namespace {
+
+/**
+ * Plays a level with scripted input and hashes every enemy position and the score along the way
+ */
+uint64_t PlaySeededLevel(uint64_t seed, size_t num_ticks) {
+  GameStateGenerator generator(seed);
+  generator.Generate();
+  GameEngine engine(generator.GetTileGrid(), 100, generator.GetEngineSeed());
+
+  const vec2 kDirections[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t tick = 0; tick < num_ticks; tick++) {
+    if (tick % 7 == 0) {
+      engine.AttackEnemy();
+    } else {
+      engine.MovePlayer(kDirections[(tick / 40) % 4]);
+    }
+
+    engine.MoveEnemies();
+    engine.IsPlayerDead();
+
+    for (const dig_dug::Enemy& enemy : engine.GetEnemies()) {
+      hash = (hash ^ (uint32_t) (enemy.GetFixedPosition().x)) * 1099511628211ULL;
+      hash = (hash ^ (uint32_t) (enemy.GetFixedPosition().y)) * 1099511628211ULL;
+    }
+    hash = (hash ^ engine.GetScore()) * 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+} // namespace
+
+TEST_CASE("Philox block function") {
+  SECTION("Matches the Random123 known answers") {
+    uint32_t counter[4] = {0, 0, 0, 0};
+    const uint32_t key[2] = {0, 0};
+    Random::Philox(counter, key);
+
+    REQUIRE(counter[0] == 0x6627e8d5);
+    REQUIRE(counter[1] == 0xe169c58d);
+    REQUIRE(counter[2] == 0xbc57ac4c);
+    REQUIRE(counter[3] == 0x9b00dbd8);
+  }
+
+  SECTION("Matches the Random123 known answers with every bit set") {
+    uint32_t counter[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+    const uint32_t key[2] = {0xffffffff, 0xffffffff};
+    Random::Philox(counter, key);
+
+    REQUIRE(counter[0] == 0x408f276d);
+    REQUIRE(counter[1] == 0x41c83b0e);
+    REQUIRE(counter[2] == 0xa20bc7c6);
+    REQUIRE(counter[3] == 0x6d5451fd);
+  }
+}
+
+TEST_CASE("Random streams") {
+  Random random(42, 3);
+
+  SECTION("Same seed and stream give the same numbers") {
+    Random other(42, 3);
+    for (size_t draw = 0; draw < 100; draw++) {
+      REQUIRE(random.Next() == other.Next());
+    }
+  }
+
+  SECTION("Different streams give different numbers") {
+    Random other(42, 4);
+    size_t num_equal = 0;
+    for (size_t draw = 0; draw < 100; draw++) {
+      if (random.Next() == other.Next()) {
+        num_equal++;
+      }
+    }
+
+    REQUIRE(num_equal < 2);
+  }
+
+  SECTION("Seeking jumps straight to a position") {
+    vector<uint32_t> values;
+    for (size_t draw = 0; draw < 11; draw++) {
+      values.push_back(random.Next());
+    }
+    REQUIRE(random.GetPosition() == 11);
+
+    Random jumped(42, 3);
+    jumped.Seek(6);
+    REQUIRE(jumped.GetPosition() == 6);
+    REQUIRE(jumped.Next() == values[6]);
+    REQUIRE(jumped.Next() == values[7]);
+
+    jumped.Seek(8);
+    REQUIRE(jumped.Next() == values[8]);
+  }
+
+  SECTION("Changing streams starts from the beginning of the stream") {
+    Random other(42, 7);
+    random.Next();
+    random.SetStream(7);
+
+    REQUIRE(random == other);
+    REQUIRE(random.Next() == other.Next());
+  }
+
+  SECTION("Numbers below a bound stay in range") {
+    vector<size_t> counts(6, 0);
+    for (size_t draw = 0; draw < 6000; draw++) {
+      uint32_t value = random.NextBelow(6);
+      REQUIRE(value < 6);
+      counts[value]++;
+    }
+
+    for (size_t count : counts) {
+      REQUIRE(count > 800);
+    }
+  }
+}
+
+TEST_CASE("Seeded generators") {
+  SECTION("Same seed gives the same boards") {
+    GameStateGenerator generator(9);
+    GameStateGenerator other(9);
+    REQUIRE(generator.Generate() == other.Generate());
+    REQUIRE(generator.GetEngineSeed() == other.GetEngineSeed());
+  }
+
+  SECTION("Generating again on a level makes a new board") {
+    GameStateGenerator generator(9);
+    TileGrid first = generator.Generate();
+    REQUIRE(generator.Generate() != first);
+  }
+
+  SECTION("Jumping to a level gives the same board as playing up to it") {
+    GameStateGenerator played(9);
+    for (size_t level = 1; level < 6; level++) {
+      played.Generate();
+      played.Generate();
+      played.IncreaseLevel();
+    }
+
+    GameStateGenerator jumped(9);
+    jumped.SetLevel(6);
+    REQUIRE(played.Generate() == jumped.Generate());
+  }
+}
+
+TEST_CASE("Seeded engines are reproducible across threads") {
+  const size_t kNumRuns = 4;
+  const size_t kNumTicks = 2000;
+
+  vector<uint64_t> alone_hashes;
+  for (size_t run = 0; run < kNumRuns; run++) {
+    alone_hashes.push_back(PlaySeededLevel(run + 1, kNumTicks));
+  }
+
+  vector<uint64_t> threaded_hashes(kNumRuns);
+  vector<std::thread> threads;
+  for (size_t run = 0; run < kNumRuns; run++) {
+    threads.emplace_back([run, &threaded_hashes]() {
+      threaded_hashes[run] = PlaySeededLevel(run + 1, kNumTicks);
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(threaded_hashes == alone_hashes);
+  REQUIRE(alone_hashes[0] != alone_hashes[1]);
+}
@@ -0,0 +1,198 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <vector>
+
+#include "core/binary_io.h"
+#include "core/replay_reader.h"
+#include "core/replay_writer.h"
+
+using dig_dug::ByteReader;
+using dig_dug::GameSession;
+using dig_dug::GameStateGenerator;
+using dig_dug::InputFrame;
+using dig_dug::PlayerAction;
+using dig_dug::Random;
+using dig_dug::ReplayReader;
+using dig_dug::ReplayWriter;
+using dig_dug::SessionSnapshot;
+using std::vector;
+
+/**
+ * Records a game of held random keys, keeping the state hash after every tick
+ */
+vector<uint8_t> RecordGame(size_t num_ticks, size_t keyframe_interval, vector<uint64_t>& hashes,
+                           size_t board_dimension = GameStateGenerator::kDefaultBoardDimension,
+                           size_t enemy_scale = 0) {
+  const uint32_t kNumActions = 6;
+  const uint32_t kMaxHoldTicks = 40;
+  GameSession session(21, 100, 1, nullptr, board_dimension, enemy_scale);
+  ReplayWriter writer(session, keyframe_interval);
+  Random random(4);
+  InputFrame input;
+  size_t hold_ticks = 0;
+
+  hashes.push_back(session.GetStateHash());
+  for (size_t tick = 0; tick < num_ticks; tick++) {
+    if (hold_ticks == 0) {
+      input.action = static_cast<PlayerAction>(random.NextBelow(kNumActions));
+      hold_ticks = random.NextBelow(kMaxHoldTicks) + 1;
+    }
+    hold_ticks--;
+
+    writer.Record(session, input);
+    session.Update(input);
+    hashes.push_back(session.GetStateHash());
+  }
+
+  return writer.Finish(session);
+}
+
+TEST_CASE("Varints") {
+  const uint64_t kValues[] = {0, 1, 127, 128, 300, UINT32_MAX, UINT64_MAX};
+  vector<uint8_t> bytes;
+  for (uint64_t value : kValues) {
+    dig_dug::PutVarint(bytes, value);
+  }
+  dig_dug::PutFixed32(bytes, 0x01020304);
+
+  REQUIRE(bytes[0] == 0);
+  REQUIRE(bytes[3] == 0x80);
+  REQUIRE(bytes[4] == 0x01);
+
+  ByteReader reader(bytes.data(), bytes.size());
+  for (uint64_t value : kValues) {
+    REQUIRE(reader.ReadVarint() == value);
+  }
+  REQUIRE(reader.ReadFixed32() == 0x01020304);
+  REQUIRE(reader.GetNumLeft() == 0);
+  REQUIRE_THROWS_AS(reader.ReadVarint(), std::runtime_error);
+}
+
+TEST_CASE("Session snapshots") {
+  GameSession session(9, 100);
+  for (size_t tick = 0; tick < 700; tick++) {
+    session.Update(InputFrame(tick % 90 < 45 ? PlayerAction::Attack : PlayerAction::Down));
+  }
+  SessionSnapshot snapshot = session.Snapshot();
+  uint64_t hash = session.GetStateHash();
+
+  for (size_t tick = 0; tick < 500; tick++) {
+    session.Update();
+  }
+  REQUIRE(session.GetStateHash() != hash);
+
+  GameSession other;
+  other.Restore(snapshot);
+  session.Restore(snapshot);
+  REQUIRE(session.GetStateHash() == hash);
+  REQUIRE(other.GetStateHash() == hash);
+  REQUIRE(other.GetGenerator().GetTileGrid() == session.GetGenerator().GetTileGrid());
+
+  for (size_t tick = 0; tick < 500; tick++) {
+    session.Update();
+    other.Update();
+  }
+  REQUIRE(other.GetStateHash() == session.GetStateHash());
+}
+
+TEST_CASE("Replays") {
+  const size_t kNumTicks = 2500;
+  const size_t kKeyframeInterval = 100;
+  vector<uint64_t> hashes;
+  vector<uint8_t> bytes = RecordGame(kNumTicks, kKeyframeInterval, hashes);
+  ReplayReader reader(bytes.data(), bytes.size());
+  GameSession session;
+
+  SECTION("Header and footer") {
+    REQUIRE(reader.GetSeed() == 21);
+    REQUIRE(reader.GetLevel() == 1);
+    REQUIRE(reader.GetTileSize() == 100);
+    REQUIRE(reader.GetBoardDimension() == GameStateGenerator::kDefaultBoardDimension);
+    REQUIRE(reader.GetEnemyScale() == 1);
+    REQUIRE(reader.GetNumTicks() == kNumTicks);
+    REQUIRE(reader.GetNumKeyframes() == kNumTicks / kKeyframeInterval);
+  }
+
+  SECTION("Inputs take a few bytes per second") {
+    size_t snapshot_bytes = reader.GetNumKeyframes() * dig_dug::kReplayKeyframeSize;
+    size_t input_bytes = bytes.size() - snapshot_bytes - dig_dug::kReplayHeaderSize - dig_dug::kReplayFooterSize;
+    REQUIRE(input_bytes < kNumTicks / 10);
+  }
+
+  SECTION("Plays the whole game the same way") {
+    reader.Play(session);
+    REQUIRE(reader.GetTick() == kNumTicks);
+    REQUIRE(session.GetStateHash() == hashes.back());
+  }
+
+  SECTION("Seeks to any tick") {
+    const size_t kTicks[] = {0, 1, 99, 100, 101, 1234, 2400, 2499, 2500};
+    for (size_t tick : kTicks) {
+      reader.Seek(session, tick);
+      REQUIRE(reader.GetTick() == tick);
+      REQUIRE(session.GetStateHash() == hashes[tick]);
+    }
+  }
+
+  SECTION("Plays on after seeking") {
+    reader.Seek(session, 1750);
+    reader.Advance(session, 333);
+    REQUIRE(session.GetStateHash() == hashes[2083]);
+    REQUIRE_THROWS_AS(reader.Advance(session, kNumTicks), std::out_of_range);
+  }
+
+  SECTION("Catches a game that plays differently") {
+    // Changes the length of the first run of inputs
+    bytes[dig_dug::kReplayHeaderSize] ^= 1 << dig_dug::kReplayActionBits;
+    REQUIRE_THROWS_AS(reader.Play(session), std::runtime_error);
+  }
+
+  SECTION("Plays games on boards of other sizes") {
+    vector<uint64_t> small_hashes;
+    vector<uint8_t> small_bytes = RecordGame(500, kKeyframeInterval, small_hashes, 12);
+    ReplayReader small_reader(small_bytes.data(), small_bytes.size());
+    small_reader.Play(session);
+
+    REQUIRE(small_reader.GetBoardDimension() == 12);
+    REQUIRE(session.GetGenerator().GetBoardDimension() == 12);
+    REQUIRE(session.GetStateHash() == small_hashes.back());
+  }
+
+  SECTION("Plays games with more enemies") {
+    vector<uint64_t> crowded_hashes;
+    vector<uint8_t> crowded_bytes = RecordGame(500, kKeyframeInterval, crowded_hashes, 12, 2);
+    ReplayReader crowded_reader(crowded_bytes.data(), crowded_bytes.size());
+    crowded_reader.Play(session);
+
+    REQUIRE(crowded_reader.GetEnemyScale() == 2);
+    REQUIRE(session.GetGenerator().GetEnemyScale() == 2);
+    REQUIRE(session.GetStateHash() == crowded_hashes.back());
+  }
+
+  SECTION("Rejects files that are not replays") {
+    bytes[0] = 0;
+    REQUIRE_THROWS_AS(ReplayReader(bytes.data(), bytes.size()), std::runtime_error);
+    REQUIRE_THROWS_AS(ReplayReader(bytes.data(), bytes.size() - 1), std::runtime_error);
+  }
+}
+
+TEST_CASE("Replay files") {
+  const char* kPath = "replay_tests.ddr";
+  GameSession session(30, 100);
+  ReplayWriter writer(session, 50);
+  for (size_t tick = 0; tick < 400; tick++) {
+    InputFrame input(tick % 100 < 50 ? PlayerAction::Right : PlayerAction::Left);
+    writer.Record(session, input);
+    session.Update(input);
+  }
+  writer.Save(kPath, session);
+
+  ReplayReader reader(kPath);
+  GameSession replay;
+  reader.Play(replay);
+  REQUIRE(replay.GetStateHash() == session.GetStateHash());
+
+  std::remove(kPath);
+  REQUIRE_THROWS_AS(ReplayReader(kPath), std::runtime_error);
+}
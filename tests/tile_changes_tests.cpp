@@ -0,0 +1,111 @@
+#include <catch2/catch.hpp>
+
+#include "core/game_engine.h"
+#include "core/game_state_generator.h"
+#include "core/player_action.h"
+
+using dig_dug::GameEngine;
+using dig_dug::GameStateGenerator;
+using dig_dug::EngineSnapshot;
+using dig_dug::PlayerAction;
+using dig_dug::Random;
+using dig_dug::TileChange;
+using dig_dug::TileGrid;
+using dig_dug::TileType;
+
+/**
+ * Brings a copy of the map up to date the way an incremental consumer would, and starts a new list of changes
+ */
+void ApplyTileChanges(GameEngine& engine, TileGrid& map) {
+  if (engine.IsMapReplaced()) {
+    map = engine.GetTileGrid();
+  } else {
+    for (const TileChange& change : engine.GetTileChanges()) {
+      map.Set(change.x, change.y, change.type);
+    }
+  }
+
+  engine.ClearTileChanges();
+}
+
+/**
+ * Plays random actions the same way the game loop does, keeping a copy of the map up to date every few ticks
+ */
+void PlayAndReplay(GameEngine& engine, TileGrid& map, size_t num_frames, Random& random) {
+  const uint32_t kNumActions = 6;
+  const uint32_t kMaxTicksBetweenReads = 5;
+  size_t ticks_until_read = 1;
+
+  for (size_t frame = 0; frame < num_frames; frame++) {
+    ApplyAction(engine, static_cast<PlayerAction>(random.NextBelow(kNumActions)));
+    if (!engine.IsPlayerDead()) {
+      engine.MoveEnemies();
+    }
+
+    if (--ticks_until_read == 0) {
+      ApplyTileChanges(engine, map);
+      ticks_until_read = random.NextBelow(kMaxTicksBetweenReads) + 1;
+    }
+  }
+}
+
+TEST_CASE("Tile change list") {
+  GameStateGenerator generator(8);
+  GameEngine engine(generator.Generate(), 100, generator.GetEngineSeed());
+
+  SECTION("New engines ask for the whole map") {
+    REQUIRE(engine.IsMapReplaced());
+    REQUIRE(engine.GetTileChanges().empty());
+
+    engine.ClearTileChanges();
+    REQUIRE_FALSE(engine.IsMapReplaced());
+  }
+
+  SECTION("Moving through a tunnel changes nothing") {
+    engine.ClearTileChanges();
+    engine.MovePlayer({0, -1});
+
+    REQUIRE(engine.GetTileChanges().empty());
+  }
+
+  SECTION("Digging records the new tunnel") {
+    engine.ClearTileChanges();
+    size_t center = engine.GetTileGrid().GetDimension() / 2;
+    for (size_t frame = 0; frame < 6; frame++) {
+      engine.MovePlayer({0, 1});
+    }
+
+    REQUIRE(engine.GetTileChanges().size() == 1);
+    REQUIRE(engine.GetTileChanges()[0].x == center);
+    REQUIRE(engine.GetTileChanges()[0].y == center + 1);
+    REQUIRE(engine.GetTileChanges()[0].type == TileType::Tunnel);
+  }
+
+  SECTION("Restoring replaces the whole map") {
+    EngineSnapshot snapshot = engine.Snapshot();
+    engine.ClearTileChanges();
+    engine.Restore(snapshot);
+
+    REQUIRE(engine.IsMapReplaced());
+    REQUIRE(engine.GetTileChanges().empty());
+  }
+}
+
+TEST_CASE("Replaying tile changes reproduces the map") {
+  Random random(21);
+
+  for (uint64_t seed = 1; seed <= 10; seed++) {
+    GameStateGenerator generator(seed);
+    GameEngine engine(generator.Generate(), 100, generator.GetEngineSeed());
+    TileGrid map;
+
+    PlayAndReplay(engine, map, 300, random);
+    EngineSnapshot snapshot = engine.Snapshot();
+    PlayAndReplay(engine, map, 300, random);
+    engine.Restore(snapshot);
+    PlayAndReplay(engine, map, 300, random);
+    ApplyTileChanges(engine, map);
+
+    REQUIRE(map == engine.GetTileGrid());
+  }
+}
@@ -0,0 +1,194 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include "core/tile_grid.h"
+#include "core/game_state_generator.h"
+#include "core/state_hash.h"
+
+using dig_dug::StateHash;
+using dig_dug::TileGrid;
+using dig_dug::TileStorage;
+using dig_dug::TileType;
+using dig_dug::GameStateGenerator;
+using std::vector;
+
+TEST_CASE("Tile grid construction") {
+  SECTION("Filled grid") {
+    TileGrid grid(15, TileType::Dirt);
+    REQUIRE(grid.GetDimension() == 15);
+    REQUIRE(grid.GetNumTiles() == 225);
+
+    bool is_all_dirt = true;
+    for (size_t x = 0; x < 15; x++) {
+      for (size_t y = 0; y < 15; y++) {
+        if (grid.Get(x, y) != TileType::Dirt) {
+          is_all_dirt = false;
+        }
+      }
+    }
+
+    REQUIRE(is_all_dirt);
+  }
+
+  SECTION("Grid built from nested map keeps [x][y] order") {
+    vector<vector<TileType>> tiles(3, vector<TileType>(3, TileType::Dirt));
+    tiles[2][0] = TileType::Rock;
+    tiles[0][1] = TileType::Tunnel;
+    TileGrid grid(tiles);
+
+    REQUIRE(grid.Get(2, 0) == TileType::Rock);
+    REQUIRE(grid.Get(0, 1) == TileType::Tunnel);
+    REQUIRE(grid.ToNestedVector() == tiles);
+  }
+
+  SECTION("Non-square nested map is rejected") {
+    vector<vector<TileType>> tiles(3, vector<TileType>(2, TileType::Dirt));
+    REQUIRE_THROWS_AS(TileGrid(tiles), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Tile grid accessors") {
+  TileGrid grid(4, TileType::Dirt);
+
+  SECTION("Checked and unchecked accessors agree") {
+    grid.Set(1, 3, TileType::Tunnel);
+    grid.SetUnchecked(3, 1, TileType::Rock);
+
+    REQUIRE(grid.GetUnchecked(1, 3) == TileType::Tunnel);
+    REQUIRE(grid.Get(3, 1) == TileType::Rock);
+  }
+
+  SECTION("Tiles are stored contiguously in row-major order") {
+    grid.Set(1, 2, TileType::Tunnel);
+    REQUIRE(grid.GetData()[1 * 4 + 2] == static_cast<uint8_t>(TileType::Tunnel));
+  }
+
+  SECTION("Checked accessors reject coordinates off the board") {
+    REQUIRE_THROWS_AS(grid.Get(4, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(grid.Set(0, 4, TileType::Rock), std::out_of_range);
+    REQUIRE_FALSE(grid.IsInBounds(0, 4));
+    REQUIRE(grid.IsInBounds(3, 3));
+  }
+
+  SECTION("Comparing grids") {
+    TileGrid other(4, TileType::Dirt);
+    REQUIRE(grid == other);
+
+    other.Set(0, 0, TileType::Tunnel);
+    REQUIRE(grid != other);
+  }
+}
+
+TEST_CASE("Generator exposes the same map as a grid and as a nested map") {
+  GameStateGenerator generator;
+  const TileGrid& grid = generator.Generate();
+  vector<vector<TileType>> game_map = generator.GetGameMap();
+
+  REQUIRE(TileGrid(game_map) == grid);
+}
+
+TEST_CASE("Chunked tile grids") {
+  const size_t kDimension = 300;
+  TileGrid chunked(kDimension, TileType::Dirt);
+  TileGrid dense(kDimension, TileType::Dirt, TileStorage::Dense);
+
+  // Digs a tunnel across the middle of the board and drops a few rocks
+  for (size_t x = 0; x < kDimension; x++) {
+    chunked.Set(x, 150, TileType::Tunnel);
+    dense.Set(x, 150, TileType::Tunnel);
+  }
+  chunked.Set(299, 299, TileType::Rock);
+  dense.Set(299, 299, TileType::Rock);
+
+  SECTION("Large grids are chunked and hold the same tiles as dense ones") {
+    REQUIRE(chunked.GetStorage() == TileStorage::Chunked);
+    REQUIRE(dense.GetStorage() == TileStorage::Dense);
+    REQUIRE(TileGrid(15, TileType::Dirt).GetStorage() == TileStorage::Dense);
+    REQUIRE(chunked.GetData() == nullptr);
+    REQUIRE(chunked == dense);
+
+    REQUIRE(chunked.Get(17, 150) == TileType::Tunnel);
+    REQUIRE(chunked.Get(299, 299) == TileType::Rock);
+    REQUIRE(chunked.Get(0, 0) == TileType::Dirt);
+    REQUIRE(chunked.IsImplicit(0, 0));
+    REQUIRE_FALSE(chunked.IsImplicit(17, 150));
+    REQUIRE_THROWS_AS(chunked.Get(kDimension, 0), std::out_of_range);
+  }
+
+  SECTION("Memory follows the changed tiles rather than the board") {
+    // One row of chunks for the tunnel, and one more for the rock
+    REQUIRE(chunked.GetNumResidentChunks() == 11);
+    REQUIRE(chunked.GetMemoryUsage() < dense.GetMemoryUsage() / 4);
+
+    // Setting a tile to the fill type does not give its chunk memory
+    chunked.Set(0, 0, TileType::Dirt);
+    REQUIRE(chunked.GetNumResidentChunks() == 11);
+  }
+
+  SECTION("Grids with the same tiles hash the same however they are chunked") {
+    TileGrid copy(chunked);
+    copy.Set(0, 0, TileType::Tunnel);
+    copy.Set(0, 0, TileType::Dirt);
+
+    StateHash chunked_hash;
+    StateHash copy_hash;
+    chunked.AddToHash(chunked_hash);
+    copy.AddToHash(copy_hash);
+    REQUIRE(copy.GetNumResidentChunks() == 12);
+    REQUIRE(chunked_hash.Get() == copy_hash.Get());
+
+    copy.Set(1, 1, TileType::Rock);
+    StateHash changed_hash;
+    copy.AddToHash(changed_hash);
+    REQUIRE(changed_hash.Get() != chunked_hash.Get());
+  }
+
+  SECTION("Cold chunks spill to a file and come back when written") {
+    chunked.SpillTo(".", 4);
+    REQUIRE(chunked.GetNumResidentChunks() == 4);
+    REQUIRE(chunked.GetNumSpilledChunks() == 7);
+    REQUIRE(chunked == dense);
+
+    // The rock's chunk was written last, so it stays in memory
+    REQUIRE_FALSE(chunked.IsImplicit(299, 299));
+    REQUIRE(chunked.Get(299, 299) == TileType::Rock);
+
+    // Writing a spilled chunk loads it and spills the coldest one in its place
+    chunked.Set(0, 151, TileType::Tunnel);
+    dense.Set(0, 151, TileType::Tunnel);
+    REQUIRE(chunked.GetNumResidentChunks() == 4);
+    REQUIRE(chunked.GetNumSpilledChunks() == 7);
+    REQUIRE(chunked == dense);
+
+    TileGrid copy(chunked);
+    REQUIRE(copy.GetNumSpilledChunks() == 0);
+    REQUIRE(copy.GetNumResidentChunks() == 11);
+    REQUIRE(copy == dense);
+  }
+
+  SECTION("Only chunked grids spill") {
+    REQUIRE_THROWS_AS(dense.SpillTo(".", 4), std::invalid_argument);
+    REQUIRE_THROWS_AS(chunked.SpillTo(".", 0), std::invalid_argument);
+  }
+
+  SECTION("Filling a chunked grid gives back its chunks") {
+    chunked.Fill(TileType::Tunnel);
+    REQUIRE(chunked.GetNumResidentChunks() == 0);
+    REQUIRE(chunked.Get(299, 299) == TileType::Tunnel);
+    REQUIRE(chunked == TileGrid(kDimension, TileType::Tunnel, TileStorage::Dense));
+  }
+
+  SECTION("Setting a chunked grid from dense tiles") {
+    TileGrid copy(kDimension, TileType::Dirt);
+    copy.SetData(dense.GetData());
+    REQUIRE(copy == dense);
+    REQUIRE(copy.GetNumResidentChunks() == 11);
+  }
+
+  SECTION("Copying the tiles out of a chunked grid") {
+    vector<uint8_t> tiles(chunked.GetNumTiles());
+    chunked.CopyData(tiles.data());
+    REQUIRE(std::equal(tiles.begin(), tiles.end(), dense.GetData()));
+  }
+}
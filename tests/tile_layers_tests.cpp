@@ -0,0 +1,236 @@
+#include <catch2/catch.hpp>
+
+#include <cstdlib>
+#include <queue>
+#include <utility>
+#include "core/bit_board.h"
+#include "core/tile_layers.h"
+#include "core/game_engine.h"
+
+using dig_dug::BitBoard;
+using dig_dug::TileLayers;
+using dig_dug::TileGrid;
+using dig_dug::TileType;
+using dig_dug::GameStateGenerator;
+using dig_dug::GameEngine;
+using glm::vec2;
+using std::vector;
+
+namespace {
+
+/**
+ * Reference copy of the scalar IsNextTileOpen that the engine used before it had bit board layers
+ */
+bool IsNextTileOpenScalar(const TileGrid& game_map, size_t tile_size, const vec2& velocity, const vec2& position) {
+  size_t board_size = game_map.GetDimension();
+  if (velocity.x > 0 && velocity.y == 0) {
+    size_t next_x = (size_t) (position.x) + (size_t) (velocity.x) + tile_size;
+    return next_x < board_size * tile_size
+           && game_map.Get(next_x / tile_size, (size_t) (position.y) / tile_size) != TileType::Rock;
+
+  } else if (velocity.x == 0 && velocity.y > 0) {
+    size_t next_y = (size_t) (position.y) + (size_t) (velocity.y) + tile_size;
+    return next_y < board_size * tile_size
+           && game_map.Get((size_t) (position.x) / tile_size, next_y / tile_size) != TileType::Rock;
+
+  } else if (velocity.x < 0 && velocity.y == 0) {
+    int next_x = ((int) (position.x) + (int) (velocity.x));
+    return next_x >= 0 && game_map.Get(next_x / tile_size, (size_t) (position.y) / tile_size) != TileType::Rock;
+
+  } else {
+    int next_y = ((int) (position.y) + (int) (velocity.y));
+    return next_y >= 0 && game_map.Get((size_t) (position.x) / tile_size, next_y / tile_size) != TileType::Rock;
+  }
+}
+
+/**
+ * Reference copy of the scalar IsNextTileDirt that the engine used before it had bit board layers
+ */
+bool IsNextTileDirtScalar(const TileGrid& game_map, size_t tile_size, const vec2& velocity, const vec2& position) {
+  if (!IsNextTileOpenScalar(game_map, tile_size, velocity, position)) {
+    return false;
+  }
+
+  int next_x;
+  int next_y;
+  if (velocity.x > 0 && velocity.y == 0) {
+    next_x = ((int) (position.x + velocity.x) + (int) (tile_size)) / (int) (tile_size);
+    next_y = (int) (position.y) / (int) (tile_size);
+
+  } else if (velocity.x == 0 && velocity.y > 0) {
+    next_x = (int) (position.x) / (int) (tile_size);
+    next_y = ((int) (position.y + velocity.y) + (int) (tile_size)) / (int) (tile_size);
+
+  } else if (velocity.x < 0 && velocity.y == 0) {
+    next_x = ((int) (position.x) + (int) (velocity.x)) / (int) (tile_size);
+    next_y = (int) (position.y) / (int) (tile_size);
+
+  } else {
+    next_y = ((int) (position.y) + (int) (velocity.y)) / (int) (tile_size);
+    next_x = (int) (position.x) / (int) (tile_size);
+  }
+
+  return game_map.Get(next_x, next_y) == TileType::Tunnel;
+}
+
+/**
+ * Breadth first search over tunnel tiles used to check the bit board flood fill
+ */
+BitBoard ReachableTunnelsScalar(const TileGrid& game_map, size_t start_x, size_t start_y) {
+  BitBoard reached;
+  if (game_map.Get(start_x, start_y) != TileType::Tunnel) {
+    return reached;
+  }
+
+  const int kOffsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+  std::queue<std::pair<size_t, size_t>> frontier;
+  frontier.push({start_x, start_y});
+  reached.Set(start_x, start_y);
+
+  while (!frontier.empty()) {
+    std::pair<size_t, size_t> tile = frontier.front();
+    frontier.pop();
+
+    for (const int* offset : kOffsets) {
+      size_t x = tile.first + offset[0];
+      size_t y = tile.second + offset[1];
+      if (game_map.IsInBounds(x, y) && game_map.Get(x, y) == TileType::Tunnel && !reached.Test(x, y)) {
+        reached.Set(x, y);
+        frontier.push({x, y});
+      }
+    }
+  }
+
+  return reached;
+}
+
+} // namespace
+
+TEST_CASE("Bit board set operations") {
+  BitBoard board;
+
+  SECTION("Setting and clearing tiles") {
+    board.Set(3, 4);
+    board.Set(15, 15);
+    REQUIRE(board.Test(3, 4));
+    REQUIRE(board.Test(15, 15));
+    REQUIRE(board.Count() == 2);
+
+    board.Clear(3, 4);
+    REQUIRE_FALSE(board.Test(3, 4));
+    REQUIRE(board.Count() == 1);
+  }
+
+  SECTION("Full board has one bit per tile") {
+    REQUIRE(BitBoard::Full(15).Count() == 225);
+    REQUIRE_FALSE(BitBoard::Full(15).Test(15, 0));
+    REQUIRE_THROWS_AS(BitBoard::Full(17), std::invalid_argument);
+  }
+
+  SECTION("Shifts move tiles one step and drop tiles at the edges") {
+    board.Set(0, 15);
+    board.Set(3, 0);
+
+    BitBoard plus_y = board.ShiftedPlusY();
+    REQUIRE(plus_y.Count() == 1);
+    REQUIRE(plus_y.Test(3, 1));
+
+    BitBoard minus_y = board.ShiftedMinusY();
+    REQUIRE(minus_y.Count() == 1);
+    REQUIRE(minus_y.Test(0, 14));
+
+    BitBoard plus_x = board.ShiftedPlusX();
+    REQUIRE(plus_x.Test(1, 15));
+    REQUIRE(plus_x.Test(4, 0));
+
+    BitBoard minus_x = board.ShiftedMinusX();
+    REQUIRE(minus_x.Count() == 1);
+    REQUIRE(minus_x.Test(2, 0));
+  }
+
+  SECTION("Neighbors of a tile") {
+    board.Set(7, 7);
+    BitBoard neighbors = board.Neighbors();
+    REQUIRE(neighbors.Count() == 4);
+    REQUIRE(neighbors.Test(6, 7));
+    REQUIRE(neighbors.Test(8, 7));
+    REQUIRE(neighbors.Test(7, 6));
+    REQUIRE(neighbors.Test(7, 8));
+  }
+}
+
+TEST_CASE("Tile layers match the scalar map") {
+  for (unsigned int seed = 1; seed <= 20; seed++) {
+    GameStateGenerator generator(seed);
+    generator.Generate();
+    GameEngine engine(generator.GetTileGrid(), 100);
+
+    // Digs some random tunnels so the layers are checked after DigUpTiles as well
+    const vec2 kDirections[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+    for (size_t move = 0; move < 400; move++) {
+      engine.MovePlayer(kDirections[(move / 25 + seed) % 4]);
+    }
+
+    const TileGrid& game_map = engine.GetTileGrid();
+    const TileLayers& layers = engine.GetTileLayers();
+    REQUIRE(engine.HasTileLayers());
+
+    SECTION("Next tile queries match the scalar logic") {
+      const vec2 kVelocities[9] = {{10, 0}, {-10, 0}, {0, 10}, {0, -10}, {4, 0}, {-4, 0}, {0, 4}, {0, -4}, {0, 0}};
+      const size_t kOffsets[3] = {0, 40, 96};
+
+      bool is_matching = true;
+      for (size_t x = 0; x < game_map.GetDimension(); x++) {
+        for (size_t y = 0; y < game_map.GetDimension(); y++) {
+          for (size_t offset : kOffsets) {
+            for (const vec2& velocity : kVelocities) {
+              vec2 position {x * 100 + (velocity.x != 0 ? offset : 0), y * 100 + (velocity.y != 0 ? offset : 0)};
+
+              if (engine.IsNextTileOpen(velocity, position)
+                  != IsNextTileOpenScalar(game_map, 100, velocity, position)
+                  || engine.IsNextTileDirt(velocity, position)
+                     != IsNextTileDirtScalar(game_map, 100, velocity, position)) {
+                is_matching = false;
+              }
+            }
+          }
+        }
+      }
+
+      REQUIRE(is_matching);
+    }
+
+    SECTION("Layers hold the same tiles as the map") {
+      REQUIRE(TileLayers(game_map).GetTunnels() == layers.GetTunnels());
+      REQUIRE(TileLayers(game_map).GetDirt() == layers.GetDirt());
+      REQUIRE(TileLayers(game_map).GetRocks() == layers.GetRocks());
+    }
+
+    SECTION("Whole board queries match scalar scans") {
+      size_t num_tunnels = 0;
+      BitBoard junctions;
+      for (size_t x = 0; x < game_map.GetDimension(); x++) {
+        for (size_t y = 0; y < game_map.GetDimension(); y++) {
+          if (game_map.Get(x, y) != TileType::Tunnel) {
+            continue;
+          }
+
+          num_tunnels++;
+          size_t num_tunnel_neighbors = 0;
+          num_tunnel_neighbors += x + 1 < 15 && game_map.Get(x + 1, y) == TileType::Tunnel;
+          num_tunnel_neighbors += x > 0 && game_map.Get(x - 1, y) == TileType::Tunnel;
+          num_tunnel_neighbors += y + 1 < 15 && game_map.Get(x, y + 1) == TileType::Tunnel;
+          num_tunnel_neighbors += y > 0 && game_map.Get(x, y - 1) == TileType::Tunnel;
+          if (num_tunnel_neighbors >= 3) {
+            junctions.Set(x, y);
+          }
+        }
+      }
+
+      REQUIRE(layers.CountTunnels() == num_tunnels);
+      REQUIRE(layers.GetJunctions() == junctions);
+      REQUIRE(layers.GetReachableTunnels(7, 7) == ReachableTunnelsScalar(game_map, 7, 7));
+      REQUIRE(layers.GetReachableTunnels(0, 0) == ReachableTunnelsScalar(game_map, 0, 0));
+    }
+  }
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+
+#include "core/game_engine.h"
+#include "core/game_state_generator.h"
+#include "core/player_action.h"
+#include "core/tunnel_exits.h"
+
+using dig_dug::Direction;
+using dig_dug::EnemyPool;
+using dig_dug::FixedVec2;
+using dig_dug::GameEngine;
+using dig_dug::GameStateGenerator;
+using dig_dug::PlayerAction;
+using dig_dug::Random;
+using dig_dug::TileGrid;
+using dig_dug::TileType;
+using dig_dug::TunnelExits;
+
+/**
+ * Finds the exits of a tile by looking at its neighbors
+ */
+uint8_t FindExits(const TileGrid& grid, size_t x, size_t y) {
+  uint8_t exits = 0;
+  for (size_t direction = 0; direction < dig_dug::kNumDirections; direction++) {
+    size_t next_x = x + dig_dug::kDirectionOffsetX[direction];
+    size_t next_y = y + dig_dug::kDirectionOffsetY[direction];
+
+    if (grid.IsInBounds(next_x, next_y) && grid.GetUnchecked(next_x, next_y) == TileType::Tunnel) {
+      exits |= (uint8_t) (1 << direction);
+    }
+  }
+
+  return exits;
+}
+
+void RequireExitsOf(const TunnelExits& exits, const TileGrid& grid) {
+  REQUIRE(exits.GetDimension() == grid.GetDimension());
+  for (size_t x = 0; x < grid.GetDimension(); x++) {
+    for (size_t y = 0; y < grid.GetDimension(); y++) {
+      REQUIRE(exits.GetExits(x, y) == FindExits(grid, x, y));
+    }
+  }
+}
+
+TEST_CASE("Tunnel exits") {
+  GameStateGenerator generator(4);
+  TileGrid grid = generator.Generate();
+  TunnelExits exits;
+  exits.Reset(grid);
+
+  SECTION("Are the tunnel neighbors of each tile") {
+    RequireExitsOf(exits, grid);
+  }
+
+  SECTION("Directions off the board are never exits") {
+    TileGrid tunnels(5, TileType::Tunnel);
+    exits.Reset(tunnels);
+
+    REQUIRE(exits.GetExits(0, 0) == ((1 << 0) | (1 << 1)));
+    REQUIRE(exits.GetExits(4, 4) == ((1 << 2) | (1 << 3)));
+    REQUIRE(exits.GetExits(2, 2) == 0xF);
+  }
+
+  SECTION("Follow tiles as they change") {
+    Random random(9);
+    for (size_t change = 0; change < 500; change++) {
+      size_t x = random.NextBelow((uint32_t) (grid.GetDimension()));
+      size_t y = random.NextBelow((uint32_t) (grid.GetDimension()));
+      TileType type = random.NextBelow(3) == 0 ? TileType::Dirt : TileType::Tunnel;
+
+      grid.SetUnchecked(x, y, type);
+      exits.SetTile(x, y, type);
+    }
+
+    RequireExitsOf(exits, grid);
+  }
+
+  SECTION("Check directions by bit") {
+    uint8_t mask = (uint8_t) (1 << static_cast<size_t>(Direction::Left));
+
+    REQUIRE(TunnelExits::HasExit(mask, Direction::Left));
+    REQUIRE_FALSE(TunnelExits::HasExit(mask, Direction::Right));
+  }
+
+  SECTION("Are only kept for boards that are not chunked") {
+    REQUIRE(TunnelExits::CanRepresent(TileGrid::kMaxDenseDimension));
+    REQUIRE_FALSE(TunnelExits::CanRepresent(TileGrid::kMaxDenseDimension + 1));
+  }
+}
+
+TEST_CASE("Engine tunnel exits") {
+  GameStateGenerator generator(6, 24);
+  GameEngine engine(generator.Generate(), 100, generator.GetEngineSeed());
+  REQUIRE(engine.HasTunnelExits());
+
+  SECTION("Match the board checks for every aligned enemy while the game is played") {
+    const uint32_t kNumActions = 6;
+    Random random(3);
+
+    for (size_t tick = 0; tick < 2000 && !engine.GetEnemyView().IsEmpty(); tick++) {
+      const EnemyPool& enemies = engine.GetEnemyView();
+      for (size_t index = 0; index < enemies.Size(); index++) {
+        FixedVec2 position = enemies.GetPosition(index);
+        int32_t pixels_x = dig_dug::FixedToPixels(position.x);
+        int32_t pixels_y = dig_dug::FixedToPixels(position.y);
+        if (pixels_x < 0 || pixels_y < 0 || pixels_x % 100 != 0 || pixels_y % 100 != 0
+            || (size_t) (pixels_x) / 100 >= 24 || (size_t) (pixels_y) / 100 >= 24) {
+          continue;
+        }
+
+        uint8_t exits = engine.GetTunnelExits().GetExits((size_t) (pixels_x) / 100, (size_t) (pixels_y) / 100);
+        for (size_t direction = 0; direction < dig_dug::kNumDirections; direction++) {
+          FixedVec2 velocity = dig_dug::DirectionVelocity(static_cast<Direction>(direction), GameEngine::kEnemySpeed);
+          REQUIRE(TunnelExits::HasExit(exits, static_cast<Direction>(direction))
+                  == engine.IsNextTileDirt(velocity, position));
+        }
+      }
+
+      dig_dug::ApplyAction(engine, static_cast<PlayerAction>(random.NextBelow(kNumActions)));
+      if (engine.IsPlayerDead()) {
+        engine.Reset(generator.Generate(), 100, generator.GetEngineSeed());
+      } else {
+        engine.MoveEnemies();
+      }
+    }
+  }
+
+  SECTION("Are rebuilt on restore") {
+    GameEngine small(GameStateGenerator(6).Generate(), 100);
+    dig_dug::EngineSnapshot snapshot = small.Snapshot();
+    for (size_t tick = 0; tick < 100; tick++) {
+      small.MovePlayer({1, 0});
+    }
+    small.Restore(snapshot);
+
+    RequireExitsOf(small.GetTunnelExits(), small.GetTileGrid());
+  }
+
+  SECTION("Are not kept on chunked boards") {
+    GameEngine large(TileGrid(TileGrid::kMaxDenseDimension + 1, TileType::Dirt), 100);
+
+    REQUIRE_FALSE(large.HasTunnelExits());
+  }
+}